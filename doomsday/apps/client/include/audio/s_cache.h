@@ -22,6 +22,8 @@
 #define AUDIO_SFXSAMPLECACHE_H
 
 #include "api_audiod_sfx.h"  // sfxsample_t
+#include <doomsday/audio/samplecache.h>
+#include <de/list.h>
 #include <de/observers.h>
 
 namespace audio {
@@ -34,6 +36,10 @@ namespace audio {
  *  2) Call @ref cache() to get a sfxsample_t.
  *  3) Pass the sfxsample_t to Sfx_StartSound().
  *
+ * The samples are kept in a SampleCache with a byte budget; the least recently
+ * played samples are uncached first. Samples that are likely to be needed can be
+ * prepared beforehand with @ref prepare().
+ *
  * @todo Use de::WaveformBank instead. -ds
  */
 class SfxSampleCache
@@ -42,28 +48,6 @@ public:
     /// Notified when a sound sample is about to be removed from the cache.
     DE_AUDIENCE(SampleRemove, void sfxSampleCacheAboutToRemove(const sfxsample_t &sample))
 
-    struct CacheItem
-    {
-        CacheItem *next, *prev;
-
-        int hits;            ///< Number of cache hits.
-        int lastUsed;        ///< Tic the sample was last hit.
-        sfxsample_t sample;  ///< The cached sample data.
-
-        CacheItem();
-        ~CacheItem();
-
-        /**
-         * Register a cache hit and remember the current tic.
-         */
-        void hit();
-
-        /**
-         * Replace the cached sample data with a copy of @a newSample.
-         */
-        void replaceSample(sfxsample_t &newSample);
-    };
-
 public:
     /**
      * Construct a new (empty) sound sample cache.
@@ -77,7 +61,8 @@ public:
 
     /**
      * Call this periodically to perform a cache purge. If the cache is too large,
-     * stopped samples with the lowest hitcount will be uncached.
+     * the least recently used stopped samples will be uncached. Samples prepared
+     * in the background are added to the cache.
      */
     void maybeRunPurge();
 
@@ -91,15 +76,22 @@ public:
     sfxsample_t *cache(int soundId);
 
     /**
-     * Register a cache hit on the sound sample associated with @a id.
-     *
-     * Hits keep count of how many times the cached sound has been played. The purger
-     * will remove samples with the lowest hitcount first.
+     * Register a cache hit on the sound sample associated with @a id. The sample
+     * becomes the most recently used one.
      *
      * @param soundId  Sound sample identifier.
      */
     void hit(int soundId);
 
+    /**
+     * Loads the sound samples that are not cached yet and converts them to the
+     * playback format in background tasks. They are added to the cache when ready,
+     * or when they are needed.
+     *
+     * @param soundIds  Sound sample identifiers.
+     */
+    void prepare(const de::List<int> &soundIds);
+
     /**
      * Returns cache usage info (for debug).
      *
@@ -108,6 +100,13 @@ public:
      */
     void info(uint *cacheBytes, uint *sampleCount);
 
+    SampleCache::Statistics statistics() const;
+
+    /**
+     * Returns the number of samples prepared in the background.
+     */
+    int preparedCount() const;
+
 private:
     DE_PRIVATE(d)
 };
@@ -0,0 +1,43 @@
+/** @file sys_audiod_softmixer.h  Software mixer for sound effects (no output device).
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef CLIENT_AUDIO_SYS_AUDIOD_SOFTMIXER_H
+#define CLIENT_AUDIO_SYS_AUDIOD_SOFTMIXER_H
+
+/**
+ * Sound effects are mixed in software into a 16-bit stereo stream, with volume,
+ * panning, pitch (resampling) and 3D distance attenuation applied per channel.
+ * There is no output device: the mix is discarded, or written to a WAV file.
+ *
+ * By default a worker thread mixes the channels in real time. With the option
+ * "-mixwav <file>" the mixer runs offline instead: the channels are mixed in the
+ * main thread up to the latest game tic and the result is written to the file, so
+ * playing the same demo always produces the same output.
+ *
+ * Streaming buffers (SFXBF_STREAM) are not supported; they remain silent. Music and
+ * CD playback use the dummy interfaces.
+ */
+
+#include <de/liblegacy.h>
+#include "api_audiod.h"
+#include "api_audiod_sfx.h"
+
+DE_EXTERN_C audiodriver_t        audiod_softmixer;
+DE_EXTERN_C audiointerface_sfx_t audiod_softmixer_sfx;
+
+#endif // CLIENT_AUDIO_SYS_AUDIOD_SOFTMIXER_H
@@ -64,6 +64,10 @@ struct AngleRange
  * Oranges (occlusion ranges) clip a half-space on an angle range. These are produced
  * by horizontal edges that have empty space behind.
  *
+ * Both kinds of ranges are kept in arrays sorted by the start angle. Clip checks are
+ * binary searches, and occlusion checks stop at the first range beyond the angle.
+ * The arrays are reused from frame to frame.
+ *
  * @ingroup render
  */
 class AngleClipper
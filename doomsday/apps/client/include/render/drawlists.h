@@ -24,16 +24,71 @@
 #include "render/drawlist.h"
 #include <de/vector.h>
 
+/**
+ * Registry of draw lists.
+ *
+ * Each distinct list specification is interned to a dense integer handle (an Id)
+ * that geometry producers can keep and use to write to the list directly. The
+ * lists are kept in a flat array indexed by the handle; at the start of a frame
+ * they are rewound but not deallocated.
+ *
+ * The handle of a list that does not interpolate between two textures remains
+ * valid until clear() is called. Interpolated (blended) lists depend on the
+ * current animation state, so their handles are only valid until the next
+ * reset(); the lists themselves are recycled.
+ *
+ * Producers keep the handles they use in CachedIds (e.g., per material), so that
+ * a specification is interned only once per frame.
+ */
 class DrawLists
 {
 public:
     typedef de::List<DrawList *> FoundLists;
+    typedef de::duint32 Id;
+
+    /// Handle of the list for sky mask geometry (which is never textured).
+    static const Id SkyMaskList = 0;
+
+    /**
+     * Handle kept by a geometry producer. It is valid until the next reset() or
+     * clear(), after which the specification is interned again.
+     */
+    struct CachedId
+    {
+        Id          id         = 0;
+        de::duint32 generation = 0;  ///< Zero if not interned yet.
+    };
 
 public:
     DrawLists();
 
     /**
-     * Locate an appropriate draw list for the given specification.
+     * Returns the handle of the draw list for the given specification, creating
+     * a new list if needed.
+     *
+     * @param spec  Draw list specification.
+     */
+    Id intern(const DrawListSpec &spec);
+
+    /**
+     * Returns the handle of the draw list for the given specification. If @a cached
+     * is still valid, it is returned as is; otherwise @a spec is interned and the
+     * handle is kept in @a cached. The caller must use @a cached only for equivalent
+     * specifications.
+     *
+     * @param spec    Draw list specification.
+     * @param cached  Handle kept by the caller.
+     */
+    Id intern(const DrawListSpec &spec, CachedId &cached);
+
+    /**
+     * Returns the draw list with the handle @a id.
+     */
+    DrawList &list(Id id);
+
+    /**
+     * Locate an appropriate draw list for the given specification. Same as
+     * calling list(intern(spec)).
      *
      * @param spec  Draw list specification.
      *
@@ -43,7 +98,8 @@ public:
 
     /**
      * Finds all draw lists which match the given specification. Note that only
-     * non-empty lists are collected.
+     * non-empty lists are collected. The lists are found in the order they were
+     * created.
      *
      * @param group  Logical geometry group identifier.
      * @param found  Set of draw lists which match the result.
@@ -53,12 +109,13 @@ public:
     int findAll(GeomGroup group, FoundLists &found);
 
     /**
-     * To be called before rendering of a new frame begins.
+     * To be called before rendering of a new frame begins. Handles of blended
+     * lists become invalid, as do all CachedIds.
      */
     void reset();
 
     /**
-     * All lists will be destroyed.
+     * All lists will be destroyed. All handles (except SkyMaskList) become invalid.
      */
     void clear();
 
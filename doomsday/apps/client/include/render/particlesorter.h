@@ -0,0 +1,94 @@
+/** @file particlesorter.h  Back-to-front ordering of particles.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef CLIENT_RENDER_PARTICLESORTER_H
+#define CLIENT_RENDER_PARTICLESORTER_H
+
+#include <de/list.h>
+
+/**
+ * Orders particles back to front, i.e., by descending distance from the viewer.
+ *
+ * The distances are quantized to integer keys that are sorted with a (stable) LSD
+ * radix sort. The particles visible in consecutive frames are usually the same and
+ * in nearly the same order, so when the same particles are sorted again, the order
+ * of the previous frame is fixed up with an insertion sort instead. All buffers are
+ * reused from frame to frame.
+ *
+ * The sorter has no dependencies on the renderer, so it can be used with synthetic
+ * data as well.
+ *
+ * @ingroup render
+ */
+class ParticleSorter
+{
+public:
+    /// Distances are quantized to this fraction of a map unit.
+    static const int QUANTIZATION = 16;
+
+    enum Method { RadixSort, IncrementalSort };
+
+public:
+    ParticleSorter();
+
+    /**
+     * Removes all particles, beginning a new frame.
+     */
+    void clear();
+
+    /**
+     * Adds a particle to be sorted.
+     *
+     * @param id        Identifies the particle from one frame to the next.
+     * @param distance  Distance of the particle from the viewer.
+     */
+    void add(de::duint64 id, float distance);
+
+    /**
+     * Returns the number of particles added since the previous clear().
+     */
+    int count() const;
+
+    /**
+     * Sorts the particles added since the previous clear().
+     *
+     * @return  Indices of the particles (in the order they were added) from the
+     * farthest to the nearest. Valid until the next call to clear().
+     */
+    const de::List<de::duint32> &sort();
+
+    /**
+     * Returns the method used in the most recent sort().
+     */
+    Method lastMethod() const;
+
+private:
+    bool sortIncrementally();
+    void radixSort();
+
+    de::List<de::duint64> _ids;
+    de::List<de::duint32> _keys;        ///< Quantized inverted distance of each particle.
+    de::List<de::duint32> _order;
+    de::List<de::duint32> _scratch;
+    de::List<de::duint64> _previousIds; ///< Particles of the previous sort.
+    de::List<de::duint32> _previousOrder;
+    Method                _lastMethod;
+};
+
+#endif // CLIENT_RENDER_PARTICLESORTER_H
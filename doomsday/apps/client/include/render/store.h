@@ -41,6 +41,11 @@ struct Store
 
     de::duint allocateVertices(de::duint count);
 
+    /**
+     * Returns the number of vertices allocated since the last rewind().
+     */
+    de::duint vertCount() const;
+
 private:
     de::duint _vertCount = 0;
     de::duint _vertMax   = 0;
@@ -30,6 +30,7 @@
 #include <de/vector.h>
 #include "resource/clienttexture.h"
 #include "resource/clientmaterial.h"
+#include "render/drawlists.h"
 #include "render/materialcontext.h"
 #include "resource/materialvariantspec.h"
 #include "gl/gltextureunit.h"
@@ -70,6 +71,18 @@ public:
         NUM_TEXTUREUNITS
     };
 
+    /**
+     * Ways the renderer uses the texture units, each with its own draw list:
+     */
+    enum
+    {
+        UnlitDrawList,
+        LitDrawList,
+        ShineDrawList,
+        SkyStripDrawList,
+        NUM_DRAWLIST_USAGES
+    };
+
     /**
      * Animated Material::Decoration.
      */
@@ -199,6 +212,15 @@ public:
      */
     de::GLTextureUnit &texUnit(int unitIndex) const;
 
+    /**
+     * Returns the draw list handle kept for geometry that uses the current texture
+     * units in the given way. The handles are forgotten when the units change, so the
+     * renderer needs to look up the draw list only once per frame for each material.
+     *
+     * @param usage  Draw list usage (e.g., @ref LitDrawList).
+     */
+    DrawLists::CachedId &drawList(int usage) const;
+
     /**
      * Lookup an animated Material Decoration by it's unique @a decorIndex.
      */
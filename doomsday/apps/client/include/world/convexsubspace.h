@@ -25,6 +25,7 @@
 #include <doomsday/world/convexsubspace.h>
 
 class Lumobj;
+class Subsector;
 namespace world { class AudioEnvironment; }
 
 /**
@@ -81,6 +82,26 @@ public:
      */
     const world::AudioEnvironment &audioEnvironment() const;
 
+    /**
+     * Recalculates the audio environment characteristics if they have been marked
+     * changed since the previous update (@ref markAudioEnvironmentDirty()).
+     *
+     * @return  @c true if the subspace has valid characteristics.
+     */
+    bool prepareAudioEnvironment();
+
+    /**
+     * Marks the audio environment characteristics of the subspace changed (e.g., when a
+     * plane has moved). The reverb of all the listening subsectors is marked for update.
+     */
+    void markAudioEnvironmentDirty();
+
+    /**
+     * Adds a subsector whose reverb depends on the audio environment of the subspace.
+     * If the subsector is already listening then nothing will happen.
+     */
+    void addReverbListener(Subsector &subsector);
+
     //- Fake radio ---------------------------------------------------------------------------
 
     /**
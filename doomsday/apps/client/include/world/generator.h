@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <de/list.h>
 #include <de/vector.h>
 #include <doomsday/defs/dedtypes.h>
 #include "map.h"
@@ -35,8 +36,8 @@ struct ParticleInfo
 {
     int             stage;      // -1 => particle doesn't exist
     int16_t         tics;
-    fixed_t         origin[3];  // Coordinates.
-    fixed_t         mov[3];     // Momentum.
+    float           origin[3];  // Coordinates (Z is +/-FLT_MAX when stuck to a plane).
+    float           mov[3];     // Momentum.
     world::BspLeaf *bspLeaf;    // Updated when needed.
     Line *          contact;    // Updated when lines hit/avoided.
     uint16_t        yaw, pitch; // Rotation angles (0-65536 => 0-360).
@@ -102,6 +103,40 @@ struct Generator
     /// Unique identifier associated with each generator (1-based).
     typedef int16_t Id;
 
+    /**
+     * Particle state stored as a structure of arrays: each property has its own
+     * contiguous array (lane) so that the simulation can process one property of
+     * many particles at a time. All lanes are allocated from the zone as one block.
+     *
+     * The gravity, force and resistance lanes are copied from the current stage of
+     * the particle. Inactive particles have no forces acting on them.
+     */
+    struct ParticleLanes
+    {
+        int32_t *        stage;       ///< -1 => particle doesn't exist
+        int16_t *        tics;
+        float *          origin[3];   ///< Z is +/-FLT_MAX when stuck to a plane.
+        float *          mov[3];      ///< Momentum.
+        float *          force[3];    ///< Vector force of the stage.
+        float *          gravity;     ///< Gravity factor of the stage.
+        float *          resistance;  ///< Momentum multiplier of the stage.
+        world::BspLeaf **bspLeaf;     ///< Updated when needed.
+        Line **          contact;     ///< Updated when lines hit/avoided.
+        uint16_t *       yaw;         ///< Rotation angles (0-65536 => 0-360).
+        uint16_t *       pitch;
+    };
+
+    /**
+     * Sound to be played at a particle's origin. Sounds can only be started in the
+     * main thread, so they are collected while particles are moved concurrently.
+     */
+    struct ParticleSound
+    {
+        const ded_embsound_t *sound;
+        de::Vec3d             origin;
+    };
+    typedef de::List<ParticleSound> ParticleSounds;
+
 public:                                   //! @todo make private:
     thinker_t           thinker;          //  Func = P_PtcGenThinker
     Plane *             plane;            //  Flat-triggered.
@@ -143,8 +178,23 @@ public:
 
     /**
      * Generate and/or move the particles.
+     *
+     * @param moveNow  If @c false, only new particles are generated and moving the
+     *                 particles is left to movePendingParticles(), which moves the
+     *                 particles of all the generators of the map at once.
      */
-    void runTick();
+    void runTick(bool moveNow = true);
+
+    /**
+     * Advance the stages of the particles and move them by one tic. Nothing outside
+     * the generator is modified, so the particles of several generators can be moved
+     * concurrently (as long as the map itself is not modified meanwhile).
+     *
+     * @param sounds  Sounds started by the particles are appended here to be played
+     *                afterwards in the main thread. If @c nullptr, the sounds are
+     *                played immediately and this must be called in the main thread.
+     */
+    void moveParticles(ParticleSounds *sounds = nullptr);
 
     /**
      * Run the generator's thinker for the given number of @a tics.
@@ -193,9 +243,14 @@ public:
     int activeParticleCount() const;
 
     /**
-     * Provides readonly access to the generator particle info data.
+     * Returns the current state of the particle at @a index.
      */
-    const ParticleInfo *particleInfo() const;
+    ParticleInfo particleInfo(int index) const;
+
+    /**
+     * Provides readonly access to the generator particle data.
+     */
+    const ParticleLanes &particles() const;
 
 public: /// @todo make private:
     /**
@@ -216,29 +271,43 @@ public: /// @todo make private:
      * XY movement checks for hits with solid walls (no backsector).
      * This is supposed to be fast and simple (but not too simple).
      */
-    void moveParticle(int index);
+    void moveParticle(int index, ParticleSounds *sounds);
 
-    void spinParticle(ParticleInfo &pt);
+    void spinParticle(int index);
 
-    float particleZ(const ParticleInfo &pt) const;
+    float particleZ(int index) const;
 
-    de::Vec3f particleOrigin(const ParticleInfo &pt) const;
-    de::Vec3f particleMomentum(const ParticleInfo &pt) const;
+    de::Vec3f particleOrigin(int index) const;
+    de::Vec3f particleMomentum(int index) const;
 
 public:
+    /**
+     * Moves the particles of all the generators of @a map that have been ticked
+     * with runTick(false) since the previous call. The generators are processed
+     * concurrently when there are enough particles to make it worthwhile.
+     */
+    static void movePendingParticles(Map &map);
+
     /**
      * Register the console commands, variables, etc..., of this module.
      */
     static void consoleRegister();
 
 private:
+    void setParticleStage(int index, int stage);
+    void killParticle(int index);
+    void applySphereForce(int index);
+    float randomFloat();
+
     Id            _id; // Unique in the map.
     de::Flags     _flags;
     int           _age; // Time since spawn, in tics.
     float         _spawnCount;
     bool          _untriggered; // @c true= consider this as not yet triggered.
     int           _spawnCP;     // Particle spawn cursor.
-    ParticleInfo *_pinfo;       // Info about each generated particle.
+    int           _pendingMoves; // Tics the particles have not yet been moved.
+    uint32_t      _randomState;  // Used while moving particles (see randomFloat()).
+    ParticleLanes _particles;    // Info about each generated particle.
 };
 
 typedef Generator::ParticleStage GeneratorParticleStage;
@@ -273,6 +273,12 @@ public:  //- Particle generators -----------------------------------------------
      */
     void initRadio();
 
+    /**
+     * Determine the subspaces that contribute to the environmental audio characteristics
+     * of each subsector. The results are cached for the map geometry.
+     */
+    void initReverb();
+
     /**
      * Spawn all generators for the map which should be initialized automatically during
      * map setup.
@@ -0,0 +1,61 @@
+/** @file particlekernels.h  Momentum updates of particles stored in lanes.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef CLIENT_WORLD_PARTICLEKERNELS_H
+#define CLIENT_WORLD_PARTICLEKERNELS_H
+
+/**
+ * Per-tic momentum updates of particles stored as separate arrays (lanes) of floats,
+ * as in Generator::ParticleLanes. Unused particles have no forces and no resistance,
+ * so the loops need no branching and can be vectorized.
+ *
+ * The kernels have no dependencies on the world, so they can be used with synthetic
+ * data as well.
+ *
+ * @ingroup world
+ */
+namespace particlekernels {
+
+/**
+ * Adds the vector force and gravity of the current stage to the momentum.
+ *
+ * @param count       Number of particles.
+ * @param mov         Momentum lanes (X, Y, Z).
+ * @param force       Vector force lanes (X, Y, Z).
+ * @param gravity     Gravity factor lane.
+ * @param mapGravity  Gravity of the map.
+ */
+void applyForces(int count, float *const mov[3], const float *const force[3],
+                 const float *gravity, float mapGravity);
+
+/**
+ * Multiplies the momentum with the resistance of the current stage. Momentum
+ * smaller than @a minMomentum becomes zero.
+ *
+ * @param count        Number of particles.
+ * @param mov          Momentum lanes (X, Y, Z).
+ * @param resistance   Resistance lane.
+ * @param minMomentum  Smallest nonzero momentum.
+ */
+void applyResistance(int count, float *const mov[3], const float *resistance,
+                     float minMomentum);
+
+} // namespace particlekernels
+
+#endif // CLIENT_WORLD_PARTICLEKERNELS_H
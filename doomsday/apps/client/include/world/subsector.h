@@ -120,6 +120,26 @@ public:
      */
     void markReverbDirty(bool yes = true);
 
+    /**
+     * Marks the audio environment characteristics of all the subspaces of the subsector
+     * changed, e.g., when a plane moves or a wall material changes. Only the subsectors
+     * whose reverb depends on these subspaces will be updated.
+     */
+    void markAudioEnvironmentDirty();
+
+    /**
+     * Returns the subspaces in the neighborhood that contribute to the environmental
+     * audio characteristics of the subsector. These are determined when first needed
+     * unless set with setReverbSubspaces().
+     */
+    const de::List<ConvexSubspace *> &reverbSubspaces() const;
+
+    /**
+     * Sets the subspaces that contribute to the environmental audio characteristics of
+     * the subsector, e.g., from a previously cached result.
+     */
+    void setReverbSubspaces(const de::List<ConvexSubspace *> &subspaces);
+
 //- Decorations -------------------------------------------------------------------------
 
     /**
@@ -64,6 +64,7 @@
 #include <de/legacy/memory.h>
 
 #include <de/hash.h>
+#include <de/set.h>
 
 using namespace de;
 using namespace res;
@@ -117,7 +118,8 @@ static const char *driverIdentifier[AUDIODRIVER_COUNT] = {
     "fmod",
     "fluidsynth",
     "dsound",
-    "winmm"
+    "winmm",
+    "softmixer"
 };
 
 static audiodriverid_t identifierToDriverId(String name)
@@ -220,6 +222,9 @@ DE_PIMPL(AudioSystem)
         if (cmdLine.has("-dummy"))
             return AUDIOD_DUMMY;
 
+        if (cmdLine.has("-softmixer") || cmdLine.has("-mixwav"))
+            return AUDIOD_SOFTMIXER;
+
         if (cmdLine.has("-fmod"))
             return AUDIOD_FMOD;
 
@@ -266,6 +271,7 @@ DE_PIMPL(AudioSystem)
             switch (driverId)
             {
             case AUDIOD_DUMMY:
+            case AUDIOD_SOFTMIXER:
             case AUDIOD_OPENAL:
             case AUDIOD_FMOD:
             case AUDIOD_FLUIDSYNTH:
@@ -642,6 +648,7 @@ DE_PIMPL(AudioSystem)
     mobj_t *sfxListener = nullptr;
     world::Subsector *sfxListenerSubsector = nullptr;
     std::unique_ptr<audio::SfxChannels> sfxChannels;
+    Set<dint> playerSoundIds;           ///< Played by player mobjs (weapons, pain, etc.).
 #endif
 
     audio::SfxSampleCache sfxSampleCache;      ///< @todo should be __CLIENT__ only.
@@ -1466,6 +1473,9 @@ DE_PIMPL(AudioSystem)
     void aboutToUnloadGame(const Game &)
     {
         reset();
+#ifdef __CLIENT__
+        playerSoundIds.clear();  // Sound IDs depend on the game's definitions.
+#endif
     }
 };
 
@@ -2190,6 +2200,13 @@ dint AudioSystem::playSound(sfxsample_t *sample, dfloat volume, dfloat freq, con
     // Hit count tells how many times the cached sound has been used.
     d->sfxSampleCache.hit(sample->id);
 
+    // Remember what the players sound like, so the samples can be prepared for the
+    // next map, too.
+    if (emitter && emitter->dPlayer)
+    {
+        d->playerSoundIds.insert(sample->id);
+    }
+
     /*
      * Pick a channel for the sound. We will do our best to play the sound,
      * cancelling existing ones if need be. The ideal choice is a free channel
@@ -2500,6 +2517,27 @@ void AudioSystem::worldMapChanged()
 {
     // Update who is listening now.
     setSfxListener(S_GetListenerMobj());
+
+    // Prepare the samples of the sounds the map's objects are likely to make.
+    if (!world::World::get().hasMap()) return;
+
+    // Weapon and player class sounds are played by the game, so they are only known
+    // once the players have made them. They are needed again on every map.
+    Set<dint> soundIds = d->playerSoundIds;
+    world::World::get().map().thinkers().forAll(reinterpret_cast<thinkfunc_t>(gx.MobjThinker), 0x1,
+                                                [&soundIds] (thinker_t *th)
+    {
+        if (const mobjinfo_t *info = reinterpret_cast<mobj_t *>(th)->info)
+        {
+            for (dint id : {info->seeSound, info->attackSound, info->painSound,
+                            info->deathSound, info->activeSound})
+            {
+                if (id > 0) soundIds.insert(id);
+            }
+        }
+        return LoopContinue;
+    });
+    d->sfxSampleCache.prepare(compose<List<dint>>(soundIds.begin(), soundIds.end()));
 }
 #endif
 
@@ -2672,6 +2710,24 @@ D_CMD(ReverbParameters)
 
     return true;
 }
+
+D_CMD(SfxCacheStats)
+{
+    DE_UNUSED(src, argc, argv);
+
+    const auto &cache = App_AudioSystem().sfxSampleCache();
+    const auto stats  = cache.statistics();
+    LOG_SCR_MSG("Sound sample cache:\n"
+                "- samples: %i (%i prepared in the background)\n"
+                "- size: %.1f KB (peak %.1f KB, budget %.1f KB)\n"
+                "- lookups: %u hits, %u misses\n"
+                "- evictions: %u")
+            << stats.count << cache.preparedCount()
+            << stats.bytes / 1024.0 << stats.peakBytes / 1024.0 << stats.budget / 1024.0
+            << stats.hits << stats.misses
+            << stats.evictions;
+    return true;
+}
 #endif
 
 void AudioSystem::consoleRegister()  // static
@@ -2699,6 +2755,7 @@ void AudioSystem::consoleRegister()  // static
     C_CMD_FLAGS("stopmusic",  "",      StopMusic,  CMDF_NO_DEDICATED);
 
     C_CMD("reverbparams", "ffff", ReverbParameters);
+    C_CMD("sfxcachestats", "",    SfxCacheStats);
 
     // Debug:
     C_VAR_INT     ("sound-info",          &showSoundInfo,         0, 0, 1);
@@ -0,0 +1,898 @@
+/** @file sys_audiod_softmixer.cpp  Software mixer for sound effects (no output device).
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de_base.h"
+#include "audio/sys_audiod_softmixer.h"
+#include "audio/audiodriver.h"
+#include "dd_loop.h"    // ::gameTime
+
+#include <de/block.h>
+#include <de/commandline.h>
+#include <de/list.h>
+#include <de/log.h>
+#include <de/math.h>
+#include <de/nativefile.h>
+#include <de/time.h>
+#include <de/writer.h>
+#include <de/legacy/concurrency.h>
+#include <de/legacy/timer.h>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define DE_SOFTMIXER_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  define DE_SOFTMIXER_NEON
+#  include <arm_neon.h>
+#endif
+
+using namespace de;
+
+int  DS_SoftMixerInit(void);
+void DS_SoftMixerShutdown(void);
+void DS_SoftMixerEvent(int type);
+
+int          DS_SoftMixer_SFX_Init(void);
+sfxbuffer_t *DS_SoftMixer_SFX_CreateBuffer(int flags, int bits, int rate);
+void         DS_SoftMixer_SFX_DestroyBuffer(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Load(sfxbuffer_t *buf, struct sfxsample_s *sample);
+void         DS_SoftMixer_SFX_Reset(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Play(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Stop(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Refresh(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Set(sfxbuffer_t *buf, int prop, float value);
+void         DS_SoftMixer_SFX_Setv(sfxbuffer_t *buf, int prop, float *values);
+void         DS_SoftMixer_SFX_Listener(int prop, float value);
+void         DS_SoftMixer_SFX_Listenerv(int prop, float *values);
+int          DS_SoftMixer_SFX_Getv(int prop, void *values);
+
+audiodriver_t audiod_softmixer = {
+    DS_SoftMixerInit,
+    DS_SoftMixerShutdown,
+    DS_SoftMixerEvent,
+    0
+};
+
+audiointerface_sfx_t audiod_softmixer_sfx = {
+    {
+        DS_SoftMixer_SFX_Init,
+        DS_SoftMixer_SFX_CreateBuffer,
+        DS_SoftMixer_SFX_DestroyBuffer,
+        DS_SoftMixer_SFX_Load,
+        DS_SoftMixer_SFX_Reset,
+        DS_SoftMixer_SFX_Play,
+        DS_SoftMixer_SFX_Stop,
+        DS_SoftMixer_SFX_Refresh,
+        DS_SoftMixer_SFX_Set,
+        DS_SoftMixer_SFX_Setv,
+        DS_SoftMixer_SFX_Listener,
+        DS_SoftMixer_SFX_Listenerv,
+        DS_SoftMixer_SFX_Getv
+    }
+};
+
+/// Number of output frames mixed at a time.
+static const int MIX_BLOCK = 256;
+
+/// How long the mixer thread sleeps between rounds of mixing (milliseconds).
+static const int MIX_THREAD_SLEEP = 5;
+
+static const dsize WAV_HEADER_SIZE = 44;
+
+/**
+ * Mixer state of a buffer (sfxbuffer_t::ptr).
+ */
+struct Voice
+{
+    ddouble position;   ///< Read position in the sample (sample frames).
+    duint64 startFrame; ///< Output frame where the sound begins.
+    float   volume;
+    float   pan;        ///< -1..1 (2D only)
+    float   pitch;      ///< Frequency factor.
+    float   minDistance;
+    float   maxDistance;
+    float   origin[3];
+    bool    relative;   ///< Origin is relative to the listener.
+    bool    started;    ///< Gains have been applied at least once.
+    bool    ended;      ///< Played to the end; the buffer is stopped on the main thread.
+    float   gains[2];   ///< Left and right gains of the previous block.
+
+    Voice()
+        : position(0), startFrame(0), volume(1), pan(0), pitch(1)
+        , minDistance(1), maxDistance(2), relative(false), started(false), ended(false)
+    {
+        origin[0] = origin[1] = origin[2] = 0;
+        gains[0] = gains[1] = 0;
+    }
+};
+
+static dd_bool inited;
+static mutex_t mixMutex;
+static thread_t mixThread;
+static volatile bool stopMixThread;
+static List<sfxbuffer_t *> buffers; ///< All existing buffers.
+
+static int outputRate = 44100;
+static duint64 mixedFrames;         ///< Total number of frames mixed so far.
+static ddouble mixingTime;          ///< Time spent mixing (seconds).
+static int peakVoices;
+
+static float listenerOrigin[3];
+static float listenerYaw;           ///< Radians.
+
+static float mixBuffer[MIX_BLOCK * 2];
+static float voiceBuffer[MIX_BLOCK];
+static dint16 outputBuffer[MIX_BLOCK * 2];
+
+// Offline mode.
+static bool offline;
+static std::unique_ptr<NativeFile> wavFile;
+static dsize wavDataSize;
+static int lastGameTic;
+static duint64 ticClock;            ///< Game tics played since initialization.
+
+static inline Voice &voiceOf(sfxbuffer_t *buf)
+{
+    return *reinterpret_cast<Voice *>(buf->ptr);
+}
+
+static inline float sampleValue(duint8 value)
+{
+    return (int(value) - 128) / 128.f;
+}
+
+static inline float sampleValue(dint16 value)
+{
+    return value / 32768.f;
+}
+
+/**
+ * Reads a sample at a different rate, interpolating linearly between the sample
+ * frames.
+ *
+ * @return Number of frames written to @a out. Less than @a count if the end of
+ * a non-repeating sample was reached.
+ */
+template <typename Type>
+static int resample(const Type *data, int numSamples, bool repeat,
+                    ddouble &position, ddouble step, float *out, int count)
+{
+    int i = 0;
+    for (; i < count; ++i)
+    {
+        if (position >= numSamples)
+        {
+            if (!repeat) break;
+            position = std::fmod(position, ddouble(numSamples));
+        }
+        const int   index = int(position);
+        const int   next  = (index + 1 < numSamples? index + 1 : repeat? 0 : index);
+        const float a     = sampleValue(data[index]);
+        const float b     = sampleValue(data[next]);
+        out[i] = a + (b - a) * float(position - index);
+        position += step;
+    }
+    return i;
+}
+
+/**
+ * Adds a mono voice to the stereo mix. The gains are ramped linearly over the
+ * frames to avoid clicks when they change.
+ */
+static void accumulate(float *mix, const float *voice, int count,
+                       const float fromGains[2], const float toGains[2])
+{
+    if (count <= 0) return;
+
+    const float deltaLeft  = (toGains[0] - fromGains[0]) / count;
+    const float deltaRight = (toGains[1] - fromGains[1]) / count;
+    int i = 0;
+
+#if defined(DE_SOFTMIXER_SSE2)
+    // Four frames (eight floats) at a time.
+    __m128 gains01 = _mm_setr_ps(fromGains[0], fromGains[1],
+                                 fromGains[0] + deltaLeft, fromGains[1] + deltaRight);
+    __m128 gains23 = _mm_add_ps(gains01, _mm_setr_ps(2 * deltaLeft, 2 * deltaRight,
+                                                     2 * deltaLeft, 2 * deltaRight));
+    const __m128 step = _mm_setr_ps(4 * deltaLeft, 4 * deltaRight, 4 * deltaLeft, 4 * deltaRight);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 v   = _mm_loadu_ps(voice + i);
+        const __m128 v01 = _mm_unpacklo_ps(v, v);
+        const __m128 v23 = _mm_unpackhi_ps(v, v);
+        float *m = mix + 2 * i;
+        _mm_storeu_ps(m,     _mm_add_ps(_mm_loadu_ps(m),     _mm_mul_ps(v01, gains01)));
+        _mm_storeu_ps(m + 4, _mm_add_ps(_mm_loadu_ps(m + 4), _mm_mul_ps(v23, gains23)));
+        gains01 = _mm_add_ps(gains01, step);
+        gains23 = _mm_add_ps(gains23, step);
+    }
+#elif defined(DE_SOFTMIXER_NEON)
+    const float init01[4] = { fromGains[0], fromGains[1],
+                              fromGains[0] + deltaLeft, fromGains[1] + deltaRight };
+    const float steps[4]  = { 4 * deltaLeft, 4 * deltaRight, 4 * deltaLeft, 4 * deltaRight };
+    const float half[4]   = { 2 * deltaLeft, 2 * deltaRight, 2 * deltaLeft, 2 * deltaRight };
+    float32x4_t gains01 = vld1q_f32(init01);
+    float32x4_t gains23 = vaddq_f32(gains01, vld1q_f32(half));
+    const float32x4_t step = vld1q_f32(steps);
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t   v = vld1q_f32(voice + i);
+        const float32x4x2_t z = vzipq_f32(v, v);
+        float *m = mix + 2 * i;
+        vst1q_f32(m,     vmlaq_f32(vld1q_f32(m),     z.val[0], gains01));
+        vst1q_f32(m + 4, vmlaq_f32(vld1q_f32(m + 4), z.val[1], gains23));
+        gains01 = vaddq_f32(gains01, step);
+        gains23 = vaddq_f32(gains23, step);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        mix[2 * i]     += voice[i] * (fromGains[0] + deltaLeft  * i);
+        mix[2 * i + 1] += voice[i] * (fromGains[1] + deltaRight * i);
+    }
+}
+
+#if defined(DE_SOFTMIXER_NEON)
+/**
+ * Converts to integers, rounding to the nearest like lrint() does. (vcvtq_s32_f32
+ * truncates.)
+ */
+static inline int32x4_t roundToInt(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32(v);
+#else
+    // Add 0.5 with the sign of the value, then truncate. Halfway cases are rounded
+    // away from zero.
+    const float32x4_t half = vbslq_f32(vdupq_n_u32(0x80000000u), v, vdupq_n_f32(.5f));
+    return vcvtq_s32_f32(vaddq_f32(v, half));
+#endif
+}
+#endif
+
+/**
+ * Converts the mix to 16-bit samples, saturating at the limits.
+ */
+static void convertMix(const float *mix, dint16 *out, int count)
+{
+    int i = 0;
+
+#if defined(DE_SOFTMIXER_SSE2)
+    const __m128 scale = _mm_set1_ps(32767.f);
+    const __m128 lower = _mm_set1_ps(-1.f);
+    const __m128 upper = _mm_set1_ps(1.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i),     lower), upper);
+        const __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i + 4), lower), upper);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(a, scale)),
+                                         _mm_cvtps_epi32(_mm_mul_ps(b, scale))));
+    }
+#elif defined(DE_SOFTMIXER_NEON)
+    const float32x4_t scale = vdupq_n_f32(32767.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        // The conversion saturates.
+        const int32x4_t a = roundToInt(vmulq_f32(vld1q_f32(mix + i),     scale));
+        const int32x4_t b = roundToInt(vmulq_f32(vld1q_f32(mix + i + 4), scale));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        out[i] = dint16(std::lrint(de::clamp(-1.f, mix[i], 1.f) * 32767.f));
+    }
+}
+
+/**
+ * Determines the left and right gains of a voice. 3D voices are attenuated by
+ * their distance from the listener and panned by their direction.
+ */
+static void voiceGains(const sfxbuffer_t &buf, const Voice &voice, float gains[2])
+{
+    float volume = voice.volume;
+    float pan    = voice.pan;
+
+    if (buf.flags & SFXBF_3D)
+    {
+        float delta[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            delta[i] = voice.origin[i] - (voice.relative? 0.f : listenerOrigin[i]);
+        }
+        const float dist = std::sqrt(delta[0] * delta[0] + delta[1] * delta[1] +
+                                     delta[2] * delta[2]);
+        if (dist >= voice.maxDistance)
+        {
+            volume = 0;
+        }
+        else if (dist > voice.minDistance)
+        {
+            volume *= 1 - (dist - voice.minDistance) / (voice.maxDistance - voice.minDistance);
+        }
+
+        // Positive angles are to the left.
+        pan = (dist > 0? -std::sin(std::atan2(delta[1], delta[0]) - listenerYaw) : 0.f);
+    }
+
+    // Constant power panning.
+    const float angle = (de::clamp(-1.f, pan, 1.f) + 1) * PIf / 4;
+    volume   = de::clamp(0.f, volume, 1.f);
+    gains[0] = volume * std::cos(angle);
+    gains[1] = volume * std::sin(angle);
+}
+
+/**
+ * Stops a buffer. Only called on the main thread, because the Sfx module reads the
+ * buffer flags without locking the mixer.
+ */
+static void stopBuffer(sfxbuffer_t *buf)
+{
+    // Clear the flag that tells the Sfx module about playing buffers.
+    buf->flags &= ~SFXBF_PLAYING;
+
+    // If the sound is started again, it needs to be reloaded.
+    buf->flags |= SFXBF_RELOAD;
+
+    voiceOf(buf).ended = false;
+}
+
+/**
+ * Stops the buffers whose voices the mixer has played to the end.
+ * The mixer mutex must be locked.
+ */
+static void stopEndedBuffers()
+{
+    for (sfxbuffer_t *buf : buffers)
+    {
+        if (voiceOf(buf).ended) stopBuffer(buf);
+    }
+}
+
+/**
+ * Mixes all playing buffers into the next @a count frames of output.
+ * The mixer mutex must be locked.
+ */
+static void mixBlock(int count)
+{
+    DE_ASSERT(count <= MIX_BLOCK);
+
+    const Time startedAt;
+    int voices = 0;
+
+    std::memset(mixBuffer, 0, sizeof(float) * 2 * count);
+    for (sfxbuffer_t *buf : buffers)
+    {
+        if (!(buf->flags & SFXBF_PLAYING) || !buf->sample || (buf->flags & SFXBF_STREAM))
+            continue;
+
+        Voice &voice = voiceOf(buf);
+        if (voice.ended) continue;
+
+        const sfxsample_t &sample = *buf->sample;
+
+        // The sound may begin later during this block.
+        int offset = 0;
+        if (voice.startFrame > mixedFrames)
+        {
+            if (voice.startFrame >= mixedFrames + count) continue;
+            offset = int(voice.startFrame - mixedFrames);
+        }
+
+        const bool    repeat = (buf->flags & SFXBF_REPEAT) != 0;
+        const ddouble step   = ddouble(sample.rate) * voice.pitch / outputRate;
+        const int     wanted = count - offset;
+        int produced;
+        if (sample.bytesPer == 2)
+        {
+            produced = resample(reinterpret_cast<const dint16 *>(sample.data), sample.numSamples,
+                                repeat, voice.position, step, voiceBuffer, wanted);
+        }
+        else
+        {
+            produced = resample(reinterpret_cast<const duint8 *>(sample.data), sample.numSamples,
+                                repeat, voice.position, step, voiceBuffer, wanted);
+        }
+
+        float gains[2];
+        voiceGains(*buf, voice, gains);
+        if (!voice.started)
+        {
+            voice.gains[0] = gains[0];
+            voice.gains[1] = gains[1];
+            voice.started  = true;
+        }
+        accumulate(mixBuffer + 2 * offset, voiceBuffer, produced, voice.gains, gains);
+        voice.gains[0] = gains[0];
+        voice.gains[1] = gains[1];
+        voices++;
+
+        if (produced < wanted)
+        {
+            // The sample has ended. The flags are left for the main thread to
+            // update (see stopEndedBuffers()).
+            voice.ended = true;
+        }
+    }
+
+    convertMix(mixBuffer, outputBuffer, 2 * count);
+
+    mixedFrames += count;
+    mixingTime  += startedAt.since();
+    peakVoices   = de::max(peakVoices, voices);
+}
+
+static void writeWavData(int count)
+{
+    Block pcm;
+    Writer out(pcm);
+    for (int i = 0; i < 2 * count; ++i)
+    {
+        out << outputBuffer[i];
+    }
+    wavFile->set(WAV_HEADER_SIZE + wavDataSize, pcm.data(), pcm.size());
+    wavDataSize += pcm.size();
+}
+
+static void writeWavHeader()
+{
+    Block header;
+    Writer out(header);
+    out.writeText("RIFF");
+    out << duint32(36 + wavDataSize);
+    out.writeText("WAVEfmt ");
+    out << duint32(16)                  // Size of the format chunk.
+        << duint16(1)                   // PCM.
+        << duint16(2)                   // Channels.
+        << duint32(outputRate)
+        << duint32(outputRate * 4)      // Bytes per second.
+        << duint16(4)                   // Bytes per frame.
+        << duint16(16);                 // Bits per sample.
+    out.writeText("data");
+    out << duint32(wavDataSize);
+    DE_ASSERT(header.size() == WAV_HEADER_SIZE);
+    wavFile->set(0, header.data(), header.size());
+}
+
+/**
+ * Output frame where game tic @a tic begins.
+ */
+static duint64 ticFrame(duint64 tic)
+{
+    return tic * duint64(outputRate) / TICSPERSEC;
+}
+
+/**
+ * Returns the current game tic of the offline mixer. The game time is reset when
+ * a map is loaded, so the mixer keeps its own count of the tics played.
+ */
+static duint64 currentTic()
+{
+    const int tic = SECONDS_TO_TICKS(::gameTime);
+    return ticClock + (tic > lastGameTic? tic - lastGameTic : 0);
+}
+
+/**
+ * Mixes all the game tics completed since the previous call (offline mode).
+ */
+static void mixCompletedTics()
+{
+    ticClock    = currentTic();
+    lastGameTic = SECONDS_TO_TICKS(::gameTime);
+
+    const duint64 target = ticFrame(ticClock);
+    while (mixedFrames < target)
+    {
+        const int count = int(de::min(duint64(MIX_BLOCK), target - mixedFrames));
+        mixBlock(count);
+        writeWavData(count);
+    }
+}
+
+static int C_DECL mixerThread(void *)
+{
+    const Time startedAt;
+    duint64 skipped = 0;
+
+    while (!stopMixThread)
+    {
+        const duint64 due = duint64(startedAt.since() * outputRate) - skipped;
+        if (due > mixedFrames + duint64(outputRate))
+        {
+            // Fallen too far behind (more than a second); don't try to catch up.
+            skipped += due - mixedFrames;
+            continue;
+        }
+        while (mixedFrames + MIX_BLOCK <= due && !stopMixThread)
+        {
+            Sys_Lock(mixMutex);
+            mixBlock(MIX_BLOCK);
+            Sys_Unlock(mixMutex);
+        }
+        Thread_Sleep(MIX_THREAD_SLEEP);
+    }
+    return 0;
+}
+
+/**
+ * Initialization of the sound driver.
+ * @return @c true if successful.
+ */
+int DS_SoftMixerInit(void)
+{
+    if (inited)
+        return true; // Already initialized.
+
+    LOG_AS("SoftMixer");
+
+    mixedFrames = 0;
+    mixingTime  = 0;
+    peakVoices  = 0;
+    wavDataSize = 0;
+    ticClock    = 0;
+    lastGameTic = SECONDS_TO_TICKS(::gameTime);
+
+    offline = false;
+    if (auto arg = CommandLine::get().check("-mixwav", 1))
+    {
+        const NativePath path = NativePath(arg.params.at(0)).expand();
+        try
+        {
+            wavFile.reset(NativeFile::newStandalone(path));
+            wavFile->setMode(File::Write | File::Truncate);
+            writeWavHeader();
+            offline = true;
+            LOG_AUDIO_NOTE("Mixing offline to %s") << path.pretty();
+        }
+        catch (const Error &er)
+        {
+            LOG_AUDIO_ERROR("Failed to open %s for writing: %s") << path.pretty() << er.asText();
+            wavFile.reset();
+            return false;
+        }
+    }
+
+    mixMutex = Sys_CreateMutex("SoftMixer");
+    if (!offline)
+    {
+        stopMixThread = false;
+        mixThread = Sys_StartThread(mixerThread, nullptr, nullptr);
+        if (!mixThread)
+        {
+            Sys_DestroyMutex(mixMutex);
+            mixMutex = nullptr;
+            return false;
+        }
+    }
+
+    inited = true;
+    return true;
+}
+
+/**
+ * Shut everything down.
+ */
+void DS_SoftMixerShutdown(void)
+{
+    if (!inited) return;
+
+    LOG_AS("SoftMixer");
+
+    if (mixThread)
+    {
+        stopMixThread = true;
+        Sys_WaitThread(mixThread, 2000, nullptr);
+        mixThread = nullptr;
+    }
+    if (wavFile)
+    {
+        writeWavHeader();
+        wavFile->flush();
+        wavFile.reset();
+    }
+
+    const ddouble mixedSeconds = ddouble(mixedFrames) / outputRate;
+    LOG_AUDIO_MSG("Mixed %.1f seconds of audio in %.3f seconds (%.1f%% of real time), "
+                  "at most %i voices at once")
+            << mixedSeconds << mixingTime
+            << (mixedSeconds > 0? 100 * mixingTime / mixedSeconds : 0.0)
+            << peakVoices;
+
+    Sys_DestroyMutex(mixMutex);
+    mixMutex = nullptr;
+    inited = false;
+}
+
+/**
+ * The Event function is called to tell the driver about certain critical
+ * events like the beginning and end of an update cycle.
+ *
+ * @param type  Type of event.
+ */
+void DS_SoftMixerEvent(int type)
+{
+    if (!inited) return;
+
+    // Sounds that have ended are stopped before the channels are updated.
+    if (type == SFXEV_BEGIN)
+    {
+        Sys_Lock(mixMutex);
+        stopEndedBuffers();
+        Sys_Unlock(mixMutex);
+    }
+
+    // In offline mode, the completed game tics are mixed after the channels
+    // have been updated.
+    if (offline && type == SFXEV_END)
+    {
+        mixCompletedTics();
+    }
+}
+
+int DS_SoftMixer_SFX_Init(void)
+{
+    return inited;
+}
+
+sfxbuffer_t *DS_SoftMixer_SFX_CreateBuffer(int flags, int bits, int rate)
+{
+    auto *buf = (sfxbuffer_t *) Z_Calloc(sizeof(sfxbuffer_t), PU_APPSTATIC, 0);
+
+    buf->bytes = bits / 8;
+    buf->rate  = rate;
+    buf->flags = flags;
+    buf->freq  = rate; // Modified by calls to Set(SFXBP_FREQUENCY).
+    buf->ptr   = new Voice;
+
+    Sys_Lock(mixMutex);
+    buffers << buf;
+    Sys_Unlock(mixMutex);
+    return buf;
+}
+
+void DS_SoftMixer_SFX_DestroyBuffer(sfxbuffer_t *buf)
+{
+    if (!buf) return;
+
+    Sys_Lock(mixMutex);
+    buffers.removeOne(buf);
+    Sys_Unlock(mixMutex);
+
+    delete &voiceOf(buf);
+    Z_Free(buf);
+}
+
+/**
+ * Prepare the buffer for playing a sample. The pointer to sample is saved, so the
+ * caller mustn't free it while the sample is loaded.
+ *
+ * @param buf     Sound buffer.
+ * @param sample  Sample data.
+ */
+void DS_SoftMixer_SFX_Load(sfxbuffer_t *buf, struct sfxsample_s *sample)
+{
+    if (!buf || !sample) return;
+
+    Sys_Lock(mixMutex);
+    buf->sample  = sample;
+    buf->written = sample->size;
+    buf->flags  &= ~SFXBF_RELOAD;
+    voiceOf(buf).position = 0;
+    Sys_Unlock(mixMutex);
+}
+
+/**
+ * Stops the buffer and makes it forget about its sample.
+ *
+ * @param buf  Sound buffer.
+ */
+void DS_SoftMixer_SFX_Reset(sfxbuffer_t *buf)
+{
+    if (!buf) return;
+
+    Sys_Lock(mixMutex);
+    stopBuffer(buf);
+    buf->sample = nullptr;
+    buf->flags &= ~SFXBF_RELOAD;
+    Sys_Unlock(mixMutex);
+}
+
+void DS_SoftMixer_SFX_Play(sfxbuffer_t *buf)
+{
+    // Playing is quite impossible without a sample.
+    if (!buf || !buf->sample) return;
+
+    // Do we need to reload?
+    if (buf->flags & SFXBF_RELOAD)
+        DS_SoftMixer_SFX_Load(buf, buf->sample);
+
+    Sys_Lock(mixMutex);
+    if (!(buf->flags & SFXBF_PLAYING) || voiceOf(buf).ended)
+    {
+        // The sound starts playing now. In offline mode, "now" is the beginning
+        // of the current game tic.
+        Voice &voice = voiceOf(buf);
+        voice.position   = 0;
+        voice.started    = false;
+        voice.ended      = false;
+        voice.startFrame = (offline? de::max(mixedFrames, ticFrame(currentTic())) : mixedFrames);
+        buf->flags |= SFXBF_PLAYING;
+    }
+    Sys_Unlock(mixMutex);
+}
+
+void DS_SoftMixer_SFX_Stop(sfxbuffer_t *buf)
+{
+    if (!buf) return;
+
+    Sys_Lock(mixMutex);
+    stopBuffer(buf);
+    Sys_Unlock(mixMutex);
+}
+
+void DS_SoftMixer_SFX_Refresh(sfxbuffer_t *)
+{
+    // The mixer notices by itself when sounds end.
+}
+
+/**
+ * @param buf   Sound buffer.
+ * @param prop  Buffer property:
+ *              - SFXBP_VOLUME
+ *              - SFXBP_FREQUENCY
+ *              - SFXBP_PAN (-1..1)
+ *              - SFXBP_MIN_DISTANCE
+ *              - SFXBP_MAX_DISTANCE
+ *              - SFXBP_RELATIVE_MODE
+ * @param value Value for the property.
+ */
+void DS_SoftMixer_SFX_Set(sfxbuffer_t *buf, int prop, float value)
+{
+    if (!buf) return;
+
+    Sys_Lock(mixMutex);
+    Voice &voice = voiceOf(buf);
+    switch (prop)
+    {
+    case SFXBP_VOLUME:
+        voice.volume = value;
+        break;
+
+    case SFXBP_FREQUENCY:
+        buf->freq   = unsigned(buf->rate * value);
+        voice.pitch = value;
+        break;
+
+    case SFXBP_PAN:
+        voice.pan = value;
+        break;
+
+    case SFXBP_MIN_DISTANCE:
+        voice.minDistance = value;
+        break;
+
+    case SFXBP_MAX_DISTANCE:
+        voice.maxDistance = value;
+        break;
+
+    case SFXBP_RELATIVE_MODE:
+        voice.relative = (value != 0);
+        break;
+
+    default:
+        break;
+    }
+    Sys_Unlock(mixMutex);
+}
+
+/**
+ * Coordinates are specified in the map coordinate system.
+ *
+ * @param prop  SFXBP_POSITION
+ *              SFXBP_VELOCITY
+ */
+void DS_SoftMixer_SFX_Setv(sfxbuffer_t *buf, int prop, float *values)
+{
+    if (!buf || !values) return;
+
+    if (prop == SFXBP_POSITION)
+    {
+        Sys_Lock(mixMutex);
+        Voice &voice = voiceOf(buf);
+        std::memcpy(voice.origin, values, sizeof(voice.origin));
+        Sys_Unlock(mixMutex);
+    }
+}
+
+/**
+ * @param prop  SFXLP_UNITS_PER_METER
+ *              SFXLP_DOPPLER
+ *              SFXLP_UPDATE
+ */
+void DS_SoftMixer_SFX_Listener(int, float)
+{
+    // Properties are applied immediately; no Doppler effect.
+}
+
+/**
+ * @param prop  SFXLP_PRIMARY_FORMAT
+ *              SFXLP_POSITION
+ *              SFXLP_ORIENTATION
+ *              SFXLP_VELOCITY
+ *              SFXLP_REVERB
+ */
+void DS_SoftMixer_SFX_Listenerv(int prop, float *values)
+{
+    if (!values) return;
+
+    Sys_Lock(mixMutex);
+    switch (prop)
+    {
+    case SFXLP_PRIMARY_FORMAT:
+        // The output rate can only be chosen before anything has been mixed.
+        if (!mixedFrames && values[1] > 0)
+        {
+            outputRate = int(values[1]);
+        }
+        break;
+
+    case SFXLP_POSITION:
+        std::memcpy(listenerOrigin, values, sizeof(listenerOrigin));
+        break;
+
+    case SFXLP_ORIENTATION:
+        listenerYaw = degreeToRadian(values[0]);
+        break;
+
+    default:
+        break;
+    }
+    Sys_Unlock(mixMutex);
+}
+
+/**
+ * Gets a driver property.
+ *
+ * @param prop    Property (SFXP_*).
+ * @param values  Pointer to return value(s).
+ */
+int DS_SoftMixer_SFX_Getv(int prop, void *values)
+{
+    switch (prop)
+    {
+    case SFXIP_DISABLE_CHANNEL_REFRESH:
+    case SFXIP_ANY_SAMPLE_RATE_ACCEPTED: {
+        /// The return value is a single 32-bit int.
+        int *value = (int *) values;
+        if (value)
+        {
+            // The mixer stops finished sounds and resamples everything.
+            *value = true;
+        }
+        break; }
+
+    default:
+        return false;
+    }
+    return true;
+}
@@ -48,6 +48,7 @@
 #  include "ui/busyvisual.h"
 #  include "ui/clientwindow.h"
 #  include "ui/inputsystem.h"
+#  include "world/generator.h"
 #endif
 
 using namespace de;
@@ -177,6 +178,14 @@ static void baseTicker(timespan_t time)
             gx.Ticker(time);
         }
 
+#ifdef __CLIENT__
+        // Move the particles of the generators ticked by the game.
+        if(ClientApp::world().hasMap())
+        {
+            Generator::movePendingParticles(ClientApp::world().map().as<Map>());
+        }
+#endif
+
 #ifdef __CLIENT__
         // Windowing system ticks.
         for(dint i = 0; i < DDMAXPLAYERS; ++i)
@@ -26,6 +26,7 @@
 #include <doomsday/console/var.h>
 #include <doomsday/mesh/hedge.h>
 #include <doomsday/tab_tables.h>
+#include <algorithm>
 
 #include "dd_def.h"
 #include "render/rend_main.h"
@@ -41,155 +42,46 @@ namespace internal
     {
         return RAD2BANG(atan2f(point.y, point.x));
     }
-
-    /**
-     * Simple data structure for pooling POD elements. Note that unlike a traditional
-     * ObjectPool (pattern), the pooled elements are @em not owned by the pool!
-     */
-    class ElementPool
-    {
-    public:
-        /**
-         * Base for POD elements.
-         */
-        struct Element
-        {
-        private:
-            Element *_prev, *_next;
-
-            friend class ElementPool;
-        };
-
-        /**
-         * Begin reusing elements in the pool.
-         */
-        void rewind() {
-            _rover = _first;
-        }
-
-        /**
-         * Add a new @em unused object to the pool.
-         *
-         * @param elem  Element to be linked in the pool. Ownership is unaffected.
-         */
-        void add(Element *elem)
-        {
-            // Link it to the start of the rover's list.
-            if(!_last) _last = elem;
-            if(_first) _first->_prev = elem;
-
-            elem->_next = _first;
-            elem->_prev = nullptr;
-
-            _first = elem;
-        }
-
-        /**
-         * Returns a pointer to the next unused element in the pool; otherwise @c nullptr.
-         */
-        void *get() {
-            if(!_rover) return nullptr;
-
-            // We'll use this.
-            Element *next = _rover;
-            _rover = _rover->_next;
-            return next;
-        }
-
-        /**
-         * Release the element @a elem (@important which is assumed to have been added
-         * previously!), moving it to the list of used elements, for later reuse.
-         */
-        void release(Element *elem)
-        {
-            DE_ASSERT(_last);
-
-            if(elem == _last)
-            {
-                DE_ASSERT(!_rover);
-
-                // We can only remove the last if all elements are already in use.
-                _rover = elem;
-                return;
-            }
-
-            DE_ASSERT(elem->_next);
-
-            // Unlink from the list entirely.
-            elem->_next->_prev = elem->_prev;
-            if(elem->_prev)
-            {
-                elem->_prev->_next = elem->_next;
-            }
-            else
-            {
-                _first = _first->_next;
-                _first->_prev = nullptr;
-            }
-
-            // Put it back to the end of the list.
-            _last->_next = elem;
-            elem->_prev = _last;
-            elem->_next = nullptr;
-            _last = elem;
-
-            // If all were in use, set the rover here. Otherwise the rover can stay
-            // where it is.
-            if(!_rover)
-            {
-                _rover = _last;
-            }
-        }
-
-    private:
-        Element *_first = nullptr;
-        Element *_last  = nullptr;
-        Element *_rover = nullptr;
-    };
 }  // namespace internal
 using namespace ::internal;
 
 DE_PIMPL_NOREF(AngleClipper)
 {
-    /// Specialized AngleRange for half-space clipping.
-    struct Clipper : public ElementPool::Element, AngleRange
-    {
-        Clipper *prev;
-        Clipper *next;
-    };
-    ElementPool clipNodes;          ///< The list of clipnodes.
-    Clipper *   clipHead = nullptr; ///< Head of the clipped-range list.
+    /**
+     * Clipped ranges, sorted by the start angle. The ranges are disjoint: ranges
+     * that overlap or touch are merged when added, so at most one range can contain
+     * a given angle. The storage is reused from frame to frame.
+     */
+    List<AngleRange> clipRanges;
 
     /// Specialized AngleRange for half-space occlusion.
-    struct Occluder : public ElementPool::Element, AngleRange
+    struct Occluder : public AngleRange
     {
-        Occluder *prev;
-        Occluder *next;
-
         bool  topHalf; ///< @c true= top, rather than bottom, half.
         Vec3f normal;  ///< Of the occlusion plane.
+
+        Occluder(binangle_t from, binangle_t to, const Vec3f &normal, bool topHalf)
+            : AngleRange(from, to), topHalf(topHalf), normal(normal)
+        {}
     };
-    ElementPool occNodes;          ///< The list of occlusion nodes.
-    Occluder *  occHead = nullptr; ///< Head of the occlusion-range list.
+    /**
+     * Occlusion ranges, sorted by the start angle. Unlike the clipped ranges, these
+     * may overlap.
+     */
+    List<Occluder> occluders;
+    List<Occluder> cutParts;    ///< Scratch buffer for cutOcclusionRange().
 
     List<binangle_t> angleBuf;  ///< Scratch buffer for sorting angles.
 
-    ~Impl()
+    /**
+     * Returns the first clipped range that ends at or after @a angle.
+     */
+    List<AngleRange>::const_iterator firstClipRangeEndingAfter(binangle_t angle) const
     {
-        clearRangeList(&clipHead);
-        clearRangeList(&occHead);
-    }
-
-    template <typename NodeType>
-    void clearRangeList(NodeType **head)
-    {
-        DE_ASSERT(head);
-        while(*head)
-        {
-            auto *next = static_cast<NodeType *>((*head)->next);
-            delete *head;
-            *head = next;
-        }
+        return std::lower_bound(clipRanges.begin(), clipRanges.end(), angle,
+                                [] (const AngleRange &range, binangle_t a) {
+                                    return range.to < a;
+                                });
     }
 
     /**
@@ -197,9 +89,11 @@ DE_PIMPL_NOREF(AngleClipper)
      */
     dint isRangeVisible(binangle_t from, binangle_t to) const
     {
-        for(Clipper *i = clipHead; i; i = i->next)
+        // Only the range that contains @a from can contain the entire range.
+        auto range = firstClipRangeEndingAfter(from);
+        if(range != clipRanges.end())
         {
-            if(from >= i->from && to <= i->to)
+            if(from >= range->from && to <= range->to)
                 return false;
         }
         // No clip-node fully contained the specified range.
@@ -219,262 +113,33 @@ DE_PIMPL_NOREF(AngleClipper)
         return isRangeVisible(from, to);
     }
 
-    void removeRange(Clipper *crange)
-    {
-        // If this is the head, move it.
-        if(clipHead == crange)
-            clipHead = crange->next;
-
-        if(crange->prev)
-            crange->prev->next = crange->next;
-        if(crange->next)
-            crange->next->prev = crange->prev;
-
-        // We're done with this range - mark it as free for reuse.
-        clipNodes.release(crange);
-    }
-
-    Clipper *newClipNode(binangle_t from, binangle_t to)
-    {
-        // Perhaps a previously-used clip-node can be reused?
-        auto *crange = reinterpret_cast<Clipper *>(clipNodes.get());
-        if(!crange)
-        {
-            // No, allocate another.
-            clipNodes.add(crange = new Clipper);
-        }
-
-        // (Re)Configure.
-        crange->from = from;
-        crange->to   = to;
-        crange->prev = nullptr;
-        crange->next = nullptr;
-
-        return crange;
-    }
-
     void addRange(binangle_t from, binangle_t to)
     {
         // This range becomes a solid segment: cut everything away from the
         // corresponding occlusion range.
         cutOcclusionRange(from, to);
 
-        // If there is no head, this will be the first range.
-        if(!clipHead)
-        {
-            clipHead = newClipNode(from, to);
-
-            /*
-            LOG_AS("AngleClipper::addRange");
-            LOG_DEBUG(String("New head added: %1 => %2")
-                        .arg(clipHead->from, 0, 16)
-                        .arg(clipHead->to,   0, 16));
-            */
-            return;
-        }
-
-        // There are previous ranges. Check that the new range isn't contained
-        // by any of them.
-        for(Clipper *i = clipHead; i; i = i->next)
+        // Find the ranges that overlap or touch the new range.
+        const dsize first = firstClipRangeEndingAfter(from) - clipRanges.begin();
+        dsize last = first;
+        while(last < clipRanges.size() && clipRanges[last].from <= to)
         {
-            /*
-            LOG_AS("AngleClipper::addRange");
-            LOG_DEBUG(String("0x%1: %2 => %3")
-                        .arg((quintptr)i, QT_POINTER_SIZE * 2, 16, QChar('0'))
-                        .arg(i->from, 0, 16)
-                        .arg(i->to,   0, 16));
-            */
-
-            if(from >= i->from && to <= i->to)
-            {
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG("Range already exists");
-                */
-                return;  // The new range already exists.
-            }
-
-#ifdef DE_DEBUG
-            if (i == i->next)
-                throw Error("AngleClipper::addRange",
-                            stringf("loop1 %p linked to itself: %x => %x", i, i->from, i->to));
-#endif
-        }
-
-        // Now check if any of the old ranges are contained by the new one.
-        for(Clipper *i = clipHead; i;)
-        {
-            if(i->from >= from && i->to <= to)
-            {
-                Clipper *contained = i;
-
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG(String("Removing contained range %1 => %2")
-                            .arg(contained->from, 0, 16)
-                            .arg(contained->to,   0, 16));
-                */
-
-                i = i->next;
-                removeRange(contained);
-                continue;
-            }
-
-            i = i->next;
+            ++last;
         }
 
-        // Now it is possible that the new range overlaps one or two old ranges.
-        // If two are overlapped, they are consecutive. First we'll try to find
-        // a range that overlaps the beginning.
-        Clipper *crange = nullptr;
-        for(Clipper *i = clipHead; i; i = i->next)
+        if(first == last)
         {
-            // In preparation for the next stage, find a good spot for the range.
-            if(i->from < to)
-            {
-                // After this one.
-                crange = i;
-            }
-
-            if(i->from >= from && i->from <= to)
-            {
-                // New range's end and i's beginning overlap. i's end is outside.
-                // Otherwise it would have been already removed.
-                // It suffices to adjust i.
-
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG(String("Overlapping start: %1 => %2 - adjusting to %3 => %4")
-                            .arg(i->from, 0, 16)
-                            .arg(i->to,   0, 16)
-                            .arg(from,    0, 16)
-                            .arg(i->to,   0, 16));
-                */
-
-                i->from = from;
-                return;
-            }
-
-            // Check an overlapping end.
-            if(i->to >= from && i->to <= to)
-            {
-                // Now it's possible that the i->next's beginning overlaps the
-                // new range's end. In that case there will be a merger.
-
-                /*
-                LOG_AS("AngleClipper::addRange");
-                LOG_DEBUG(String("Overlapping end: %1 => %2")
-                            .arg(i->from, 0, 16)
-                            .arg(i->to,   0, 16));
-                */
-
-                crange = i->next;
-                if(!crange)
-                {
-                    i->to = to;
-
-                    /*
-                    LOG_AS("AngleClipper::addRange");
-                    LOG_DEBUG(String("No next, adjusting end (now %1 => %2)")
-                                .arg(i->from, 0, 16)
-                                .arg(i->to,   0, 16));
-                    */
-                }
-                else
-                {
-                    if(crange->from <= to)
-                    {
-                        // A fusion will commence. Ci will eat the new range
-                        // *and* crange.
-                        i->to = crange->to;
-
-                        /*
-                        LOG_AS("AngleClipper::addRange");
-                        LOG_DEBUG(String("merging with the next (%1 => %2)")
-                                    .arg(crange->from, 0, 16)
-                                    .arg(crange->to,   0, 16));
-                        */
-
-                        removeRange(crange);
-                    }
-                    else
-                    {
-                        // Not overlapping.
-                        i->to = to;
-
-                        /*
-                        LOG_AS("AngleClipper::addRange");
-                        LOG_DEBUG(String("Not merger w/next (now %1 => %2)")
-                                    .arg(i->from, 0, 16)
-                                    .arg(i->to,   0, 16));
-                        */
-                    }
-                }
-
-                return;
-            }
-        }
-
-        // Still here? Now we know for sure that the range is disconnected from
-        // the others. We still need to find a good place for it. Crange will
-        // mark the spot.
-
-        if(!crange)
-        {
-            // We have a new head.
-            crange = clipHead;
-            clipHead = newClipNode(from, to);
-            clipHead->next = crange;
-            if(crange)
-                crange->prev = clipHead;
-        }
-        else
-        {
-            // Add the new range after crange.
-            Clipper *added = newClipNode(from, to);
-            added->next = crange->next;
-            if(added->next)
-                added->next->prev = added;
-            added->prev = crange;
-            crange->next = added;
-        }
-    }
-
-    void removeOcclusionRange(Occluder *orange)
-    {
-        // If this is the head, move it.
-        if(occHead == orange)
-            occHead = orange->next;
-
-        if(orange->prev)
-            orange->prev->next = orange->next;
-        if(orange->next)
-            orange->next->prev = orange->prev;
-
-        // We're done with this range - mark it as free for reuse.
-        occNodes.release(orange);
-    }
-
-    Occluder *newOcclusionRange(binangle_t from, binangle_t to, const Vec3f &normal,
-        bool topHalf)
-    {
-        // Perhaps a previously-used occluder can be reused?
-        auto *orange = reinterpret_cast<Occluder *>(occNodes.get());
-        if(!orange)
-        {
-            // No, allocate another.
-            occNodes.add(orange = new Occluder);
+            // The range is disconnected from the others.
+            clipRanges.insert(first, AngleRange(from, to));
+            return;
         }
 
-        // (Re)Configure.
-        orange->from    = from;
-        orange->to      = to;
-        orange->prev    = nullptr;
-        orange->next    = nullptr;
-        orange->topHalf = topHalf;
-        orange->normal  = normal;
-
-        return orange;
+        // The overlapped ranges are merged into the first one. (If the new range
+        // already exists, nothing changes.)
+        AngleRange &merged = clipRanges[first];
+        merged.from = de::min(merged.from, from);
+        merged.to   = de::max(clipRanges[last - 1].to, to);
+        clipRanges.remove(first + 1, last - first - 1);
     }
 
     /**
@@ -486,49 +151,16 @@ DE_PIMPL_NOREF(AngleClipper)
         // Is the range valid?
         if(from > to) return;
 
-        // A new range will be added.
-        Occluder *newor = newOcclusionRange(from, to, normal, topHalf);
-
-        // Are there any previous occlusion nodes?
-        if(!occHead)
-        {
-            // No; this is the first.
-            occHead = newor;
-            occHead->next = occHead->prev = nullptr;
-            return;
-        }
-
         /// @todo Optimize: Remove existing oranges that are fully contained by
         /// the new orange. But how to do the check efficiently?
 
-        // Add the new occlusion range to the appropriate position.
-        Occluder *after = nullptr;
-        for(Occluder *orange = occHead; orange; orange = orange->next)
-        {
-            // The list of oranges is sorted by the start angle.
-            // Find the first range whose start is greater than the new one.
-            if(orange->from > from)
-            {
-                // Add before this one.
-                newor->next = orange;
-                newor->prev = orange->prev;
-                orange->prev = newor;
-
-                if(newor->prev)
-                    newor->prev->next = newor;
-                else
-                    occHead = newor;  // We have a new head.
-
-                return;
-            }
-
-            after = orange;
-        }
-
-        // Add the new range to the end of the list.
-        after->next = newor;
-        newor->prev = after;
-        newor->next = nullptr;
+        // Add the new occlusion range before the first range whose start is
+        // greater than the new one.
+        auto pos = std::upper_bound(occluders.begin(), occluders.end(), from,
+                                    [] (binangle_t a, const Occluder &orange) {
+                                        return a < orange.from;
+                                    });
+        occluders.insert(pos, Occluder(from, to, normal, topHalf));
     }
 
     /**
@@ -561,86 +193,94 @@ DE_PIMPL_NOREF(AngleClipper)
     }
 
     /**
-     * Attempts to merge the two given occnodes.
+     * Attempts to merge the two given occnodes. Neither is removed from the list.
      *
      * @return @c 0= Could not be merged.
-     *         @c 1= orange was merged into other.
-     *         @c 2= other was merged into orange.
+     *         @c 1= orange was merged into other (orange should be removed).
+     *         @c 2= other was merged into orange (other should be removed).
      */
-    dint tryMergeOccludes(Occluder *orange, Occluder *other)
+    dint tryMergeOccludes(const Occluder &orange, const Occluder &other) const
     {
         // We can't test this steep planes.
-        if(!orange->normal.z) return 0;
+        if(!orange.normal.z) return 0;
 
         // Where do they cross?
-        Vec3f cross = orange->normal.cross(other->normal);
+        Vec3f cross = orange.normal.cross(other.normal);
         if(!cross.x && !cross.y && !cross.z)
         {
             // These two planes are exactly the same! Remove one.
-            removeOcclusionRange(orange);
             return 1;
         }
 
         // The cross angle must be outside the range.
         binangle_t crossAngle = bamsAtan2(dint(cross.y), dint(cross.x));
-        if(crossAngle >= orange->from && crossAngle <= orange->to)
+        if(crossAngle >= orange.from && crossAngle <= orange.to)
             return 0;  // Inside the range, can't do a thing.
 
         /// @todo Is it not possible to consistently determine the direction at
         /// which cross (vector) is pointing?
         crossAngle += BANG_180;
-        if(crossAngle >= orange->from && crossAngle <= orange->to)
+        if(crossAngle >= orange.from && crossAngle <= orange.to)
             return 0;  // Inside the range, can't do a thing.
 
         // Now we must determine which plane occludes which.
         // Pick a point in the middle of the range.
-        crossAngle = (orange->from + orange->to) >> (1 + BAMS_BITS - 13);
+        crossAngle = (orange.from + orange.to) >> (1 + BAMS_BITS - 13);
         cross.x = 100 * FIX2FLT(finecosine[crossAngle]);
         cross.y = 100 * FIX2FLT(finesine  [crossAngle]);
-        cross.z = -(orange->normal.x * cross.x +
-                    orange->normal.y * cross.y) / orange->normal.z;
+        cross.z = -(orange.normal.x * cross.x +
+                    orange.normal.y * cross.y) / orange.normal.z;
 
         // Is orange occluded by the other one?
-        if(cross.dot(other->normal) < 0)
+        if(cross.dot(other.normal) < 0)
         {
             // No; then the other one is occluded by us. Remove it instead.
-            removeOcclusionRange(other);
             return 2;
         }
-        else
-        {
-            removeOcclusionRange(orange);
-            return 1;
-        }
+        return 1;
     }
 
     /**
      * Try to merge oranges with matching ranges. (Quite a number may be produced
      * as a result of the cuts.)
+     *
+     * Merging is a heuristic, so the order in which the oranges are tried affects
+     * which ones are dropped. The order is the same as when the oranges were kept
+     * in a linked list: when an orange other than the next one is dropped, the
+     * next one is skipped until the following merge.
      */
     void mergeOccludes()
     {
-        for(Occluder *orange = occHead; orange && orange->next; )
+        dsize i = 0;
+        while(i + 1 < occluders.size())
         {
-            // As orange might be removed - remember the next one.
-            auto *next = orange->next;
+            dsize next = i + 1;
 
             // Find a good one to test with.
-            for(Occluder *other = next; other && orange->from == other->from; other = other->next)
+            for(dsize k = i + 1; k < occluders.size() && occluders[k].from == occluders[i].from; ++k)
             {
-                if(other->topHalf != orange->topHalf) continue;
-                if(orange->to != other->to) continue;
+                const Occluder &orange = occluders[i];
+                const Occluder &other  = occluders[k];
+                if(other.topHalf != orange.topHalf) continue;
+                if(orange.to != other.to) continue;
 
                 // It is a candidate for merging.
-                dint result = tryMergeOccludes(orange, other);
-                if(result == 2)
+                const dint result = tryMergeOccludes(orange, other);
+                if(result == 1)
+                {
+                    // The next one is now at this index.
+                    occluders.removeAt(i);
+                    next = i;
+                }
+                else if(result == 2)
                 {
-                    next = next->next;
+                    occluders.removeAt(k);
+                    if(k > i + 1) next = i + 2;
                 }
                 break;
             }
 
-            orange = next;
+            i = next;
         }
     }
 
@@ -651,40 +291,35 @@ DE_PIMPL_NOREF(AngleClipper)
     {
         DE_DEBUG_ONLY(occlusionRanger(1));
 
-        // Find the range after which it's OK to add oranges cut in half.
-        // (Must preserve the ascending order of the start angles.) We want the
-        // orange with the smallest start angle, but one that starts after the
-        // cut range has ended.
-        Occluder *after  = nullptr;
-        for(Occluder *orange = occHead; orange && orange->from < to; orange = orange->next)
-        {
-            after = orange;
-        }
+        // Oranges cut in half are added after the ones that start before the end of
+        // the cut range. (Must preserve the ascending order of the start angles.)
+        cutParts.clear();
 
-        for(Occluder *orange = occHead; orange; )
+        // Oranges starting after the cut range has ended are not affected.
+        const dsize end = std::lower_bound(occluders.begin(), occluders.end(), to,
+                                           [] (const Occluder &orange, binangle_t a) {
+                                               return orange.from < a;
+                                           }) - occluders.begin();
+        dsize out = 0;
+        for(dsize i = 0; i < end; ++i)
         {
-            // As orange might be removed - remember the next one.
-            auto *next = orange->next;
+            Occluder &orange = occluders[i];
 
             // Does the cut range include this orange?
-            if(from <= orange->to)
+            if(from <= orange.to)
             {
-                // No more cuts possible?
-                if(orange->from >= to) break;
-
                 // Four options:
-                switch(orange->relationship(AngleRange(from, to)))
+                switch(orange.relationship(AngleRange(from, to)))
                 {
                 case 0:  // The cut range completely includes this orange.
 
                     // Fully contained; this orange will be removed.
-                    removeOcclusionRange(orange);
-                    break;
+                    continue;
 
                 case 1:  // The cut range contains the beginning of the orange.
 
                     // Cut away the beginning of this orange.
-                    orange->from = to;
+                    orange.from = to;
                     // Even though the start angle is modified, we don't need to
                     // move this orange anywhere. This is because after the cut
                     // there will be no oranges beginning inside the cut range.
@@ -693,43 +328,33 @@ DE_PIMPL_NOREF(AngleClipper)
                 case 2:  // The cut range contains the end of the orange.
 
                     // Cut away the end of this orange.
-                    orange->to = from;
+                    orange.to = from;
                     break;
 
-                case 3: {  // The orange contains the whole cut range.
-
-                    // The orange gets cut in two parts. Create a new orange that
-                    // represents the end, and add it after the 'after' range, or
-                    // to the head of the list.
-                    Occluder *part = newOcclusionRange(to, orange->to, orange->normal,
-                                                       orange->topHalf);
-
-                    part->prev = after;
-                    if(after)
-                    {
-                        part->next = after->next;
-                        after->next = part;
-                    }
-                    else
-                    {
-                        // Add to the head.
-                        part->next = occHead;
-                        occHead = part;
-                    }
-
-                    if(part->next)
-                        part->next->prev = part;
+                case 3:  // The orange contains the whole cut range.
+
+                    // The orange gets cut in two parts. The end part is added
+                    // afterwards.
+                    cutParts << Occluder(to, orange.to, orange.normal, orange.topHalf);
 
                     // Modify the start part.
-                    orange->to = from;
-                    break; }
+                    orange.to = from;
+                    break;
 
                 default:  // No meaningful relationship (in this context).
                     break;
                 }
             }
 
-            orange = next;
+            if(out != i) occluders[out] = orange;
+            ++out;
+        }
+        occluders.remove(out, end - out);
+
+        // (The most recently cut part ends up first.)
+        for(const Occluder &part : cutParts)
+        {
+            occluders.insert(out, part);
         }
 
         DE_DEBUG_ONLY(occlusionRanger(2));
@@ -742,17 +367,17 @@ DE_PIMPL_NOREF(AngleClipper)
 #ifdef DE_DEBUG
     void occlusionLister()
     {
-        for (Occluder *orange = occHead; orange; orange = orange->next)
+        for (const Occluder &orange : occluders)
         {
-            LOG_MSG("from: %x to: %x topHalf: %b") << orange->from << orange->to << orange->topHalf;
+            LOG_MSG("from: %x to: %x topHalf: %b") << orange.from << orange.to << orange.topHalf;
         }
     }
 
     void occlusionRanger(int mark)
     {
-        for (Occluder *orange = occHead; orange; orange = orange->next)
+        for (dsize i = 1; i < occluders.size(); ++i)
         {
-            if (orange->prev && orange->prev->from > orange->from)
+            if (occluders[i - 1].from > occluders[i].from)
             {
                 occlusionLister();
                 throw Error("AngleClipper::occlusionRanger", stringf("Order %i has failed", mark));
@@ -769,14 +394,17 @@ dint AngleClipper::isFull() const
 {
     if(::devNoCulling) return false;
 
-    return d->clipHead && d->clipHead->from == 0 && d->clipHead->to == BANG_MAX;
+    return d->clipRanges.size() == 1 && d->clipRanges.first().from == 0
+        && d->clipRanges.first().to == BANG_MAX;
 }
 
 dint AngleClipper::isAngleVisible(binangle_t bang) const
 {
     if(::devNoCulling) return true;
 
-    for(const Impl::Clipper *crange = d->clipHead; crange; crange = crange->next)
+    // Only the range that contains the angle can clip it.
+    auto crange = d->firstClipRangeEndingAfter(bang);
+    if(crange != d->clipRanges.end())
     {
         if(bang > crange->from && bang < crange->to)
             return false;
@@ -795,18 +423,15 @@ dint AngleClipper::isPointVisible(const Vec3d &point) const
     if(!isAngleVisible(angle)) return false;
 
     // Not clipped by the clipnodes. Perhaps it's occluded by an orange.
-    for(const Impl::Occluder *orange = d->occHead; orange; orange = orange->next)
+    for(const Impl::Occluder &orange : d->occluders)
     {
-        if(angle >= orange->from && angle <= orange->to)
-        {
-            if(orange->from > angle)
-                return true;  // No more possibilities.
+        if(orange.from > angle)
+            break;  // No more possibilities.
 
-            // On which side of the occlusion plane is it?
-            // The positive side is the occluded one.
-            if(viewRelPoint.dot(orange->normal) > 0)
-                return false;
-        }
+        // On which side of the occlusion plane is it?
+        // The positive side is the occluded one.
+        if(angle <= orange.to && viewRelPoint.dot(orange.normal) > 0)
+            return false;
     }
 
     return true;  // Not occluded.
@@ -864,11 +489,9 @@ dint AngleClipper::isPolyVisible(const mesh::Face &poly) const
 
 void AngleClipper::clearRanges()
 {
-    d->clipHead = nullptr;
-    d->clipNodes.rewind();  // Start reusing ranges.
-
-    d->occHead = nullptr;
-    d->occNodes.rewind();   // Start reusing ranges.
+    // The storage is kept for reuse.
+    d->clipRanges.clear();
+    d->occluders.clear();
 }
 
 dint AngleClipper::safeAddRange(binangle_t from, binangle_t to)
@@ -941,30 +564,15 @@ dint AngleClipper::checkRangeFromViewRelPoints(const Vec2d &from, const Vec2d &t
 #ifdef DE_DEBUG
 void AngleClipper::validate()
 {
-    for(Impl::Clipper *i = d->clipHead; i; i = i->next)
+    for(dsize i = 0; i < d->clipRanges.size(); ++i)
     {
-        if(i == d->clipHead)
-        {
-            if(i->prev)
-                throw Error("AngleClipper::validate", "Cliphead->prev != NULL");
-        }
+        const AngleRange &range = d->clipRanges[i];
+        if(range.from > range.to)
+            throw Error("AngleClipper::validate", "Range ends before it begins");
 
-        // Confirm that the links to prev and next are OK.
-        if(i->prev)
-        {
-            if(i->prev->next != i)
-                throw Error("AngleClipper::validate", "Prev->next != this");
-        }
-        else if(i != d->clipHead)
-        {
-            throw Error("AngleClipper::validate", "prev == NULL, this isn't clipHead");
-        }
-
-        if(i->next)
-        {
-            if(i->next->prev != i)
-                throw Error("AngleClipper::validate", "Next->prev != this");
-        }
+        // The ranges must be sorted and disjoint.
+        if(i > 0 && d->clipRanges[i - 1].to >= range.from)
+            throw Error("AngleClipper::validate", "Ranges overlap or are out of order");
     }
 }
 #endif
@@ -22,217 +22,251 @@
 #include "render/drawlists.h"
 
 #include <de/log.h>
+#include <de/math.h>
 #include <de/legacy/memoryzone.h>
 #include <de/hash.h>
 
 using namespace de;
 
-typedef std::unordered_multimap<GLuint, DrawList *> DrawListHash;
+static const int NUM_GEOM_GROUPS = ShineGeom + 1;
 
-DE_PIMPL(DrawLists)
+namespace {
+
+/**
+ * Identifies the texture of a unit. Properties which are applied per-primitive
+ * (written to the primitive header and applied dynamically when reading back the
+ * draw list) are ignored, as they should not result in list separation. Nearly
+ * equal opacities are considered the same, so opacity is not part of the hash.
+ */
+struct UnitKey
 {
-    std::unique_ptr<DrawList> skyMaskList;
-    DrawListHash unlitHash;
-    DrawListHash litHash;
-    DrawListHash dynHash;
-    DrawListHash shinyHash;
-    DrawListHash shadowHash;
+    const TextureVariant *texture = nullptr;
+    GLuint  glName  = 0;
+    duint32 state   = 0; ///< Wrapping and filtering of an unmanaged texture.
+    float   opacity = 0;
 
-    Impl(Public *i) : Base(i)
+    UnitKey() {}
+    UnitKey(const GLTextureUnit &unit) : texture(unit.texture), opacity(unit.opacity)
+    {
+        if (!texture)
+        {
+            glName = unit.unmanaged.glName;
+            state  = duint32(unit.unmanaged.wrapS)
+                   | duint32(unit.unmanaged.wrapT)  << 8
+                   | duint32(unit.unmanaged.filter) << 16;
+        }
+    }
+
+    bool operator == (const UnitKey &other) const
+    {
+        return texture == other.texture && glName == other.glName && state == other.state
+            && de::fequal(opacity, other.opacity);
+    }
+
+    dsize hash() const
     {
-        DrawListSpec newSpec;
-        newSpec.group = SkyMaskGeom;
-        skyMaskList.reset(new DrawList(newSpec));
+        dsize h = std::hash<const void *>()(texture);
+        h = h * 31 + glName;
+        h = h * 31 + state;
+        return h;
+    }
+};
+
+/**
+ * Identifies a draw list. Shiny surfaces have no details, and the interpolation
+ * target is only used in blended lists.
+ */
+struct SpecKey
+{
+    GeomGroup group;
+    UnitKey units[NUM_TEXTURE_UNITS];
+
+    SpecKey(const DrawListSpec &spec, bool blended) : group(spec.group)
+    {
+        units[TU_PRIMARY] = spec.unit(TU_PRIMARY);
+        if (group != ShineGeom)
+        {
+            units[TU_PRIMARY_DETAIL] = spec.unit(TU_PRIMARY_DETAIL);
+        }
+        if (blended)
+        {
+            units[TU_INTER] = spec.unit(TU_INTER);
+            if (group != ShineGeom)
+            {
+                units[TU_INTER_DETAIL] = spec.unit(TU_INTER_DETAIL);
+            }
+        }
     }
 
-    /// Choose the correct draw list hash table.
-    DrawListHash &listHash(GeomGroup group)
+    bool operator == (const SpecKey &other) const
     {
-        switch(group)
+        if (group != other.group) return false;
+        for (int i = 0; i < NUM_TEXTURE_UNITS; ++i)
         {
-        case UnlitGeom:  return unlitHash;
-        case LitGeom:    return litHash;
-        case LightGeom:  return dynHash;
-        case ShadowGeom: return shadowHash;
-        case ShineGeom:  return shinyHash;
+            if (!(units[i] == other.units[i])) return false;
+        }
+        return true;
+    }
+};
 
-        case SkyMaskGeom: break; // n/a?
+struct SpecKeyHash
+{
+    dsize operator () (const SpecKey &key) const
+    {
+        dsize h = dsize(key.group);
+        for (const auto &unit : key.units)
+        {
+            h = h * 0x9e3779b1 + unit.hash();
         }
-        DE_ASSERT_FAIL("Invalid geometry group type");
-        return unlitHash;
+        return h;
     }
 };
 
-DrawLists::DrawLists() : d(new Impl(this))
-{}
+} // namespace
+
+typedef Hash<SpecKey, DrawLists::Id, SpecKeyHash> DrawListIds;
 
-static void clearAllLists(DrawListHash &hash)
+DE_PIMPL(DrawLists)
 {
-    for (const auto &list : hash)
+    List<DrawList *> lists;                    ///< Indexed by Id (owned).
+    List<Id>         groupLists[NUM_GEOM_GROUPS]; ///< Ids in creation order.
+    DrawListIds      ids;                      ///< Lists kept from frame to frame.
+    DrawListIds      blendedIds;               ///< Blended lists of the current frame.
+    List<Id>         freeBlendedLists[NUM_GEOM_GROUPS];
+    duint32          generation = 1;           ///< Current generation of CachedIds.
+
+    Impl(Public *i) : Base(i)
     {
-        list.second->clear();
-        delete list.second;
+        createSkyMaskList();
     }
-    hash.clear();
-}
 
-void DrawLists::clear()
-{
-    clearAllLists(d->unlitHash);
-    clearAllLists(d->litHash);
-    clearAllLists(d->dynHash);
-    clearAllLists(d->shadowHash);
-    clearAllLists(d->shinyHash);
-    d->skyMaskList->clear();
-}
+    ~Impl()
+    {
+        deleteAll(lists);
+    }
 
-static void resetList(DrawList &list)
-{
-    list.rewind();
-
-    // Reset the list specification.
-    // The interpolation target must be explicitly set.
-    DrawListSpec &listSpec = list.spec();
-    listSpec.unit(TU_INTER).unmanaged.glName = 0;
-    listSpec.unit(TU_INTER).texture          = 0;
-    listSpec.unit(TU_INTER).opacity          = 0;
-
-    listSpec.unit(TU_INTER_DETAIL).unmanaged.glName = 0;
-    listSpec.unit(TU_INTER_DETAIL).texture          = 0;
-    listSpec.unit(TU_INTER_DETAIL).opacity          = 0;
-}
+    void createSkyMaskList()
+    {
+        DE_ASSERT(lists.isEmpty());
+        newList(DrawListSpec(SkyMaskGeom));
+    }
 
-static void resetAllLists(DrawListHash &hash)
-{
-    for (const auto &list : hash)
+    Id newList(const DrawListSpec &spec)
     {
-        resetList(*list.second);
+        const Id id = Id(lists.size());
+        lists << new DrawList(spec);
+        groupLists[spec.group] << id;
+        return id;
     }
-}
 
-void DrawLists::reset()
+    void invalidateCachedIds()
+    {
+        if (++generation == 0) generation = 1;
+    }
+
+    /**
+     * Blended lists are reassigned every frame; empty lists left over from the
+     * previous frames are used before new ones are created.
+     */
+    Id blendedList(const DrawListSpec &spec)
+    {
+        auto &freeLists = freeBlendedLists[spec.group];
+        if (freeLists.isEmpty())
+        {
+            return newList(spec);
+        }
+        const Id id = freeLists.takeLast();
+        lists[id]->spec() = spec;
+        return id;
+    }
+};
+
+DrawLists::DrawLists() : d(new Impl(this))
+{}
+
+void DrawLists::clear()
 {
-    resetAllLists(d->unlitHash);
-    resetAllLists(d->litHash);
-    resetAllLists(d->dynHash);
-    resetAllLists(d->shadowHash);
-    resetAllLists(d->shinyHash);
-    resetList(*d->skyMaskList);
+    deleteAll(d->lists);
+    d->lists.clear();
+    for (int i = 0; i < NUM_GEOM_GROUPS; ++i)
+    {
+        d->groupLists[i].clear();
+        d->freeBlendedLists[i].clear();
+    }
+    d->ids.clear();
+    d->blendedIds.clear();
+    d->createSkyMaskList();
+    d->invalidateCachedIds();
 }
 
-/**
- * Specialized texture unit comparision function that ignores properties which
- * are applied per-primitive and which should not result in list separation.
- *
- * (These properties are written to the primitive header and applied dynamically
- * when reading back the draw list.)
- */
-static bool compareTexUnit(const GLTextureUnit &lhs, const GLTextureUnit &rhs)
+void DrawLists::reset()
 {
-    if(lhs.texture)
+    for (DrawList *list : d->lists)
     {
-        if(lhs.texture != rhs.texture) return false;
+        list->rewind();
     }
-    else
+
+    // The blended lists will be reassigned.
+    for (const auto &blended : d->blendedIds)
     {
-        if(lhs.unmanaged != rhs.unmanaged) return false;
+        d->freeBlendedLists[blended.first.group] << blended.second;
     }
-    if(!de::fequal(lhs.opacity, rhs.opacity)) return false;
-    // Other properties are applied per-primitive and should not affect the outcome.
-    return true;
+    d->blendedIds.clear();
+    d->invalidateCachedIds();
 }
 
-DrawList &DrawLists::find(const DrawListSpec &spec)
+DrawLists::Id DrawLists::intern(const DrawListSpec &spec)
 {
-    // Sky masked geometry is never textured; therefore no draw list hash.
-    /// @todo Make hash management dynamic. -ds
-    if(spec.group == SkyMaskGeom)
+    // Sky masked geometry is never textured; there is only one list.
+    if (spec.group == SkyMaskGeom)
     {
-        return *d->skyMaskList;
+        return SkyMaskList;
     }
 
-    DrawList *convertable = 0;
+    const bool blended = spec.unit(TU_INTER).hasTexture();
+    DrawListIds &ids = (blended? d->blendedIds : d->ids);
 
-    // Find/create a list in the hash.
-    const GLuint key  = spec.unit(TU_PRIMARY).getTextureGLName();
-    DrawListHash &hash = d->listHash(spec.group);
-    const auto    keys = hash.equal_range(key);
-    for (auto it = keys.first; it != keys.second; ++it)
+    const SpecKey key(spec, blended);
+    auto found = ids.find(key);
+    if (found != ids.end())
     {
-        DrawList *          list     = it->second;
-        const DrawListSpec &listSpec = list->spec();
-
-        if ((spec.group == ShineGeom &&
-             compareTexUnit(listSpec.unit(TU_PRIMARY), spec.unit(TU_PRIMARY))) ||
-            (spec.group != ShineGeom &&
-             compareTexUnit(listSpec.unit(TU_PRIMARY), spec.unit(TU_PRIMARY)) &&
-             compareTexUnit(listSpec.unit(TU_PRIMARY_DETAIL), spec.unit(TU_PRIMARY_DETAIL))))
-        {
-            if (!listSpec.unit(TU_INTER).hasTexture() && !spec.unit(TU_INTER).hasTexture())
-            {
-                // This will do great.
-                return *list;
-            }
-
-            // Is this eligible for conversion to a blended list?
-            if (list->isEmpty() && !convertable && spec.unit(TU_INTER).hasTexture())
-            {
-                // If necessary, this empty list will be selected.
-                convertable = list;
-            }
-
-            // Possibly an exact match?
-            if ((spec.group == ShineGeom &&
-                 compareTexUnit(listSpec.unit(TU_INTER), spec.unit(TU_INTER))) ||
-                (spec.group != ShineGeom &&
-                 compareTexUnit(listSpec.unit(TU_INTER), spec.unit(TU_INTER)) &&
-                 compareTexUnit(listSpec.unit(TU_INTER_DETAIL), spec.unit(TU_INTER_DETAIL))))
-            {
-                return *list;
-            }
-        }
+        return found->second;
     }
+    const Id id = (blended? d->blendedList(spec) : d->newList(spec));
+    ids.insert(key, id);
+    return id;
+}
 
-    // Did we find a convertable list?
-    if(convertable)
+DrawLists::Id DrawLists::intern(const DrawListSpec &spec, CachedId &cached)
+{
+    if (cached.generation != d->generation)
     {
-        // This list is currently empty.
-        if(spec.group == ShineGeom)
-        {
-            convertable->spec().unit(TU_INTER) = spec.unit(TU_INTER);
-        }
-        else
-        {
-            convertable->spec().unit(TU_INTER) = spec.unit(TU_INTER);
-            convertable->spec().unit(TU_INTER_DETAIL) = spec.unit(TU_INTER_DETAIL);
-        }
-
-        return *convertable;
+        cached.id         = intern(spec);
+        cached.generation = d->generation;
     }
+    return cached.id;
+}
+
+DrawList &DrawLists::list(Id id)
+{
+    DE_ASSERT(id < d->lists.size());
+    return *d->lists[id];
+}
 
-    // Create a new list.
-    return *hash.insert(std::make_pair(key, new DrawList(spec)))->second;
+DrawList &DrawLists::find(const DrawListSpec &spec)
+{
+    return list(intern(spec));
 }
 
 int DrawLists::findAll(GeomGroup group, FoundLists &found)
 {
     found.clear();
-    if(group == SkyMaskGeom)
+    for (const Id id : d->groupLists[group])
     {
-        if(!d->skyMaskList->isEmpty())
+        DrawList *list = d->lists[id];
+        if (!list->isEmpty())
         {
-            found << d->skyMaskList.get();
-        }
-    }
-    else
-    {
-        const DrawListHash &hash = d->listHash(group);
-        for (const auto &list : hash)
-        {
-            if (!list.second->isEmpty())
-            {
-                found << list.second;
-            }
+            found << list;
         }
     }
     return found.count();
@@ -0,0 +1,150 @@
+/** @file particlesorter.cpp  Back-to-front ordering of particles.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/particlesorter.h"
+
+#include <de/math.h>
+#include <algorithm>
+
+using namespace de;
+
+/// Fixing up the previous order is abandoned (in favor of a full sort) if it needs
+/// more moves than this per particle.
+static const dsize PARTICLESORTER_MAX_MOVES = 4;
+
+ParticleSorter::ParticleSorter() : _lastMethod(RadixSort)
+{}
+
+void ParticleSorter::clear()
+{
+    _ids.clear();
+    _keys.clear();
+    _order.clear();
+}
+
+void ParticleSorter::add(duint64 id, float distance)
+{
+    // Nearer particles get larger keys, so ascending key order is back to front.
+    const ddouble quantized = de::clamp(0.0, ddouble(distance) * QUANTIZATION, ddouble(0xffffffffu));
+    _ids  << id;
+    _keys << (0xffffffffu - duint32(quantized));
+}
+
+int ParticleSorter::count() const
+{
+    return _keys.sizei();
+}
+
+const List<duint32> &ParticleSorter::sort()
+{
+    if (sortIncrementally())
+    {
+        _lastMethod = IncrementalSort;
+    }
+    else
+    {
+        radixSort();
+        _lastMethod = RadixSort;
+    }
+
+    // Remember the order for the next frame (reusing the buffers).
+    _previousIds   = _ids;
+    _previousOrder = _order;
+    return _order;
+}
+
+ParticleSorter::Method ParticleSorter::lastMethod() const
+{
+    return _lastMethod;
+}
+
+bool ParticleSorter::sortIncrementally()
+{
+    // Only applicable if the same particles are being sorted again.
+    if (_ids.isEmpty() || _ids != _previousIds) return false;
+
+    _order = _previousOrder;
+
+    // Insertion sort, starting from the previous order.
+    const dsize    count    = _order.size();
+    const dsize    maxMoves = count * PARTICLESORTER_MAX_MOVES;
+    const duint32 *keys     = _keys.data();
+    duint32 *      order    = _order.data();
+    dsize          moves    = 0;
+    for (dsize i = 1; i < count; ++i)
+    {
+        const duint32 index = order[i];
+        const duint32 key   = keys[index];
+        dsize j = i;
+        for (; j > 0 && keys[order[j - 1]] > key; --j)
+        {
+            if (++moves > maxMoves) return false; // Too much has changed.
+            order[j] = order[j - 1];
+        }
+        order[j] = index;
+    }
+    return true;
+}
+
+void ParticleSorter::radixSort()
+{
+    const dsize count = _keys.size();
+    _order.resize(count);
+    _scratch.resize(count);
+    for (dsize i = 0; i < count; ++i)
+    {
+        _order[i] = duint32(i);
+    }
+    if (count < 2) return;
+
+    const duint32 *keys = _keys.data();
+    duint32 *src = _order.data();
+    duint32 *dst = _scratch.data();
+
+    // Least significant digit first; each pass is stable.
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        dsize offsets[256] = {};
+        for (dsize i = 0; i < count; ++i)
+        {
+            offsets[(keys[src[i]] >> shift) & 0xff]++;
+        }
+
+        // Nothing to do if all keys have the same digit.
+        if (offsets[(keys[src[0]] >> shift) & 0xff] == count) continue;
+
+        dsize total = 0;
+        for (dsize &offset : offsets)
+        {
+            const dsize digitCount = offset;
+            offset = total;
+            total += digitCount;
+        }
+        for (dsize i = 0; i < count; ++i)
+        {
+            dst[offsets[(keys[src[i]] >> shift) & 0xff]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != _order.data())
+    {
+        std::copy(src, src + count, _order.data());
+    }
+}
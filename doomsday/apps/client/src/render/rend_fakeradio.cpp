@@ -749,11 +749,15 @@ static void drawWallShadow(const Vec3f *posCoords, const WallEdge &leftEdge, con
     // Uniform color - shadows are black.
     Vec4ub const shadowColor(0, 0, 0, 255 * de::clamp(0.f, shadowDark, 1.0f));
 
+    // Each shadow texture has its own list.
+    static DrawLists::CachedId shadowLists[NUM_LIGHTING_TEXTURES];
+
     DrawListSpec listSpec;
     listSpec.group = ShadowGeom;
     listSpec.texunits[TU_PRIMARY] =
         GLTextureUnit(GL_PrepareLSTexture(tp.texture), gfx::ClampToEdge, gfx::ClampToEdge);
-    DrawList &shadowList = ClientApp::render().drawLists().find(listSpec);
+    DrawLists &drawLists = ClientApp::render().drawLists();
+    DrawList &shadowList = drawLists.list(drawLists.intern(listSpec, shadowLists[tp.texture]));
 
     static DrawList::Indices indices;
     if (indices.size() < 64) indices.resize(64);
@@ -1033,13 +1037,15 @@ void Rend_DrawFlatRadio(const ConvexSubspace &subspace)
     const auto eyeToSubspace = Vec2f(Rend_EyeOrigin().xz() - subspace.poly().center());
 
     // All shadow geometry uses the same texture (i.e., none) - use the same list.
-    DrawList &shadowList = ClientApp::render().drawLists().find(
 #if defined (DE_OPENGL)
-        DrawListSpec(renderWireframe? UnlitGeom : ShadowGeom)
+    const GeomGroup shadowGroup = (renderWireframe? UnlitGeom : ShadowGeom);
 #else
-        DrawListSpec(ShadowGeom)
+    const GeomGroup shadowGroup = ShadowGeom;
 #endif
-    );
+    static DrawLists::CachedId shadowLists[2];  // Unlit (wireframe) or shadow.
+    DrawLists &drawLists = ClientApp::render().drawLists();
+    DrawList &shadowList = drawLists.list(
+        drawLists.intern(DrawListSpec(shadowGroup), shadowLists[shadowGroup == ShadowGeom]));
 
     // Process all LineSides linked to this subspace as potential shadow casters.
     subspace.forAllShadowLines([&subsec, &shadowDark, &eyeToSubspace, &shadowList] (LineSide &side)
@@ -96,8 +96,10 @@
 #include <de/legacy/timer.h>
 #include <de/legacy/texgamma.h>
 #include <de/legacy/vector1.h>
+#include <de/folder.h>
 #include <de/glinfo.h>
 #include <de/glstate.h>
+#include <de/writer.h>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -154,6 +156,7 @@ D_CMD(LowRes);
 D_CMD(MipMap);
 D_CMD(TexReset);
 D_CMD(CubeShot);
+D_CMD(DumpFrameGeometry);
 
 FogParams fogParams;
 float fieldOfView = 95.0f;
@@ -320,6 +323,8 @@ static ConvexSubspace *curSubspace;   ///< Subspace currently being drawn.
 static Vec3f curSectorLightColor;
 static float curSectorLightLevel;
 static bool firstSubspace;            ///< No range checking for the first one.
+static List<ConvexSubspace *> visibleSubspaces; ///< Front to back, found in the visibility pass.
+static String dumpFrameGeometryPath;  ///< Write the geometry of the next frame here (if set).
 
 using MaterialAnimatorLookup = Hash<const Record *, MaterialAnimator *>;
 
@@ -1383,6 +1388,47 @@ struct rendworldpoly_params_t
     } wall;
 };
 
+/**
+ * Returns the draw list for geometry in @a group with a single clamped texture (e.g.,
+ * a projected light). Only a few such textures are used at a time, so the handles of
+ * the recently used lists are kept instead of interning the specification each time.
+ */
+static DrawList &projectedTextureList(GeomGroup group, DGLuint glName)
+{
+    struct CachedList
+    {
+        GeomGroup           group  = UnlitGeom;
+        DGLuint             glName = 0;
+        DrawLists::CachedId id;
+    };
+    static CachedList cached[8];
+    static int        nextCached = 0;
+
+    CachedList *found = nullptr;
+    for (auto &list : cached)
+    {
+        if (list.group == group && list.glName == glName)
+        {
+            found = &list;
+            break;
+        }
+    }
+    if (!found)
+    {
+        found = &cached[nextCached];
+        nextCached = (nextCached + 1) % int(sizeof(cached) / sizeof(cached[0]));
+        *found = CachedList();
+        found->group  = group;
+        found->glName = glName;
+    }
+
+    DrawListSpec listSpec(group);
+    listSpec.texunits[TU_PRIMARY] = GLTextureUnit(glName, gfx::ClampToEdge, gfx::ClampToEdge);
+
+    DrawLists &drawLists = ClientApp::render().drawLists();
+    return drawLists.list(drawLists.intern(listSpec, found->id));
+}
+
 static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
     const rendworldpoly_params_t &p, MaterialAnimator &matAnimator)
 {
@@ -1521,11 +1567,7 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
             if (!(skipFirst && numProcessed == 0))
             {
                 // Light texture determines the list to write to.
-                DrawListSpec listSpec;
-                listSpec.group = LightGeom;
-                listSpec.texunits[TU_PRIMARY] =
-                    GLTextureUnit(tp.texture, gfx::ClampToEdge, gfx::ClampToEdge);
-                DrawList &lightList = ClientApp::render().drawLists().find(listSpec);
+                DrawList &lightList = projectedTextureList(LightGeom, tp.texture);
 
                 // Make geometry.
                 Geometry verts;
@@ -1612,11 +1654,7 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
     {
         // Write projected shadows.
         // All shadows use the same texture (so use the same list).
-        DrawListSpec listSpec;
-        listSpec.group                = ShadowGeom;
-        listSpec.texunits[TU_PRIMARY] = GLTextureUnit(
-            GL_PrepareLSTexture(LST_DYNAMIC), gfx::ClampToEdge, gfx::ClampToEdge);
-        DrawList &shadowList = ClientApp::render().drawLists().find(listSpec);
+        DrawList &shadowList = projectedTextureList(ShadowGeom, GL_PrepareLSTexture(LST_DYNAMIC));
 
         ClientApp::render().forAllSurfaceProjections(p.shadowListIdx,
                                            [&p, &mustSubdivide, &rvertices, &numVertices, &shadowList]
@@ -1737,7 +1775,7 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
 
         if (p.skyMasked)
         {
-            DrawList &skyMaskList = ClientApp::render().drawLists().find(DrawListSpec(SkyMaskGeom));
+            DrawList &skyMaskList = ClientApp::render().drawLists().list(DrawLists::SkyMaskList);
 
             Store &buffer = ClientApp::render().buffer();
             {
@@ -1806,7 +1844,10 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
                     listSpec.texunits[TU_INTER_DETAIL].offset += *p.materialOrigin;
                 }
             }
-            DrawList &drawList = ClientApp::render().drawLists().find(listSpec);
+            DrawList &drawList = ClientApp::render().drawLists().list(
+                ClientApp::render().drawLists().intern(listSpec, matAnimator.drawList(
+                    listSpec.group == LitGeom? MaterialAnimator::LitDrawList
+                                             : MaterialAnimator::UnlitDrawList)));
             // Is the geometry lit?
             Flags primFlags;
             //bool oneLight   = false;
@@ -1915,7 +1956,7 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
                 buffer.posCoords[indices[i]] = verts.pos[i];
             }
             ClientApp::render()
-                .drawLists().find(DrawListSpec(SkyMaskGeom))
+                .drawLists().list(DrawLists::SkyMaskList)
                     .write(buffer, indices.data(), numVerts, p.isWall?  gfx::TriangleStrip :  gfx::TriangleFan);
         }
         else
@@ -2007,8 +2048,10 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
                     buffer.modCoords[indices[i]] = modTexCoords[i];
                 }
             }
-            ClientApp::render()
-                .drawLists().find(listSpec)
+            DrawLists &drawLists = ClientApp::render().drawLists();
+            drawLists.list(drawLists.intern(listSpec, matAnimator.drawList(
+                listSpec.group == LitGeom? MaterialAnimator::LitDrawList
+                                         : MaterialAnimator::UnlitDrawList)))
                     .write(buffer, indices.data(), numVertices,
                            Parm(p.isWall?  gfx::TriangleStrip  :  gfx::TriangleFan,
                                 listSpec.unit(TU_PRIMARY       ).scale,
@@ -2063,7 +2106,9 @@ static bool renderWorldPoly(const Vec3f *rvertices, uint32_t numVertices,
                 listSpec.texunits[TU_INTER].offset *= *p.materialScale;
             }
         }
-        DrawList &shineList = ClientApp::render().drawLists().find(listSpec);
+        DrawList &shineList = ClientApp::render().drawLists().list(
+            ClientApp::render().drawLists().intern(
+                listSpec, matAnimator.drawList(MaterialAnimator::ShineDrawList)));
 
         Parm shineParams(gfx::TriangleFan,
                          listSpec.unit(TU_INTER).scale,
@@ -2688,15 +2733,10 @@ static void wallLuminosityDeltas(const WallEdge &leftEdge, const WallEdge &right
     }
 }
 
-static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
-    bool *retWroteOpaque = nullptr, coord_t *retBottomZ = nullptr, coord_t *retTopZ = nullptr)
+static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge)
 {
     DE_ASSERT(leftEdge.lineSideSegment().isFrontFacing() && leftEdge.lineSide().hasSections());
 
-    if (retWroteOpaque) *retWroteOpaque = false;
-    if (retBottomZ)     *retBottomZ     = 0;
-    if (retTopZ)        *retTopZ        = 0;
-
     auto &subsec = curSubspace->subsector().as<Subsector>();
     Surface &surface = leftEdge.lineSide().surface(leftEdge.spec().section).as<Surface>();
 
@@ -2716,7 +2756,7 @@ static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
         return;
 
     const WallSpec &wallSpec      = leftEdge.spec();
-    const bool didNearFade        = applyNearFadeOpacity(leftEdge, rightEdge, opacity);
+    applyNearFadeOpacity(leftEdge, rightEdge, opacity);
     const bool skyMasked          = material->isSkyMasked() && !::devRendSkyMode;
     const bool twoSidedMiddle     = (wallSpec.section == LineSide::Middle && !leftEdge.lineSide().considerOneSided());
 
@@ -2817,10 +2857,49 @@ static void writeWall(const WallEdge &leftEdge, const WallEdge &rightEdge,
         curSectorLightColor = color.toVec3f();
         curSectorLightLevel = color.w;
     }
+}
+
+/**
+ * Determines whether a wall section would be drawn opaque by writeWall(), without
+ * writing any geometry. This must agree with writeWall() and renderWorldPoly().
+ */
+static bool isOpaqueWallSection(const WallEdge &leftEdge, const WallEdge &rightEdge)
+{
+    Surface &surface = leftEdge.lineSide().surface(leftEdge.spec().section).as<Surface>();
+
+    float opacity = surface.opacity();
+    if (opacity < .001f)
+        return false;
+
+    ClientMaterial *material = Rend_ChooseMapSurfaceMaterial(surface);
+    if (!material || !material->isDrawable())
+        return false;
+
+    if (!leftEdge.isValid() || !rightEdge.isValid()
+        || de::fequal(leftEdge.bottom().z(), rightEdge.top().z()))
+        return false;
+
+    // Sections faded near the viewer must not occlude (see applyNearFadeOpacity()).
+    if (applyNearFadeOpacity(leftEdge, rightEdge, opacity))
+        return false;
+
+    const WallSpec &wallSpec = leftEdge.spec();
+    if (wallSpec.flags.testFlag(WallSpec::ForceOpaque))
+        return true;
+
+    if (material->isSkyMasked() && !::devRendSkyMode)
+        return true;
+
+    blendmode_t blendMode = BM_NORMAL;
+    if (wallSpec.section == LineSide::Middle && !leftEdge.lineSide().considerOneSided())
+    {
+        blendMode = surface.blendMode();
+        if (blendMode == BM_NORMAL && noSpriteTrans)
+            blendMode = BM_ZEROALPHA;  // "no translucency" mode
+    }
 
-    if (retWroteOpaque) *retWroteOpaque = wroteOpaque && !didNearFade;
-    if (retBottomZ)     *retBottomZ     = leftEdge .bottom().z();
-    if (retTopZ)        *retTopZ        = rightEdge.top   ().z();
+    const MaterialAnimator &matAnimator = material->getAnimator(Rend_MapSurfaceMaterialSpec());
+    return !(opacity < 1 || !matAnimator.isOpaque() || blendMode > 0);
 }
 
 /**
@@ -3025,15 +3104,18 @@ static void writeSkyMaskStrip(int vertCount, const Vec3f *posCoords, const Vec2f
             indices[i] = base + i;
             buffer.posCoords[indices[i]] = posCoords[i];
         }
-        ClientApp::render().drawLists().find(DrawListSpec(SkyMaskGeom))
+        ClientApp::render().drawLists().list(DrawLists::SkyMaskList)
                       .write(buffer, indices.data(), vertCount, gfx::TriangleStrip);
     }
     else
     {
         DE_ASSERT(texCoords);
 
+        static DrawLists::CachedId untexturedList;
+
         DrawListSpec listSpec;
         listSpec.group = UnlitGeom;
+        DrawLists::CachedId *cachedList = &untexturedList;
         if (renderTextures != 2)
         {
             DE_ASSERT(material);
@@ -3047,6 +3129,7 @@ static void writeSkyMaskStrip(int vertCount, const Vec3f *posCoords, const Vec2f
             listSpec.texunits[TU_PRIMARY_DETAIL] = matAnimator.texUnit(MaterialAnimator::TU_DETAIL);
             listSpec.texunits[TU_INTER]          = matAnimator.texUnit(MaterialAnimator::TU_LAYER0_INTER);
             listSpec.texunits[TU_INTER_DETAIL]   = matAnimator.texUnit(MaterialAnimator::TU_DETAIL_INTER);
+            cachedList = &matAnimator.drawList(MaterialAnimator::SkyStripDrawList);
         }
 
         Store &buffer = ClientApp::render().buffer();
@@ -3060,7 +3143,8 @@ static void writeSkyMaskStrip(int vertCount, const Vec3f *posCoords, const Vec2f
             buffer.colorCoords [indices[i]] = Vec4ub(255, 255, 255, 255);
         }
 
-        ClientApp::render().drawLists().find(listSpec)
+        DrawLists &drawLists = ClientApp::render().drawLists();
+        drawLists.list(drawLists.intern(listSpec, *cachedList))
                       .write(buffer, indices.data(), vertCount,
                              DrawList::PrimitiveParams(gfx::TriangleStrip,
                                                        listSpec.unit(TU_PRIMARY       ).scale,
@@ -3256,7 +3340,7 @@ static void writeSubspaceSkyMask(int skyCap = SKYCAP_LOWER | SKYCAP_UPPER)
     auto &subsec = curSubspace->subsector().as<Subsector>();
     Map &map = subsec.sector().map().as<Map>();
 
-    DrawList &dlist = ClientApp::render().drawLists().find(DrawListSpec(SkyMaskGeom));
+    DrawList &dlist = ClientApp::render().drawLists().list(DrawLists::SkyMaskList);
     static DrawList::Indices indices;
 
     // Lower?
@@ -3415,39 +3499,87 @@ static void writeAllWalls(mesh::HEdge &hedge)
     // Done here because of the logic of doom.exe wrt the automap.
     reportWallDrawn(seg.line());
 
-    bool wroteOpaqueMiddle = false;
-    coord_t middleBottomZ  = 0;
-    coord_t middleTopZ     = 0;
-
     writeWall(WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Bottom), hedge, Line::From),
               WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Bottom), hedge, Line::To  ));
     writeWall(WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Top),    hedge, Line::From),
               WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Top),    hedge, Line::To  ));
     writeWall(WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::From),
-              WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::To  ),
-              &wroteOpaqueMiddle, &middleBottomZ, &middleTopZ);
+              WallEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::To  ));
+}
+
+/**
+ * Range-occludes the wall of @a hedge in the angle clipper, if the wall sections
+ * (as they will be written later) cover the open range.
+ */
+static void occludeWalls(mesh::HEdge &hedge)
+{
+    // Edges without a map line segment implicitly have no surfaces.
+    if (!hedge.hasMapElement())
+        return;
+
+    auto &seg = hedge.mapElementAs<LineSideSegment>();
+    if (!seg.isFrontFacing() || !seg.lineSide().hasSections())
+        return;
+
+    // Nothing is occluded when the viewer is in the void.
+    if (P_IsInVoid(viewPlayer))
+        return;
+
+    const WallEdge leftEdge (WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::From);
+    const WallEdge rightEdge(WallSpec::fromMapSide(seg.lineSide().as<LineSide>(), LineSide::Middle), hedge, Line::To  );
+
+    const bool opaqueMiddle = isOpaqueWallSection(leftEdge, rightEdge);
+    const coord_t middleBottomZ = opaqueMiddle? leftEdge .bottom().z() : 0;
+    const coord_t middleTopZ    = opaqueMiddle? rightEdge.top   ().z() : 0;
 
     // We can occlude the angle range defined by the X|Y origins of the
-    // line segment if the open range has been covered (when the viewer
-    // is not in the void).
-    if (!P_IsInVoid(viewPlayer) && coveredOpenRange(hedge, middleBottomZ, middleTopZ, wroteOpaqueMiddle))
+    // line segment if the open range has been covered.
+    if (!coveredOpenRange(hedge, middleBottomZ, middleTopZ, opaqueMiddle))
+        return;
+
+    // IssueID #2306: Black segments appear in the sky due to polyobj walls being marked
+    // as occluding angle ranges. As a workaround, don't consider these walls occluding.
+    if (seg.line().definesPolyobj())
     {
-        if (hedge.hasMapElement())
+        const Polyobj &poly = seg.line().polyobj();
+        if (poly.sector().ceiling().surface().hasSkyMaskedMaterial())
         {
-            // IssueID #2306: Black segments appear in the sky due to polyobj walls being marked
-            // as occluding angle ranges. As a workaround, don't consider these walls occluding.
-            if (hedge.mapElementAs<LineSideSegment>().line().definesPolyobj())
-            {
-                const Polyobj &poly = hedge.mapElementAs<LineSideSegment>().line().polyobj();
-                if (poly.sector().ceiling().surface().hasSkyMaskedMaterial())
-                {
-                    return;
-                }
-            }
+            return;
         }
-        ClientApp::render().angleClipper()
-            .addRangeFromViewRelPoints(hedge.origin(), hedge.twin().origin());
     }
+
+    ClientApp::render().angleClipper()
+        .addRangeFromViewRelPoints(hedge.origin(), hedge.twin().origin());
+}
+
+static void occludeSubspaceWalls()
+{
+    DE_ASSERT(::curSubspace);
+    auto *base  = ::curSubspace->poly().hedge();
+    DE_ASSERT(base);
+    auto *hedge = base;
+    do
+    {
+        occludeWalls(*hedge);
+    } while ((hedge = &hedge->next()) != base);
+
+    ::curSubspace->forAllExtraMeshes([] (mesh::Mesh &mesh)
+    {
+        for (auto *hedge : mesh.hedges())
+        {
+            occludeWalls(*hedge);
+        }
+        return LoopContinue;
+    });
+
+    ::curSubspace->forAllPolyobjs([] (Polyobj &pob)
+    {
+        for (auto *hedge : pob.mesh().hedges())
+        {
+            occludeWalls(*hedge);
+        }
+        return LoopContinue;
+    });
 }
 
 static void writeSubspaceWalls()
@@ -3741,9 +3873,13 @@ static void projectSubspaceSprites()
 }
 
 /**
+ * Visibility pass for the current subspace: marks what is visible, projects the
+ * sprites, and occludes the angle ranges covered by the walls. No world geometry
+ * is written; that is done afterwards in emitCurrentSubspace().
+ *
  * @pre Assumes the subspace is at least partially visible.
  */
-static void drawCurrentSubspace()
+static void prepareCurrentSubspace()
 {
     DE_ASSERT(curSubspace);
 
@@ -3757,8 +3893,6 @@ static void drawCurrentSubspace()
     // Perform contact spreading for this map region.
     sector.map().as<Map>().spreadAllContacts(::curSubspace->poly().bounds());
 
-    Rend_DrawFlatRadio(*::curSubspace);
-
     // Before clip testing lumobjs (for halos), range-occlude the back facing edges.
     // After testing, range-occlude the front facing edges. Done before drawing wall
     // sections so that opening occlusions cut out unnecessary oranges.
@@ -3790,6 +3924,23 @@ static void drawCurrentSubspace()
     // of halos.
     projectSubspaceSprites();
 
+    // The walls of this subspace hide whatever is behind them.
+    occludeSubspaceWalls();
+}
+
+/**
+ * Emission pass for the current subspace: writes the world geometry to the draw
+ * lists. Depends only on the state determined in the visibility pass.
+ *
+ * @note Emission is done on the main thread. Material preparation may upload
+ * textures, and the shared Store and the draw lists are not thread-safe.
+ */
+static void emitCurrentSubspace()
+{
+    DE_ASSERT(curSubspace);
+
+    Rend_DrawFlatRadio(*::curSubspace);
+
     writeSubspaceSkyMask();
     writeSubspaceWalls();
     writeSubspaceFlats();
@@ -3816,7 +3967,7 @@ static void makeCurrent(ConvexSubspace &subspace)
     }
 }
 
-static void traverseBspTreeAndDrawSubspaces(const world::BspTree *bspTree)
+static void traverseBspTreeAndFindVisibleSubspaces(const world::BspTree *bspTree)
 {
     DE_ASSERT(bspTree);
     const AngleClipper &clipper = ClientApp::render().angleClipper();
@@ -3829,7 +3980,7 @@ static void traverseBspTreeAndDrawSubspaces(const world::BspTree *bspTree)
         const int eyeSide  = bspNode.pointOnSide(eyeOrigin) < 0;
 
         // Recursively divide front space.
-        traverseBspTreeAndDrawSubspaces(bspTree->childPtr(world::BspTree::ChildId(eyeSide)));
+        traverseBspTreeAndFindVisibleSubspaces(bspTree->childPtr(world::BspTree::ChildId(eyeSide)));
 
         // If the clipper is full we're pretty much done. This means no geometry
         // will be visible in the distance because every direction has already
@@ -3859,13 +4010,82 @@ static void traverseBspTreeAndDrawSubspaces(const world::BspTree *bspTree)
         // This is now the current subspace.
         makeCurrent(subspace->as<ConvexSubspace>());
 
-        drawCurrentSubspace();
+        prepareCurrentSubspace();
+        ::visibleSubspaces << &subspace->as<ConvexSubspace>();
 
         // This is no longer the first subspace.
         ::firstSubspace = false;
     }
 }
 
+/**
+ * Writes the geometry of all the subspaces found visible, in front to back order.
+ *
+ * @todo Emit the subspaces in parallel. Material preparation (and the texture
+ * uploads it may cause) needs to move into the visibility pass, the current
+ * subspace and light state must be per worker, and each worker needs its own Store
+ * whose contents are merged into the draw lists in subspace order. The output
+ * must be compared with the single-threaded emission (e.g., "dumpframegeometry").
+ */
+static void emitVisibleSubspaces()
+{
+    // Begin again with the draw state of the first subspace.
+    ::curSubspace = nullptr;
+
+    for (ConvexSubspace *subspace : ::visibleSubspaces)
+    {
+        makeCurrent(*subspace);
+        emitCurrentSubspace();
+    }
+}
+
+/**
+ * Writes the world geometry of the current frame (in the order it was emitted) to
+ * a text file, for comparing the output of the renderer between builds.
+ */
+static void writeFrameGeometry(const Path &filePath)
+{
+    const Store &buffer = ClientApp::render().buffer();
+    try
+    {
+        File &file = App::rootFolder().replaceFile(filePath);
+        de::Writer out(file);
+
+        const viewdata_t *viewData = &viewPlayer->viewport();
+        out.writeText(Stringf("# Eye origin: %.3f %.3f %.3f angle: %x pitch: %.3f\n",
+                              eyeOrigin.x, eyeOrigin.y, eyeOrigin.z,
+                              viewData->current.angle(), viewData->current.pitch));
+
+        out.writeText(Stringf("subspaces %i\n", ::visibleSubspaces.sizei()));
+        for (const ConvexSubspace *subspace : ::visibleSubspaces)
+        {
+            out.writeText(Stringf("%i\n", subspace->indexInMap()));
+        }
+
+        out.writeText(Stringf("vertices %u\n", buffer.vertCount()));
+        for (duint i = 0; i < buffer.vertCount(); ++i)
+        {
+            const Vec3f &pos   = buffer.posCoords[i];
+            const Vec4ub &color = buffer.colorCoords[i];
+            const Vec2f &tex   = buffer.texCoords[0][i];
+            out.writeText(Stringf("%.3f %.3f %.3f %u %u %u %u %.4f %.4f\n",
+                                  pos.x, pos.y, pos.z,
+                                  color.x, color.y, color.z, color.w,
+                                  tex.x, tex.y));
+        }
+        file.flush();
+
+        LOG_GL_MSG("Frame geometry (%i subspaces, %u vertices) saved to \"%s\"")
+                << ::visibleSubspaces.sizei() << buffer.vertCount()
+                << file.correspondingNativePath();
+    }
+    catch (const Error &er)
+    {
+        LOG_GL_WARNING("Failed to write frame geometry to \"%s\": %s")
+                << filePath << er.asText();
+    }
+}
+
 /**
  * Project all the non-clipped decorations. They become regular vissprites.
  */
@@ -4811,8 +5031,16 @@ void Rend_RenderMap(Map &map)
         // No current subspace as of yet.
         curSubspace = nullptr;
 
-        // Draw the world!
-        traverseBspTreeAndDrawSubspaces(&map.bspTree());
+        // Find out what is visible, then draw the world!
+        visibleSubspaces.clear();
+        traverseBspTreeAndFindVisibleSubspaces(&map.bspTree());
+        emitVisibleSubspaces();
+
+        if (dumpFrameGeometryPath)
+        {
+            writeFrameGeometry(dumpFrameGeometryPath);
+            dumpFrameGeometryPath.clear();
+        }
     }
     drawAllLists(map);
 
@@ -6164,6 +6392,22 @@ D_CMD(OpenModelAssetEditor)
     return true;
 }
 
+D_CMD(DumpFrameGeometry)
+{
+    DE_UNUSED(src, argc);
+
+    if (!ClientApp::world().hasMap())
+    {
+        LOG_SCR_ERROR("No map is currently loaded");
+        return false;
+    }
+
+    // The geometry is written when the next frame has been drawn. Relative paths
+    // are in the user's runtime folder.
+    dumpFrameGeometryPath = String("/home") / argv[1];
+    return true;
+}
+
 D_CMD(LowRes)
 {
     DE_UNUSED(src, argv, argc);
@@ -6362,6 +6606,7 @@ void Rend_Register()
     C_CMD("rendedit", "", OpenRendererAppearanceEditor);
     C_CMD("modeledit", "", OpenModelAssetEditor);
     C_CMD("cubeshot", "i", CubeShot);
+    C_CMD_FLAGS("dumpframegeometry", "s", DumpFrameGeometry, CMDF_NO_DEDICATED);
 
     C_CMD_FLAGS("lowres", "", LowRes, CMDF_NO_DEDICATED);
     C_CMD_FLAGS("mipmap", "i", MipMap, CMDF_NO_DEDICATED);
@@ -50,6 +50,7 @@
 #include <de/legacy/binangle.h>
 #include <de/legacy/memory.h>
 #include <de/legacy/concurrency.h>
+#include <de/modelkernels.h>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
@@ -465,8 +466,19 @@ static void drawPrimitives(rendcmd_t mode,
     DGL_End();
 }
 
+static_assert(sizeof(FrameModelFrame::Vertex) == sizeof(modelkernels::KeyFrameVertex),
+              "FrameModel vertices must match the kernel vertex layout");
+
+static inline const modelkernels::KeyFrameVertex *keyFrameVertices(const FrameModelFrame &frame)
+{
+    return reinterpret_cast<const modelkernels::KeyFrameVertex *>(frame.vertices.data());
+}
+
 /**
  * Interpolate linearly between two sets of vertices.
+ *
+ * All vertices are processed regardless of the active LOD; the unused ones are
+ * simply not referenced by the LOD's primitives.
  */
 static void Mod_LerpVertices(float inter, int count, const FrameModelFrame &from,
     const FrameModelFrame &to, Vec3f *posOut, Vec3f *normOut)
@@ -475,30 +487,14 @@ static void Mod_LerpVertices(float inter, int count, const FrameModelFrame &from
     DE_ASSERT(!activeLod || &activeLod->model == &from.model); // sanity check.
     DE_ASSERT(from.vertices.count() == to.vertices.count()); // sanity check.
 
-    FrameModelFrame::VertexBuf::const_iterator startIt = from.vertices.begin();
-    FrameModelFrame::VertexBuf::const_iterator endIt   = to.vertices.begin();
-
     if (&from == &to || de::fequal(inter, 0))
     {
-        for (int i = 0; i < count; ++i, startIt++, posOut++, normOut++)
-        {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = startIt->pos;
-                *normOut = startIt->norm;
-            }
-        }
+        modelkernels::copyKeyFrame(count, keyFrameVertices(from), posOut, normOut);
     }
     else
     {
-        for (int i = 0; i < count; ++i, startIt++, endIt++, posOut++, normOut++)
-        {
-            if (!activeLod || activeLod->hasVertex(i))
-            {
-                *posOut  = de::lerp(startIt->pos,  endIt->pos,  inter);
-                *normOut = de::lerp(startIt->norm, endIt->norm, inter);
-            }
-        }
+        modelkernels::lerpKeyFrames(inter, count, keyFrameVertices(from), keyFrameVertices(to),
+                                    posOut, normOut);
     }
 }
 
@@ -518,8 +514,6 @@ static void Mod_MirrorCoords(dint count, Vec3f *coords, dint axis)
  * @param yaw     Yaw rotation angle.
  * @param pitch   Pitch rotation angle.
  * @param invert  @c true= flip light normal (for use with inverted models).
- *
- * @todo Construct a rotation matrix once and use it for all lights.
  */
 static Vec3f rotateLightVector(const VectorLightData &vlight, dfloat yaw, dfloat pitch,
     bool invert = false)
@@ -544,47 +538,26 @@ static void Mod_VertexColors(Vec4ub *out, dint count, const Vec3f *normCoords,
     duint lightListIdx, duint maxLights, const Vec4f &ambient, bool invert,
     dfloat rotateYaw, dfloat rotatePitch)
 {
-    Vec4f const saturated(1, 1, 1, 1);
+    static List<modelkernels::DirectionalLight> lights;
+    lights.clear();
 
-    for (dint i = 0; i < count; ++i, out++, normCoords++)
+    // The lights are transformed to model space once for all the vertices.
+    ClientApp::render().forAllVectorLights(lightListIdx, [&maxLights, &invert, &rotateYaw
+                                                  , &rotatePitch] (const VectorLightData &vlight)
     {
-        if (activeLod && !activeLod->hasVertex(i))
-            continue;
-
-        const Vec3f &normal = *normCoords;
-
-        // Accumulate contributions from all affecting lights.
-        dint numProcessed = 0;
-        Vec3f accum[2];  // Begin with total darkness [color, extra].
-        ClientApp::render().forAllVectorLights(lightListIdx, [&maxLights, &invert, &rotateYaw
-                                                      , &rotatePitch, &normal
-                                                      , &accum, &numProcessed] (const VectorLightData &vlight)
-        {
-            numProcessed += 1;
-
-            // We must transform the light vector to model space.
-            Vec3f const lightDirection
-                    = rotateLightVector(vlight, rotateYaw, rotatePitch, invert);
-
-            dfloat strength = lightDirection.dot(normal)
-                            + vlight.offset;  // Shift a bit towards the light.
-
-            // Ability to both light and shade.
-            if (strength > 0) strength *= vlight.lightSide;
-            else             strength *= vlight.darkSide;
-
-            accum[vlight.affectedByAmbient? 0 : 1]
-                += vlight.color * de::clamp(-1.f, strength, 1.f);
-
-            // Time to stop?
-            return (maxLights && duint(numProcessed) == maxLights);
-        });
-
-        // Check for ambient and convert to ubyte.
-        Vec4f color(accum[0].max(ambient) + accum[1], ambient[3]);
-
-        *out = (color.min(saturated) * 255).toVec4ub();
-    }
+        lights << modelkernels::DirectionalLight{
+                      rotateLightVector(vlight, rotateYaw, rotatePitch, invert),
+                      vlight.color,
+                      vlight.offset, // Shift a bit towards the light.
+                      vlight.lightSide,
+                      vlight.darkSide,
+                      vlight.affectedByAmbient};
+
+        // Time to stop?
+        return (maxLights && duint(lights.size()) == maxLights);
+    });
+
+    modelkernels::shadeVertices(count, normCoords, lights.data(), lights.size(), ambient, out);
 }
 
 /**
@@ -38,6 +38,7 @@
 #include "render/viewports.h"
 #include "render/rend_main.h"
 #include "render/rend_model.h"
+#include "render/particlesorter.h"
 #include "render/vissprite.h"
 
 #include "clientapp.h"
@@ -52,6 +53,7 @@
 #include <de/folder.h>
 #include <de/glinfo.h>
 #include <de/imagefile.h>
+#include <de/math.h>
 #include <cstdlib>
 
 using namespace de;
@@ -74,6 +76,9 @@ struct OrderedParticle
 static OrderedParticle *order;
 static size_t orderSize;
 
+static ParticleSorter particleSorter;
+static const List<duint32> *sortedParts; ///< Indices to @ref order, back to front.
+
 static size_t numParts;
 
 /*
@@ -84,11 +89,11 @@ static int maxParticles;           ///< @c 0= Unlimited.
 static int particleNearLimit;
 static float particleDiffuse = 4;
 
-static float pointDist(fixed_t const c[3])
+static float pointDist(const float c[3])
 {
     const viewdata_t *viewData = &viewPlayer->viewport();
-    float dist = ((viewData->current.origin.y - FIX2FLT(c[1])) * -viewData->viewSin)
-                - ((viewData->current.origin.x - FIX2FLT(c[0])) * viewData->viewCos);
+    float dist = ((viewData->current.origin.y - c[1]) * -viewData->viewSin)
+                - ((viewData->current.origin.x - c[0]) * viewData->viewCos);
 
     return de::abs(dist);  // Always return positive.
 }
@@ -247,19 +252,6 @@ void Rend_ParticleReleaseExtraTextures()
     de::zap(ptctexname);
 }
 
-/**
- * Sorts in descending order.
- */
-static int comparePOrder(const void *a, const void *b)
-{
-    const auto &ptA = *(const OrderedParticle *) a;
-    const auto &ptB = *(const OrderedParticle *) b;
-
-    if(ptA.distance > ptB.distance) return -1;
-    if(ptA.distance < ptB.distance) return 1;
-    return 0;  // Highly unlikely (but possible).
-}
-
 /**
  * Allocate more memory for the particle ordering buffer, if necessary.
  */
@@ -288,17 +280,18 @@ static void expandOrderBuffer(size_t max)
 /**
  * Determines whether the given particle is potentially visible for the current viewer.
  */
-static bool particlePVisible(const ParticleInfo &pinfo)
+static bool particlePVisible(const Generator::ParticleLanes &pl, int index)
 {
     // Never if it has already expired.
-    if(pinfo.stage < 0) return false;
+    if(pl.stage[index] < 0) return false;
 
     // Never if the origin lies outside the map.
-    if(!pinfo.bspLeaf || !pinfo.bspLeaf->hasSubspace())
+    const world::BspLeaf *bspLeaf = pl.bspLeaf[index];
+    if(!bspLeaf || !bspLeaf->hasSubspace())
         return false;
 
     // Potentially, if the subspace at the origin is visible.
-    return R_ViewerSubspaceIsVisible(pinfo.bspLeaf->subspace().as<ConvexSubspace>());
+    return R_ViewerSubspaceIsVisible(bspLeaf->subspace().as<ConvexSubspace>());
  }
 
 /**
@@ -328,18 +321,19 @@ static int listVisibleParticles(Map &map)
     // Populate the particle sort buffer and determine what type(s) of
     // particle (model/point/line/etc...) we'll need to draw.
     size_t numVisibleParts = 0;
+    ::particleSorter.clear();
     map.forAllGenerators([&numVisibleParts] (Generator &gen)
     {
         if(!R_ViewerGeneratorIsVisible(gen)) return LoopContinue;  // Skip.
 
+        const Generator::ParticleLanes &pl = gen.particles();
         for(int i = 0; i < gen.count; ++i)
         {
-            const ParticleInfo &pinfo = gen.particleInfo()[i];
-
-            if(!particlePVisible(pinfo)) continue;  // Skip.
+            if(!particlePVisible(pl, i)) continue;  // Skip.
 
             // Skip particles too far from, or near to, the viewer.
-            const float dist = de::max(pointDist(pinfo.origin), 1.f);
+            const float origin[3] = { pl.origin[0][i], pl.origin[1][i], pl.origin[2][i] };
+            const float dist = de::max(pointDist(origin), 1.f);
             if(gen.def->maxDist != 0 && dist > gen.def->maxDist) continue;
             if(dist < float( ::particleNearLimit )) continue;
 
@@ -348,10 +342,11 @@ static int listVisibleParticles(Map &map)
             slot->generator  = &gen;
             slot->particleId = i;
             slot->distance   = dist;
+            ::particleSorter.add((duint64(duint16(gen.id())) << 32) | duint32(i), dist);
 
             // Determine what type of particle this is, as this will affect how
             // we go order our render passes and manipulate the render state.
-            const int psType = gen.stages[pinfo.stage].type;
+            const int psType = gen.stages[pl.stage[i]].type;
             if(psType == PTC_POINT)
             {
                 ::hasPoints = true;
@@ -394,14 +389,15 @@ static int listVisibleParticles(Map &map)
     // This is the real number of possibly visible particles.
     ::numParts = numVisibleParts;
 
-    // Sort the order list back->front. A quicksort is fast enough.
-    qsort(::order, ::numParts, sizeof(OrderedParticle), comparePOrder);
+    // Sort the order list back->front. Usually the same particles are visible as in
+    // the previous frame and their order has hardly changed.
+    ::sortedParts = &::particleSorter.sort();
 
     return true;
 }
 
-static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pinfo,
-    const GeneratorParticleStage *st, const ded_ptcstage_t *dst, const Vec3f &origin,
+static void setupModelParamsForParticle(vissprite_t &spr, const Generator::ParticleLanes &pl,
+    int index, const GeneratorParticleStage *st, const ded_ptcstage_t *dst, const Vec3f &origin,
     float dist, float size, float mark, float alpha)
 {
     drawmodelparams_t &parm = *VS_MODEL(&spr);
@@ -429,20 +425,20 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
     // Set the correct orientation for the particle.
     if(parm.mf->testSubFlag(0, MFF_MOVEMENT_YAW))
     {
-        spr.pose.yaw = R_MovementXYYaw(FIX2FLT(pinfo->mov[0]), FIX2FLT(pinfo->mov[1]));
+        spr.pose.yaw = R_MovementXYYaw(pl.mov[0][index], pl.mov[1][index]);
     }
     else
     {
-        spr.pose.yaw = pinfo->yaw / 32768.0f * 180;
+        spr.pose.yaw = pl.yaw[index] / 32768.0f * 180;
     }
 
     if(parm.mf->testSubFlag(0, MFF_MOVEMENT_PITCH))
     {
-        spr.pose.pitch = R_MovementXYZPitch(FIX2FLT(pinfo->mov[0]), FIX2FLT(pinfo->mov[1]), FIX2FLT(pinfo->mov[2]));
+        spr.pose.pitch = R_MovementXYZPitch(pl.mov[0][index], pl.mov[1][index], pl.mov[2][index]);
     }
     else
     {
-        spr.pose.pitch = pinfo->pitch / 32768.0f * 180;
+        spr.pose.pitch = pl.pitch[index] / 32768.0f * 180;
     }
 
     spr.light.ambientColor.w = alpha;
@@ -454,7 +450,7 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
     }
     else
     {
-        world::Map &map = pinfo->bspLeaf->subspace().sector().map();
+        world::Map &map = pl.bspLeaf[index]->subspace().sector().map();
 
 #if 0
         if(useBias && map.hasLightGrid())
@@ -472,7 +468,7 @@ static void setupModelParamsForParticle(vissprite_t &spr, const ParticleInfo *pi
         else
 #endif
         {
-            const Vec4f color = pinfo->bspLeaf->subspace().subsector().as<Subsector>()
+            const Vec4f color = pl.bspLeaf[index]->subspace().subsector().as<Subsector>()
                                        .lightSourceColorfIntensity();
 
             float lightLevel = color.w;
@@ -573,12 +569,14 @@ static void drawParticles(int rtype, bool withBlend)
     blendmode_t mode = BM_NORMAL, newMode;
     for (; i < numParts; ++i)
     {
-        const OrderedParticle *slot = &order[i];
+        const OrderedParticle *slot = &order[(*sortedParts)[i]];
         const Generator *gen        = slot->generator;
-        const ParticleInfo &pinfo   = gen->particleInfo()[slot->particleId];
+        const Generator::ParticleLanes &pl = gen->particles();
+        const int index             = slot->particleId;
+        const int stage             = pl.stage[index];
 
-        const GeneratorParticleStage *st = &gen->stages[pinfo.stage];
-        const ded_ptcstage_t *stDef      = &gen->def->stages[pinfo.stage];
+        const GeneratorParticleStage *st = &gen->stages[stage];
+        const ded_ptcstage_t *stDef      = &gen->def->stages[stage];
 
         dshort stageType = st->type;
         if (stageType >= PTC_TEXTURE && stageType < PTC_TEXTURE + MAX_PTC_TEXTURES &&
@@ -616,19 +614,19 @@ static void drawParticles(int rtype, bool withBlend)
 
         // Is there a next stage for this particle?
         const ded_ptcstage_t *nextStDef;
-        if (pinfo.stage >= gen->def->stages.size() - 1 ||
-            !gen->stages[pinfo.stage + 1].type)
+        if (stage >= gen->def->stages.size() - 1 ||
+            !gen->stages[stage + 1].type)
         {
             // There is no "next stage". Use the current one.
-            nextStDef = &gen->def->stages[pinfo.stage];
+            nextStDef = &gen->def->stages[stage];
         }
         else
         {
-            nextStDef = &gen->def->stages[pinfo.stage + 1];
+            nextStDef = &gen->def->stages[stage + 1];
         }
 
         // Where is intermark?
-        const float inter = 1 - float( pinfo.tics ) / stDef->tics;
+        const float inter = 1 - float( pl.tics[index] ) / stDef->tics;
 
         // Calculate size and color.
         float size = de::lerp(    stDef->particleRadius(slot->particleId),
@@ -643,7 +641,7 @@ static void drawParticles(int rtype, bool withBlend)
         {
             // This is a simplified version of sectorlight (no distance attenuation or
             // range compression).
-            if (world::ConvexSubspace *subspace = pinfo.bspLeaf->subspacePtr())
+            if (world::ConvexSubspace *subspace = pl.bspLeaf[index]->subspacePtr())
             {
                 const float intensity = subspace->subsector().as<Subsector>()
                                             .lightSourceIntensity();
@@ -652,7 +650,7 @@ static void drawParticles(int rtype, bool withBlend)
         }
 
         const float maxDist = gen->def->maxDist;
-        const float dist    = order[i].distance;
+        const float dist    = slot->distance;
 
         // Far diffuse?
         if(maxDist)
@@ -677,14 +675,14 @@ static void drawParticles(int rtype, bool withBlend)
 
         DGL_Color4f(color.x, color.y, color.z, color.w);
 
-        const bool nearWall = (pinfo.contact && !pinfo.mov[0] && !pinfo.mov[1]);
+        const bool nearWall = (pl.contact[index] && !pl.mov[0][index] && !pl.mov[1][index]);
 
         bool nearPlane = false;
-        if (world::ConvexSubspace *space = pinfo.bspLeaf->subspacePtr())
+        if (world::ConvexSubspace *space = pl.bspLeaf[index]->subspacePtr())
         {
             auto &subsec = space->subsector().as<Subsector>();
-            if (   FLT2FIX(subsec.  visFloor().heightSmoothed()) + 2 * FRACUNIT >= pinfo.origin[2]
-                || FLT2FIX(subsec.visCeiling().heightSmoothed()) - 2 * FRACUNIT <= pinfo.origin[2])
+            if (   subsec.  visFloor().heightSmoothed() + 2 >= pl.origin[2][index]
+                || subsec.visCeiling().heightSmoothed() - 2 <= pl.origin[2][index])
             {
                 nearPlane = true;
             }
@@ -700,19 +698,19 @@ static void drawParticles(int rtype, bool withBlend)
                 flatOnWall = true;
         }
 
-        Vec3f center = gen->particleOrigin(pinfo).xzy();
+        Vec3f center = gen->particleOrigin(index).xzy();
 
         if(!flatOnPlane && !flatOnWall)
         {
             Vec3f offset(frameTimePos, nearPlane ? 0 : frameTimePos, frameTimePos);
-            center += offset * gen->particleMomentum(pinfo).xzy();
+            center += offset * gen->particleMomentum(index).xzy();
         }
 
         // Model particles are rendered using the normal model rendering routine.
         if(rtype == PTC_MODEL && stDef->model >= 0)
         {
             vissprite_t temp;
-            setupModelParamsForParticle(temp, &pinfo, st, stDef, center, dist, size, inter, color.w);
+            setupModelParamsForParticle(temp, pl, index, st, stDef, center, dist, size, inter, color.w);
             Rend_DrawModel(temp);
             continue;
         }
@@ -738,8 +736,8 @@ static void drawParticles(int rtype, bool withBlend)
             // Flat against a wall, then?
             else if(flatOnWall)
             {
-                DE_ASSERT(pinfo.contact);
-                const Line &contact = *pinfo.contact;
+                DE_ASSERT(pl.contact[index]);
+                const Line &contact = *pl.contact[index];
 
                 // There will be a slight approximation on the XY plane since
                 // the particles aren't that accurate when it comes to wall
@@ -747,7 +745,7 @@ static void drawParticles(int rtype, bool withBlend)
 
                 // Calculate a new center point (project onto the wall).
                 vec2d_t origin;
-                V2d_Set(origin, FIX2FLT(pinfo.origin[0]), FIX2FLT(pinfo.origin[1]));
+                V2d_Set(origin, pl.origin[0][index], pl.origin[1][index]);
 
                 vec2d_t projected;
                 V2d_ProjectOnLine(projected, origin,
@@ -764,7 +762,7 @@ static void drawParticles(int rtype, bool withBlend)
                     projected[1] += diff[1] / dist * gap;
                 }
 
-                Vec2f unitVec = lineUnitVector(*pinfo.contact);
+                Vec2f unitVec = lineUnitVector(*pl.contact[index]);
 
                 DGL_TexCoord2f(0, 0, 0);
                 DGL_Vertex3f(projected[0] - size * unitVec.x, center.y - size,
@@ -808,9 +806,9 @@ static void drawParticles(int rtype, bool withBlend)
         else  // It's a line.
         {
             DGL_Vertex3f(center.x, center.y, center.z);
-            DGL_Vertex3f(center.x - FIX2FLT(pinfo.mov[0]),
-                         center.y - FIX2FLT(pinfo.mov[2]),
-                         center.z - FIX2FLT(pinfo.mov[1]));
+            DGL_Vertex3f(center.x - pl.mov[0][index],
+                         center.y - pl.mov[2][index],
+                         center.z - pl.mov[1][index]);
         }
     }
 
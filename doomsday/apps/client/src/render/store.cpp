@@ -79,3 +79,8 @@ duint Store::allocateVertices(duint count)
 
     return base;
 }
+
+duint Store::vertCount() const
+{
+    return _vertCount;
+}
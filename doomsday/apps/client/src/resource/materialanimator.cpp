@@ -313,6 +313,9 @@ DE_PIMPL(MaterialAnimator)
         /// the renderer's DrawLists module.
         std::array<GLTextureUnit, MaterialAnimator::NUM_TEXTUREUNITS> units;
 
+        /// Draw lists of the renderer for the prepared units.
+        std::array<DrawLists::CachedId, MaterialAnimator::NUM_DRAWLIST_USAGES> drawLists;
+
         Snapshot() { clear(); }
 
         void clear()
@@ -325,6 +328,7 @@ DE_PIMPL(MaterialAnimator)
 
             textures.fill(nullptr);
             units.fill(GLTextureUnit());
+            drawLists.fill(DrawLists::CachedId());
         }
     };
     std::unique_ptr<Snapshot> snapshot;
@@ -804,6 +808,13 @@ GLTextureUnit &MaterialAnimator::texUnit(int unitIndex) const
     throw MissingTextureUnitError("MaterialAnimator::glTextureUnit", "Unknown GL texture unit #" + String::asText(unitIndex));
 }
 
+DrawLists::CachedId &MaterialAnimator::drawList(int usage) const
+{
+    DE_ASSERT(usage >= 0 && usage < NUM_DRAWLIST_USAGES);
+    d->updateSnapshotIfNeeded();
+    return d->snapshot->drawLists[usage];
+}
+
 MaterialAnimator::Decoration &MaterialAnimator::decoration(int decorIndex) const
 {
     d->updateSnapshotIfNeeded();
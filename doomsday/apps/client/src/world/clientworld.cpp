@@ -225,6 +225,7 @@ void ClientWorld::mapFinalized()
 
     map().initGenerators();
     map().initRadio();
+    map().initReverb();
     map().initContactBlockmaps();
     R_InitContactLists(map());
     rendSys.worldSystemMapChanged(map());
@@ -21,6 +21,7 @@
 #include "world/convexsubspace.h"
 #include "world/audioenvironment.h"
 #include "world/line.h"
+#include "world/subsector.h"
 #include "world/surface.h"
 #include "resource/clientmaterial.h"
 
@@ -51,6 +52,9 @@ DE_PIMPL(ConvexSubspace)
     int lastSpriteProjectFrame = 0; // Frame number of last R_AddSprites.
 
     world::AudioEnvironment audioEnvironment; // Cached audio characteristics.
+    bool needAudioEnvironmentUpdate = true;
+    bool hasAudioEnvironment        = false;
+    List<Subsector *> reverbListeners;        // Subsectors whose reverb depends on this.
 
     Impl(Public *i) : Base(i)
     {}
@@ -319,3 +323,30 @@ const world::AudioEnvironment &ConvexSubspace::audioEnvironment() const
 {
     return d->audioEnvironment;
 }
+
+bool ConvexSubspace::prepareAudioEnvironment()
+{
+    if(d->needAudioEnvironmentUpdate)
+    {
+        d->hasAudioEnvironment        = updateAudioEnvironment();
+        d->needAudioEnvironmentUpdate = false;
+    }
+    return d->hasAudioEnvironment;
+}
+
+void ConvexSubspace::markAudioEnvironmentDirty()
+{
+    d->needAudioEnvironmentUpdate = true;
+    for(Subsector *listener : d->reverbListeners)
+    {
+        listener->markReverbDirty();
+    }
+}
+
+void ConvexSubspace::addReverbListener(Subsector &subsector)
+{
+    if(!d->reverbListeners.contains(&subsector))
+    {
+        d->reverbListeners << &subsector;
+    }
+}
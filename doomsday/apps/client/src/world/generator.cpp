@@ -21,6 +21,7 @@
 
 #include "de_platform.h"
 #include "world/generator.h"
+#include "world/particlekernels.h"
 #include "world/subsector.h"
 #include "client/cl_mobj.h"
 #include "world/convexsubspace.h"
@@ -38,30 +39,48 @@
 #include <doomsday/world/thinkers.h>
 #include <doomsday/tab_tables.h>
 #include <de/string.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 #include <de/legacy/fixedpoint.h>
 #include <de/legacy/memoryzone.h>
 #include <de/legacy/timer.h>
 #include <de/legacy/vector1.h>
+#include <cfloat>
 #include <cmath>
 
 using namespace de;
 using world::World;
 
-#define DOT2F(a,b)          ( FIX2FLT(a[0]) * FIX2FLT(b[0]) + FIX2FLT(a[1]) * FIX2FLT(b[1]) )
-#define VECMUL(a,scalar)    ( a[0] = FixedMul(a[0], scalar), a[1] = FixedMul(a[1], scalar) )
-#define VECADD(a,b)         ( a[0] += b[0], a[1] += b[1] )
-#define VECMULADD(a,scal,b) ( a[0] += FixedMul(scal, b[0]), a[1] += FixedMul(scal, b[1]) )
-#define VECSUB(a,b)         ( a[0] -= b[0], a[1] -= b[1] )
-#define VECCPY(a,b)         ( a[0] = b[0], a[1] = b[1] )
+/// Z coordinates of particles stuck to a plane.
+static const float STUCK_TO_FLOOR   = -FLT_MAX;
+static const float STUCK_TO_CEILING =  FLT_MAX;
+
+/// Momentum smaller than this is considered to be zero (same as the smallest
+/// fixed-point unit used by the original particle physics).
+static const float MIN_MOMENTUM = 1.f / FRACUNIT;
+
+/// Float lanes are aligned for the benefit of vectorized loops.
+static const dsize LANE_ALIGNMENT = 16;
+
+/// Fewer particles than this are not worth moving in worker threads.
+static const int CONCURRENT_MIN_PARTICLES = 2048;
+
+/// Approximate number of particles moved by a single task.
+static const int PARTICLES_PER_TASK = 1024;
 
 static float particleSpawnRate = 1; // Unmodified (cvar).
 
+static TaskPool &particleTasks()
+{
+    static TaskPool pool;
+    return pool;
+}
+
 /**
  * The offset is spherical and random.
  * Low and High should be positive.
  */
-static void uncertainPosition(fixed_t *pos, fixed_t low, fixed_t high)
+static void uncertainPosition(float *pos, float low, float high)
 {
     if(!low)
     {
@@ -74,24 +93,62 @@ static void uncertainPosition(fixed_t *pos, fixed_t low, fixed_t high)
     else
     {
         // The more complicated, spherical algorithm.
-        fixed_t off = ((high - low) * (RNG_RandByte() - RNG_RandByte())) * reciprocal255;
+        float off = ((high - low) * (RNG_RandByte() - RNG_RandByte())) * reciprocal255;
         off += off < 0 ? -low : low;
 
-        fixed_t theta = RNG_RandByte() << (24 - ANGLETOFINESHIFT);
-        fixed_t phi = acos(2 * (RNG_RandByte() * reciprocal255) - 1) / PI * (ANGLE_180 >> ANGLETOFINESHIFT);
+        const double theta = RNG_RandByte() / 256.0 * 2 * PI;
+        const double phi   = std::acos(2 * (RNG_RandByte() * reciprocal255) - 1);
 
-        fixed_t vec[3];
-        vec[0] = FixedMul(finecosine[theta], finesine[phi]);
-        vec[1] = FixedMul(finesine[theta], finesine[phi]);
-        vec[2] = FixedMul(finecosine[phi], FLT2FIX(0.8333f));
+        const float vec[3] = {
+            float(std::cos(theta) * std::sin(phi)),
+            float(std::sin(theta) * std::sin(phi)),
+            float(std::cos(phi) * 0.8333)
+        };
 
         for(int i = 0; i < 3; ++i)
         {
-            pos[i] += FixedMul(vec[i], off);
+            pos[i] += vec[i] * off;
         }
     }
 }
 
+/**
+ * Allocates the lanes for @a count particles from the zone as a single block. The
+ * block begins with the stage lane.
+ */
+static void allocParticleLanes(Generator::ParticleLanes &lanes, int count)
+{
+    const int laneCount = 17;
+    const dsize particleSize = sizeof(*lanes.stage) + sizeof(*lanes.tics) + 11 * sizeof(float) +
+                               sizeof(*lanes.bspLeaf) + sizeof(*lanes.contact) +
+                               sizeof(*lanes.yaw) + sizeof(*lanes.pitch);
+
+    auto *cursor = (Byte *) Z_Calloc(dsize(count) * particleSize + laneCount * LANE_ALIGNMENT,
+                                     PU_MAP, 0);
+    auto lane = [&cursor, count] (dsize elementSize) -> void *
+    {
+        void *begin = cursor;
+        cursor += dsize(count) * elementSize;
+        cursor += (LANE_ALIGNMENT - (uintptr_t(cursor) % LANE_ALIGNMENT)) % LANE_ALIGNMENT;
+        return begin;
+    };
+
+    lanes.stage = (int32_t *) lane(sizeof(int32_t));
+    for(int i = 0; i < 3; ++i)
+    {
+        lanes.origin[i] = (float *) lane(sizeof(float));
+        lanes.mov[i]    = (float *) lane(sizeof(float));
+        lanes.force[i]  = (float *) lane(sizeof(float));
+    }
+    lanes.gravity    = (float *) lane(sizeof(float));
+    lanes.resistance = (float *) lane(sizeof(float));
+    lanes.bspLeaf    = (world::BspLeaf **) lane(sizeof(world::BspLeaf *));
+    lanes.contact    = (Line **) lane(sizeof(Line *));
+    lanes.tics       = (int16_t *) lane(sizeof(int16_t));
+    lanes.yaw        = (uint16_t *) lane(sizeof(uint16_t));
+    lanes.pitch      = (uint16_t *) lane(sizeof(uint16_t));
+}
+
 Map &Generator::map() const
 {
     return Thinker_Map(thinker).as<Map>();
@@ -127,8 +184,8 @@ Vec3d Generator::origin() const
 
 void Generator::clearParticles()
 {
-    Z_Free(_pinfo);
-    _pinfo = nullptr;
+    Z_Free(_particles.stage);
+    zap(_particles);
 }
 
 void Generator::configureFromDef(const ded_ptcgen_t *newDef)
@@ -143,7 +200,7 @@ void Generator::configureFromDef(const ded_ptcgen_t *newDef)
 
     def    = newDef;
     _flags = Flags(def->flags);
-    _pinfo = (ParticleInfo *) Z_Calloc(sizeof(ParticleInfo) * count, PU_MAP, 0);
+    allocParticleLanes(_particles, count);
     stages = (ParticleStage *) Z_Calloc(sizeof(ParticleStage) * def->stages.size(), PU_MAP, 0);
 
     for(int i = 0; i < def->stages.size(); ++i)
@@ -169,15 +226,21 @@ void Generator::configureFromDef(const ded_ptcgen_t *newDef)
     // Apply a random component to the spawn vector.
     if(def->initVectorVariance > 0)
     {
-        uncertainPosition(vector, 0, FLT2FIX(def->initVectorVariance));
+        float vec[3] = { def->vector[0], def->vector[1], def->vector[2] };
+        uncertainPosition(vec, 0, def->initVectorVariance);
+        for(int i = 0; i < 3; ++i)
+        {
+            vector[i] = FLT2FIX(vec[i]);
+        }
     }
 
     // Mark unused.
     for(int i = 0; i < count; ++i)
     {
-        ParticleInfo* pinfo = &_pinfo[i];
-        pinfo->stage = -1;
+        _particles.stage[i] = -1;
     }
+
+    _randomState = randui32() | 1; // Never zero.
 }
 
 void Generator::presimulate(int tics)
@@ -222,7 +285,7 @@ int Generator::activeParticleCount() const
     int numActive = 0;
     for(int i = 0; i < count; ++i)
     {
-        if(_pinfo[i].stage >= 0)
+        if(_particles.stage[i] >= 0)
         {
             numActive += 1;
         }
@@ -230,39 +293,116 @@ int Generator::activeParticleCount() const
     return numActive;
 }
 
-const ParticleInfo *Generator::particleInfo() const
+ParticleInfo Generator::particleInfo(int index) const
 {
-    return _pinfo;
+    DE_ASSERT(index >= 0 && index < count);
+
+    ParticleInfo pinfo;
+    pinfo.stage   = _particles.stage[index];
+    pinfo.tics    = _particles.tics[index];
+    for(int i = 0; i < 3; ++i)
+    {
+        pinfo.origin[i] = _particles.origin[i][index];
+        pinfo.mov[i]    = _particles.mov[i][index];
+    }
+    pinfo.bspLeaf = _particles.bspLeaf[index];
+    pinfo.contact = _particles.contact[index];
+    pinfo.yaw     = _particles.yaw[index];
+    pinfo.pitch   = _particles.pitch[index];
+    return pinfo;
 }
 
-static void setParticleAngles(ParticleInfo *pinfo, int flags)
+const Generator::ParticleLanes &Generator::particles() const
 {
-    DE_ASSERT(pinfo);
+    return _particles;
+}
 
+void Generator::setParticleStage(int index, int stage)
+{
+    const ParticleStage *st     = &stages[stage];
+    const ded_ptcstage_t *stDef = &def->stages[stage];
+
+    _particles.stage[index]      = stage;
+    _particles.gravity[index]    = FIX2FLT(st->gravity);
+    _particles.resistance[index] = FIX2FLT(st->resistance);
+    for(int i = 0; i < 3; ++i)
+    {
+        _particles.force[i][index] = stDef->vectorForce[i];
+    }
+}
+
+void Generator::killParticle(int index)
+{
+    _particles.stage[index]      = -1;
+    _particles.gravity[index]    = 0;
+    _particles.resistance[index] = 0;
+    for(int i = 0; i < 3; ++i)
+    {
+        _particles.force[i][index] = 0;
+    }
+}
+
+float Generator::randomFloat()
+{
+    // Each generator has its own (xorshift) random number sequence so that the
+    // particles of several generators can be moved concurrently.
+    _randomState ^= _randomState << 13;
+    _randomState ^= _randomState >> 17;
+    _randomState ^= _randomState << 5;
+    return (_randomState >> 8) / float(1 << 24);
+}
+
+template <typename RandomFunc>
+static void setParticleAngles(uint16_t &yaw, uint16_t &pitch, int flags, RandomFunc randomFloat)
+{
     if(flags & Generator::ParticleStage::ZeroYaw)
-        pinfo->yaw = 0;
+        yaw = 0;
     if(flags & Generator::ParticleStage::ZeroPitch)
-        pinfo->pitch = 0;
+        pitch = 0;
     if(flags & Generator::ParticleStage::RandomYaw)
-        pinfo->yaw = RNG_RandFloat() * 65536;
+        yaw = randomFloat() * 65536;
     if(flags & Generator::ParticleStage::RandomPitch)
-        pinfo->pitch = RNG_RandFloat() * 65536;
+        pitch = randomFloat() * 65536;
 }
 
-static void particleSound(fixed_t pos[3], ded_embsound_t *sound)
+/**
+ * Determines the Z coordinate of a particle, which may be stuck to a plane.
+ */
+static float particleZAt(const world::BspLeaf *bspLeaf, float z)
 {
-    DE_ASSERT(pos && sound);
+    if(z == STUCK_TO_CEILING || z == STUCK_TO_FLOOR)
+    {
+        const auto &subsec = bspLeaf->subspace().subsector().as<Subsector>();
+        if(z == STUCK_TO_CEILING)
+        {
+            return subsec.visCeiling().heightSmoothed() - 2;
+        }
+        return subsec.visFloor().heightSmoothed() + 2;
+    }
+    return z;
+}
+
+static void playParticleSound(const Vec3d &origin, const ded_embsound_t &sound)
+{
+    coord_t orig[3] = { origin.x, origin.y, origin.z };
+    S_LocalSoundAtVolumeFrom(sound.id, nullptr, orig, sound.volume);
+}
 
+/**
+ * @param sounds  If not @c nullptr, the sound is appended here to be played later.
+ */
+static void particleSound(const Vec3d &origin, const ded_embsound_t &sound,
+                          Generator::ParticleSounds *sounds = nullptr)
+{
     // Is there any sound to play?
-    if(!sound->id || sound->volume <= 0) return;
+    if(!sound.id || sound.volume <= 0) return;
 
-    double orig[3];
-    for (int i = 0; i < 3; ++i)
+    if(sounds)
     {
-        orig[i] = FIX2FLT(pos[i]);
+        sounds->append(Generator::ParticleSound{&sound, origin});
+        return;
     }
-
-    S_LocalSoundAtVolumeFrom(sound->id, nullptr, orig, sound->volume);
+    playParticleSound(origin, sound);
 }
 
 int Generator::newParticle()
@@ -288,43 +428,42 @@ int Generator::newParticle()
     const int newParticleIdx = _spawnCP;
 
     // Set the particle's data.
-    ParticleInfo *pinfo = &_pinfo[_spawnCP];
-    pinfo->stage = 0;
+    int stage = 0;
     if(RNG_RandFloat() < def->altStartVariance)
     {
-        pinfo->stage = def->altStart;
+        stage = def->altStart;
     }
+    setParticleStage(newParticleIdx, stage);
 
-    pinfo->tics = def->stages[pinfo->stage].tics *
-        (1 - def->stages[pinfo->stage].variance * RNG_RandFloat());
+    _particles.tics[newParticleIdx] = def->stages[stage].tics *
+        (1 - def->stages[stage].variance * RNG_RandFloat());
 
     // Launch vector.
-    pinfo->mov[0] = vector[0];
-    pinfo->mov[1] = vector[1];
-    pinfo->mov[2] = vector[2];
+    float mov[3] = { FIX2FLT(vector[0]), FIX2FLT(vector[1]), FIX2FLT(vector[2]) };
 
     // Apply some random variance.
-    pinfo->mov[0] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
-    pinfo->mov[1] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
-    pinfo->mov[2] += FLT2FIX(def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat()));
+    mov[0] += def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat());
+    mov[1] += def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat());
+    mov[2] += def->vectorVariance * (RNG_RandFloat() - RNG_RandFloat());
 
     // Apply some aspect ratio scaling to the momentum vector.
     // This counters the 200/240 difference nearly completely.
-    pinfo->mov[0] = FixedMul(pinfo->mov[0], FLT2FIX(1.1f));
-    pinfo->mov[1] = FixedMul(pinfo->mov[1], FLT2FIX(0.95f));
-    pinfo->mov[2] = FixedMul(pinfo->mov[2], FLT2FIX(1.1f));
+    mov[0] *= 1.1f;
+    mov[1] *= 0.95f;
+    mov[2] *= 1.1f;
 
     // Set proper speed.
-    fixed_t uncertain = FLT2FIX(def->speed * (1 - def->speedVariance * RNG_RandFloat()));
+    const float uncertain = def->speed * (1 - def->speedVariance * RNG_RandFloat());
+
+    float len = M_ApproxDistancef(M_ApproxDistancef(mov[0], mov[1]), mov[2]);
+    if(len < MIN_MOMENTUM) len = 1;
+    len = uncertain / len;
 
-    fixed_t len = FLT2FIX(M_ApproxDistancef(
-        M_ApproxDistancef(FIX2FLT(pinfo->mov[0]), FIX2FLT(pinfo->mov[1])), FIX2FLT(pinfo->mov[2])));
-    if(!len) len = FRACUNIT;
-    len = FixedDiv(uncertain, len);
+    mov[0] *= len;
+    mov[1] *= len;
+    mov[2] *= len;
 
-    pinfo->mov[0] = FixedMul(pinfo->mov[0], len);
-    pinfo->mov[1] = FixedMul(pinfo->mov[1], len);
-    pinfo->mov[2] = FixedMul(pinfo->mov[2], len);
+    float origin[3] = { 0, 0, 0 };
 
     // The source is a mobj?
     if(source)
@@ -332,46 +471,42 @@ int Generator::newParticle()
         if(_flags & RelativeVector)
         {
             // Rotate the vector using the source angle.
-            float temp[3];
-
-            temp[0] = FIX2FLT(pinfo->mov[0]);
-            temp[1] = FIX2FLT(pinfo->mov[1]);
-            temp[2] = 0;
+            float temp[3] = { mov[0], mov[1], 0 };
 
             // Player visangles have some problems, let's not use them.
             M_RotateVector(temp, source->angle / (float) ANG180 * -180 + 90, 0);
 
-            pinfo->mov[0] = FLT2FIX(temp[0]);
-            pinfo->mov[1] = FLT2FIX(temp[1]);
+            mov[0] = temp[0];
+            mov[1] = temp[1];
         }
 
         if(_flags & RelativeVelocity)
         {
-            pinfo->mov[0] += FLT2FIX(source->mom[MX]);
-            pinfo->mov[1] += FLT2FIX(source->mom[MY]);
-            pinfo->mov[2] += FLT2FIX(source->mom[MZ]);
+            mov[0] += source->mom[MX];
+            mov[1] += source->mom[MY];
+            mov[2] += source->mom[MZ];
         }
 
         // Origin.
-        pinfo->origin[0] = FLT2FIX(source->origin[0]);
-        pinfo->origin[1] = FLT2FIX(source->origin[1]);
-        pinfo->origin[2] = FLT2FIX(source->origin[2] - source->floorClip);
+        origin[0] = source->origin[0];
+        origin[1] = source->origin[1];
+        origin[2] = source->origin[2] - source->floorClip;
 
-        uncertainPosition(pinfo->origin, FLT2FIX(def->spawnRadiusMin), FLT2FIX(def->spawnRadius));
+        uncertainPosition(origin, def->spawnRadiusMin, def->spawnRadius);
 
         // Offset to the real center.
-        pinfo->origin[2] += originAtSpawn[2];
+        origin[2] += FIX2FLT(originAtSpawn[2]);
 
         // Include bobbing in the spawn height.
-        pinfo->origin[2] -= FLT2FIX(Mobj_BobOffset(*source));
+        origin[2] -= Mobj_BobOffset(*source);
 
         // Calculate XY center with mobj angle.
         const angle_t angle = Mobj_AngleSmoothed(source) + (fixed_t) (FIX2FLT(originAtSpawn[1]) / 180.0f * ANG180);
         const duint an      = angle >> ANGLETOFINESHIFT;
         const duint an2     = (angle + ANG90) >> ANGLETOFINESHIFT;
 
-        pinfo->origin[0] += FixedMul(finecosine[an], originAtSpawn[0]);
-        pinfo->origin[1] += FixedMul(finesine[an], originAtSpawn[0]);
+        origin[0] += FIX2FLT(finecosine[an]) * FIX2FLT(originAtSpawn[0]);
+        origin[1] += FIX2FLT(finesine[an])   * FIX2FLT(originAtSpawn[0]);
 
         // There might be an offset from the model of the mobj.
         if(mf && (mf->testSubFlag(0, MFF_PARTICLE_SUB1) || def->subModel >= 0))
@@ -402,39 +537,38 @@ int Generator::newParticle()
             off[2] += mf->particleOffset(subidx)[2];
 
             // Apply it to the particle coords.
-            pinfo->origin[0] += FixedMul(finecosine[an],  FLT2FIX(off[0]));
-            pinfo->origin[0] += FixedMul(finecosine[an2], FLT2FIX(off[2]));
-            pinfo->origin[1] += FixedMul(finesine[an],    FLT2FIX(off[0]));
-            pinfo->origin[1] += FixedMul(finesine[an2],   FLT2FIX(off[2]));
-            pinfo->origin[2] += FLT2FIX(off[1]);
+            origin[0] += FIX2FLT(finecosine[an])  * off[0];
+            origin[0] += FIX2FLT(finecosine[an2]) * off[2];
+            origin[1] += FIX2FLT(finesine[an])    * off[0];
+            origin[1] += FIX2FLT(finesine[an2])   * off[2];
+            origin[2] += off[1];
         }
     }
     else if(plane)
     {
         /// @todo fixme: ignorant of mapped sector planes.
-        fixed_t radius = stages[pinfo->stage].radius;
+        const float radius = FIX2FLT(stages[stage].radius);
         const auto *sector = &plane->sector();
 
         // Choose a random spot inside the sector, on the spawn plane.
         if(_flags & SpawnSpace)
         {
-            pinfo->origin[2] =
-                FLT2FIX(sector->floor().height()) + radius +
-                FixedMul(RNG_RandByte() << 8,
-                         FLT2FIX(sector->ceiling().height() -
-                                 sector->floor().height()) - 2 * radius);
+            origin[2] =
+                sector->floor().height() + radius +
+                RNG_RandByte() / 256.f *
+                    (sector->ceiling().height() - sector->floor().height() - 2 * radius);
         }
         else if((_flags & SpawnFloor) ||
                 (!(_flags & (SpawnFloor | SpawnCeiling)) &&
                  plane->isSectorFloor()))
         {
             // Spawn on the floor.
-            pinfo->origin[2] = FLT2FIX(plane->height()) + radius;
+            origin[2] = plane->height() + radius;
         }
         else
         {
             // Spawn on the ceiling.
-            pinfo->origin[2] = FLT2FIX(plane->height()) - radius;
+            origin[2] = plane->height() - radius;
         }
 
         /**
@@ -461,7 +595,7 @@ int Generator::newParticle()
 
         if(!subspace)
         {
-            pinfo->stage = -1;
+            killParticle(newParticleIdx);
             return -1;
         }
 
@@ -476,8 +610,8 @@ int Generator::newParticle()
             float y = subBounds.minY +
                 RNG_RandFloat() * (subBounds.maxY - subBounds.minY);
 
-            pinfo->origin[0] = FLT2FIX(x);
-            pinfo->origin[1] = FLT2FIX(y);
+            origin[0] = x;
+            origin[1] = y;
 
             if(subspace == map().bspLeafAt(Vec2d(x, y)).subspacePtr())
                 break; // This is a good place.
@@ -485,22 +619,29 @@ int Generator::newParticle()
 
         if(tries == 10) // No good place found?
         {
-            pinfo->stage = -1; // Damn.
+            killParticle(newParticleIdx); // Damn.
             return -1;
         }
     }
     else if(isUntriggered())
     {
         // The center position is the spawn origin.
-        pinfo->origin[0] = originAtSpawn[0];
-        pinfo->origin[1] = originAtSpawn[1];
-        pinfo->origin[2] = originAtSpawn[2];
-        uncertainPosition(pinfo->origin, FLT2FIX(def->spawnRadiusMin),
-                          FLT2FIX(def->spawnRadius));
+        origin[0] = FIX2FLT(originAtSpawn[0]);
+        origin[1] = FIX2FLT(originAtSpawn[1]);
+        origin[2] = FIX2FLT(originAtSpawn[2]);
+        uncertainPosition(origin, def->spawnRadiusMin, def->spawnRadius);
     }
 
+    for(int i = 0; i < 3; ++i)
+    {
+        _particles.origin[i][newParticleIdx] = origin[i];
+        _particles.mov[i][newParticleIdx]    = mov[i];
+    }
+    _particles.contact[newParticleIdx] = nullptr;
+
     // Initial angles for the particle.
-    setParticleAngles(pinfo, def->stages[pinfo->stage].flags);
+    setParticleAngles(_particles.yaw[newParticleIdx], _particles.pitch[newParticleIdx],
+                      def->stages[stage].flags, RNG_RandFloat);
 
     // The other place where this gets updated is after moving over
     // a two-sided line.
@@ -510,19 +651,19 @@ int Generator::newParticle()
     }
     else*/
     {
-        Vec2d ptOrigin(FIX2FLT(pinfo->origin[0]), FIX2FLT(pinfo->origin[1]));
-        pinfo->bspLeaf = &map().bspLeafAt(ptOrigin);
+        world::BspLeaf *bspLeaf = &map().bspLeafAt(Vec2d(origin[0], origin[1]));
+        _particles.bspLeaf[newParticleIdx] = bspLeaf;
 
         // A BSP leaf with no geometry is not a suitable place for a particle.
-        if(!pinfo->bspLeaf->hasSubspace())
+        if(!bspLeaf->hasSubspace())
         {
-            pinfo->stage = -1;
+            killParticle(newParticleIdx);
             return -1;
         }
     }
 
     // Play a stage sound?
-    particleSound(pinfo->origin, &def->stages[pinfo->stage].sound);
+    particleSound(Vec3d(origin[0], origin[1], origin[2]), def->stages[stage].sound);
 
     return newParticleIdx;
 #else  // !__CLIENT__
@@ -559,260 +700,230 @@ static int newGeneratorParticlesWorker(mobj_t *cmo, void *context)
 
 #endif
 
-/**
- * Particle touches something solid. Returns false iff the particle dies.
- */
-static int touchParticle(ParticleInfo *pinfo, Generator::ParticleStage *stage,
-    ded_ptcstage_t *stageDef, bool touchWall)
+float Generator::particleZ(int index) const
 {
-    // Play a hit sound.
-    particleSound(pinfo->origin, &stageDef->hitSound);
-
-    if(stage->flags.testFlag(Generator::ParticleStage::DieTouch))
-    {
-        // Particle dies from touch.
-        pinfo->stage = -1;
-        return false;
-    }
-
-    if(stage->flags.testFlag(Generator::ParticleStage::StageTouch) ||
-       (touchWall && stage->flags.testFlag(Generator::ParticleStage::StageWallTouch)) ||
-       (!touchWall && stage->flags.testFlag(Generator::ParticleStage::StageFlatTouch)))
-    {
-        // Particle advances to the next stage.
-        pinfo->tics = 0;
-    }
-
-    // Particle survives the touch.
-    return true;
-}
-
-float Generator::particleZ(const ParticleInfo &pinfo) const
-{
-    const auto &subsec = pinfo.bspLeaf->subspace().subsector().as<Subsector>();
-    if(pinfo.origin[2] == DDMAXINT)
-    {
-        return subsec.visCeiling().heightSmoothed() - 2;
-    }
-    if(pinfo.origin[2] == DDMININT)
-    {
-        return (subsec.visFloor().heightSmoothed() + 2);
-    }
-    return FIX2FLT(pinfo.origin[2]);
+    return particleZAt(_particles.bspLeaf[index], _particles.origin[2][index]);
 }
 
-Vec3f Generator::particleOrigin(const ParticleInfo &pt) const
+Vec3f Generator::particleOrigin(int index) const
 {
-    return Vec3f(FIX2FLT(pt.origin[0]), FIX2FLT(pt.origin[1]), particleZ(pt));
+    return Vec3f(_particles.origin[0][index], _particles.origin[1][index], particleZ(index));
 }
 
-Vec3f Generator::particleMomentum(const ParticleInfo &pt) const
+Vec3f Generator::particleMomentum(int index) const
 {
-    return Vec3f(FIX2FLT(pt.mov[0]), FIX2FLT(pt.mov[1]), FIX2FLT(pt.mov[2]));
+    return Vec3f(_particles.mov[0][index], _particles.mov[1][index], _particles.mov[2][index]);
 }
 
-void Generator::spinParticle(ParticleInfo &pinfo)
+void Generator::spinParticle(int index)
 {
     static int const yawSigns[4]   = { 1,  1, -1, -1 };
     static int const pitchSigns[4] = { 1, -1,  1, -1 };
 
-    const ded_ptcstage_t *stDef = &def->stages[pinfo.stage];
-    const duint spinIndex        = uint(&pinfo - &_pinfo[id() / 8]) % 4;
+    const ded_ptcstage_t *stDef = &def->stages[_particles.stage[index]];
+    const duint spinIndex        = uint(index - id() / 8) % 4;
 
     DE_ASSERT(spinIndex < 4);
 
     const int yawSign   =   yawSigns[spinIndex];
     const int pitchSign = pitchSigns[spinIndex];
 
+    uint16_t &yaw   = _particles.yaw[index];
+    uint16_t &pitch = _particles.pitch[index];
+
     if(stDef->spin[0] != 0)
     {
-        pinfo.yaw   += 65536 * yawSign   * stDef->spin[0] / (360 * TICSPERSEC);
+        yaw   += 65536 * yawSign   * stDef->spin[0] / (360 * TICSPERSEC);
     }
     if(stDef->spin[1] != 0)
     {
-        pinfo.pitch += 65536 * pitchSign * stDef->spin[1] / (360 * TICSPERSEC);
+        pitch += 65536 * pitchSign * stDef->spin[1] / (360 * TICSPERSEC);
     }
 
-    pinfo.yaw   *= 1 - stDef->spinResistance[0];
-    pinfo.pitch *= 1 - stDef->spinResistance[1];
+    yaw   *= 1 - stDef->spinResistance[0];
+    pitch *= 1 - stDef->spinResistance[1];
 }
 
-void Generator::moveParticle(int index)
+void Generator::applySphereForce(int index)
 {
-    DE_ASSERT(index >= 0 && index < count);
-
-    ParticleInfo *pinfo   = &_pinfo[index];
-    ParticleStage *st     = &stages[pinfo->stage];
-    ded_ptcstage_t *stDef = &def->stages[pinfo->stage];
-
-    // Particle rotates according to spin speed.
-    spinParticle(*pinfo);
-
-    // Changes to momentum.
-    /// @todo Do not assume generator is from the CURRENT map.
-    pinfo->mov[2] -= FixedMul(FLT2FIX(map().gravity()), st->gravity);
+    ParticleLanes &pl = _particles;
+    float delta[3];
 
-    // Vector force.
-    if(stDef->vectorForce[0] != 0 || stDef->vectorForce[1] != 0 ||
-       stDef->vectorForce[2] != 0)
+    if(source)
+    {
+        delta[0] = pl.origin[0][index] - source->origin[0];
+        delta[1] = pl.origin[1][index] - source->origin[1];
+        delta[2] = particleZAt(pl.bspLeaf[index], pl.origin[2][index]) -
+                   (source->origin[2] + FIX2FLT(originAtSpawn[2]));
+    }
+    else
     {
         for(int i = 0; i < 3; ++i)
         {
-            pinfo->mov[i] += FLT2FIX(stDef->vectorForce[i]);
+            delta[i] = pl.origin[i][index] - FIX2FLT(originAtSpawn[i]);
         }
     }
 
-    // Sphere force pull and turn.
-    // Only applicable to sourced or untriggered generators. For other
-    // types it's difficult to define the center coordinates.
-    if(st->flags.testFlag(ParticleStage::SphereForce) &&
-       (source || isUntriggered()))
+    // Apply the offset (to source coords).
+    for(int i = 0; i < 3; ++i)
     {
-        float delta[3];
+        delta[i] -= def->forceOrigin[i];
+    }
 
-        if(source)
-        {
-            delta[0] = FIX2FLT(pinfo->origin[0]) - source->origin[0];
-            delta[1] = FIX2FLT(pinfo->origin[1]) - source->origin[1];
-            delta[2] = particleZ(*pinfo) - (source->origin[2] + FIX2FLT(originAtSpawn[2]));
-        }
-        else
+    // Counter the aspect ratio of old times.
+    delta[2] *= 1.2f;
+
+    const float dist = M_ApproxDistancef(M_ApproxDistancef(delta[0], delta[1]), delta[2]);
+    if(dist == 0) return;
+
+    // Radial force pushes the particles on the surface of a sphere.
+    if(def->force)
+    {
+        // Normalize delta vector, multiply with (dist - forceRadius),
+        // multiply with radial force strength.
+        for(int i = 0; i < 3; ++i)
         {
-            for(int i = 0; i < 3; ++i)
-            {
-                delta[i] = FIX2FLT(pinfo->origin[i] - originAtSpawn[i]);
-            }
+            pl.mov[i][index] -= ((delta[i] / dist) * (dist - def->forceRadius)) * def->force;
         }
+    }
+
+    // Rotate!
+    if(def->forceAxis[0] || def->forceAxis[1] || def->forceAxis[2])
+    {
+        float cross[3];
+        V3f_CrossProduct(cross, def->forceAxis, delta);
 
-        // Apply the offset (to source coords).
         for(int i = 0; i < 3; ++i)
         {
-            delta[i] -= def->forceOrigin[i];
+            pl.mov[i][index] += cross[i] / 256;
         }
+    }
+}
 
-        // Counter the aspect ratio of old times.
-        delta[2] *= 1.2f;
+void Generator::moveParticle(int index, ParticleSounds *sounds)
+{
+    DE_ASSERT(index >= 0 && index < count);
 
-        float dist = M_ApproxDistancef(M_ApproxDistancef(delta[0], delta[1]), delta[2]);
-        if(dist != 0)
-        {
-            // Radial force pushes the particles on the surface of a sphere.
-            if(def->force)
-            {
-                // Normalize delta vector, multiply with (dist - forceRadius),
-                // multiply with radial force strength.
-                for(int i = 0; i < 3; ++i)
-                {
-                    pinfo->mov[i] -= FLT2FIX(
-                        ((delta[i] / dist) * (dist - def->forceRadius)) * def->force);
-                }
-            }
+    ParticleLanes &pl           = _particles;
+    const ParticleStage *st     = &stages[pl.stage[index]];
+    const ded_ptcstage_t *stDef = &def->stages[pl.stage[index]];
 
-            // Rotate!
-            if(def->forceAxis[0] || def->forceAxis[1] || def->forceAxis[2])
-            {
-                float cross[3];
-                V3f_CrossProduct(cross, def->forceAxis, delta);
+    float *origin[3] = { &pl.origin[0][index], &pl.origin[1][index], &pl.origin[2][index] };
+    float *mov[3]    = { &pl.mov[0][index],    &pl.mov[1][index],    &pl.mov[2][index]    };
 
-                for(int i = 0; i < 3; ++i)
-                {
-                    pinfo->mov[i] += FLT2FIX(cross[i]) >> 8;
-                }
-            }
+    /**
+     * Particle touches something solid. Returns false iff the particle dies.
+     */
+    auto touchParticle = [&] (bool touchWall)
+    {
+        // Play a hit sound.
+        particleSound(Vec3d(*origin[0], *origin[1], particleZAt(pl.bspLeaf[index], *origin[2])),
+                      stDef->hitSound, sounds);
+
+        if(st->flags.testFlag(ParticleStage::DieTouch))
+        {
+            // Particle dies from touch.
+            killParticle(index);
+            return false;
         }
-    }
 
-    if(st->resistance != FRACUNIT)
-    {
-        for(int i = 0; i < 3; ++i)
+        if(st->flags.testFlag(ParticleStage::StageTouch) ||
+           (touchWall && st->flags.testFlag(ParticleStage::StageWallTouch)) ||
+           (!touchWall && st->flags.testFlag(ParticleStage::StageFlatTouch)))
         {
-            pinfo->mov[i] = FixedMul(pinfo->mov[i], st->resistance);
+            // Particle advances to the next stage.
+            pl.tics[index] = 0;
         }
-    }
+
+        // Particle survives the touch.
+        return true;
+    };
 
     // The particle is 'soft': half of radius is ignored.
     // The exception is plane flat particles, which are rendered flat
     // against planes. They are almost entirely soft when it comes to plane
     // collisions.
-    fixed_t hardRadius = st->radius / 2;
+    float hardRadius = FIX2FLT(st->radius) / 2;
     if((st->type == PTC_POINT || (st->type >= PTC_TEXTURE && st->type < PTC_TEXTURE + MAX_PTC_TEXTURES)) &&
        st->flags.testFlag(ParticleStage::PlaneFlat))
     {
-        hardRadius = FRACUNIT;
+        hardRadius = 1;
     }
 
     // Check the new Z position only if not stuck to a plane.
-    fixed_t z = pinfo->origin[2] + pinfo->mov[2];
+    float z = *origin[2] + *mov[2];
     bool zBounce = false, hitFloor = false;
-    if(pinfo->origin[2] != DDMININT && pinfo->origin[2] != DDMAXINT && pinfo->bspLeaf)
+    if(*origin[2] != STUCK_TO_FLOOR && *origin[2] != STUCK_TO_CEILING && pl.bspLeaf[index])
     {
-        auto &subsec = pinfo->bspLeaf->subspace().subsector().as<Subsector>();
-        if(z > FLT2FIX(subsec.visCeiling().heightSmoothed()) - hardRadius)
+        auto &subsec = pl.bspLeaf[index]->subspace().subsector().as<Subsector>();
+        if(z > subsec.visCeiling().heightSmoothed() - hardRadius)
         {
             // The Z is through the roof!
             if(subsec.visCeiling().surface().hasSkyMaskedMaterial())
             {
                 // Special case: particle gets lost in the sky.
-                pinfo->stage = -1;
+                killParticle(index);
                 return;
             }
 
-            if(!touchParticle(pinfo, st, stDef, false))
+            if(!touchParticle(false))
                 return;
 
-            z = FLT2FIX(subsec.visCeiling().heightSmoothed()) - hardRadius;
+            z = subsec.visCeiling().heightSmoothed() - hardRadius;
             zBounce = true;
             hitFloor = false;
         }
 
         // Also check the floor.
-        if(z < FLT2FIX(subsec.visFloor().heightSmoothed()) + hardRadius)
+        if(z < subsec.visFloor().heightSmoothed() + hardRadius)
         {
             if(subsec.visFloor().surface().hasSkyMaskedMaterial())
             {
-                pinfo->stage = -1;
+                killParticle(index);
                 return;
             }
 
-            if(!touchParticle(pinfo, st, stDef, false))
+            if(!touchParticle(false))
                 return;
 
-            z = FLT2FIX(subsec.visFloor().heightSmoothed()) + hardRadius;
+            z = subsec.visFloor().heightSmoothed() + hardRadius;
             zBounce = true;
             hitFloor = true;
         }
 
         if(zBounce)
         {
-            pinfo->mov[2] = FixedMul(-pinfo->mov[2], st->bounce);
-            if(!pinfo->mov[2])
+            *mov[2] = -*mov[2] * FIX2FLT(st->bounce);
+            if(std::abs(*mov[2]) < MIN_MOMENTUM)
             {
+                *mov[2] = 0;
+
                 // The particle has stopped moving. This means its Z-movement
                 // has ceased because of the collision with a plane. Plane-flat
                 // particles will stick to the plane.
                 if((st->type == PTC_POINT || (st->type >= PTC_TEXTURE && st->type < PTC_TEXTURE + MAX_PTC_TEXTURES)) &&
                    st->flags.testFlag(ParticleStage::PlaneFlat))
                 {
-                    z = hitFloor ? DDMININT : DDMAXINT;
+                    z = hitFloor ? STUCK_TO_FLOOR : STUCK_TO_CEILING;
                 }
             }
         }
 
         // Move to the new Z coordinate.
-        pinfo->origin[2] = z;
+        *origin[2] = z;
     }
 
     // Now check the XY direction.
     // - Check if the movement crosses any solid lines.
     // - If it does, quit when first one contacted and apply appropriate
     //   bounce (result depends on the angle of the contacted wall).
-    fixed_t x = pinfo->origin[0] + pinfo->mov[0];
-    fixed_t y = pinfo->origin[1] + pinfo->mov[1];
+    float x = *origin[0] + *mov[0];
+    float y = *origin[1] + *mov[1];
 
     struct checklineworker_params_t
     {
         AABoxd box;
-        fixed_t tmpz, tmprad, tmpx1, tmpx2, tmpy1, tmpy2;
+        float tmpz, tmprad, tmpx1, tmpx2, tmpy1, tmpy2;
         bool tmcross;
         Line *ptcHitLine;
     };
@@ -821,18 +932,18 @@ void Generator::moveParticle(int index)
 
     // XY movement can be skipped if the particle is not moving on the
     // XY plane.
-    if(!pinfo->mov[0] && !pinfo->mov[1])
+    if(!*mov[0] && !*mov[1])
     {
         // If the particle is contacting a line, there is a chance that the
         // particle should be killed (if it's moving slowly at max).
-        if(pinfo->contact)
+        if(Line *contact = pl.contact[index])
         {
-            auto *front = pinfo->contact->front().sectorPtr();
-            auto *back  = pinfo->contact->back().sectorPtr();
+            auto *front = contact->front().sectorPtr();
+            auto *back  = contact->back().sectorPtr();
 
-            if (front && back && abs(pinfo->mov[2]) < FRACUNIT / 2)
+            if (front && back && std::abs(*mov[2]) < .5f)
             {
-                const coord_t pz = particleZ(*pinfo);
+                const coord_t pz = particleZAt(pl.bspLeaf[index], *origin[2]);
 
                 coord_t fz;
                 if (front->floor().height() > back->floor().height())
@@ -859,7 +970,7 @@ void Generator::moveParticle(int index)
                 if (pz > fz && pz < cz)
                 {
                     // Kill the particle.
-                    pinfo->stage = -1;
+                    killParticle(index);
                     return;
                 }
             }
@@ -870,29 +981,28 @@ void Generator::moveParticle(int index)
     }
 
     // We're moving in XY, so if we don't hit anything there can't be any line contact.
-    pinfo->contact = 0;
+    pl.contact[index] = nullptr;
 
     // Bounding box of the movement line.
     clParm.tmpz = z;
     clParm.tmprad = hardRadius;
-    clParm.tmpx1 = pinfo->origin[0];
+    clParm.tmpx1 = *origin[0];
     clParm.tmpx2 = x;
-    clParm.tmpy1 = pinfo->origin[1];
+    clParm.tmpy1 = *origin[1];
     clParm.tmpy2 = y;
 
     vec2d_t point;
-    V2d_Set(point, FIX2FLT(MIN_OF(x, pinfo->origin[0]) - st->radius),
-                   FIX2FLT(MIN_OF(y, pinfo->origin[1]) - st->radius));
+    V2d_Set(point, de::min(x, *origin[0]) - FIX2FLT(st->radius),
+                   de::min(y, *origin[1]) - FIX2FLT(st->radius));
     V2d_InitBox(clParm.box.arvec2, point);
-    V2d_Set(point, FIX2FLT(MAX_OF(x, pinfo->origin[0]) + st->radius),
-                   FIX2FLT(MAX_OF(y, pinfo->origin[1]) + st->radius));
+    V2d_Set(point, de::max(x, *origin[0]) + FIX2FLT(st->radius),
+                   de::max(y, *origin[1]) + FIX2FLT(st->radius));
     V2d_AddToBox(clParm.box.arvec2, point);
 
-    // Iterate the lines in the contacted blocks.
-
-    World::validCount++;
+    // Iterate the lines in the contacted blocks. World::validCount is not used so
+    // that particles can be moved concurrently; checking a line twice is harmless.
     DE_ASSERT(!clParm.ptcHitLine);
-    map().forAllLinesInBox(clParm.box, [&clParm] (world::Line &line)
+    map().forAllLinesInBoxConcurrently(clParm.box, LIF_ALL, [&clParm] (world::Line &line)
     {
         // Does the bounding box miss the line completely?
         if (clParm.box.maxX <= line.bounds().minX || clParm.box.minX >= line.bounds().maxX ||
@@ -902,8 +1012,8 @@ void Generator::moveParticle(int index)
         }
 
         // Movement must cross the line.
-        if ((line.pointOnSide(Vec2d(FIX2FLT(clParm.tmpx1), FIX2FLT(clParm.tmpy1))) < 0) ==
-            (line.pointOnSide(Vec2d(FIX2FLT(clParm.tmpx2), FIX2FLT(clParm.tmpy2))) < 0))
+        if ((line.pointOnSide(Vec2d(clParm.tmpx1, clParm.tmpy1)) < 0) ==
+            (line.pointOnSide(Vec2d(clParm.tmpx2, clParm.tmpy2)) < 0))
         {
             return LoopContinue;
         }
@@ -925,24 +1035,24 @@ void Generator::moveParticle(int index)
 
         // Determine the opening we have here.
         /// @todo Use R_OpenRange()
-        fixed_t ceil;
+        float ceil;
         if (front->ceiling().height() < back->ceiling().height())
         {
-            ceil = FLT2FIX(front->ceiling().height());
+            ceil = front->ceiling().height();
         }
         else
         {
-            ceil = FLT2FIX(back->ceiling().height());
+            ceil = back->ceiling().height();
         }
 
-        fixed_t floor;
+        float floor;
         if (front->floor().height() > back->floor().height())
         {
-            floor = FLT2FIX(front->floor().height());
+            floor = front->floor().height();
         }
         else
         {
-            floor = FLT2FIX(back->floor().height());
+            floor = back->floor().height();
         }
 
         // There is a backsector. We possibly might hit something.
@@ -960,10 +1070,8 @@ void Generator::moveParticle(int index)
 
     if(clParm.ptcHitLine)
     {
-        fixed_t normal[2], dotp;
-
         // Must survive the touch.
-        if(!touchParticle(pinfo, st, stDef, true))
+        if(!touchParticle(true))
             return;
 
         // There was a hit! Calculate bounce vector.
@@ -973,49 +1081,116 @@ void Generator::moveParticle(int index)
         // - Multiply with bounce.
 
         // Calculate the normal.
-        normal[0] = -FLT2FIX(clParm.ptcHitLine->direction().x);
-        normal[1] = -FLT2FIX(clParm.ptcHitLine->direction().y);
+        const Vec2f normal = -Vec2f(clParm.ptcHitLine->direction());
 
-        if(!normal[0] && !normal[1])
+        if(!normal.x && !normal.y)
             goto quit_iteration;
 
-        // Calculate as floating point so we don't overflow.
-        dotp = FRACUNIT * (DOT2F(pinfo->mov, normal) / DOT2F(normal, normal));
-        VECMUL(normal, dotp);
-        VECSUB(normal, pinfo->mov);
-        VECMULADD(pinfo->mov, 2 * FRACUNIT, normal);
-        VECMUL(pinfo->mov, st->bounce);
+        const Vec2f movXY(*mov[0], *mov[1]);
+        const Vec2f diff = normal * (movXY.dot(normal) / normal.dot(normal)) - movXY;
+        const Vec2f bounced = (movXY + diff * 2) * FIX2FLT(st->bounce);
+        *mov[0] = bounced.x;
+        *mov[1] = bounced.y;
 
         // Continue from the old position.
-        x = pinfo->origin[0];
-        y = pinfo->origin[1];
+        x = *origin[0];
+        y = *origin[1];
         clParm.tmcross = false; // Sector can't change if XY doesn't.
 
         // This line is the latest contacted line.
-        pinfo->contact = clParm.ptcHitLine;
+        pl.contact[index] = clParm.ptcHitLine;
         goto quit_iteration;
     }
 
   quit_iteration:
     // The move is now OK.
-    pinfo->origin[0] = x;
-    pinfo->origin[1] = y;
+    *origin[0] = x;
+    *origin[1] = y;
 
     // Should we update the sector pointer?
     if(clParm.tmcross)
     {
-        pinfo->bspLeaf = &map().bspLeafAt(Vec2d(FIX2FLT(x), FIX2FLT(y)));
+        pl.bspLeaf[index] = &map().bspLeafAt(Vec2d(x, y));
 
         // A BSP leaf with no geometry is not a suitable place for a particle.
-        if(!pinfo->bspLeaf->hasSubspace())
+        if(!pl.bspLeaf[index]->hasSubspace())
         {
             // Kill the particle.
-            pinfo->stage = -1;
+            killParticle(index);
+        }
+    }
+}
+
+void Generator::moveParticles(ParticleSounds *sounds)
+{
+    DE_ASSERT(def);
+
+    ParticleLanes &pl = _particles;
+
+    // Advance the stages.
+    for(int i = 0; i < count; ++i)
+    {
+        if(pl.stage[i] < 0) continue; // Not in use.
+
+        if(pl.tics[i]-- <= 0)
+        {
+            // Advance to next stage.
+            const int next = pl.stage[i] + 1;
+            if(next == def->stages.size() || stages[next].type == PTC_NONE)
+            {
+                // Kill the particle.
+                killParticle(i);
+                continue;
+            }
+
+            setParticleStage(i, next);
+            pl.tics[i] = def->stages[next].tics * (1 - def->stages[next].variance * randomFloat());
+
+            // Change in particle angles?
+            setParticleAngles(pl.yaw[i], pl.pitch[i], def->stages[next].flags,
+                              [this] () { return randomFloat(); });
+
+            // Play a sound?
+            particleSound(Vec3d(pl.origin[0][i], pl.origin[1][i],
+                                particleZAt(pl.bspLeaf[i], pl.origin[2][i])),
+                          def->stages[next].sound, sounds);
+        }
+
+        // Particle rotates according to spin speed.
+        spinParticle(i);
+    }
+
+    // Changes to momentum. Inactive particles have no forces acting on them.
+    /// @todo Do not assume generator is from the CURRENT map.
+    particlekernels::applyForces(count, pl.mov, pl.force, pl.gravity, float(map().gravity()));
+
+    // Sphere force pull and turn.
+    // Only applicable to sourced or untriggered generators. For other
+    // types it's difficult to define the center coordinates.
+    if(source || isUntriggered())
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            if(pl.stage[i] >= 0 && stages[pl.stage[i]].flags.testFlag(ParticleStage::SphereForce))
+            {
+                applySphereForce(i);
+            }
         }
     }
+
+    // Resistance. Very slow movement stops altogether.
+    particlekernels::applyResistance(count, pl.mov, pl.resistance, MIN_MOMENTUM);
+
+    // Collisions with planes and lines.
+    for(int i = 0; i < count; ++i)
+    {
+        if(pl.stage[i] < 0) continue; // Not in use.
+
+        moveParticle(i, sounds);
+    }
 }
 
-void Generator::runTick()
+void Generator::runTick(bool moveNow)
 {
     // Source has been destroyed?
     if(!isUntriggered() && !map().thinkers().isUsedMobjId(srcid))
@@ -1085,34 +1260,98 @@ void Generator::runTick()
         }
     }
 
-    // Move particles.
-    ParticleInfo *pinfo = _pinfo;
-    for(int i = 0; i < count; ++i, pinfo++)
+    if(moveNow)
     {
-        if(pinfo->stage < 0) continue; // Not in use.
+        moveParticles();
+    }
+    else
+    {
+        // Moved later together with the particles of the other generators.
+        _pendingMoves++;
+    }
+}
 
-        if(pinfo->tics-- <= 0)
+/**
+ * Moves the particles of @a gens in worker threads using @a move. Each task moves a
+ * contiguous range of generators and the sounds of each generator are collected
+ * separately, so the outcome does not depend on timing.
+ *
+ * @return  Sounds to be played, for each generator.
+ */
+static List<Generator::ParticleSounds> moveParticlesConcurrently(
+    const List<Generator *> &gens,
+    const std::function<void (Generator &, Generator::ParticleSounds &)> &move)
+{
+    List<Generator::ParticleSounds> sounds(gens.size());
+    int first = 0, batch = 0;
+    for(int i = 0; i < gens.sizei(); ++i)
+    {
+        batch += gens[i]->count;
+        if(batch < PARTICLES_PER_TASK && i < gens.sizei() - 1) continue;
+
+        particleTasks().start([&gens, &sounds, &move, first, i] ()
         {
-            // Advance to next stage.
-            if(++pinfo->stage == def->stages.size() ||
-               stages[pinfo->stage].type == PTC_NONE)
+            for(int k = first; k <= i; ++k)
             {
-                // Kill the particle.
-                pinfo->stage = -1;
-                continue;
+                move(*gens[k], sounds[k]);
             }
+        });
+        first = i + 1;
+        batch = 0;
+    }
+    particleTasks().waitForDone();
+    return sounds;
+}
 
-            pinfo->tics = def->stages[pinfo->stage].tics * (1 - def->stages[pinfo->stage].variance * RNG_RandFloat());
+void Generator::movePendingParticles(Map &map) // static
+{
+    List<Generator *> pending;
+    int particleCount = 0;
+    map.forAllGenerators([&map, &pending, &particleCount] (Generator &gen)
+    {
+        if(gen._pendingMoves > 0)
+        {
+            // The source may have been destroyed after the generator was ticked.
+            if(!gen.isUntriggered() && !map.thinkers().isUsedMobjId(gen.srcid))
+            {
+                gen.source = nullptr;
+            }
+            pending << &gen;
+            particleCount += gen.count * gen._pendingMoves;
+        }
+        return LoopContinue;
+    });
+    if(pending.isEmpty()) return;
 
-            // Change in particle angles?
-            setParticleAngles(pinfo, def->stages[pinfo->stage].flags);
+    auto movePending = [] (Generator &gen, ParticleSounds *sounds)
+    {
+        for(; gen._pendingMoves > 0; gen._pendingMoves--)
+        {
+            gen.moveParticles(sounds);
+        }
+    };
 
-            // Play a sound?
-            particleSound(pinfo->origin, &def->stages[pinfo->stage].sound);
+    if(particleCount < CONCURRENT_MIN_PARTICLES)
+    {
+        for(Generator *gen : pending)
+        {
+            movePending(*gen, nullptr);
         }
+        return;
+    }
 
-        // Try to move.
-        moveParticle(i);
+    const auto sounds = moveParticlesConcurrently(pending,
+        [&movePending] (Generator &gen, ParticleSounds &genSounds)
+    {
+        movePending(gen, &genSounds);
+    });
+
+    for(const ParticleSounds &genSounds : sounds)
+    {
+        for(const ParticleSound &snd : genSounds)
+        {
+            playParticleSound(snd.origin, *snd.sound);
+        }
     }
 }
 
@@ -1134,5 +1373,7 @@ void Generator_Delete(Generator *gen)
 void Generator_Thinker(Generator *gen)
 {
     DE_ASSERT(gen != 0);
-    gen->runTick();
+
+    // The particles are moved after all thinkers have been run.
+    gen->runTick(false /* move later */);
 }
@@ -65,6 +65,7 @@
 #include <doomsday/world/mobjthinker.h>
 #include <doomsday/world/polyobj.h>
 #include <doomsday/world/sector.h>
+#include <doomsday/world/sectorvisibility.h>
 #include <doomsday/world/sky.h>
 #include <doomsday/world/thinkers.h>
 #include <doomsday/world/bsp/partitioner.h>
@@ -72,6 +73,9 @@
 #include <de/bitarray.h>
 #include <de/logbuffer.h>
 #include <de/hash.h>
+#include <de/metadatabank.h>
+#include <de/reader.h>
+#include <de/writer.h>
 #include <de/rectangle.h>
 #include <de/charsymbols.h>
 #include <de/legacy/aabox.h>
@@ -90,6 +94,12 @@ using world::World;
 /// status should be removed fairly quickly.
 #define CLMOBJ_TIMEOUT  4000
 
+DE_STATIC_STRING(RADIO_CACHE_CATEGORY,  "FakeRadio");
+DE_STATIC_STRING(REVERB_CACHE_CATEGORY, "ReverbSubspaces");
+
+/// Incremented when the cached acoustics or radio data changes.
+static const duint32 MAP_GEOMETRY_CACHE_VERSION = 1;
+
 DE_PIMPL(Map)
 , DE_OBSERVES(ThinkerData, Deletion)
 #ifdef __SERVER__
@@ -214,6 +224,8 @@ DE_PIMPL(Map)
 
     ClMobjHash clMobjHash;
 
+    Block geometryCacheId; ///< Determined on demand.
+
     Impl(Public *i)
         : Base(i)
     {}
@@ -604,13 +616,13 @@ DE_PIMPL(Map)
             {
                 if (!gen) continue;
 
-                const ParticleInfo *pInfo = gen->particleInfo();
-                for (int i = 0; i < gen->count; ++i, pInfo++)
+                const Generator::ParticleLanes &particles = gen->particles();
+                for (int i = 0; i < gen->count; ++i)
                 {
-                    if (pInfo->stage < 0 || !pInfo->bspLeaf)
+                    if (particles.stage[i] < 0 || !particles.bspLeaf[i])
                         continue;
 
-                    int listIndex = pInfo->bspLeaf->sectorPtr()->indexInMap();
+                    int listIndex = particles.bspLeaf[i]->sectorPtr()->indexInMap();
                     DE_ASSERT((unsigned)listIndex < gens.listsSize);
 
                     // Must check that it isn't already there...
@@ -641,6 +653,104 @@ DE_PIMPL(Map)
         }
     }
 
+    /**
+     * Returns an identifier for the geometry of the map, including the subspaces of the
+     * BSP. Data derived from the geometry alone is cached in the MetadataBank using this.
+     */
+    const Block &geometryId()
+    {
+        if (geometryCacheId.isEmpty())
+        {
+            Block data;
+            Writer writer(data);
+            writer << MAP_GEOMETRY_CACHE_VERSION
+                   << world::SectorVisibility::geometryId(self())
+                   << dint32(self().subspaceCount());
+            self().forAllSubspaces([&writer] (world::ConvexSubspace &sub)
+            {
+                const AABoxd &box = sub.poly().bounds();
+                writer << box.minX << box.minY << box.maxX << box.maxY
+                       << dint32(sub.hasSubsector()? sub.subsector().sector().indexInMap() : -1);
+                return LoopContinue;
+            });
+            geometryCacheId = data.md5Hash();
+        }
+        return geometryCacheId;
+    }
+
+    /**
+     * Reads a cached list of indices for each element: a count followed by the indices.
+     * All indices must be in the range [0, @a indexLimit).
+     *
+     * @return  @c true if the cached lists were valid.
+     */
+    bool readCachedLists(const String &category, int listCount, int indexLimit,
+                         List<List<dint32>> &lists)
+    {
+        try
+        {
+            if (Block cached = MetadataBank::get().check(category, geometryId()))
+            {
+                cached = cached.decompressed();
+                Reader reader(cached);
+                reader.withHeader();
+
+                dint32 count;
+                reader >> count;
+                if (count != listCount) return false;
+
+                lists.resize(dsize(count));
+                for (auto &list : lists)
+                {
+                    dint32 size;
+                    reader >> size;
+                    if (size < 0 || size > indexLimit) return false;
+                    list.resize(dsize(size));
+                    for (dint32 &index : list)
+                    {
+                        reader >> index;
+                        if (index < 0 || index >= indexLimit) return false;
+                    }
+                }
+                return true;
+            }
+        }
+        catch (const Error &er)
+        {
+            LOGDEV_MAP_WARNING("Corrupt cached %s: %s") << category << er.asText();
+        }
+        return false;
+    }
+
+    void cacheLists(const String &category, const List<List<dint32>> &lists)
+    {
+        Block buf;
+        Writer writer(buf);
+        writer.withHeader();
+        writer << dint32(lists.size());
+        for (const auto &list : lists)
+        {
+            writer << dint32(list.size());
+            for (dint32 index : list) writer << index;
+        }
+        MetadataBank::get().setMetadata(category, geometryId(), buf.compressed());
+    }
+
+    /// Subsectors of all sectors, in order.
+    List<Subsector *> allSubsectors()
+    {
+        List<Subsector *> subsecs;
+        self().forAllSectors([&subsecs] (world::Sector &sector)
+        {
+            return sector.forAllSubsectors([&subsecs] (world::Subsector &subsec)
+            {
+                subsecs << &subsec.as<Subsector>();
+                return LoopContinue;
+            });
+        });
+        return subsecs;
+    }
+
     void thinkerBeingDeleted(thinker_s &th)
     {
         clMobjHash.remove(th.id);
@@ -668,6 +778,24 @@ void Map::initRadio()
         return LoopContinue;
     });
 
+    // The shadow lines only depend on the geometry, so they may have been cached.
+    {
+        List<List<dint32>> cached;
+        if (d->readCachedLists(RADIO_CACHE_CATEGORY(), subspaceCount(), sideCount(), cached))
+        {
+            for (int i = 0; i < cached.sizei(); ++i)
+            {
+                auto &subspace = this->subspace(i).as<ConvexSubspace>();
+                for (dint32 sideIndex : cached[i])
+                {
+                    subspace.addShadowLine(sidePtr(sideIndex)->as<LineSide>());
+                }
+            }
+            LOGDEV_GL_MSG("Using cached shadow lines (%.2f seconds)") << begunAt.since();
+            return;
+        }
+    }
+
     /// The algorithm:
     ///
     /// 1. Use the subspace blockmap to look for all the blocks that are within the line's shadow
@@ -737,9 +865,63 @@ void Map::initRadio()
         return LoopContinue;
     });
 
+    List<List<dint32>> lists;
+    forAllSubspaces([&lists] (world::ConvexSubspace &sub)
+    {
+        List<dint32> sides;
+        sub.as<ConvexSubspace>().forAllShadowLines([&sides] (LineSide &side)
+        {
+            sides << toSideIndex(side.line().indexInMap(), side.sideId());
+            return LoopContinue;
+        });
+        lists << sides;
+        return LoopContinue;
+    });
+    d->cacheLists(RADIO_CACHE_CATEGORY(), lists);
+
     LOGDEV_GL_MSG("Completed in %.2f seconds") << begunAt.since();
 }
 
+void Map::initReverb()
+{
+    LOG_AS("Map::initReverb");
+
+    Time begunAt;
+
+    const auto subsecs = d->allSubsectors();
+
+    // The neighborhoods only depend on the geometry, so they may have been cached.
+    List<List<dint32>> lists;
+    if (d->readCachedLists(REVERB_CACHE_CATEGORY(), subsecs.sizei(), subspaceCount(), lists))
+    {
+        for (int i = 0; i < subsecs.sizei(); ++i)
+        {
+            List<ConvexSubspace *> subspaces;
+            for (dint32 index : lists[i])
+            {
+                subspaces << &subspace(index).as<ConvexSubspace>();
+            }
+            subsecs[i]->setReverbSubspaces(subspaces);
+        }
+        LOGDEV_AUDIO_MSG("Using cached reverb subspaces (%.2f seconds)") << begunAt.since();
+        return;
+    }
+
+    lists.clear();
+    for (const Subsector *subsec : subsecs)
+    {
+        List<dint32> indices;
+        for (const ConvexSubspace *sub : subsec->reverbSubspaces())
+        {
+            indices << sub->indexInMap();
+        }
+        lists << indices;
+    }
+    d->cacheLists(REVERB_CACHE_CATEGORY(), lists);
+
+    LOGDEV_AUDIO_MSG("Completed in %.2f seconds") << begunAt.since();
+}
+
 void Map::initContactBlockmaps()
 {
     d->initContactBlockmaps();
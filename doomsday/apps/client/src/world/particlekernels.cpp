@@ -0,0 +1,52 @@
+/** @file particlekernels.cpp  Momentum updates of particles stored in lanes.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "world/particlekernels.h"
+
+namespace particlekernels {
+
+void applyForces(int count, float *const mov[3], const float *const force[3],
+                 const float *gravity, float mapGravity)
+{
+    float *movX = mov[0], *movY = mov[1], *movZ = mov[2];
+    const float *forceX = force[0], *forceY = force[1], *forceZ = force[2];
+    for (int i = 0; i < count; ++i)
+    {
+        movX[i] += forceX[i];
+        movY[i] += forceY[i];
+        movZ[i] += forceZ[i] - mapGravity * gravity[i];
+    }
+}
+
+void applyResistance(int count, float *const mov[3], const float *resistance,
+                     float minMomentum)
+{
+    for (int k = 0; k < 3; ++k)
+    {
+        float *lane = mov[k];
+        for (int i = 0; i < count; ++i)
+        {
+            const float m = lane[i] * resistance[i];
+            // Very slow movement stops altogether.
+            lane[i] = (m < minMomentum && m > -minMomentum)? 0.f : m;
+        }
+    }
+}
+
+} // namespace particlekernels
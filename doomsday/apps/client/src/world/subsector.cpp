@@ -214,8 +214,8 @@ DE_PIMPL(Subsector)
     GeometryGroups geomGroups;
 
     /// Subspaces in the neighborhood effecting environmental audio characteristics.
-    typedef Set<ConvexSubspace *> ReverbSubspaces;
-    ReverbSubspaces reverbSubspaces;
+    List<ConvexSubspace *> reverbSubspaces;
+    bool needFindReverbSubspaces = true;
 
     /// Environmental audio config.
     AudioEnvironment reverb;
@@ -796,7 +796,8 @@ DE_PIMPL(Subsector)
     void addReverbSubspace(ConvexSubspace *subspace)
     {
         if (!subspace) return;
-        reverbSubspaces.insert(subspace);
+        reverbSubspaces << subspace;
+        subspace->addReverbListener(self());
     }
 
     /**
@@ -813,6 +814,8 @@ DE_PIMPL(Subsector)
     {
         const Map &map = self().sector().map().as<Map>();
 
+        needFindReverbSubspaces = false;
+
         AABoxd box = self().bounds();
         box.minX -= 128;
         box.minY -= 128;
@@ -849,7 +852,7 @@ DE_PIMPL(Subsector)
     void updateReverb()
     {
         // Need to initialize?
-        if (reverbSubspaces.isEmpty())
+        if (needFindReverbSubspaces)
         {
             findReverbSubspaces();
         }
@@ -863,7 +866,8 @@ DE_PIMPL(Subsector)
 
         for (ConvexSubspace *subspace : reverbSubspaces)
         {
-            if (subspace->updateAudioEnvironment())
+            // Only the subspaces whose characteristics have changed are recalculated.
+            if (subspace->prepareAudioEnvironment())
             {
                 const auto &aenv = subspace->audioEnvironment();
 
@@ -1296,8 +1300,9 @@ DE_PIMPL(Subsector)
         const bool planeIsInterior = (&plane == &self().visPlane(plane.indexInSector()));
         if (planeIsInterior)
         {
-            // We'll need to recalculate environmental audio characteristics.
-            needReverbUpdate = true;
+            // We'll need to recalculate environmental audio characteristics, here and
+            // in the neighborhood.
+            self().markAudioEnvironmentDirty();
 
             // Check if there are any camera players in the subsector. If their height
             // is now above the ceiling/below the floor they are now in the void.
@@ -1676,6 +1681,36 @@ void Subsector::markReverbDirty(bool yes)
     d->needReverbUpdate = yes;
 }
 
+void Subsector::markAudioEnvironmentDirty()
+{
+    forAllSubspaces([] (world::ConvexSubspace &subspace)
+    {
+        subspace.as<ConvexSubspace>().markAudioEnvironmentDirty();
+        return LoopContinue;
+    });
+    d->needReverbUpdate = true;
+}
+
+const List<ConvexSubspace *> &Subsector::reverbSubspaces() const
+{
+    if (d->needFindReverbSubspaces)
+    {
+        d->findReverbSubspaces();
+    }
+    return d->reverbSubspaces;
+}
+
+void Subsector::setReverbSubspaces(const List<ConvexSubspace *> &subspaces)
+{
+    d->reverbSubspaces.clear();
+    for (ConvexSubspace *subspace : subspaces)
+    {
+        d->addReverbSubspace(subspace);
+    }
+    d->needFindReverbSubspaces = false;
+    d->needReverbUpdate        = true;
+}
+
 const Subsector::AudioEnvironment &Subsector::reverb() const
 {
     // Perform any scheduled update now.
@@ -49,6 +49,7 @@ struct material_s;
 extern int svMaxPlayers;
 extern int allowFrames;    ///< Allow sending of frames.
 extern int frameInterval;  ///< In tics.
+extern int pvsMode;        ///< Interest management: 0=off, 1=deprioritize, 2=exclude.
 //extern int netRemoteUser;  ///< The client who is currently logged in.
 extern char *netPassword;       ///< Remote login password.
 
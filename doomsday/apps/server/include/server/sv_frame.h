@@ -28,7 +28,14 @@
 #  error "server/sv_frame.h requires C++"
 #endif
 
+struct delta_s;
+
 void Sv_TransmitFrame();
 de::dsize Sv_GetMaxFrameSize(int playerNumber);
 
+/**
+ * Returns the number of bytes @a delta would take in a frame packet.
+ */
+de::dsize Sv_DeltaSize(const struct delta_s *delta);
+
 #endif  // SERVER_FRAME_H
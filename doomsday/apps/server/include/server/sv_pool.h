@@ -65,6 +65,10 @@ typedef enum deltastate_e {
  * All delta structures begin the same way (with a delta_t).
  * That way they can all be linked into the same hash table.
  */
+// delta_t::pvsCounted flags.
+#define DPVS_WITHHELD           0x1
+#define DPVS_DEPRIORITIZED      0x2
+
 typedef struct delta_s {
     // Links to the next and previous delta in the hash.
     struct delta_s* next, *prev;
@@ -93,6 +97,10 @@ typedef struct delta_s {
     uint            timeStamp;
 
     int             flags;
+
+    // Interest management statistics that already include this delta
+    // (DPVS_* flags).
+    byte            pvsCounted;
 } delta_t;
 
 typedef mobj_t  dt_mobj_t;
@@ -220,6 +228,7 @@ typedef struct ownerinfo_s {
     angle_t         angle; // Angle can change rapidly => not very important
     float           speed;
     uint            ackThreshold; // Expected ack time in milliseconds
+    int             sector; // Index of the sector the owner is in (-1 if none)
 } ownerinfo_t;
 
 /**
@@ -254,6 +263,13 @@ typedef struct pool_s {
     int             queueSize;
     int             allocatedSize;
     delta_t**       queue;
+
+    // Interest management statistics. Reset when the pool is drained.
+    uint64_t        sentDeltas;
+    uint64_t        sentBytes;
+    uint64_t        pvsWithheld; // Not sent because outside the owner's PVS.
+    uint64_t        pvsWithheldBytes; // Total size of the withheld deltas.
+    uint64_t        pvsDeprioritized; // Rated lower because outside the owner's PVS.
 } pool_t;
 
 void            Sv_InitPools(void);
@@ -744,6 +744,20 @@ writeDeltaLength:
 #endif
 }
 
+dsize Sv_DeltaSize(const delta_t *delta)
+{
+    DE_ASSERT(delta);
+
+    // Write the delta into a scratch buffer instead of the message.
+    Writer1 *msg = ::msgWriter;
+    ::msgWriter = Writer_NewWithDynamicBuffer(0);
+    Sv_WriteDelta(delta);
+    const dsize size = Writer_Size(::msgWriter);
+    Writer_Delete(::msgWriter);
+    ::msgWriter = msg;
+    return size;
+}
+
 /**
  * Returns an estimate for the maximum frame size appropriate for the client.
  * The bandwidth rating is updated whenever a frame is sent.
@@ -853,6 +867,9 @@ void Sv_SendFrame(dint plrNum)
         }
 
         // Successfully written.
+        pool->sentDeltas++;
+        pool->sentBytes += Writer_Size(::msgWriter) - lastStart;
+
         // Update the sent delta's state.
         if (delta->state == DELTA_NEW)
         {
@@ -23,12 +23,16 @@
 
 #include "de_base.h"
 #include "server/sv_pool.h"
+#include "server/sv_def.h"
+#include "server/sv_frame.h"
 #include "def_main.h"  // Def_SameStateSequence
 #include "network/net_main.h"
 #include "world/p_object.h"
 #include "world/p_players.h"
 
+#include <doomsday/world/bspleaf.h>
 #include <doomsday/world/sector.h>
+#include <doomsday/world/sectorvisibility.h>
 #include <doomsday/world/thinkers.h>
 #include <de/legacy/mathutil.h>
 #include <de/legacy/timer.h>
@@ -50,6 +54,9 @@ using world::Surface;
 // Maximum difference in plane height where the absolute height doesn't need to be sent.
 #define PLANE_SKIP_LIMIT            ( 40 )
 
+// Score divisor for deltas outside the owner's potentially visible set.
+#define PVS_HIDDEN_SCORE_DIVISOR    ( 100 )
+
 struct reg_mobj_t
 {
     reg_mobj_t *next;  ///< In the register hash.
@@ -93,6 +100,8 @@ cregister_t initialRegister;
 
 static dfloat deltaBaseScores[NUM_DELTA_TYPES];
 
+dint pvsMode = 0; ///< cvar: 0=off, 1=deprioritize, 2=exclude hidden deltas.
+
 // Keep this zeroed out. Used if the register doesn't have data for
 // the mobj being compared.
 static ThinkerT<dt_mobj_t> dummyZeroMobj;
@@ -151,6 +160,13 @@ void Sv_InitPools()
     Sv_RegisterWorld(&::worldRegister, false);
     Sv_RegisterWorld(&::initialRegister, true);
 
+    if (::pvsMode)
+    {
+        // Determine sector visibility now rather than when the first frame is rated.
+        // Otherwise it is only determined if interest management gets enabled.
+        ServerWorld::get().map().sectorVisibility();
+    }
+
     // How much time did we spend?
     LOG_MAP_VERBOSE("World registered in %.2f seconds") << startedAt.since();
 }
@@ -989,6 +1005,7 @@ void Sv_UpdateOwnerInfo(pool_t *pool)
 
     // Pointer to the owner's pool.
     info->pool = pool;
+    info->sector = -1;
 
     if (plr->publicData().mo)
     {
@@ -997,6 +1014,11 @@ void Sv_UpdateOwnerInfo(pool_t *pool)
         V3d_Copy(info->origin, mob->origin);
         info->angle = mob->angle;
         info->speed = M_ApproxDistance(mob->mom[0], mob->mom[1]);
+
+        if (const Sector *sector = Mobj_Sector(mob))
+        {
+            info->sector = sector->indexInMap();
+        }
     }
 
     // The acknowledgement threshold is a multiple of the average ack time of the
@@ -1673,6 +1695,11 @@ void Sv_DrainPool(uint clientNumber)
     // Reset the counters.
     pool->setDealer = 0;
     pool->resendDealer = 0;
+    pool->sentDeltas = 0;
+    pool->sentBytes = 0;
+    pool->pvsWithheld = 0;
+    pool->pvsWithheldBytes = 0;
+    pool->pvsDeprioritized = 0;
 
     Sv_PoolQueueClear(pool);
 
@@ -2632,6 +2659,51 @@ dd_bool Sv_IsPostponedDelta(void* deltaPtr, ownerinfo_t* info)
     return false;
 }
 
+/**
+ * Determines whether the delta's entity is in the potentially visible set of
+ * the pool owner. Deltas without a known location are always visible, as are
+ * sounds (they can be heard around corners) and player deltas.
+ */
+dd_bool Sv_IsDeltaPotentiallyVisible(const delta_t *delta, const ownerinfo_t *info)
+{
+    if (info->sector < 0) return true;
+
+    const world::Map &map = ServerWorld::get().map();
+    const world::SectorVisibility &pvs = map.sectorVisibility();
+
+    if (delta->type == DT_MOBJ)
+    {
+        // Removals must always get through.
+        if (Sv_IsNullMobjDelta(delta)) return true;
+
+        // Use the registered position of the mobj.
+        const mobj_t *mo = &((const mobjdelta_t *) delta)->mo;
+        const Sector *sector = map.bspLeafAt(Vec2d(mo->origin[VX], mo->origin[VY])).sectorPtr();
+        return !sector || pvs.isVisible(sector->indexInMap(), info->sector);
+    }
+
+    if (delta->type == DT_SECTOR)
+    {
+        return pvs.isVisible(delta->id, info->sector);
+    }
+
+    if (delta->type == DT_SIDE)
+    {
+        const auto &line = map.side(delta->id).line();
+        for (dint i = 0; i < 2; ++i)
+        {
+            const world::LineSide &side = line.side(i);
+            if (side.hasSector() && pvs.isVisible(side.sector().indexInMap(), info->sector))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * Calculate a priority score for the delta. A higher score indicates
  * greater importance.
@@ -2649,6 +2721,7 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
 
     // The importance doubles normally in 1 second.
     float ageScoreDouble = 1.0f;
+    bool isHidden = false;
 
     if (Sv_IsPostponedDelta(delta, info))
     {
@@ -2656,6 +2729,29 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
         return false;
     }
 
+    // The owner can't see it, so it can wait until the entity becomes visible.
+    if (::pvsMode && !Sv_IsDeltaPotentiallyVisible(delta, info))
+    {
+        // The statistics count each delta only once, although it gets rated again
+        // for every frame.
+        if (::pvsMode >= 2)
+        {
+            if (!(delta->pvsCounted & DPVS_WITHHELD))
+            {
+                delta->pvsCounted |= DPVS_WITHHELD;
+                info->pool->pvsWithheld++;
+                info->pool->pvsWithheldBytes += Sv_DeltaSize(delta);
+            }
+            return false;
+        }
+        if (!(delta->pvsCounted & DPVS_DEPRIORITIZED))
+        {
+            delta->pvsCounted |= DPVS_DEPRIORITIZED;
+            info->pool->pvsDeprioritized++;
+        }
+        isHidden = true;
+    }
+
     // Calculate the distance to the delta's origin.
     // If no distance can be determined, it's 1.0.
     distance = Sv_DeltaDistance(delta, info);
@@ -2734,6 +2830,12 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
             score *= 1.2f;
     }
 
+    if (isHidden)
+    {
+        // Only sent if there is room to spare.
+        score /= PVS_HIDDEN_SCORE_DIVISOR;
+    }
+
     // This is the final score. Only positive scores are accepted in
     // the frame (deltas with nonpositive scores as ignored).
     delta->score = score;
@@ -26,6 +26,7 @@
 #include "remotefeeduser.h"
 #include "server/sv_def.h"
 #include "server/sv_frame.h"
+#include "server/sv_pool.h"
 #include "network/net_main.h"
 #include "network/net_buf.h"
 #include "network/net_event.h"
@@ -213,6 +214,19 @@ DE_PIMPL(ServerSystem)
         {
             LOG_MSG("No clients connected");
         }
+        else if (::pvsMode)
+        {
+            LOG_MSG(_E(b) "Interest management (server-pvs %i):") << ::pvsMode;
+            for (int i = 1; i < DDMAXPLAYERS; ++i)
+            {
+                if (!DD_Player(i)->remoteUserId) continue;
+
+                const pool_t *pool = Sv_GetPool(i);
+                LOG_MSG("  %2i withheld %i deltas (%.1f KB), deprioritized %i, sent %.1f KB")
+                        << i << pool->pvsWithheld << pool->pvsWithheldBytes / 1024.0
+                        << pool->pvsDeprioritized << pool->sentBytes / 1024.0;
+            }
+        }
 
         if (shellUsers.count())
         {
@@ -434,6 +448,7 @@ void Server_Register()
     C_VAR_BYTE      ("server-latencies",        &::netShowLatencies, 0, 0, 1);
     C_VAR_INT       ("server-frame-interval",   &::frameInterval, CVF_NO_MAX, 0, 0);
     C_VAR_INT       ("server-player-limit",     &::svMaxPlayers, 0, 0, DDMAXPLAYERS);
+    C_VAR_INT       ("server-pvs",              &::pvsMode, 0, 0, 2);
 
     C_VAR_CHARPTR   ("net-ip-address", &nptIPAddress, 0, 0, 0);
     C_VAR_INT       ("net-ip-port",    &nptIPPort, CVF_NO_MAX, 0, 0);
@@ -316,6 +316,12 @@ public:
      */
     static MetadataBank &metadataBank();
 
+    /**
+     * Determines if the metadata cache is available. It is created when the
+     * subsystems are initialized.
+     */
+    static bool hasMetadataBank();
+
     /**
      * Returns the root folder of the file system.
      */
@@ -169,6 +169,17 @@ public:
      */
     bool remove() const;
 
+    /**
+     * Renames (moves) the native file at the path. An existing file at @a newPath is
+     * replaced. If the operating system supports it, the replacement is atomic: the
+     * destination is never missing or partially written.
+     *
+     * @param newPath  New path of the file.
+     *
+     * @return @c true on success.
+     */
+    bool renameTo(const NativePath &newPath) const;
+
 public:
     /**
      * Returns the current native working path.
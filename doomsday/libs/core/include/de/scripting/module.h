@@ -37,6 +37,9 @@ class Script;
  * is executed only the first time it gets imported -- subsequent calls simply
  * provide a reference to the existing module's namespace.
  *
+ * The parsed statements of modules are cached in MetadataBank, so a module whose
+ * source has not changed is not parsed again in later sessions.
+ *
  * @ingroup script
  */
 class Module
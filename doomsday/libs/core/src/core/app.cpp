@@ -923,6 +923,11 @@ MetadataBank &App::metadataBank()
     return *DE_APP->d->metaBank;
 }
 
+bool App::hasMetadataBank()
+{
+    return appExists() && DE_APP->d->metaBank;
+}
+
 PackageLoader &App::packageLoader()
 {
     return DE_APP->d->packageLoader;
@@ -25,7 +25,6 @@
 #include "de/huffman.h"
 #include "de/app.h"
 #include "de/log.h"
-#include "de/byterefarray.h"
 
 // Heap relations.
 #define HEAP_PARENT(i)  (((i) + 1)/2 - 1)
@@ -123,9 +122,18 @@ struct HuffCode {
     duint length;
 };
 
-struct HuffBuffer {
-    dbyte *data;
-    dsize size;
+/// Number of bits resolved with one lookup in the decoding table. Must be at least
+/// as long as the longest code (currently 10 bits).
+static const int DECODE_BITS = 12;
+
+/**
+ * Entry in the decoding table, indexed by the next DECODE_BITS bits of the coded
+ * message. Resolves one or two complete codes.
+ */
+struct HuffDecodeEntry {
+    dbyte  values[2];
+    duint8 firstLength;  ///< Length of the first code.
+    duint8 totalLength;  ///< Length of both codes, or firstLength if there is only one.
 };
 
 struct Huffman
@@ -136,12 +144,19 @@ struct Huffman
     // The lookup table for encoding.
     HuffCode huffCodes[256];
 
+    // The lookup table for decoding.
+    HuffDecodeEntry decodeTable[1 << DECODE_BITS];
+
+    duint minLength = 0;
+    duint maxLength = 0;
+
     /**
-     * Builds the Huffman tree and initializes the code lookup.
+     * Builds the Huffman tree and initializes the code lookups.
      */
     Huffman() : huffRoot(0)
     {
         zap(huffCodes);
+        zap(decodeTable);
 
         HuffQueue queue;
         HuffNode *node;
@@ -171,8 +186,9 @@ struct Huffman
         // The root is the last node left in the queue.
         huffRoot = Huff_QueueExtract(&queue);
 
-        // Fill in the code lookup table.
+        // Fill in the code lookup tables.
         Huff_BuildLookup(huffRoot, 0, 0);
+        Huff_BuildDecodeTable();
 
 #if 0
         if (qApp->arguments().contains("-huffcodes"))
@@ -327,19 +343,58 @@ struct Huffman
     }
 
     /**
-     * Checks if the encoding/decoding buffer can hold the given number of
-     * bytes. If not, reallocates the buffer.
+     * Follows the bits of @a bits from the root, least significant bit first, until
+     * a leaf is reached. Returns the leaf, or @c nullptr if @a count bits were not
+     * enough.
      */
-    static void Huff_ResizeBuffer(HuffBuffer *buffer, dsize neededSize)
+    const HuffNode *Huff_FindLeaf(duint bits, duint count, duint *length) const
     {
-        while (neededSize > buffer->size)
+        const HuffNode *node = huffRoot;
+        for (duint i = 0; i < count; ++i)
         {
-            if (!buffer->size)
-                buffer->size = std::max(dsize(1024), neededSize);
-            else
-                buffer->size *= 2;
+            node = (bits & (1 << i)? node->right : node->left);
+            if (!node->left && !node->right)
+            {
+                *length = i + 1;
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Fills in the decoding table. Each entry holds the code that begins with the
+     * entry's index bits, and the following code, too, if it fits in the index.
+     */
+    void Huff_BuildDecodeTable()
+    {
+        minLength = 32;
+        maxLength = 0;
+        for (const HuffCode &hc : huffCodes)
+        {
+            minLength = std::min(minLength, hc.length);
+            maxLength = std::max(maxLength, hc.length);
+        }
+        DE_ASSERT(maxLength <= duint(DECODE_BITS));
+
+        for (duint index = 0; index < (1 << DECODE_BITS); ++index)
+        {
+            HuffDecodeEntry &entry = decodeTable[index];
+            duint length = 0;
+            const HuffNode *first = Huff_FindLeaf(index, DECODE_BITS, &length);
+            DE_ASSERT(first);
+            entry.values[0]   = first->value;
+            entry.firstLength = duint8(length);
+            entry.totalLength = duint8(length);
+
+            duint secondLength = 0;
+            if (const HuffNode *second = Huff_FindLeaf(index >> length, DECODE_BITS - length,
+                                                       &secondLength))
+            {
+                entry.values[1]    = second->value;
+                entry.totalLength += duint8(secondLength);
+            }
         }
-        buffer->data = reinterpret_cast<dbyte *>(realloc(buffer->data, buffer->size));
     }
 
     /**
@@ -355,146 +410,103 @@ struct Huffman
         }
     }
 
-    /**
-     * Free the buffer.
-     */
-    void Huff_DestroyBuffer(HuffBuffer *buffer)
+    Block encode(const dbyte *data, dsize size) const
     {
-        free(buffer->data);
-        zapPtr(buffer);
-    }
-
-    dbyte *encode(const dbyte *data, dsize size, dsize *encodedSize) const
-    {
-        HuffBuffer huffEnc;
-        dsize i;
-        duint code;
-        int remaining, fits;
-        dbyte *out, bit;
-
-        zap(huffEnc);
-
-        // The encoded message is never twice the original size
-        // (longest codes are currently 11 bits).
-        Huff_ResizeBuffer(&huffEnc, 2 * size);
-
-        // First three bits of the encoded data contain the number of bits (-1)
-        // in the last dbyte of the encoded data. It's written when we have
+        // The first three bits of the encoded data contain the number of bits (-1)
+        // in the last byte of the encoded data. They are written when we have
         // finished the encoding.
-        bit = 3;
-
-        // Clear the first dbyte of the result.
-        out = huffEnc.data;
-        *out = 0;
+        Block encoded((3 + size * maxLength + 7) / 8 + 4);
+        dbyte *out = encoded.data();
 
-        for (i = 0; i < size; ++i)
+        duint64 pending = 0;
+        int pendingBits = 3;
+        for (dsize i = 0; i < size; ++i)
         {
-            remaining = huffCodes[data[i]].length;
-            code = huffCodes[data[i]].code;
-
-            while (remaining > 0)
+            const HuffCode &hc = huffCodes[data[i]];
+            pending |= duint64(hc.code) << pendingBits;
+            pendingBits += hc.length;
+            if (pendingBits >= 32)
             {
-                fits = 8 - bit;
-                if (fits > remaining)
-                    fits = remaining;
-
-                // Write the bits that fit the current dbyte.
-                *out |= code << bit;
-                code >>= fits;
-                remaining -= fits;
-
-                // Advance the bit position.
-                bit += fits;
-                if (bit == 8)
-                {
-                    bit = 0;
-                    *++out = 0;
-                }
+                out[0] = dbyte(pending);
+                out[1] = dbyte(pending >> 8);
+                out[2] = dbyte(pending >> 16);
+                out[3] = dbyte(pending >> 24);
+                out += 4;
+                pending >>= 32;
+                pendingBits -= 32;
             }
         }
-
-        // If the last dbyte is empty, back up.
-        if (bit == 0)
+        while (pendingBits > 0)
         {
-            out--;
-            bit = 8;
+            *out++ = dbyte(pending);
+            pending >>= 8;
+            pendingBits -= 8;
         }
+        encoded.resize(dsize(out - encoded.data()));
 
-        if (encodedSize)
-            *encodedSize = out - huffEnc.data + 1;
-
-        // The number of valid bits - 1 in the last dbyte.
-        huffEnc.data[0] |= bit - 1;
-
-        return huffEnc.data;
+        // The number of valid bits - 1 in the last byte.
+        encoded.data()[0] |= dbyte(8 + pendingBits - 1);
+        return encoded;
     }
 
-    dbyte *decode(const dbyte *data, dsize size, dsize *decodedSize) const
+    Block decode(const dbyte *data, dsize size) const
     {
-        HuffBuffer huffDec;
-        HuffNode *node;
-        dsize outBytes = 0;
-        const dbyte *in = data;
-        const dbyte *lastIn = in + size - 1;
-        dbyte bit = 3, lastByteBits;
+        if (!data || size == 0) return Block();
 
-        if (!data || size == 0) return nullptr;
+        const dbyte *in    = data;
+        const dbyte *inEnd = data + size;
 
-        zap(huffDec);
-        Huff_ResizeBuffer(&huffDec, 256);
+        // The first three bits contain the number of valid bits in the last byte.
+        dint64 remaining = dint64(size - 1) * 8 + (*in & 7) + 1 - 3;
+        if (remaining <= 0) return Block();
 
-        // The first three bits contain the number of valid bits in
-        // the last dbyte.
-        lastByteBits = (*in & 7) + 1;
+        Block decoded(dsize(remaining) / minLength + 2);
+        dbyte *out = decoded.data();
 
-        // Start from the root node.
-        node = huffRoot;
+        // Bits are consumed from the least significant end.
+        duint64 bits = 0;
+        int bitCount = 0;
+        auto refill = [&] () {
+            while (bitCount <= 56 && in < inEnd)
+            {
+                bits |= duint64(*in++) << bitCount;
+                bitCount += 8;
+            }
+        };
+        refill();
+        bits >>= 3;
+        bitCount -= 3;
 
-        while (in < lastIn || bit < lastByteBits)
+        while (remaining > 0)
         {
-            // Go left or right?
-            if (*in & (1 << bit))
+            if (bitCount < DECODE_BITS) refill();
+
+            const HuffDecodeEntry &entry = decodeTable[bits & ((1 << DECODE_BITS) - 1)];
+            int length;
+            if (entry.totalLength <= remaining)
             {
-                node = node->right;
+                // One or two complete codes.
+                out[0] = entry.values[0];
+                out[1] = entry.values[1];
+                out += (entry.totalLength > entry.firstLength? 2 : 1);
+                length = entry.totalLength;
             }
-            else
+            else if (entry.firstLength <= remaining)
             {
-                node = node->left;
+                *out++ = entry.values[0];
+                length = entry.firstLength;
             }
-
-            // Did we arrive at a leaf?
-            DE_ASSERT(node);
-            if (!node->left && !node->right)
-            {
-                // This node represents a value.
-                huffDec.data[outBytes++] = node->value;
-
-                // Should we allocate more memory?
-                if (outBytes == huffDec.size)
-                {
-                    Huff_ResizeBuffer(&huffDec, 2 * huffDec.size);
-                }
-
-                // Back to the root.
-                node = huffRoot;
-            }
-
-            // Advance bit position.
-            if (++bit == 8)
+            else
             {
-                bit = 0;
-                ++in;
-
-                // Out of buffer?
-                if (in > lastIn)
-                    break;
+                // Incomplete code at the end.
+                break;
             }
+            bits >>= length;
+            bitCount  -= length;
+            remaining -= length;
         }
-        if (decodedSize)
-        {
-            *decodedSize = outBytes;
-        }
-        return huffDec.data;
+        decoded.resize(dsize(out - decoded.data()));
+        return decoded;
     }
 };
 
@@ -504,28 +516,12 @@ static internal::Huffman huff;
 
 Block codec::huffmanEncode(const Block &data)
 {
-    Block result;
-    dsize size = 0;
-    dbyte *coded = huff.encode(data.data(), data.size(), &size);
-    if (coded)
-    {
-        result.copyFrom(ByteRefArray(coded, size), 0, size);
-        free(coded);
-    }
-    return result;
+    return huff.encode(data.data(), data.size());
 }
 
 Block codec::huffmanDecode(const Block &codedData)
 {
-    Block result;
-    dsize size = 0;
-    dbyte *decoded = huff.decode(codedData.data(), codedData.size(), &size);
-    if (decoded)
-    {
-        result.copyFrom(ByteRefArray(decoded, size), 0, size);
-        free(decoded);
-    }
-    return result;
+    return huff.decode(codedData.data(), codedData.size());
 }
 
 } // namespace de
@@ -22,10 +22,13 @@
 #include "de/folder.h"
 #include "de/log.h"
 #include "de/logbuffer.h"
+#include "de/metadatabank.h"
+#include "de/reader.h"
 #include "de/recordvalue.h"
 #include "de/scripting/scriptlex.h"
 #include "de/sourcelinetable.h"
 #include "de/textvalue.h"
+#include "de/writer.h"
 
 #include <fstream>
 
@@ -33,6 +36,10 @@ namespace de {
 
 DE_STATIC_STRING(WHITESPACE_OR_COMMENT, " \t\r\n#");
 DE_STATIC_STRING(TOKEN_BREAKING_CHARS,  "#:=$(){}<>,;\" \t\r\n");
+DE_STATIC_STRING(CACHE_CATEGORY,        "Info");
+
+/// Layout of the cached elements. Increment when readElement()/writeElement() change.
+static const duint32 CACHE_FORMAT = 1;
 
 static const char *INCLUDE_TOKEN = "@include";
 static const char *SCRIPT_TOKEN  = "script";
@@ -61,6 +68,7 @@ DE_PIMPL(Info)
     String implicitBlockType = GROUP_TOKEN;
 
     String sourcePath; ///< May be unknown (empty).
+    bool hasIncludes = false; ///< Parsed document included other documents.
     String content;
     int currentLine = 0;
     String::const_iterator cursor; ///< Index of the next character from the source.
@@ -594,6 +602,7 @@ DE_PIMPL(Info)
 
     void includeFrom(const String &includeName)
     {
+        hasIncludes = true;
         try
         {
             DE_ASSERT(finder != nullptr);
@@ -648,7 +657,164 @@ DE_PIMPL(Info)
     void parse(const File &file)
     {
         sourcePath = file.path();
-        parse(String::fromUtf8(Block(file)));
+
+        const Block source(file);
+        const bool useCache = App::hasMetadataBank();
+        Block id;
+        if (useCache)
+        {
+            id = cacheId(source);
+            if (readFromCache(id)) return;
+        }
+
+        hasIncludes = false;
+        parse(String::fromUtf8(source));
+
+        // The cache is not aware of changes in included documents.
+        if (useCache && !hasIncludes)
+        {
+            updateCache(id);
+        }
+    }
+
+    /**
+     * Identifies a parsed document in the metadata cache. The parser settings affect
+     * the resulting elements, so they are part of the identifier, as is the format of
+     * the cached data.
+     */
+    Block cacheId(const Block &source) const
+    {
+        StringList scriptTypes = compose<StringList>(scriptBlockTypes.begin(),
+                                                     scriptBlockTypes.end());
+        scriptTypes.sort();
+        return md5Hash(sourcePath, source.md5Hash(), String::join(scriptTypes, ","),
+                       implicitBlockType, CACHE_FORMAT);
+    }
+
+    bool readFromCache(const Block &id)
+    {
+        try
+        {
+            if (const Block cached = MetadataBank::get().check(CACHE_CATEGORY(), id))
+            {
+                rootBlock.clear();
+                Reader reader(cached);
+                reader.withHeader();
+                duint32 count;
+                reader >> count;
+                while (count--)
+                {
+                    rootBlock.add(readElement(reader));
+                }
+                return true;
+            }
+        }
+        catch (const Error &er)
+        {
+            LOGDEV_RES_WARNING("Corrupt cached Info document \"%s\": %s")
+                    << sourcePath << er.asText();
+            rootBlock.clear();
+        }
+        return false;
+    }
+
+    void updateCache(const Block &id)
+    {
+        Block data;
+        Writer writer(data);
+        writer.withHeader();
+        writer << duint32(rootBlock.contentsInOrder().size());
+        for (const Element *e : rootBlock.contentsInOrder())
+        {
+            writeElement(writer, *e);
+        }
+        MetadataBank::get().setMetadata(CACHE_CATEGORY(), id, data);
+    }
+
+    static void writeValue(Writer &to, const InfoValue &value)
+    {
+        to << value.text << duint32(value.flags);
+    }
+
+    static InfoValue readValue(Reader &from)
+    {
+        InfoValue value;
+        duint32 flags;
+        from >> value.text >> flags;
+        value.flags = flags;
+        return value;
+    }
+
+    static void writeElement(Writer &to, const Element &elem)
+    {
+        to << duint8(elem.type()) << elem.name()
+           << duint32(sourceLineTable.sourcePathAndLineNumber(elem.sourceLineId()).second);
+
+        switch (elem.type())
+        {
+        case Element::Key:
+            writeValue(to, elem.as<KeyElement>().value());
+            to << duint32(elem.as<KeyElement>().flags());
+            break;
+
+        case Element::List: {
+            const auto values = elem.values();
+            to << duint32(values.size());
+            for (const auto &value : values) writeValue(to, value);
+            break; }
+
+        case Element::Block: {
+            const auto &block = elem.as<BlockElement>();
+            to << block.blockType() << duint32(block.contentsInOrder().size());
+            for (const Element *e : block.contentsInOrder()) writeElement(to, *e);
+            break; }
+
+        default:
+            DE_ASSERT_FAIL("Info::writeElement: Invalid element type");
+            break;
+        }
+    }
+
+    Element *readElement(Reader &from)
+    {
+        duint8 type;
+        String name;
+        duint32 line;
+        from >> type >> name >> line;
+
+        std::unique_ptr<Element> elem;
+        switch (type)
+        {
+        case Element::Key: {
+            const InfoValue value = readValue(from);
+            duint32 flags;
+            from >> flags;
+            elem.reset(new KeyElement(name, value, flags));
+            break; }
+
+        case Element::List: {
+            auto *list = new ListElement(name);
+            elem.reset(list);
+            duint32 count;
+            from >> count;
+            while (count--) list->add(readValue(from));
+            break; }
+
+        case Element::Block: {
+            String blockType;
+            from >> blockType;
+            auto *block = new BlockElement(blockType, name, self());
+            elem.reset(block);
+            duint32 count;
+            from >> count;
+            while (count--) block->add(readElement(from));
+            break; }
+
+        default:
+            throw Error("Info::readElement", stringf("Invalid element type %i", type));
+        }
+        elem->setSourceLocation(sourcePath, int(line));
+        return elem.release();
     }
 };
 
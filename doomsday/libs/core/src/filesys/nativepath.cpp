@@ -26,6 +26,12 @@
 #include <the_Foundation/path.h>
 #include <cstdio>
 
+#if defined (DE_WINDOWS)
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#endif
+
 /**
  * @def NATIVE_BASE_SYMBOLIC
  *
@@ -271,6 +277,17 @@ bool NativePath::remove() const
     return ::remove(c_str()) == 0; // stdio.h
 }
 
+bool NativePath::renameTo(const NativePath &newPath) const
+{
+#if defined (DE_WINDOWS)
+    return MoveFileExW(String(c_str()).toWideString().c_str(),
+                       String(newPath.c_str()).toWideString().c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return ::rename(c_str(), newPath.c_str()) == 0; // stdio.h
+#endif
+}
+
 static std::unique_ptr<NativePath> currentNativeWorkPath;
 
 NativePath NativePath::workPath()
@@ -23,18 +23,73 @@
 #include "de/file.h"
 #include "de/app.h"
 #include "de/folder.h"
+#include "de/metadatabank.h"
+#include "de/reader.h"
+#include "de/writer.h"
 
 using namespace de;
 
+DE_STATIC_STRING(MODULE_CACHE_CATEGORY, "ScriptModule");
+
+/// Layout of the cached statements. Increment when the serialization of statements
+/// changes.
+static const duint32 CACHE_FORMAT = 1;
+
+/**
+ * Loads the statements of a module. The parsed statements are kept in the metadata
+ * cache, identified by the path and contents of the source, so an unchanged module
+ * does not need to be parsed again.
+ */
+static void loadModuleScript(const File &sourceFile, Script &script)
+{
+    LOG_AS("Module");
+
+    const Block source(sourceFile);
+    script.setPath(sourceFile.path());
+
+    // Without a metadata bank (e.g., during early init) there is nothing to cache in.
+    if (!App::hasMetadataBank())
+    {
+        script.parse(String::fromUtf8(source));
+        return;
+    }
+
+    const Block cacheId = md5Hash(sourceFile.path(), source.md5Hash(), CACHE_FORMAT);
+    try
+    {
+        if (const Block cached = MetadataBank::get().check(MODULE_CACHE_CATEGORY(), cacheId))
+        {
+            Reader(cached).withHeader() >> script.compound();
+            LOGDEV_SCR_XVERBOSE("Parsed statements of \"%s\" found in cache", sourceFile.path());
+            return;
+        }
+    }
+    catch (const Error &er)
+    {
+        LOGDEV_SCR_WARNING("Corrupt cached statements of \"%s\": %s")
+                << sourceFile.path() << er.asText();
+    }
+
+    script.parse(String::fromUtf8(source));
+
+    Block compiled;
+    Writer(compiled).withHeader() << script.compound();
+    MetadataBank::get().setMetadata(MODULE_CACHE_CATEGORY(), cacheId, compiled);
+}
+
 Module::Module(const String &sourcePath) : _sourcePath(sourcePath), _process(0)
 {
     // Load the script.
-    initialize(Script(App::rootFolder().locate<File>(sourcePath)));
+    Script script;
+    loadModuleScript(App::rootFolder().locate<File>(sourcePath), script);
+    initialize(script);
 }
 
 Module::Module(const File &sourceFile) : _sourcePath(sourceFile.path()), _process(0)
 {
-    initialize(Script(sourceFile));
+    Script script;
+    loadModuleScript(sourceFile, script);
+    initialize(script);
 }
 
 void Module::initialize(const Script &script)
@@ -0,0 +1,154 @@
+/** @file samplecache.h  Byte-budgeted LRU cache of sound samples.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_AUDIO_SAMPLECACHE_H
+#define LIBDOOMSDAY_AUDIO_SAMPLECACHE_H
+
+#include "../libdoomsday.h"
+#include "api_audiod_sfx.h"  // sfxsample_t
+
+#include <de/block.h>
+#include <de/observers.h>
+#include <functional>
+
+namespace audio {
+
+/**
+ * Cache of sound samples in the playback format, with a limit on the total size of
+ * the sample data.
+ *
+ * The cached samples are kept in the order of use. When the cache grows over its
+ * budget, the least recently used samples are removed first. Samples that are in
+ * use (e.g., currently playing) are never removed; the cache may temporarily exceed
+ * the budget because of them, and trim() can be called later to try again.
+ *
+ * Converting samples to the playback format is done with prepare(), which has no
+ * side effects and can be called in any thread. Other methods must be called in
+ * the thread that owns the cache.
+ *
+ * The cache has no dependencies on an audio driver.
+ *
+ * @ingroup audio
+ */
+class LIBDOOMSDAY_PUBLIC SampleCache
+{
+public:
+    /// Notified when a sample is about to be removed from the cache.
+    DE_AUDIENCE(Remove, void sampleCacheAboutToRemove(const sfxsample_t &sample))
+
+    /// Determines if a sample is in use and must not be removed.
+    typedef std::function<bool (const sfxsample_t &)> IsInUseFunc;
+
+    /**
+     * Sample data converted to the playback format. The data pointer of @a sample
+     * is updated when the sample is inserted in the cache.
+     */
+    struct LIBDOOMSDAY_PUBLIC PreparedSample
+    {
+        sfxsample_t sample;
+        de::Block   data;
+
+        PreparedSample();
+    };
+
+    struct Statistics
+    {
+        de::duint hits      = 0;  ///< Lookups that found the sample.
+        de::duint misses    = 0;  ///< Lookups that did not find the sample.
+        de::duint inserts   = 0;
+        de::duint evictions = 0;  ///< Samples removed to stay within the budget.
+        de::dsize bytes     = 0;  ///< Total size of the cached sample data.
+        de::dsize peakBytes = 0;
+        de::dsize budget    = 0;
+        int       count     = 0;  ///< Number of cached samples.
+    };
+
+    static const de::dsize DEFAULT_BUDGET = 4096 * 1024;
+
+public:
+    SampleCache(de::dsize budget = DEFAULT_BUDGET);
+
+    void setBudget(de::dsize bytes);
+
+    de::dsize budget() const;
+
+    void setInUseCheck(const IsInUseFunc &isInUse);
+
+    /**
+     * Converts sample data to the playback format.
+     *
+     * @param soundId         Sound sample identifier.
+     * @param group           Exclusion group (0, if none).
+     * @param data            Sample data.
+     * @param bytesPer        Bytes per sample in @a data (1 or 2).
+     * @param rate            Samples per second in @a data.
+     * @param numSamples      Number of samples in @a data.
+     * @param toBytesPer      Bytes per sample in the playback format. 8-bit samples
+     *                        are converted to 16-bit ones, but not vice versa.
+     * @param upsampleFactor  The rate is multiplied by this using linear interpolation.
+     */
+    static PreparedSample prepare(int soundId, int group, const void *data,
+                                  int bytesPer, int rate, int numSamples,
+                                  int toBytesPer, int upsampleFactor = 1);
+
+    /**
+     * Finds a cached sample. Counts as a hit or a miss in the statistics, but does
+     * not change the order of use (see markUsed()).
+     *
+     * @param soundId  Sound sample identifier.
+     * @return Sample, or @c nullptr.
+     */
+    sfxsample_t *find(int soundId);
+
+    bool has(int soundId) const;
+
+    /**
+     * Marks a cached sample the most recently used one.
+     */
+    void markUsed(int soundId);
+
+    /**
+     * Adds a sample to the cache, replacing any sample with the same ID. The cache
+     * is then trimmed to the budget; the new sample is kept regardless.
+     *
+     * @return The cached sample. Valid until the sample is removed.
+     */
+    sfxsample_t &insert(PreparedSample &&prepared);
+
+    void remove(int soundId);
+
+    /**
+     * Removes all samples.
+     */
+    void clear();
+
+    /**
+     * Removes the least recently used samples that are not in use, until the cache
+     * is within the budget.
+     */
+    void trim();
+
+    Statistics statistics() const;
+
+private:
+    DE_PRIVATE(d)
+};
+
+} // namespace audio
+
+#endif // LIBDOOMSDAY_AUDIO_SAMPLECACHE_H
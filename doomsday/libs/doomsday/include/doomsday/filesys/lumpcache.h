@@ -22,38 +22,35 @@
 
 #include "../libdoomsday.h"
 #include "dd_types.h"
-#include <vector>
+#include <de/libcore.h>
 
 /**
+ * Cache for the data of the lumps in a container (e.g., a WAD or ZIP file).
+ *
+ * The cache is thread-safe. The lumps are divided into shards by index, and each
+ * shard has its own lock that is held only briefly while looking up or modifying
+ * entries; the data itself is accessed without locking. Callers lock (pin) the
+ * data they are using, and a locked lump is never evicted or freed.
+ *
+ * The total size of the data in all the caches is limited by a shared byte budget.
+ * When the caches grow over the budget, the least recently used unlocked lumps are
+ * evicted, regardless of which cache they are in. A cache may also have a budget of
+ * its own.
+ *
  * @ingroup fs
  */
 class LIBDOOMSDAY_PUBLIC LumpCache
 {
-private:
-    /**
-     * Data item. Represents a lump of data in the cache.
-     */
-    class Data
+public:
+    struct Statistics
     {
-    public:
-        explicit Data(uint8_t *data = 0);
-
-        ~Data();
-
-        uint8_t *data() const;
-
-        const uint8_t *replaceData(uint8_t *newData);
-
-        Data &clearData(bool *retCleared = 0);
-
-        Data &lock();
-
-        Data &unlock();
-
-    private:
-        uint8_t *data_;
+        de::duint64 hits      = 0;  ///< Lookups that found the data in the cache.
+        de::duint64 misses    = 0;  ///< Lumps that had to be read and inserted.
+        de::duint64 evictions = 0;  ///< Lumps removed to stay within the budget.
+        de::dsize   bytes     = 0;  ///< Total size of the cached data.
+        de::dsize   peakBytes = 0;
+        int         count     = 0;  ///< Number of cached lumps.
     };
-    typedef std::vector<Data> DataCache;
 
 public:
     explicit LumpCache(uint size);
@@ -63,28 +60,73 @@ public:
 
     bool isValidIndex(uint idx) const;
 
-    const uint8_t *data(uint lumpIdx) const;
-
-    LumpCache &insert(uint lumpIdx, uint8_t *data);
+    /**
+     * Sets the maximum total size of the data in this cache, in addition to the
+     * shared budget (see setSharedBudget()). Zero means only the shared budget applies.
+     */
+    void setBudget(de::dsize bytes);
 
-    LumpCache &insertAndLock(uint lumpIdx, uint8_t *data);
+    /**
+     * Returns the budget of this cache, or zero if only the shared budget applies.
+     */
+    de::dsize budget() const;
 
-    LumpCache &lock(uint lumpIdx);
+    /**
+     * Locks the cached data of a lump so that it remains valid until unlock() is
+     * called. Each call must be paired with a call to unlock().
+     *
+     * @param lumpIdx  Index of the lump.
+     *
+     * @return The cached data, or @c nullptr if the lump is not cached (in which
+     * case nothing is locked).
+     */
+    const uint8_t *lock(uint lumpIdx);
 
+    /**
+     * Releases one lock of a lump. Once all locks are released, the data may be
+     * evicted.
+     */
     LumpCache &unlock(uint lumpIdx);
 
+    /**
+     * Adds the data of a lump to the cache and locks it. If the lump is already
+     * cached (e.g., another thread inserted it first), the cached data is locked
+     * and returned instead, and @a data is freed.
+     *
+     * @param lumpIdx  Index of the lump.
+     * @param data     Data allocated with M_Malloc(). The cache takes ownership.
+     * @param size     Size of @a data in bytes.
+     *
+     * @return The locked data of the lump.
+     */
+    const uint8_t *insertAndLock(uint lumpIdx, uint8_t *data, de::dsize size);
+
+    /**
+     * Removes the data of a lump. Data that is locked is freed when the last lock
+     * is released.
+     */
     LumpCache &remove(uint lumpIdx, bool *retRemoved = 0);
 
     LumpCache &clear();
 
-protected:
-    Data *cacheRecord(uint lumpIdx);
+    Statistics statistics() const;
+
+public:
+    /**
+     * Sets the maximum total size of the data in all the lump caches. Zero means the
+     * default budget.
+     */
+    static void setSharedBudget(de::dsize bytes);
+
+    static de::dsize sharedBudget();
 
-    const Data *cacheRecord(uint lumpIdx) const;
+    /**
+     * Returns statistics combined from all the lump caches.
+     */
+    static Statistics totalStatistics();
 
 private:
-    uint _size;             ///< Number of data lumps which can be stored in the cache.
-    DataCache *_dataCache;  ///< The cached data.
+    DE_PRIVATE(d)
 };
 
 #endif /* DE_FILESYS_LUMPCACHE_H */
@@ -170,6 +170,9 @@ public:
      *
      * @param lumpIndex  Lump index associated with the data to be cached.
      *
+     * The cached data is locked and remains valid until unlockLump() is called.
+     * This can be called in any thread.
+     *
      * @return Pointer to the cached copy of the associated data.
      */
     const uint8_t *cacheLump(int lumpIndex);
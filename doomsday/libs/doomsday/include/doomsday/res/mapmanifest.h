@@ -62,6 +62,7 @@ public:
     File1 *sourceFile() const;
 
     MapManifest &setRecognizer(Id1MapRecognizer *newRecognizer);
+    bool hasRecognizer() const;
     const Id1MapRecognizer &recognizer() const;
 
 private:
@@ -526,6 +526,14 @@ public:
      */
     bool isBspWindow() const;
 
+    /**
+     * Returns the sector seen through the line if it is a "one-way window"; otherwise
+     * @c nullptr.
+     *
+     * @see isBspWindow()
+     */
+    Sector *bspWindowSector() const;
+
     /**
      * Returns @c true if the line is marked as @em mapped for @a playerNum.
      */
@@ -64,6 +64,17 @@ public:
      */
     bool trace(const BspTree &bspRoot);
 
+    /**
+     * Execute the trace without modifying the map (the validCount of lines is not
+     * used), so that several tests may be traced in parallel. The map must not be
+     * modified while the traces are running.
+     *
+     * @param bspRoot  Root of BSP to be traced.
+     *
+     * @return  Same result as trace().
+     */
+    bool traceConcurrently(const BspTree &bspRoot);
+
 private:
     DE_PRIVATE(d)
 };
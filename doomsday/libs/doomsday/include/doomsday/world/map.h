@@ -26,6 +26,7 @@
 #include "bspnode.h"
 #include "api_mapedit.h"
 
+#include <de/block.h>
 #include <de/id.h>
 #include <de/observers.h>
 #include <de/reader.h>
@@ -45,6 +46,7 @@ class IThinkerMapping;
 class Line;
 class LineBlockmap;
 class LineSide;
+class SectorVisibility;
 class Sky;
 class Subsector;
 class Surface;
@@ -229,6 +231,20 @@ public:
         return forAllLinesInBox(box, LIF_ALL, callback);
     }
 
+    /**
+     * Same as forAllLinesInBox() except that validCount is not used: a Line linked in
+     * more than one Blockmap cell may be visited more than once, so @a callback should
+     * not depend on visiting each Line only once. Nothing in the map is modified, so
+     * this can be called from several threads at once (as long as no one else is
+     * modifying the map at the same time).
+     *
+     * @param box       Axis-aligned bounding box in which Lines must be Blockmap-linked.
+     * @param flags     @ref lineIteratorFlags
+     * @param callback  Function to call for each Line.
+     */
+    de::LoopResult forAllLinesInBoxConcurrently(const AABoxd &box, int flags,
+                                                const std::function<de::LoopResult (Line &)> &callback) const;
+
     /**
      * The callback function will be called once for each Line that crosses the object.
      * This means all the lines will be two-sided.
@@ -465,6 +481,21 @@ public:
      */
     const Blockmap &subspaceBlockmap() const;
 
+    /**
+     * Provides access to the sector-to-sector potentially visible set. It is determined
+     * on first access (or read from the metadata cache) and only depends on the map
+     * geometry, so it remains valid for the lifetime of the map.
+     */
+    const SectorVisibility &sectorVisibility() const;
+
+    /**
+     * Returns the REJECT matrix of the map (see buildRejectMatrix()). A REJECT lump in
+     * the map data is used as-is if it contains any rejected pairs, because some maps
+     * rely on hand-made REJECT data for special effects. Otherwise the matrix is built
+     * from the sector visibility. It is determined on first access.
+     */
+    const de::Block &rejectMatrix() const;
+
     /**
      * Provides access to the thinker lists for the map.
      */
@@ -23,7 +23,11 @@
 #ifndef DE_WORLD_REJECT_H
 #define DE_WORLD_REJECT_H
 
-#if 0 // Needs updating
+#include "../libdoomsday.h"
+#include <de/block.h>
+
+namespace world {
+
 class Map;
 
 /**
@@ -64,14 +68,27 @@ class Map;
  *
  *     ceiling(numSectors^2)
  *
- * For now we only do very basic reject processing, limited to determining
- * all isolated sector groups (islands that are surrounded by void space).
+ * The matrix is built from the potentially visible set of the map (see
+ * SectorVisibility): a pair of sectors is rejected when no line of sight is
+ * possible between them, which includes all isolated sector groups (islands that
+ * are surrounded by void space). Sectors that share a two-sided line or a
+ * "one-way window" are never rejected. Map::sectorVisibility() caches the visibility
+ * data on disk, so building the matrix is cheap after the first time a map is
+ * loaded.
  *
- * @note Algorithm:
- * Initially all sectors are in individual groups. Next, we scan the line
- * list. For each 2-sectored line, merge the two sector groups into one.
+ * @param map  Map to build the matrix for.
+ *
+ * @return  Packed REJECT matrix (numSectors^2 bits).
  */
-byte *BuildRejectForMap(const Map &map);
-#endif
+LIBDOOMSDAY_PUBLIC de::Block buildRejectMatrix(const Map &map);
+
+/**
+ * Determines whether @a rejectData is a usable REJECT matrix for a map with
+ * @a sectorCount sectors. Matrices of the wrong size or with all bits cleared
+ * (which many nodebuilders produce) are considered unusable.
+ */
+LIBDOOMSDAY_PUBLIC bool isUsefulRejectMatrix(const de::Block &rejectData, int sectorCount);
+
+} // namespace world
 
 #endif // DE_WORLD_REJECT_H
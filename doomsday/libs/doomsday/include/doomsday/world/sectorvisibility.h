@@ -0,0 +1,133 @@
+/** @file sectorvisibility.h  Potentially visible set of map sectors.
+ * @ingroup world
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_WORLD_SECTORVISIBILITY_H
+#define LIBDOOMSDAY_WORLD_SECTORVISIBILITY_H
+
+#include "../libdoomsday.h"
+#include <de/block.h>
+#include <de/iserializable.h>
+#include <de/list.h>
+#include <de/vector.h>
+
+namespace world {
+
+class Map;
+
+/**
+ * Sector-to-sector potentially visible set (PVS).
+ *
+ * For each ordered pair of sectors, records whether there may be a line of sight
+ * between any point in the first sector and any point in the second. The set is
+ * determined by flowing through the two-sided lines and "one-way windows"
+ * ("portals") between sectors, clipping each successive portal to the region that
+ * can be seen through the source and pass portals (2D anti-penumbra). Plane heights
+ * are ignored because they change during play (doors, lifts).
+ *
+ * A sector whose lines all refer to it on both sides (self-referencing lines, used
+ * for deep water and invisible bridges) lies within another sector without sharing
+ * any lines with it. Its self-referencing lines are treated as portals to the
+ * sectors around them.
+ *
+ * The result is conservative: a pair is only marked as not visible when no line
+ * of sight between the sectors is possible. The bits are packed like in the REJECT
+ * lump, one row per sector: row @em from, column @em to of isVisible(). The matrix
+ * is symmetric, so either sector can be the viewer.
+ *
+ * @ingroup world
+ */
+class LIBDOOMSDAY_PUBLIC SectorVisibility : public de::ISerializable
+{
+public:
+    /// The map geometry does not match the (cached) visibility data. @ingroup errors
+    DE_ERROR(MismatchError);
+
+    /**
+     * Line of the map, as far as visibility is concerned.
+     */
+    struct Edge
+    {
+        de::Vec2d from;
+        de::Vec2d to;
+        int       front;  ///< Sector on the right side.
+        int       back;   ///< Sector on the left side (or the window sector), or -1.
+    };
+
+public:
+    /**
+     * Constructs an empty set where all sectors are considered visible.
+     */
+    SectorVisibility();
+
+    /**
+     * Determines the visibility between all sectors of @a map. This can take a
+     * while on complex maps; see Map::sectorVisibility() for the cached version.
+     */
+    void build(const Map &map);
+
+    /**
+     * Determines the visibility between @a sectorCount sectors bounded by @a edges.
+     * Polyobj lines should not be included.
+     */
+    void build(int sectorCount, const de::List<Edge> &edges);
+
+    /**
+     * Returns an identifier for the line/sector geometry of @a map that changes
+     * whenever the visibility data would need to be rebuilt.
+     */
+    static de::Block geometryId(const Map &map);
+
+    /**
+     * Returns the number of sectors in the set.
+     */
+    int sectorCount() const;
+
+    /**
+     * Determines whether anything in sector @a from may be visible to a viewer in
+     * sector @a to. Unknown sector indices are always considered visible.
+     */
+    inline bool isVisible(int from, int to) const
+    {
+        if (from < 0 || to < 0 || from >= _count || to >= _count) return true;
+        const de::dsize bit = de::dsize(from) * de::dsize(_count) + de::dsize(to);
+        return (_matrix.cdata()[bit >> 3] & (1 << (bit & 7))) != 0;
+    }
+
+    /**
+     * Returns the number of sectors potentially visible from sector @a from.
+     */
+    int visibleCount(int from) const;
+
+    /**
+     * Provides access to the packed visibility matrix (set bits are visible pairs).
+     */
+    const de::Block &matrix() const;
+
+    // Implements ISerializable.
+    void operator >> (de::Writer &to) const override;
+    void operator << (de::Reader &from) override;
+
+private:
+    int       _count;
+    de::Block _matrix;
+};
+
+}  // namespace world
+
+#endif  // LIBDOOMSDAY_WORLD_SECTORVISIBILITY_H
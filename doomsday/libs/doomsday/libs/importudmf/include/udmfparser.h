@@ -19,8 +19,8 @@
 #ifndef IMPORTUDMF_UDMFPARSER_H
 #define IMPORTUDMF_UDMFPARSER_H
 
-#include "udmflex.h"
-#include <de/scripting/tokenrange.h>
+#include <de/block.h>
+#include <de/cstring.h>
 #include <de/hash.h>
 #include <de/value.h>
 #include <functional>
@@ -30,13 +30,39 @@
  *
  * Reads input text and makes callbacks for each parsed block. The parsed contents are
  * not kept in memory.
+ *
+ * The parser scans the source text directly without producing tokens. Properties that
+ * have a handler registered for their block type are passed to the handler as Literals
+ * that refer to the source text, so parsing them does not allocate any memory. Only
+ * the remaining, unknown properties are boxed into Values and passed to the block
+ * handler at the end of the block.
  */
 class UDMFParser
 {
 public:
+    /**
+     * Value of an assignment. Text refers to the source; it is only valid during the
+     * callback.
+     */
+    struct Literal
+    {
+        enum Type { Integer, Number, Boolean, Text, Keyword };
+
+        Type        type   = Integer;
+        double      number = 0; ///< Integer, Number, and Boolean.
+        de::CString text;       ///< Text (still escaped) and Keyword.
+
+        int         asInt() const;
+        double      asNumber() const;
+        bool        isTrue() const;
+        de::String  asText() const;
+        de::Value * toValue() const;
+    };
+
     typedef de::Hash<de::String, std::shared_ptr<de::Value>> Block;
     typedef std::function<void (const de::String &, const de::Value &)> AssignmentFunc;
     typedef std::function<void (const de::String &, const Block &)> BlockFunc;
+    typedef std::function<void (const Literal &)> PropertyFunc;
 
     DE_ERROR(SyntaxError);
 
@@ -44,32 +70,73 @@ public:
     UDMFParser();
 
     void setGlobalAssignmentHandler(AssignmentFunc func);
+
+    /**
+     * Sets the handler that is called at the end of each block. The handler gets the
+     * block type and the properties that did not have a property handler.
+     */
     void setBlockHandler(BlockFunc func);
 
+    /**
+     * Sets the handler for a known property of a block type. Keys are case insensitive.
+     *
+     * @param blockType  Type of the block, e.g., "thing".
+     * @param key        Property key.
+     * @param func       Called with the assigned value.
+     */
+    void setPropertyHandler(const de::String &blockType, const de::String &key, PropertyFunc func);
+
     const Block &globals() const;
 
     /**
-     * Parse UDMF source and make callbacks for global assignments and blocks while
-     * parsing.
+     * Parse UDMF source and make callbacks for global assignments, properties, and
+     * blocks while parsing.
      *
-     * @param input  UDMF source text.
+     * @param begin  Start of the UDMF source text.
+     * @param end    End of the UDMF source text.
      *
      * @throws SyntaxError  UDMF source text has a syntax error.
      */
-    void parse(const de::String &input);
+    void parse(const char *begin, const char *end);
+
+    void parse(const de::Block &input);
 
 protected:
-    de::dsize nextFragment();
-    void parseBlock(Block &block);
-    void parseAssignment(Block &block);
+    struct Identifier
+    {
+        de::CString text;
+        de::duint32 hash;
+
+        de::String lower() const;
+    };
+    struct Property
+    {
+        de::String   key;
+        PropertyFunc func;
+    };
+    struct BlockType
+    {
+        de::String                      name;
+        de::Hash<de::duint32, Property> properties;
+    };
+
+    void            skipWhite();
+    void            expect(char ch);
+    Identifier      parseIdentifier();
+    Literal         parseLiteral();
+    void            parseNumber(Literal &literal);
+    void            parseBlock(const Identifier &type);
+    const Property *findProperty(const BlockType &type, const Identifier &key) const;
 
 private:
-    AssignmentFunc  _assignmentHandler;
-    BlockFunc       _blockHandler;
-    Block           _globals;
-    UDMFLex         _analyzer;
-    de::TokenBuffer _tokens;
-    de::TokenRange  _range;
+    AssignmentFunc                   _assignmentHandler;
+    BlockFunc                        _blockHandler;
+    de::Hash<de::duint32, BlockType> _blockTypes;
+    Block                            _globals;
+    Block                            _unknown;
+    const char *                     _pos  = nullptr;
+    const char *                     _end  = nullptr;
+    int                              _line = 1;
 };
 
 #endif // IMPORTUDMF_UDMFPARSER_H
@@ -18,6 +18,7 @@
  */
 
 #include "importudmf.h"
+#include "udmflex.h"
 #include "udmfparser.h"
 
 #include <doomsday/filesys/lumpindex.h>
@@ -73,6 +74,52 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                 // Parse the UDMF source and use the MPE API to create the map elements.
                 UDMFParser parser;
 
+                // Properties of the block being parsed. Each property has a typed handler
+                // that stores the value here, so the parser does not need to allocate
+                // values for them. The defaults are restored after each block.
+                struct ThingDef
+                {
+                    double x = 0, y = 0, z = 0;
+                    int angle = 0;
+                    int type = 0;
+                    int id = 0;
+                    int special = 0;
+                    int args[5]{};
+                    gfw_mapspot_flags_t flags = 0;
+                    int skillModes = 0;
+                };
+                struct VertexDef
+                {
+                    double x = 0, y = 0;
+                };
+                struct LinedefDef
+                {
+                    int v1 = 0, v2 = 0;
+                    int sidefront = 0;
+                    int sideback = -1;
+                    bool blocking = false;
+                    bool dontpegtop = false;
+                    bool dontpegbottom = false;
+                    bool twosided = false;
+                    int special = 0;
+                    int id = -1;
+                    int args[5]{};
+                };
+                struct SidedefDef
+                {
+                    int offsetx = 0, offsety = 0;
+                    String texturetop, texturemiddle, texturebottom;
+                    int sector = 0;
+                };
+                struct SectorDef
+                {
+                    int lightlevel = 160;
+                    double heightfloor = 0, heightceiling = 0;
+                    String texturefloor, textureceiling;
+                    int special = 0;
+                    int id = 0;
+                };
+
                 struct ImportState
                 {
                     bool isHexen = false;
@@ -82,11 +129,147 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                     int vertexCount = 0;
                     int sectorCount = 0;
 
-                    de::List<UDMFParser::Block> linedefs;
-                    de::List<UDMFParser::Block> sidedefs;
+                    ThingDef   thing;
+                    VertexDef  vertex;
+                    LinedefDef linedef;
+                    SidedefDef sidedef;
+                    SectorDef  sector;
+
+                    de::List<LinedefDef> linedefs;
+                    de::List<SidedefDef> sidedefs;
                 };
                 ImportState importState;
 
+                using Literal = UDMFParser::Literal;
+
+                auto setDouble = [&parser] (const String &type, const char *key, double &dest)
+                {
+                    parser.setPropertyHandler(type, key, [&dest] (const Literal &value)
+                    {
+                        dest = value.asNumber();
+                    });
+                };
+                auto setInt = [&parser] (const String &type, const char *key, int &dest)
+                {
+                    parser.setPropertyHandler(type, key, [&dest] (const Literal &value)
+                    {
+                        dest = value.asInt();
+                    });
+                };
+                auto setBool = [&parser] (const String &type, const char *key, bool &dest)
+                {
+                    parser.setPropertyHandler(type, key, [&dest] (const Literal &value)
+                    {
+                        dest = value.isTrue();
+                    });
+                };
+                auto setText = [&parser] (const String &type, const char *key, String &dest)
+                {
+                    parser.setPropertyHandler(type, key, [&dest] (const Literal &value)
+                    {
+                        dest = value.asText();
+                    });
+                };
+                auto setArgs = [&setInt] (const String &type, int *args)
+                {
+                    static const char *labels[5] = {
+                        "arg0", "arg1", "arg2", "arg3", "arg4",
+                    };
+                    for (int i = 0; i < 5; ++i) setInt(type, labels[i], args[i]);
+                };
+
+                // Things.
+                {
+                    ThingDef &thing = importState.thing;
+                    setDouble(UDMFLex::THING, "x",       thing.x);
+                    setDouble(UDMFLex::THING, "y",       thing.y);
+                    setDouble(UDMFLex::THING, "z",       thing.z);
+                    setInt   (UDMFLex::THING, "angle",   thing.angle);
+                    setInt   (UDMFLex::THING, "type",    thing.type);
+                    setInt   (UDMFLex::THING, "id",      thing.id);
+                    setInt   (UDMFLex::THING, "special", thing.special);
+                    setArgs  (UDMFLex::THING, thing.args);
+
+                    // Map spot flags.
+                    auto setFlag = [&parser, &thing] (const char *key, gfw_mapspot_flags_t flag)
+                    {
+                        parser.setPropertyHandler(UDMFLex::THING, key, [&thing, flag] (const Literal &value)
+                        {
+                            if (value.isTrue()) thing.flags |= flag; else thing.flags &= ~flag;
+                        });
+                    };
+                    setFlag("ambush",      GFW_MAPSPOT_DEAF);
+                    setFlag("single",      GFW_MAPSPOT_SINGLE);
+                    setFlag("dm",          GFW_MAPSPOT_DM);
+                    setFlag("coop",        GFW_MAPSPOT_COOP);
+                    setFlag("friend",      GFW_MAPSPOT_MBF_FRIEND);
+                    setFlag("dormant",     GFW_MAPSPOT_DORMANT);
+                    setFlag("class1",      GFW_MAPSPOT_CLASS1);
+                    setFlag("class2",      GFW_MAPSPOT_CLASS2);
+                    setFlag("class3",      GFW_MAPSPOT_CLASS3);
+                    setFlag("standing",    GFW_MAPSPOT_STANDING);
+                    setFlag("strifeally",  GFW_MAPSPOT_STRIFE_ALLY);
+                    setFlag("translucent", GFW_MAPSPOT_TRANSLUCENT);
+                    setFlag("invisible",   GFW_MAPSPOT_INVISIBLE);
+
+                    // Skill level bits.
+                    static const char *skillLabels[5] = {
+                        "skill1", "skill2", "skill3", "skill4", "skill5",
+                    };
+                    for (int skill = 0; skill < 5; ++skill)
+                    {
+                        parser.setPropertyHandler(UDMFLex::THING, skillLabels[skill],
+                                                  [&thing, skill] (const Literal &value)
+                        {
+                            if (value.isTrue()) thing.skillModes |= 1 << skill;
+                            else thing.skillModes &= ~(1 << skill);
+                        });
+                    }
+                }
+
+                // Vertices.
+                setDouble(UDMFLex::VERTEX, "x", importState.vertex.x);
+                setDouble(UDMFLex::VERTEX, "y", importState.vertex.y);
+
+                // Lines.
+                {
+                    LinedefDef &line = importState.linedef;
+                    setInt (UDMFLex::LINEDEF, "v1",            line.v1);
+                    setInt (UDMFLex::LINEDEF, "v2",            line.v2);
+                    setInt (UDMFLex::LINEDEF, "sidefront",     line.sidefront);
+                    setInt (UDMFLex::LINEDEF, "sideback",      line.sideback);
+                    setBool(UDMFLex::LINEDEF, "blocking",      line.blocking);
+                    setBool(UDMFLex::LINEDEF, "dontpegtop",    line.dontpegtop);
+                    setBool(UDMFLex::LINEDEF, "dontpegbottom", line.dontpegbottom);
+                    setBool(UDMFLex::LINEDEF, "twosided",      line.twosided);
+                    setInt (UDMFLex::LINEDEF, "special",       line.special);
+                    setInt (UDMFLex::LINEDEF, "id",            line.id);
+                    setArgs(UDMFLex::LINEDEF, line.args);
+                }
+
+                // Sides.
+                {
+                    SidedefDef &side = importState.sidedef;
+                    setInt (UDMFLex::SIDEDEF, "offsetx",       side.offsetx);
+                    setInt (UDMFLex::SIDEDEF, "offsety",       side.offsety);
+                    setText(UDMFLex::SIDEDEF, "texturetop",    side.texturetop);
+                    setText(UDMFLex::SIDEDEF, "texturemiddle", side.texturemiddle);
+                    setText(UDMFLex::SIDEDEF, "texturebottom", side.texturebottom);
+                    setInt (UDMFLex::SIDEDEF, "sector",        side.sector);
+                }
+
+                // Sectors.
+                {
+                    SectorDef &sector = importState.sector;
+                    setInt   (UDMFLex::SECTOR, "lightlevel",     sector.lightlevel);
+                    setDouble(UDMFLex::SECTOR, "heightfloor",    sector.heightfloor);
+                    setDouble(UDMFLex::SECTOR, "heightceiling",  sector.heightceiling);
+                    setText  (UDMFLex::SECTOR, "texturefloor",   sector.texturefloor);
+                    setText  (UDMFLex::SECTOR, "textureceiling", sector.textureceiling);
+                    setInt   (UDMFLex::SECTOR, "special",        sector.special);
+                    setInt   (UDMFLex::SECTOR, "id",             sector.id);
+                }
+
                 parser.setGlobalAssignmentHandler([&importState] (const String &ident, const Value &value)
                 {
                     if (ident == UDMFLex::NAMESPACE)
@@ -104,94 +287,67 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                     }
                 });
 
-                parser.setBlockHandler([&importState] (const String &type, const UDMFParser::Block &block)
+                // Called at the end of each block, after the properties have been read.
+                parser.setBlockHandler([&importState] (const String &type, const UDMFParser::Block &)
                 {
                     if (type == UDMFLex::THING)
                     {
                         const int index = importState.thingCount++;
+                        const ThingDef &thing = importState.thing;
 
                         // Properties common to all games.
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "X", block["x"]->asNumber());
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Y", block["y"]->asNumber());
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Z", block["z"]->asNumber());
-                        gmoSetThingProperty<DDVT_ANGLE>(index, "Angle", angle_t(double(block["angle"]->asInt()) / 180.0 * ANGLE_180));
-                        gmoSetThingProperty<DDVT_INT>(index, "DoomEdNum", block["type"]->asInt());
-
-                        // Map spot flags.
-                        {
-                            gfw_mapspot_flags_t gfwFlags = 0;
-
-                            if (block["ambush"]->isTrue())      gfwFlags |= GFW_MAPSPOT_DEAF;
-                            if (block["single"]->isTrue())      gfwFlags |= GFW_MAPSPOT_SINGLE;
-                            if (block["dm"]->isTrue())          gfwFlags |= GFW_MAPSPOT_DM;
-                            if (block["coop"]->isTrue())        gfwFlags |= GFW_MAPSPOT_COOP;
-                            if (block["friend"]->isTrue())      gfwFlags |= GFW_MAPSPOT_MBF_FRIEND;
-                            if (block["dormant"]->isTrue())     gfwFlags |= GFW_MAPSPOT_DORMANT;
-                            if (block["class1"]->isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS1;
-                            if (block["class2"]->isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS2;
-                            if (block["class3"]->isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS3;
-                            if (block["standing"]->isTrue())    gfwFlags |= GFW_MAPSPOT_STANDING;
-                            if (block["strifeally"]->isTrue())  gfwFlags |= GFW_MAPSPOT_STRIFE_ALLY;
-                            if (block["translucent"]->isTrue()) gfwFlags |= GFW_MAPSPOT_TRANSLUCENT;
-                            if (block["invisible"]->isTrue())   gfwFlags |= GFW_MAPSPOT_INVISIBLE;
-
-                            gmoSetThingProperty<DDVT_INT>(index, "Flags",
-                                    gfw_MapSpot_TranslateFlagsToInternal(gfwFlags));
-                        }
-
-                        // Skill level bits.
-                        {
-                            static String const labels[5] = {
-                                "skill1", "skill2", "skill3", "skill4", "skill5",
-                            };
-                            int skillModes = 0;
-                            for (int skill = 0; skill < 5; ++skill)
-                            {
-                                if (block[labels[skill]]->isTrue())
-                                    skillModes |= 1 << skill;
-                            }
-                            gmoSetThingProperty<DDVT_INT>(index, "SkillModes", skillModes);
-                        }
+                        gmoSetThingProperty<DDVT_DOUBLE>(index, "X", thing.x);
+                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Y", thing.y);
+                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Z", thing.z);
+                        gmoSetThingProperty<DDVT_ANGLE>(index, "Angle", angle_t(double(thing.angle) / 180.0 * ANGLE_180));
+                        gmoSetThingProperty<DDVT_INT>(index, "DoomEdNum", thing.type);
+                        gmoSetThingProperty<DDVT_INT>(index, "Flags",
+                                gfw_MapSpot_TranslateFlagsToInternal(thing.flags));
+                        gmoSetThingProperty<DDVT_INT>(index, "SkillModes", thing.skillModes);
 
                         if (importState.isHexen || importState.isDoom64)
                         {
-                            gmoSetThingProperty<DDVT_INT>(index, "ID", block["id"]->asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "ID", thing.id);
                         }
                         if (importState.isHexen)
                         {
-                            gmoSetThingProperty<DDVT_INT>(index, "Special", block["special"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg0", block["arg0"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg1", block["arg1"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg2", block["arg2"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg3", block["arg3"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg4", block["arg4"]->asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Special", thing.special);
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg0", thing.args[0]);
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg1", thing.args[1]);
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg2", thing.args[2]);
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg3", thing.args[3]);
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg4", thing.args[4]);
                         }
+                        importState.thing = ThingDef();
                     }
                     else if (type == UDMFLex::VERTEX)
                     {
                         const int index = importState.vertexCount++;
 
-                        MPE_VertexCreate(block["x"]->asNumber(), block["y"]->asNumber(), index);
+                        MPE_VertexCreate(importState.vertex.x, importState.vertex.y, index);
+                        importState.vertex = VertexDef();
                     }
                     else if (type == UDMFLex::LINEDEF)
                     {
-                        importState.linedefs.append(block);
+                        importState.linedefs.append(importState.linedef);
+                        importState.linedef = LinedefDef();
                     }
                     else if (type == UDMFLex::SIDEDEF)
                     {
-                        importState.sidedefs.append(block);
+                        importState.sidedefs.append(importState.sidedef);
+                        importState.sidedef = SidedefDef();
                     }
                     else if (type == UDMFLex::SECTOR)
                     {
                         const int index = importState.sectorCount++;
-                        const int lightlevel = block.contains("lightlevel")? block["lightlevel"]->asInt() : 160;
+                        const SectorDef &sector = importState.sector;
                         const struct de_api_sector_hacks_s hacks{{0, 0}, -1};
-                        
-                        MPE_SectorCreate(float(lightlevel)/255.f, 1.f, 1.f, 1.f, &hacks, index);
+
+                        MPE_SectorCreate(float(sector.lightlevel)/255.f, 1.f, 1.f, 1.f, &hacks, index);
 
                         MPE_PlaneCreate(index,
-                                        block["heightfloor"]->asNumber(),
-                                        de::Str("Flats:" + block["texturefloor"]->asText()),
+                                        sector.heightfloor,
+                                        de::Str("Flats:" + sector.texturefloor),
                                         0.f, 0.f,
                                         1.f, 1.f, 1.f,  // color
                                         1.f,            // opacity
@@ -199,77 +355,73 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                                         -1);            // index in archive
 
                         MPE_PlaneCreate(index,
-                                        block["heightceiling"]->asNumber(),
-                                        de::Str("Flats:" + block["textureceiling"]->asText()),
+                                        sector.heightceiling,
+                                        de::Str("Flats:" + sector.textureceiling),
                                         0.f, 0.f,
                                         1.f, 1.f, 1.f,  // color
                                         1.f,            // opacity
                                         0, 0, -1.f,     // normal
                                         -1);            // index in archive
 
-                        gmoSetSectorProperty<DDVT_INT>(index, "Type", block["special"]->asInt());
-                        gmoSetSectorProperty<DDVT_INT>(index, "Tag",  block["id"]->asInt());
+                        gmoSetSectorProperty<DDVT_INT>(index, "Type", sector.special);
+                        gmoSetSectorProperty<DDVT_INT>(index, "Tag",  sector.id);
+                        importState.sector = SectorDef();
                     }
                 });
 
-                parser.parse(String::fromUtf8(bytes));
+                parser.parse(bytes);
 
                 // Now that all the linedefs and sidedefs are read, let's create them.
-                for (int index = 0; index < importState.linedefs.size(); ++index)
+                for (int index = 0; index < importState.linedefs.sizei(); ++index)
                 {
-                    const UDMFParser::Block &linedef = importState.linedefs.at(index);
+                    const LinedefDef &linedef = importState.linedefs.at(index);
 
-                    int sidefront = linedef["sidefront"]->asInt();
-                    int sideback  = linedef.contains("sideback")? linedef["sideback"]->asInt() : -1;
+                    const int sidefront = linedef.sidefront;
+                    const int sideback  = linedef.sideback;
 
-                    const UDMFParser::Block &front = importState.sidedefs.at(sidefront);
-                    const UDMFParser::Block *back  =
+                    const SidedefDef &front = importState.sidedefs.at(sidefront);
+                    const SidedefDef *back  =
                             (sideback >= 0? &importState.sidedefs.at(sideback) : nullptr);
 
-                    int frontSectorIdx = front["sector"]->asInt();
-                    int backSectorIdx  = back? (*back)["sector"]->asInt() : -1;
+                    int frontSectorIdx = front.sector;
+                    int backSectorIdx  = back? back->sector : -1;
 
                     // Line flags.
                     int ddLineFlags = 0;
                     short sideFlags = 0;
                     {
-                        const bool blocking      = linedef["blocking"]->isTrue();
-                        const bool dontpegtop    = linedef["dontpegtop"]->isTrue();
-                        const bool dontpegbottom = linedef["dontpegbottom"]->isTrue();
-                        const bool twosided      = linedef["twosided"]->isTrue();
-
-                        if (blocking)      ddLineFlags |= DDLF_BLOCKING;
-                        if (dontpegtop)    ddLineFlags |= DDLF_DONTPEGTOP;
-                        if (dontpegbottom) ddLineFlags |= DDLF_DONTPEGBOTTOM;
+                        if (linedef.blocking)      ddLineFlags |= DDLF_BLOCKING;
+                        if (linedef.dontpegtop)    ddLineFlags |= DDLF_DONTPEGTOP;
+                        if (linedef.dontpegbottom) ddLineFlags |= DDLF_DONTPEGBOTTOM;
 
-                        if (!twosided && back)
+                        if (!linedef.twosided && back)
                         {
                             sideFlags |= SDF_SUPPRESS_BACK_SECTOR;
                         }
                     }
 
-                    MPE_LineCreate(linedef["v1"]->asInt(),
-                                   linedef["v2"]->asInt(),
+                    MPE_LineCreate(linedef.v1,
+                                   linedef.v2,
                                    frontSectorIdx,
                                    backSectorIdx,
                                    ddLineFlags,
                                    index);
 
-                    auto texName = [] (const Value &tex) -> String {
-                        if (tex.asText().isEmpty()) return String();
-                        return "Textures:" + tex.asText();
+                    auto texName = [] (const String &tex) -> String {
+                        if (tex.isEmpty()) return String();
+                        return "Textures:" + tex;
                     };
 
                     auto addSide = [&texName, sideFlags](
-                                       int index, const UDMFParser::Block &side, int sideIndex)
+                                       int index, const SidedefDef &side, int sideIndex)
                     {
-                        const int offsetx = side["offsetx"]->asInt();
-                        const int offsety = side["offsety"]->asInt();
+                        const int offsetx = side.offsetx;
+                        const int offsety = side.offsety;
                         float     opacity = 1.f;
 
-                        const auto topTex = texName(*side["texturetop"]   );
-                        const auto midTex = texName(*side["texturemiddle"]);
-                        const auto botTex = texName(*side["texturebottom"]);
+                        const auto topTex = texName(side.texturetop   );
+                        const auto midTex = texName(side.texturemiddle);
+                        const auto botTex = texName(side.texturebottom);
 
                         struct de_api_side_section_s top = {
                             topTex,
@@ -317,21 +469,19 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                         gmoSetLineProperty<DDVT_SHORT>(index, "Flags", flags);
                     }
 
-                    gmoSetLineProperty<DDVT_INT>(index, "Type", linedef["special"]->asInt());
+                    gmoSetLineProperty<DDVT_INT>(index, "Type", linedef.special);
 
                     if (!importState.isHexen)
                     {
-                        gmoSetLineProperty<DDVT_INT>(index, "Tag",
-                                                     linedef.contains("id") ?
-                                                         linedef["id"]->asInt() : -1);
+                        gmoSetLineProperty<DDVT_INT>(index, "Tag", linedef.id);
                     }
                     if (importState.isHexen)
                     {
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg0", linedef["arg0"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg1", linedef["arg1"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg2", linedef["arg2"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg3", linedef["arg3"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg4", linedef["arg4"]->asInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg0", linedef.args[0]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg1", linedef.args[1]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg2", linedef.args[2]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg3", linedef.args[3]);
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg4", linedef.args[4]);
                     }
                 }
                 LOG_MAP_WARNING("Loading UDMF maps is an experimental feature");
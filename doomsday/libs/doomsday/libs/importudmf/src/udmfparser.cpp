@@ -18,11 +18,167 @@
 
 #include "udmfparser.h"
 
+#include <de/math.h>
 #include <de/numbervalue.h>
 #include <de/textvalue.h>
+#include <cstdlib>
+#include <string>
 
 using namespace de;
 
+static inline char udmfLower(char c)
+{
+    return (c >= 'A' && c <= 'Z')? char(c - 'A' + 'a') : c;
+}
+
+static inline bool udmfIsIdentifierStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static inline bool udmfIsIdentifierChar(char c)
+{
+    return udmfIsIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+/// Case-insensitive FNV-1a hash of a key.
+static duint32 udmfKeyHash(const char *begin, const char *end)
+{
+    duint32 hash = 0x811c9dc5u;
+    for (const char *i = begin; i != end; ++i)
+    {
+        hash ^= duint8(udmfLower(*i));
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+/// Compares text with a lower case key without regard to case.
+static bool udmfEqualsLower(const CString &text, const char *lower, dsize lowerSize)
+{
+    if (text.size() != lowerSize) return false;
+    const char *i = text.ptr();
+    for (dsize k = 0; k < lowerSize; ++k)
+    {
+        if (udmfLower(i[k]) != lower[k]) return false;
+    }
+    return true;
+}
+
+static bool udmfEqualsLower(const CString &text, const String &lower)
+{
+    return udmfEqualsLower(text, lower.c_str(), lower.size());
+}
+
+//---------------------------------------------------------------------------------------
+
+int UDMFParser::Literal::asInt() const
+{
+    const double num = asNumber();
+    if (num > double(std::numeric_limits<int>::max()))
+    {
+        return std::numeric_limits<int>::max();
+    }
+    return round<int>(num);
+}
+
+double UDMFParser::Literal::asNumber() const
+{
+    if (type == Text || type == Keyword)
+    {
+        return asText().toDouble();
+    }
+    return number;
+}
+
+bool UDMFParser::Literal::isTrue() const
+{
+    if (type == Text || type == Keyword)
+    {
+        for (const char *i = text.ptr(), *end = text.endPtr(); i != end; ++i)
+        {
+            if (!(*i == ' ' || *i == '\t' || *i == '\r' || *i == '\n')) return true;
+        }
+        return false;
+    }
+    return !fequal(number, 0.0);
+}
+
+String UDMFParser::Literal::asText() const
+{
+    switch (type)
+    {
+    case Integer:
+        return String::asText(dint64(number));
+
+    case Number:
+        return String::asText(number);
+
+    case Boolean:
+        return number != 0.0? "true" : "false";
+
+    case Keyword:
+        return text.toString();
+
+    case Text:
+        break;
+    }
+
+    if (!text.contains('\\'))
+    {
+        return text.toString();
+    }
+
+    // Resolve the escape sequences.
+    std::string os;
+    os.reserve(text.size());
+    for (const char *i = text.ptr(), *end = text.endPtr(); i != end; ++i)
+    {
+        if (*i != '\\' || i + 1 == end)
+        {
+            os += *i;
+            continue;
+        }
+        switch (*++i)
+        {
+        case 'a': os += '\a'; break;
+        case 'b': os += '\b'; break;
+        case 'f': os += '\f'; break;
+        case 'n': os += '\n'; break;
+        case 'r': os += '\r'; break;
+        case 't': os += '\t'; break;
+        case 'v': os += '\v'; break;
+        default:  os += *i;   break;
+        }
+    }
+    return String(os.data(), os.size());
+}
+
+Value *UDMFParser::Literal::toValue() const
+{
+    switch (type)
+    {
+    case Integer:
+        return new NumberValue(dint64(number));
+
+    case Number:
+        return new NumberValue(number);
+
+    case Boolean:
+        return new NumberValue(number != 0.0);
+
+    default:
+        return new TextValue(asText());
+    }
+}
+
+String UDMFParser::Identifier::lower() const
+{
+    return text.lower();
+}
+
+//---------------------------------------------------------------------------------------
+
 UDMFParser::UDMFParser()
 {}
 
@@ -36,134 +192,328 @@ void UDMFParser::setBlockHandler(UDMFParser::BlockFunc func)
     _blockHandler = std::move(func);
 }
 
+void UDMFParser::setPropertyHandler(const String &blockType, const String &key,
+                                    PropertyFunc func)
+{
+    const String typeName = blockType.lower();
+    BlockType &type = _blockTypes[udmfKeyHash(typeName.c_str(), typeName.c_str() + typeName.size())];
+    DE_ASSERT(type.name.isEmpty() || type.name == typeName); // Hash collision?
+    type.name = typeName;
+
+    const String keyName = key.lower();
+    Property &prop = type.properties[udmfKeyHash(keyName.c_str(), keyName.c_str() + keyName.size())];
+    DE_ASSERT(prop.key.isEmpty() || prop.key == keyName); // Hash collision?
+    prop.key  = keyName;
+    prop.func = std::move(func);
+}
+
 const UDMFParser::Block &UDMFParser::globals() const
 {
     return _globals;
 }
 
-void UDMFParser::parse(const String &input)
+void UDMFParser::parse(const de::Block &input)
 {
-    // Lexical analyzer for Haw scripts.
-    _analyzer = UDMFLex(input);
+    const char *begin = reinterpret_cast<const char *>(input.data());
+    parse(begin, begin + input.size());
+}
+
+void UDMFParser::parse(const char *begin, const char *end)
+{
+    _pos  = begin;
+    _end  = end;
+    _line = 1;
 
-    while (nextFragment() > 0)
+    for (;;)
     {
-        if (_range.lastToken().equals(UDMFLex::BRACKET_OPEN))
+        skipWhite();
+        if (_pos == _end) break;
+
+        if (*_pos == ';')
+        {
+            // Just a semicolon?
+            ++_pos;
+            continue;
+        }
+
+        const Identifier ident = parseIdentifier();
+        skipWhite();
+        if (_pos != _end && *_pos == '{')
+        {
+            ++_pos;
+            parseBlock(ident);
+        }
+        else
         {
-            const String blockType = _range.firstToken().str().lower();
+            expect('=');
+            const Literal literal = parseLiteral();
+            expect(';');
 
-            Block block;
-            parseBlock(block);
+            const String identifier = ident.lower();
+            std::shared_ptr<Value> value(literal.toValue());
+            _globals.insert(identifier, value);
 
-            if (_blockHandler)
+            if (_assignmentHandler)
             {
-                _blockHandler(blockType, block);
+                _assignmentHandler(identifier, *value);
+            }
+        }
+    }
+
+    // We're done, free the remaining values.
+    _unknown.clear();
+    _pos = _end = nullptr;
+}
+
+void UDMFParser::skipWhite()
+{
+    while (_pos != _end)
+    {
+        const char c = *_pos;
+        if (c == '\n')
+        {
+            ++_line;
+            ++_pos;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v')
+        {
+            ++_pos;
+        }
+        else if (c == '/' && _end - _pos > 1 && _pos[1] == '/')
+        {
+            // Line comment.
+            while (_pos != _end && *_pos != '\n') ++_pos;
+        }
+        else if (c == '/' && _end - _pos > 1 && _pos[1] == '*')
+        {
+            // Block comment.
+            const int startLine = _line;
+            for (_pos += 2; ; ++_pos)
+            {
+                if (_end - _pos < 2)
+                {
+                    throw SyntaxError("UDMFParser::skipWhite",
+                                      String::format("Unterminated comment on line %i", startLine));
+                }
+                if (*_pos == '\n') ++_line;
+                if (_pos[0] == '*' && _pos[1] == '/')
+                {
+                    _pos += 2;
+                    break;
+                }
             }
         }
         else
         {
-            parseAssignment(_globals);
+            break;
         }
     }
-
-    // We're done, free the remaining tokens.
-    _tokens.clear();
 }
 
-dsize UDMFParser::nextFragment()
+void UDMFParser::expect(char ch)
 {
-    _analyzer.getExpressionFragment(_tokens);
-
-    // Begin with the whole thing.
-    _range = TokenRange(_tokens);
-
-    return _tokens.size();
+    skipWhite();
+    if (_pos == _end || *_pos != ch)
+    {
+        throw SyntaxError("UDMFParser::expect",
+                          String::format("Expected '%c' on line %i", ch, _line));
+    }
+    ++_pos;
 }
 
-void UDMFParser::parseBlock(Block &block)
+UDMFParser::Identifier UDMFParser::parseIdentifier()
 {
-    // Read all the assignments in the block.
-    while (nextFragment() > 0)
+    skipWhite();
+    if (_pos == _end || !udmfIsIdentifierStart(*_pos))
     {
-        if (_range.firstToken().equals(UDMFLex::BRACKET_CLOSE))
-            break;
-
-        parseAssignment(block);
+        throw SyntaxError("UDMFParser::parseIdentifier",
+                          String::format("Expected an identifier on line %i", _line));
     }
+    const char *start = _pos;
+    while (_pos != _end && udmfIsIdentifierChar(*_pos)) ++_pos;
+    return Identifier{CString(start, _pos), udmfKeyHash(start, _pos)};
 }
 
-void UDMFParser::parseAssignment(Block &block)
+UDMFParser::Literal UDMFParser::parseLiteral()
 {
-    if (_range.isEmpty())
-        return; // Nothing here?
-
-    if (!_range.lastToken().equals(UDMFLex::SEMICOLON))
+    skipWhite();
+    if (_pos == _end)
     {
-        throw SyntaxError("UDMFParser::parseAssignment",
-                          "Expected expression to end in a semicolon at " +
-                          _range.lastToken().asText());
+        throw SyntaxError("UDMFParser::parseLiteral",
+                          String::format("Expected a value on line %i", _line));
     }
-    if (_range.size() == 1)
-        return; // Just a semicolon?
 
-    if (!_range.token(1).equals(UDMFLex::ASSIGN))
+    Literal literal;
+    const char c = *_pos;
+    if (c == '"')
     {
-        throw SyntaxError("UDMFParser::parseAssignment",
-                          "Expected expression to have an assignment operator at " +
-                          _range.token(1).asText());
+        const int startLine = _line;
+        const char *start = ++_pos;
+        for (;;)
+        {
+            if (_pos == _end)
+            {
+                throw SyntaxError("UDMFParser::parseLiteral",
+                                  String::format("Unterminated string on line %i", startLine));
+            }
+            if (*_pos == '"') break;
+            if (*_pos == '\n') ++_line;
+            if (*_pos == '\\' && _end - _pos > 1) ++_pos; // Escaped character.
+            ++_pos;
+        }
+        literal.type = Literal::Text;
+        literal.text = CString(start, _pos++);
     }
-
-    const String identifier = _range.firstToken().str().lower();
-    const Token &valueToken = _range.token(2);
-
-    // Store the assigned value into a variant.
-    std::shared_ptr<Value> value;
-    switch (valueToken.type())
+    else if (udmfIsIdentifierStart(c))
     {
-    case Token::KEYWORD:
-        if (valueToken.equals(UDMFLex::T_TRUE))
+        const Identifier ident = parseIdentifier();
+        if (udmfEqualsLower(ident.text, "true", 4))
         {
-            value.reset(new NumberValue(true));
+            literal.type   = Literal::Boolean;
+            literal.number = 1;
         }
-        else if (valueToken.equals(UDMFLex::T_FALSE))
+        else if (udmfEqualsLower(ident.text, "false", 5))
         {
-            value.reset(new NumberValue(false));
+            literal.type   = Literal::Boolean;
+            literal.number = 0;
         }
         else
         {
-            throw SyntaxError("UDMFParser::parseAssignment",
-                              "Unexpected value for assignment at " + valueToken.asText());
+            literal.type = Literal::Keyword;
+            literal.text = ident.text;
         }
-        break;
+    }
+    else if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+    {
+        parseNumber(literal);
+    }
+    else
+    {
+        throw SyntaxError("UDMFParser::parseLiteral",
+                          String::format("Unexpected '%c' on line %i", c, _line));
+    }
+    return literal;
+}
 
-    case Token::LITERAL_NUMBER:
-        if (valueToken.isInteger())
+void UDMFParser::parseNumber(Literal &literal)
+{
+    // The number is copied to a null-terminated buffer for the standard conversions.
+    char buf[64];
+    dsize len = 0;
+    bool isHex = false;
+    bool isFloat = false;
+    const char *start = _pos;
+    for (; _pos != _end; ++_pos)
+    {
+        const char c = *_pos;
+        if (c == '+' || c == '-')
         {
-            value.reset(new NumberValue(valueToken.toInteger()));
+            // Only allowed as the sign of the number or the exponent.
+            if (_pos != start && (isHex || (_pos[-1] != 'e' && _pos[-1] != 'E'))) break;
         }
-        else
+        else if (!udmfIsIdentifierChar(c) && c != '.')
         {
-            value.reset(new NumberValue(valueToken.toDouble()));
+            break;
         }
-        break;
+        if (len == sizeof(buf) - 1)
+        {
+            throw SyntaxError("UDMFParser::parseNumber",
+                              String::format("Number is too long on line %i", _line));
+        }
+        buf[len++] = c;
+        if (c == 'x' || c == 'X')
+        {
+            isHex = true;
+        }
+        else if (c == '.' || (!isHex && (c == 'e' || c == 'E')))
+        {
+            isFloat = true;
+        }
+    }
+    buf[len] = 0;
 
-    case Token::LITERAL_STRING_QUOTED:
-        value.reset(new TextValue(valueToken.unescapeStringLiteral()));
-        break;
+    char *parsedEnd = nullptr;
+    if (isFloat)
+    {
+        literal.type   = Literal::Number;
+        literal.number = std::strtod(buf, &parsedEnd);
+    }
+    else
+    {
+        // Base is deduced from the prefix (0x for hexadecimal, 0 for octal).
+        literal.type   = Literal::Integer;
+        literal.number = double(std::strtoll(buf, &parsedEnd, 0));
+    }
+    if (parsedEnd != buf + len)
+    {
+        throw SyntaxError("UDMFParser::parseNumber",
+                          String::format("Invalid number \"%s\" on line %i", buf, _line));
+    }
+}
 
-    case Token::IDENTIFIER:
-        value.reset(new TextValue(valueToken.str()));
-        break;
+void UDMFParser::parseBlock(const Identifier &type)
+{
+    const BlockType *blockType = nullptr;
+    {
+        auto found = _blockTypes.find(type.hash);
+        if (found != _blockTypes.end() && udmfEqualsLower(type.text, found->second.name))
+        {
+            blockType = &found->second;
+        }
+    }
 
-    default:
-        DE_ASSERT_FAIL("[UMDFParser::parseAssignment] Invalid token type");
-        break;
+    const int startLine = _line;
+    _unknown.clear();
+
+    // Read all the assignments in the block.
+    for (;;)
+    {
+        skipWhite();
+        if (_pos == _end)
+        {
+            throw SyntaxError("UDMFParser::parseBlock",
+                              String::format("Block beginning on line %i is not closed", startLine));
+        }
+        if (*_pos == '}')
+        {
+            ++_pos;
+            break;
+        }
+        if (*_pos == ';')
+        {
+            ++_pos;
+            continue;
+        }
+
+        const Identifier key = parseIdentifier();
+        expect('=');
+        const Literal value = parseLiteral();
+        expect(';');
+
+        if (blockType)
+        {
+            if (const Property *prop = findProperty(*blockType, key))
+            {
+                prop->func(value);
+                continue;
+            }
+        }
+        _unknown.insert(key.lower(), std::shared_ptr<Value>(value.toValue()));
     }
 
-    block.insert(identifier, value);
+    if (_blockHandler)
+    {
+        _blockHandler(blockType? blockType->name : type.lower(), _unknown);
+    }
+}
 
-    if (_assignmentHandler && (&block == &_globals))
+const UDMFParser::Property *UDMFParser::findProperty(const BlockType &type,
+                                                     const Identifier &key) const
+{
+    auto found = type.properties.find(key.hash);
+    if (found != type.properties.end() && udmfEqualsLower(key.text, found->second.key))
     {
-        _assignmentHandler(identifier, *value);
+        return &found->second;
     }
+    return nullptr;
 }
@@ -0,0 +1,453 @@
+/** @file samplecache.cpp  Byte-budgeted LRU cache of sound samples.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "doomsday/audio/samplecache.h"
+
+#include <de/hash.h>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define DE_SAMPLECACHE_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  define DE_SAMPLECACHE_NEON
+#  include <arm_neon.h>
+#endif
+
+using namespace de;
+
+namespace audio {
+
+// Utility for converting an unsigned byte to signed short.
+static inline dint16 u8ToS16(duint8 b)
+{
+    return dint16((b - 0x80) << 8);
+}
+
+static inline dint16 average(dint16 a, dint16 b)
+{
+    return dint16((a + b) >> 1);
+}
+
+static void convertToS16(const duint8 *src, dint16 *dst, int count)
+{
+    int i = 0;
+#if defined(DE_SAMPLECACHE_SSE2)
+    const __m128i bias = _mm_set1_epi8(char(0x80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16)
+    {
+        // Bias to signed and move to the high byte.
+        const __m128i s = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)), bias);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),     _mm_unpacklo_epi8(zero, s));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(zero, s));
+    }
+#elif defined(DE_SAMPLECACHE_NEON)
+    const uint8x16_t bias = vdupq_n_u8(0x80);
+    for (; i + 16 <= count; i += 16)
+    {
+        const int8x16_t s = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(src + i), bias));
+        vst1q_s16(dst + i,     vshll_n_s8(vget_low_s8(s), 8));
+        vst1q_s16(dst + i + 8, vshll_n_s8(vget_high_s8(s), 8));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        dst[i] = u8ToS16(src[i]);
+    }
+}
+
+#if defined(DE_SAMPLECACHE_SSE2)
+/// Equals (a + b) >> 1 for each element, without overflowing.
+static inline __m128i averageS16(__m128i a, __m128i b)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1), _mm_srai_epi16(b, 1)),
+                         _mm_and_si128(_mm_and_si128(a, b), one));
+}
+#endif
+
+/**
+ * Upsamples by a factor of two: every other sample is the average of its neighbors.
+ * Returns the number of source samples processed.
+ */
+static int upsample2x(const dint16 *src, dint16 *dst, int count)
+{
+    int i = 0;
+#if defined(DE_SAMPLECACHE_SSE2)
+    for (; i + 8 < count; i += 8)
+    {
+        const __m128i a   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i b   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 1));
+        const __m128i mid = averageS16(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i),     _mm_unpacklo_epi16(a, mid));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i + 8), _mm_unpackhi_epi16(a, mid));
+    }
+#elif defined(DE_SAMPLECACHE_NEON)
+    for (; i + 8 < count; i += 8)
+    {
+        const int16x8_t a = vld1q_s16(src + i);
+        const int16x8_t b = vld1q_s16(src + i + 1);
+        const int16x8x2_t z = vzipq_s16(a, vhaddq_s16(a, b));
+        vst1q_s16(dst + 2 * i,     z.val[0]);
+        vst1q_s16(dst + 2 * i + 8, z.val[1]);
+    }
+#endif
+    for (; i < count - 1; ++i)
+    {
+        dst[2 * i]     = src[i];
+        dst[2 * i + 1] = average(src[i], src[i + 1]);
+    }
+    return i;
+}
+
+/**
+ * Upsamples by a factor of four, by averaging twice.
+ * Returns the number of source samples processed.
+ */
+static int upsample4x(const dint16 *src, dint16 *dst, int count)
+{
+    int i = 0;
+#if defined(DE_SAMPLECACHE_SSE2)
+    for (; i + 8 < count; i += 8)
+    {
+        const __m128i a   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i b   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 1));
+        const __m128i mid = averageS16(a, b);
+        const __m128i q1  = averageS16(a, mid);
+        const __m128i q3  = averageS16(mid, b);
+        const __m128i lo0 = _mm_unpacklo_epi16(a, mid);
+        const __m128i lo1 = _mm_unpacklo_epi16(q1, q3);
+        const __m128i hi0 = _mm_unpackhi_epi16(a, mid);
+        const __m128i hi1 = _mm_unpackhi_epi16(q1, q3);
+        __m128i *out = reinterpret_cast<__m128i *>(dst + 4 * i);
+        _mm_storeu_si128(out,     _mm_unpacklo_epi16(lo0, lo1));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo0, lo1));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi0, hi1));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi0, hi1));
+    }
+#elif defined(DE_SAMPLECACHE_NEON)
+    for (; i + 8 < count; i += 8)
+    {
+        const int16x8_t a   = vld1q_s16(src + i);
+        const int16x8_t b   = vld1q_s16(src + i + 1);
+        const int16x8_t mid = vhaddq_s16(a, b);
+        const int16x8x2_t z0 = vzipq_s16(a, mid);
+        const int16x8x2_t z1 = vzipq_s16(vhaddq_s16(a, mid), vhaddq_s16(mid, b));
+        const int32x4x2_t lo = vzipq_s32(vreinterpretq_s32_s16(z0.val[0]), vreinterpretq_s32_s16(z1.val[0]));
+        const int32x4x2_t hi = vzipq_s32(vreinterpretq_s32_s16(z0.val[1]), vreinterpretq_s32_s16(z1.val[1]));
+        dint16 *out = dst + 4 * i;
+        vst1q_s16(out,      vreinterpretq_s16_s32(lo.val[0]));
+        vst1q_s16(out + 8,  vreinterpretq_s16_s32(lo.val[1]));
+        vst1q_s16(out + 16, vreinterpretq_s16_s32(hi.val[0]));
+        vst1q_s16(out + 24, vreinterpretq_s16_s32(hi.val[1]));
+    }
+#endif
+    for (; i < count - 1; ++i)
+    {
+        const dint16 mid = average(src[i], src[i + 1]);
+        dst[4 * i]     = src[i];
+        dst[4 * i + 1] = average(src[i], mid);
+        dst[4 * i + 2] = mid;
+        dst[4 * i + 3] = average(mid, src[i + 1]);
+    }
+    return i;
+}
+
+/**
+ * Linear upsampling by any factor. Returns the number of source samples processed.
+ */
+template <typename Type>
+static int upsample(const Type *src, Type *dst, int count, int factor)
+{
+    int i = 0;
+    for (; i < count - 1; ++i)
+    {
+        const int a = src[i];
+        const int b = src[i + 1];
+        for (int k = 0; k < factor; ++k)
+        {
+            *dst++ = Type(a + (b - a) * k / factor);
+        }
+    }
+    return i;
+}
+
+SampleCache::PreparedSample::PreparedSample()
+{
+    zap(sample);
+}
+
+DE_PIMPL(SampleCache)
+{
+    struct Item
+    {
+        sfxsample_t sample;
+        Block       data;
+        Item *      prev = nullptr; ///< More recently used.
+        Item *      next = nullptr; ///< Less recently used.
+    };
+
+    Hash<dint, Item *> items;
+    Item *      mostRecent  = nullptr;
+    Item *      leastRecent = nullptr;
+    dsize       budget;
+    IsInUseFunc isInUse;
+    Statistics  stats;
+
+    Impl(Public *i, dsize budget) : Base(i), budget(budget) {}
+
+    ~Impl()
+    {
+        for (auto &item : items) delete item.second;
+    }
+
+    Item *tryFind(dint soundId) const
+    {
+        auto found = items.find(soundId);
+        return found != items.end()? found->second : nullptr;
+    }
+
+    void unlink(Item &item)
+    {
+        if (item.prev) item.prev->next = item.next;
+        else mostRecent = item.next;
+
+        if (item.next) item.next->prev = item.prev;
+        else leastRecent = item.prev;
+
+        item.prev = item.next = nullptr;
+    }
+
+    void linkFirst(Item &item)
+    {
+        item.next = mostRecent;
+        if (mostRecent) mostRecent->prev = &item;
+        mostRecent = &item;
+        if (!leastRecent) leastRecent = &item;
+    }
+
+    void remove(Item &item)
+    {
+        DE_NOTIFY_PUBLIC(Remove, i)
+        {
+            i->sampleCacheAboutToRemove(item.sample);
+        }
+        unlink(item);
+        items.remove(item.sample.id);
+        stats.bytes -= item.data.size();
+        stats.count--;
+        delete &item;
+    }
+
+    void trim(const Item *keep = nullptr)
+    {
+        for (Item *it = leastRecent; it && stats.bytes > budget; )
+        {
+            Item *next = it->prev;
+            if (it != keep && !(isInUse && isInUse(it->sample)))
+            {
+                remove(*it);
+                stats.evictions++;
+            }
+            it = next;
+        }
+    }
+
+    DE_PIMPL_AUDIENCE(Remove)
+};
+
+DE_AUDIENCE_METHOD(SampleCache, Remove)
+
+SampleCache::SampleCache(dsize budget) : d(new Impl(this, budget))
+{}
+
+void SampleCache::setBudget(dsize bytes)
+{
+    d->budget = bytes;
+    d->trim();
+}
+
+dsize SampleCache::budget() const
+{
+    return d->budget;
+}
+
+void SampleCache::setInUseCheck(const IsInUseFunc &isInUse)
+{
+    d->isInUse = isInUse;
+}
+
+SampleCache::PreparedSample SampleCache::prepare(int soundId, int group, const void *data,
+                                                 int bytesPer, int rate, int numSamples,
+                                                 int toBytesPer, int upsampleFactor)
+{
+    DE_ASSERT(data || !numSamples);
+    DE_ASSERT(bytesPer == 1 || bytesPer == 2);
+
+    const int factor = de::max(1, upsampleFactor);
+    toBytesPer = de::max(bytesPer, toBytesPer);
+
+    PreparedSample prep;
+    sfxsample_t &smp = prep.sample;
+    smp.id         = soundId;
+    smp.group      = group;
+    smp.bytesPer   = toBytesPer;
+    smp.rate       = rate * factor;
+    smp.numSamples = numSamples * factor;
+    smp.size       = duint(smp.numSamples * toBytesPer);
+    prep.data.resize(smp.size);
+    if (!numSamples) return prep;
+
+    if (toBytesPer == 1)
+    {
+        // Stays 8-bit.
+        const auto *src = reinterpret_cast<const duint8 *>(data);
+        auto *      dst = reinterpret_cast<duint8 *>(prep.data.data());
+        if (factor == 1)
+        {
+            std::memcpy(dst, src, dsize(numSamples));
+        }
+        else
+        {
+            const int done = upsample(src, dst, numSamples, factor);
+            std::fill(dst + done * factor, dst + numSamples * factor, src[numSamples - 1]);
+        }
+        return prep;
+    }
+
+    // Conversion to 16 bits.
+    const dint16 *src = reinterpret_cast<const dint16 *>(data);
+    Block converted;
+    if (bytesPer == 1)
+    {
+        if (factor == 1)
+        {
+            convertToS16(reinterpret_cast<const duint8 *>(data),
+                         reinterpret_cast<dint16 *>(prep.data.data()), numSamples);
+            return prep;
+        }
+        converted.resize(dsize(numSamples) * 2);
+        convertToS16(reinterpret_cast<const duint8 *>(data),
+                     reinterpret_cast<dint16 *>(converted.data()), numSamples);
+        src = reinterpret_cast<const dint16 *>(converted.data());
+    }
+
+    auto *dst = reinterpret_cast<dint16 *>(prep.data.data());
+    int done;
+    switch (factor)
+    {
+    case 1:
+        std::memcpy(dst, src, dsize(numSamples) * 2);
+        return prep;
+
+    case 2:
+        done = upsample2x(src, dst, numSamples);
+        break;
+
+    case 4:
+        done = upsample4x(src, dst, numSamples);
+        break;
+
+    default:
+        done = upsample(src, dst, numSamples, factor);
+        break;
+    }
+    // Fill in the last ones as well.
+    std::fill(dst + done * factor, dst + numSamples * factor, src[numSamples - 1]);
+    return prep;
+}
+
+sfxsample_t *SampleCache::find(int soundId)
+{
+    if (Impl::Item *item = d->tryFind(soundId))
+    {
+        d->stats.hits++;
+        return &item->sample;
+    }
+    d->stats.misses++;
+    return nullptr;
+}
+
+bool SampleCache::has(int soundId) const
+{
+    return d->items.contains(soundId);
+}
+
+void SampleCache::markUsed(int soundId)
+{
+    if (Impl::Item *item = d->tryFind(soundId))
+    {
+        d->unlink(*item);
+        d->linkFirst(*item);
+    }
+}
+
+sfxsample_t &SampleCache::insert(PreparedSample &&prepared)
+{
+    if (Impl::Item *existing = d->tryFind(prepared.sample.id))
+    {
+        d->remove(*existing);
+    }
+
+    auto *item = new Impl::Item;
+    item->data        = std::move(prepared.data);
+    item->sample      = prepared.sample;
+    item->sample.data = item->data.data();
+    item->sample.size = duint(item->data.size());
+
+    d->items.insert(item->sample.id, item);
+    d->linkFirst(*item);
+    d->stats.inserts++;
+    d->stats.count++;
+    d->stats.bytes    += item->data.size();
+    d->stats.peakBytes = de::max(d->stats.peakBytes, d->stats.bytes);
+
+    d->trim(item);
+    return item->sample;
+}
+
+void SampleCache::remove(int soundId)
+{
+    if (Impl::Item *item = d->tryFind(soundId))
+    {
+        d->remove(*item);
+    }
+}
+
+void SampleCache::clear()
+{
+    while (d->mostRecent)
+    {
+        d->remove(*d->mostRecent);
+    }
+}
+
+void SampleCache::trim()
+{
+    d->trim();
+}
+
+SampleCache::Statistics SampleCache::statistics() const
+{
+    Statistics stats = d->stats;
+    stats.budget = d->budget;
+    return stats;
+}
+
+} // namespace audio
@@ -25,9 +25,11 @@
 #include "doomsday/filesys/fs_util.h"
 #include "doomsday/console/exec.h"
 #include "doomsday/console/cmd.h"
+#include "doomsday/console/var.h"
 #include "doomsday/filesys/file.h"
 #include "doomsday/filesys/fileid.h"
 #include "doomsday/filesys/fileinfo.h"
+#include "doomsday/filesys/lumpcache.h"
 #include "doomsday/filesys/lumpindex.h"
 #include "doomsday/filesys/wad.h"
 #include "doomsday/filesys/zip.h"
@@ -1122,6 +1124,13 @@ const FS1::Schemes &FS1::allSchemes()
 
 } // namespace res
 
+static int lumpCacheBudget = 64; ///< MiB.
+
+static void lumpCacheBudgetChanged()
+{
+    LumpCache::setSharedBudget(de::dsize(lumpCacheBudget) * 1024 * 1024);
+}
+
 /// Print contents of directories as Doomsday sees them.
 D_CMD(Dir)
 {
@@ -1244,6 +1253,20 @@ D_CMD(ListFiles)
     return true;
 }
 
+D_CMD(LumpCacheStats)
+{
+    DE_UNUSED(src, argc, argv);
+
+    const auto stats = LumpCache::totalStatistics();
+    LOG_RES_MSG(_E(b) "Lump cache:");
+    LOG_RES_MSG("  %i lumps, %.1f KB (peak %.1f KB, shared budget %.1f KB)")
+            << stats.count << stats.bytes / 1024.0 << stats.peakBytes / 1024.0
+            << LumpCache::sharedBudget() / 1024.0;
+    LOG_RES_MSG("  %u hits, %u misses, %u evictions")
+            << stats.hits << stats.misses << stats.evictions;
+    return true;
+}
+
 void res::FS1::consoleRegister()
 {
     C_CMD("dir", "",   Dir);
@@ -1254,6 +1277,9 @@ void res::FS1::consoleRegister()
     C_CMD("dump",      "s", DumpLump);
     C_CMD("listfiles", "",  ListFiles);
     C_CMD("listlumps", "",  ListLumps);
+    C_CMD("lumpcachestats", "", LumpCacheStats);
+
+    C_VAR_INT2("file-lumpcache-budget", &lumpCacheBudget, 0, 1, 4096, lumpCacheBudgetChanged);
 }
 
 res::FS1 &App_FileSystem()
@@ -19,177 +19,431 @@
 
 #include "doomsday/filesys/lumpcache.h"
 #include <de/legacy/memory.h>
-#include <de/legacy/memoryzone.h>
 #include <de/error.h>
+#include <de/guard.h>
+#include <de/list.h>
 #include <de/log.h>
+#include <atomic>
+#include <memory>
 
 using namespace de;
 
-LumpCache::Data::Data(uint8_t *data)
-    : data_(data)
-{}
+static const int   SHARD_COUNT    = 8;
+static const dsize DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+static std::atomic<dsize>   sharedBudgetBytes { DEFAULT_BUDGET };
+static std::atomic<duint64> useCounter        { 0 }; ///< Order of use across all caches.
 
-LumpCache::Data::~Data()
+/// Statistics of all the caches.
+static std::atomic<duint64> totalHits      { 0 };
+static std::atomic<duint64> totalMisses    { 0 };
+static std::atomic<duint64> totalEvictions { 0 };
+static std::atomic<dsize>   totalBytes     { 0 };
+static std::atomic<dsize>   totalPeakBytes { 0 };
+static std::atomic<int>     totalCount     { 0 };
+
+static void updatePeak(std::atomic<dsize> &peak, dsize bytes)
 {
-    clearData();
+    dsize current = peak;
+    while (bytes > current && !peak.compare_exchange_weak(current, bytes)) {}
 }
 
-uint8_t *LumpCache::Data::data() const
+DE_PIMPL_NOREF(LumpCache)
 {
-    if (data_ && Z_GetTag(data_) == PU_PURGELEVEL)
+    struct Entry
+    {
+        uint8_t *data    = nullptr;
+        dsize    size    = 0;
+        int      locks   = 0;
+        bool     purge   = false;   ///< Free the data when the last lock is released.
+        duint64  lastUse = 0;       ///< Order of use across all caches.
+        Entry *  prev    = nullptr; ///< More recently used.
+        Entry *  next    = nullptr; ///< Less recently used.
+    };
+
+    /// Entries whose index modulo SHARD_COUNT is the same share a lock. Each shard
+    /// keeps its entries in the order of use.
+    struct Shard : public Lockable
+    {
+        Entry *mostRecent  = nullptr;
+        Entry *leastRecent = nullptr;
+    };
+
+    /// All the existing caches. The shared budget applies to them together.
+    struct Registry : public Lockable
     {
-        // Reaquire the data.
-        Z_ChangeTag2(data_, PU_APPSTATIC);
-        Z_ChangeUser(data_, (void*)&data_);
+        List<Impl *> caches;
+    };
+
+    uint                     size;
+    std::unique_ptr<Entry[]> entries;
+    Shard                    shards[SHARD_COUNT];
+    std::atomic<dsize>       budget    { 0 }; ///< Zero if only the shared budget applies.
+    std::atomic<dsize>       bytes     { 0 };
+    std::atomic<dsize>       peakBytes { 0 };
+    std::atomic<int>         count     { 0 };
+    std::atomic<duint64>     hits      { 0 };
+    std::atomic<duint64>     misses    { 0 };
+    std::atomic<duint64>     evictions { 0 };
+
+    Impl(uint size) : size(size), entries(new Entry[size])
+    {
+        Registry &reg = registry();
+        DE_GUARD(reg);
+        reg.caches << this;
     }
-    return data_;
-}
 
-const uint8_t *LumpCache::Data::replaceData(uint8_t *newData)
-{
-    clearData();
-    data_ = newData;
-    if (data_)
+    ~Impl()
     {
-        Z_ChangeUser(data_, &data_);
+        {
+            // After this, the cache is not trimmed by others.
+            Registry &reg = registry();
+            DE_GUARD(reg);
+            reg.caches.removeOne(this);
+        }
+        for (auto &shard : shards)
+        {
+            DE_GUARD(shard);
+            while (shard.leastRecent)
+            {
+                DE_ASSERT(!shard.leastRecent->locks);
+                release(shard, *shard.leastRecent);
+            }
+        }
     }
-    return newData;
-}
 
-LumpCache::Data &LumpCache::Data::clearData(bool *retCleared)
-{
-    bool hasData = !!data_;
-    if (hasData)
+    inline Shard &shardFor(uint lumpIdx)
+    {
+        return shards[lumpIdx % SHARD_COUNT];
+    }
+
+    static Registry &registry()
+    {
+        static Registry reg;
+        return reg;
+    }
+
+    void unlink(Shard &shard, Entry &entry)
+    {
+        if (entry.prev) entry.prev->next = entry.next; else shard.mostRecent  = entry.next;
+        if (entry.next) entry.next->prev = entry.prev; else shard.leastRecent = entry.prev;
+        entry.prev = entry.next = nullptr;
+    }
+
+    void linkFirst(Shard &shard, Entry &entry)
     {
-        /// @todo Implement a proper thread-safe locking mechanism.
+        entry.prev = nullptr;
+        entry.next = shard.mostRecent;
+        if (shard.mostRecent) shard.mostRecent->prev = &entry; else shard.leastRecent = &entry;
+        shard.mostRecent = &entry;
+    }
 
-        // Elevate the cached data to purge level so it will be explicitly
-        // free'd by the Zone the next time the rover passes it.
-        if (Z_GetTag(data_) != PU_PURGELEVEL)
+    void markUsed(Shard &shard, Entry &entry)
+    {
+        entry.lastUse = ++useCounter;
+        if (shard.mostRecent != &entry)
         {
-            Z_ChangeTag2(data_, PU_PURGELEVEL);
+            unlink(shard, entry);
+            linkFirst(shard, entry);
         }
-        // Mark the data as unowned.
-        Z_ChangeUser(data_, (void *) 0x2);
     }
-    if (retCleared) *retCleared = hasData;
-    return *this;
-}
 
-LumpCache::Data &LumpCache::Data::lock()
-{
-    /// @todo Implement a proper thread-safe locking mechanism.
-    return *this;
-}
+    /// Frees the data of an entry. The shard must be locked.
+    void release(Shard &shard, Entry &entry)
+    {
+        unlink(shard, entry);
+        M_Free(entry.data);
+        bytes      -= entry.size;
+        totalBytes -= entry.size;
+        count--;
+        totalCount--;
+        entry.data  = nullptr;
+        entry.size  = 0;
+        entry.purge = false;
+    }
 
-LumpCache::Data &LumpCache::Data::unlock()
-{
-    /// @todo Implement a proper thread-safe locking mechanism.
-    if (data_)
+    /**
+     * Finds the shard with the least recently used unlocked entry. Only one shard is
+     * locked at a time, so the result may be out of date when it is used.
+     *
+     * @param oldestUse  Order of use of the entry is returned here.
+     *
+     * @return Index of the shard, or -1 if everything is locked.
+     */
+    int findOldestShard(duint64 &oldestUse)
     {
-        Z_ChangeTag2(data_, PU_PURGELEVEL);
+        int oldestShard = -1;
+        for (int i = 0; i < SHARD_COUNT; ++i)
+        {
+            DE_GUARD_FOR(shards[i], G);
+            if (const Entry *entry = leastRecentUnlocked(shards[i]))
+            {
+                if (oldestShard < 0 || entry->lastUse < oldestUse)
+                {
+                    oldestShard = i;
+                    oldestUse   = entry->lastUse;
+                }
+            }
+        }
+        return oldestShard;
+    }
+
+    /**
+     * Evicts the least recently used unlocked entry of a shard.
+     */
+    void evict(int shardIndex)
+    {
+        Shard &shard = shards[shardIndex];
+        DE_GUARD(shard);
+        if (Entry *entry = leastRecentUnlocked(shard))
+        {
+            release(shard, *entry);
+            evictions++;
+            totalEvictions++;
+        }
     }
-    return *this;
-}
 
-LumpCache::LumpCache(uint size) : _size(size), _dataCache(0)
+    /**
+     * Evicts the least recently used unlocked lumps until the cache is within its
+     * own budget (if it has one), and all the caches are within the shared budget.
+     */
+    void trim()
+    {
+        if (const dsize limit = budget)
+        {
+            while (bytes > limit)
+            {
+                duint64 oldestUse;
+                const int oldestShard = findOldestShard(oldestUse);
+                if (oldestShard < 0) break; // Everything is locked.
+                evict(oldestShard);
+            }
+        }
+        trimShared();
+    }
+
+    /**
+     * Evicts the least recently used unlocked lumps of all the caches until they are
+     * within the shared budget.
+     */
+    static void trimShared()
+    {
+        const dsize limit = sharedBudgetBytes;
+        if (totalBytes <= limit) return;
+
+        Registry &reg = registry();
+        DE_GUARD(reg);
+        while (totalBytes > limit)
+        {
+            Impl *  oldestCache = nullptr;
+            int     oldestShard = -1;
+            duint64 oldestUse   = 0;
+            for (Impl *cache : reg.caches)
+            {
+                duint64 use;
+                const int shard = cache->findOldestShard(use);
+                if (shard >= 0 && (!oldestCache || use < oldestUse))
+                {
+                    oldestCache = cache;
+                    oldestShard = shard;
+                    oldestUse   = use;
+                }
+            }
+            if (!oldestCache) break; // Everything is locked.
+            oldestCache->evict(oldestShard);
+        }
+    }
+
+    static Entry *leastRecentUnlocked(const Shard &shard)
+    {
+        for (Entry *entry = shard.leastRecent; entry; entry = entry->prev)
+        {
+            if (!entry->locks) return entry;
+        }
+        return nullptr;
+    }
+};
+
+LumpCache::LumpCache(uint size) : d(new Impl(size))
 {}
 
 LumpCache::~LumpCache()
-{
-    if (_dataCache) delete _dataCache;
-}
+{}
 
 uint LumpCache::size() const
 {
-    return _size;
+    return d->size;
 }
 
 bool LumpCache::isValidIndex(uint idx) const
 {
-    return idx < _size;
-}
-
-const uint8_t *LumpCache::data(uint lumpIdx) const
-{
-    LOG_AS("LumpCache::data");
-    Data const* record = cacheRecord(lumpIdx);
-    return record? record->data() : 0;
+    return idx < d->size;
 }
 
-LumpCache &LumpCache::insert(uint lumpIdx, uint8_t *data)
+void LumpCache::setBudget(dsize bytes)
 {
-    LOG_AS("LumpCache::insert");
-    if (!isValidIndex(lumpIdx)) throw Error("LumpCache::insert", stringf("Invalid index %u", lumpIdx));
-
-    // Time to allocate the data cache?
-    if (!_dataCache)
-    {
-        _dataCache = new DataCache(_size);
-    }
-
-    Data *record = cacheRecord(lumpIdx);
-    record->replaceData(data);
-    return *this;
+    d->budget = bytes;
+    d->trim();
 }
 
-LumpCache &LumpCache::insertAndLock(uint lumpIdx, uint8_t *data)
+dsize LumpCache::budget() const
 {
-    return insert(lumpIdx, data).lock(lumpIdx);
+    return d->budget;
 }
 
-LumpCache &LumpCache::lock(uint lumpIdx)
+const uint8_t *LumpCache::lock(uint lumpIdx)
 {
     LOG_AS("LumpCache::lock");
     if (!isValidIndex(lumpIdx)) throw Error("LumpCache::lock", stringf("Invalid index %u", lumpIdx));
-    Data* record = cacheRecord(lumpIdx);
-    record->lock();
-    return *this;
+
+    auto &shard = d->shardFor(lumpIdx);
+    DE_GUARD(shard);
+    auto &entry = d->entries[lumpIdx];
+    if (!entry.data) return nullptr;
+
+    entry.locks++;
+    entry.purge = false;
+    d->markUsed(shard, entry);
+    d->hits++;
+    totalHits++;
+    return entry.data;
 }
 
 LumpCache &LumpCache::unlock(uint lumpIdx)
 {
     LOG_AS("LumpCache::unlock");
     if (!isValidIndex(lumpIdx)) throw Error("LumpCache::unlock", stringf("Invalid index %u", lumpIdx));
-    Data* record = cacheRecord(lumpIdx);
-    record->unlock();
+
+    auto &shard = d->shardFor(lumpIdx);
+    DE_GUARD(shard);
+    auto &entry = d->entries[lumpIdx];
+    if (entry.locks > 0 && --entry.locks == 0 && entry.purge)
+    {
+        d->release(shard, entry);
+    }
     return *this;
 }
 
-LumpCache &LumpCache::remove(uint lumpIdx, bool *retRemoved)
+const uint8_t *LumpCache::insertAndLock(uint lumpIdx, uint8_t *data, dsize size)
 {
-    Data *record = cacheRecord(lumpIdx);
-    if (record)
+    LOG_AS("LumpCache::insertAndLock");
+    if (!isValidIndex(lumpIdx)) throw Error("LumpCache::insert", stringf("Invalid index %u", lumpIdx));
+    DE_ASSERT(data);
+
+    const uint8_t *locked;
     {
-        record->clearData(retRemoved);
+        auto &shard = d->shardFor(lumpIdx);
+        DE_GUARD(shard);
+        auto &entry = d->entries[lumpIdx];
+        if (entry.data)
+        {
+            // Already cached; the contents are the same so keep the existing copy,
+            // which may be in use.
+            M_Free(data);
+            d->hits++;
+            totalHits++;
+        }
+        else
+        {
+            entry.data = data;
+            entry.size = size;
+            d->linkFirst(shard, entry);
+            d->bytes   += size;
+            totalBytes += size;
+            d->count++;
+            totalCount++;
+            d->misses++;
+            totalMisses++;
+            updatePeak(d->peakBytes, d->bytes);
+            updatePeak(totalPeakBytes, totalBytes);
+        }
+        entry.locks++;
+        entry.purge = false;
+        d->markUsed(shard, entry);
+        locked = entry.data;
     }
-    else if (retRemoved)
+    d->trim();
+    return locked;
+}
+
+LumpCache &LumpCache::remove(uint lumpIdx, bool *retRemoved)
+{
+    bool removed = false;
+    if (isValidIndex(lumpIdx))
     {
-        *retRemoved = false;
+        auto &shard = d->shardFor(lumpIdx);
+        DE_GUARD(shard);
+        auto &entry = d->entries[lumpIdx];
+        if (entry.data)
+        {
+            if (entry.locks)
+            {
+                entry.purge = true;
+            }
+            else
+            {
+                d->release(shard, entry);
+            }
+            removed = true;
+        }
     }
+    if (retRemoved) *retRemoved = removed;
     return *this;
 }
 
 LumpCache &LumpCache::clear()
 {
-    if (_dataCache)
+    for (auto &shard : d->shards)
     {
-        DE_FOR_EACH(DataCache, i, *_dataCache)
+        DE_GUARD(shard);
+        for (Impl::Entry *entry = shard.leastRecent; entry; )
         {
-            i->clearData();
+            Impl::Entry *moreRecent = entry->prev;
+            if (entry->locks)
+            {
+                entry->purge = true;
+            }
+            else
+            {
+                d->release(shard, *entry);
+            }
+            entry = moreRecent;
         }
     }
     return *this;
 }
 
-LumpCache::Data *LumpCache::cacheRecord(uint lumpIdx)
+LumpCache::Statistics LumpCache::statistics() const
+{
+    Statistics stats;
+    stats.hits      = d->hits;
+    stats.misses    = d->misses;
+    stats.evictions = d->evictions;
+    stats.bytes     = d->bytes;
+    stats.peakBytes = d->peakBytes;
+    stats.count     = d->count;
+    return stats;
+}
+
+void LumpCache::setSharedBudget(dsize bytes)
+{
+    sharedBudgetBytes = (bytes? bytes : DEFAULT_BUDGET);
+    Impl::trimShared();
+}
+
+dsize LumpCache::sharedBudget()
 {
-    if (!isValidIndex(lumpIdx)) return 0;
-    return _dataCache? &(*_dataCache)[lumpIdx] : 0;
+    return sharedBudgetBytes;
 }
 
-const LumpCache::Data *LumpCache::cacheRecord(uint lumpIdx) const
+LumpCache::Statistics LumpCache::totalStatistics()
 {
-    if (!isValidIndex(lumpIdx)) return 0;
-    return _dataCache? &(*_dataCache)[lumpIdx] : 0;
+    Statistics stats;
+    stats.hits      = totalHits;
+    stats.misses    = totalMisses;
+    stats.evictions = totalEvictions;
+    stats.bytes     = totalBytes;
+    stats.peakBytes = totalPeakBytes;
+    stats.count     = totalCount;
+    return stats;
 }
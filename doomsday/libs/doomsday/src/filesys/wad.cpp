@@ -27,7 +27,8 @@
 #include <de/byteorder.h>
 #include <de/nativepath.h>
 #include <de/logbuffer.h>
-#include <de/legacy/memoryzone.h>
+#include <de/guard.h>
+#include <de/legacy/memory.h>
 #include <cstring> // memcpy
 
 namespace res {
@@ -177,6 +178,7 @@ DE_PIMPL_NOREF(Wad)
 {
     LumpTree entries;                     ///< Directory structure and entry records for all lumps.
     std::unique_ptr<LumpCache> dataCache;  ///< Data payload cache.
+    Lockable reading;                      ///< Serializes reads from the file handle.
 
     Impl() : entries(PathTree::MultiLeaf) {}
 };
@@ -220,6 +222,8 @@ Wad::Wad(FileHandle &hndl, String path, const FileInfo &info, File1 *container)
 
         catalogLump(*lumpFile);
     }
+
+    d->dataCache.reset(new LumpCache(LumpIndex::size()));
 }
 
 Wad::~Wad()
@@ -264,16 +268,13 @@ const uint8_t *Wad::cacheLump(int lumpIndex)
             << lumpFile.info().size
             << (lumpFile.info().isCompressed()? ", compressed" : ""));
 
-    // Time to create the cache?
-    if (!d->dataCache)
-    {
-        d->dataCache.reset(new LumpCache(LumpIndex::size()));
-    }
+    if (const uint8_t *data = d->dataCache->lock(lumpIndex)) return data;
 
-    const uint8_t *data = d->dataCache->data(lumpIndex);
-    if (data) return data;
+    // Only one thread reads the lump; the others will find it in the cache.
+    DE_GUARD_FOR(d->reading, G);
+    if (const uint8_t *data = d->dataCache->lock(lumpIndex)) return data;
 
-    uint8_t *region = (uint8_t *) Z_Malloc(lumpFile.info().size, PU_APPSTATIC, 0);
+    uint8_t *region = (uint8_t *) M_Malloc(lumpFile.info().size);
     if (!region)
         throw Error("Wad::cacheLump",
                     stringf("Failed on allocation of %zu bytes for cache copy of lump #%i",
@@ -281,9 +282,7 @@ const uint8_t *Wad::cacheLump(int lumpIndex)
                             lumpIndex));
 
     readLump(lumpIndex, region, false);
-    d->dataCache->insert(lumpIndex, region);
-
-    return region;
+    return d->dataCache->insertAndLock(lumpIndex, region, lumpFile.info().size);
 }
 
 void Wad::unlockLump(int lumpIndex)
@@ -329,18 +328,23 @@ size_t Wad::readLump(int lumpIndex, uint8_t *buffer, size_t startOffset,
     // Try to avoid a file system read by checking for a cached copy.
     if (tryCache)
     {
-        const uint8_t *data = (d->dataCache ? d->dataCache->data(lumpIndex) : 0);
+        const uint8_t *data = (d->dataCache ? d->dataCache->lock(lumpIndex) : 0);
         LOGDEV_RES_XVERBOSE("Cache %s on #%i", (data? "hit" : "miss") << lumpIndex);
         if (data)
         {
             size_t readBytes = de::min(size_t(lumpFile.size()), length);
             std::memcpy(buffer, data + startOffset, readBytes);
+            d->dataCache->unlock(lumpIndex);
             return readBytes;
         }
     }
 
-    handle_->seek(lumpFile.info().baseOffset + startOffset, SeekSet);
-    size_t readBytes = handle_->read(buffer, length);
+    size_t readBytes;
+    {
+        DE_GUARD_FOR(d->reading, G);
+        handle_->seek(lumpFile.info().baseOffset + startOffset, SeekSet);
+        readBytes = handle_->read(buffer, length);
+    }
 
     /// @todo Do not check the read length here.
     if (readBytes < length)
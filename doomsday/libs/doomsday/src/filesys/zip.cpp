@@ -30,10 +30,10 @@
 
 #include <de/app.h>
 #include <de/byteorder.h>
+#include <de/guard.h>
 #include <de/nativepath.h>
 #include <de/logbuffer.h>
 #include <de/legacy/memory.h>
-#include <de/legacy/memoryzone.h>
 #include <cstring> // memcpy
 
 #ifdef MSVC
@@ -320,6 +320,7 @@ DE_PIMPL(Zip)
 {
     LumpTree entries;                     ///< Directory structure and entry records for all lumps.
     std::unique_ptr<LumpCache> dataCache;  ///< Data payload cache.
+    Lockable reading;                      ///< Serializes reads from the file handle.
 
     Impl(Public *i) : Base(i)
     {}
@@ -332,6 +333,7 @@ DE_PIMPL(Zip)
     {
         DE_ASSERT(buffer);
         LOG_AS("Zip");
+        DE_GUARD(reading);
 
         const FileInfo &lumpInfo = lump.info();
         self().handle_->seek(lumpInfo.baseOffset, SeekSet);
@@ -530,6 +532,8 @@ Zip::Zip(FileHandle &hndl, String path, const FileInfo &info, File1 *container)
 
     // The file central directory is no longer needed.
     M_Free(centralDirectory);
+
+    d->dataCache.reset(new LumpCache(lumpCount()));
 }
 
 Zip::~Zip()
@@ -574,23 +578,21 @@ const uint8_t *Zip::cacheLump(int lumpIndex)
                         << lumpFile.info().size
                         << (lumpFile.info().isCompressed()? ", compressed" : ""));
 
-    // Time to create the cache?
-    if (!d->dataCache)
-    {
-        d->dataCache.reset(new LumpCache(lumpCount()));
-    }
+    if (const uint8_t *data = d->dataCache->lock(lumpIndex)) return data;
 
-    const uint8_t *data = d->dataCache->data(lumpIndex);
-    if (data) return data;
+    // Only one thread reads the lump; the others will find it in the cache.
+    DE_GUARD_FOR(d->reading, G);
+    if (const uint8_t *data = d->dataCache->lock(lumpIndex)) return data;
 
-    uint8_t *region = (uint8_t *) Z_Malloc(lumpFile.info().size, PU_APPSTATIC, 0);
-    if (!region) throw Error("Zip::cacheLump", stringf("Failed on allocation of %zu bytes for cache copy of lump #%i",
-                                                       lumpFile.info().size, lumpIndex));
+    uint8_t *region = (uint8_t *) M_Malloc(lumpFile.info().size);
+    if (!region)
+        throw Error("Zip::cacheLump",
+                    stringf("Failed on allocation of %zu bytes for cache copy of lump #%i",
+                            lumpFile.info().size,
+                            lumpIndex));
 
     readLump(lumpIndex, region, false);
-    d->dataCache->insert(lumpIndex, region);
-
-    return region;
+    return d->dataCache->insertAndLock(lumpIndex, region, lumpFile.info().size);
 }
 
 void Zip::unlockLump(int lumpIndex)
@@ -635,12 +637,13 @@ size_t Zip::readLump(int lumpIndex, uint8_t *buffer, size_t startOffset,
     // Try to avoid a file system read by checking for a cached copy.
     if (tryCache)
     {
-        const uint8_t *data = (d->dataCache ? d->dataCache->data(lumpIndex) : 0);
+        const uint8_t *data = (d->dataCache ? d->dataCache->lock(lumpIndex) : 0);
         LOGDEV_RES_XVERBOSE("Cache %s on #%i", (data? "hit" : "miss") << lumpIndex);
         if (data)
         {
             size_t readBytes = de::min(size_t(lumpFile.size()), length);
             std::memcpy(buffer, data + startOffset, readBytes);
+            d->dataCache->unlock(lumpIndex);
             return readBytes;
         }
     }
@@ -66,6 +66,11 @@ MapManifest &MapManifest::setRecognizer(Id1MapRecognizer *newRecognizer)
     return *this;
 }
 
+bool MapManifest::hasRecognizer() const
+{
+    return bool(_recognized);
+}
+
 const Id1MapRecognizer &MapManifest::recognizer() const
 {
     DE_ASSERT(_recognized);
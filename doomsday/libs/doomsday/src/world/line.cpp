@@ -767,6 +767,11 @@ bool Line::isBspWindow() const
     return _bspWindowSector != nullptr;
 }
 
+Sector *Line::bspWindowSector() const
+{
+    return _bspWindowSector;
+}
+
 bool Line::definesPolyobj() const
 {
     return d->polyobj != nullptr;
@@ -34,6 +34,7 @@
 #include <de/legacy/fixedpoint.h>
 #include <de/legacy/vector1.h>
 #include <cmath>
+#include <unordered_set>
 
 using namespace de;
 
@@ -47,6 +48,10 @@ DE_PIMPL_NOREF(LineSightTest)
     dfloat bottomSlope;  // Slope to bottom of target.
     dfloat topSlope;     // Slope to top of target.
 
+    /// Lines already tested during a concurrent trace (validCount is not used).
+    bool concurrent = false;
+    std::unordered_set<const Line *> testedLines;
+
     /// The ray to be traced.
     struct Ray
     {
@@ -90,10 +95,18 @@ DE_PIMPL_NOREF(LineSightTest)
 
         Line &line = side.line();
 
-        if (line.validCount() == World::validCount)
-            return true;  // Ignore
+        if (concurrent)
+        {
+            if (!testedLines.insert(&line).second)
+                return true;  // Ignore
+        }
+        else
+        {
+            if (line.validCount() == World::validCount)
+                return true;  // Ignore
 
-        line.setValidCount(World::validCount);
+            line.setValidCount(World::validCount);
+        }
 
         // Does the ray intercept the line on the X/Y plane?
         // Try a quick bounding-box rejection.
@@ -333,4 +346,15 @@ bool LineSightTest::trace(const BspTree &bspRoot)
     return d->crossBspNode(&bspRoot);
 }
 
+bool LineSightTest::traceConcurrently(const BspTree &bspRoot)
+{
+    d->concurrent = true;
+    d->testedLines.clear();
+
+    d->topSlope    = d->to.z + d->topSlope    - d->from.z;
+    d->bottomSlope = d->to.z + d->bottomSlope - d->from.z;
+
+    return d->crossBspNode(&bspRoot);
+}
+
 }  // namespace world
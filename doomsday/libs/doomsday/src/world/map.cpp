@@ -32,6 +32,8 @@
 #include "doomsday/world/thinkers.h"
 #include "doomsday/world/thinkerdata.h"
 #include "doomsday/world/mobjthinkerdata.h"
+#include "doomsday/world/reject.h"
+#include "doomsday/world/sectorvisibility.h"
 #include "doomsday/world/sky.h"
 #include "doomsday/world/world.h"
 #include "doomsday/mesh/face.h"
@@ -46,6 +48,7 @@
 #include <de/charsymbols.h>
 #include <de/rectangle.h>
 #include <de/logbuffer.h>
+#include <de/metadatabank.h>
 
 using namespace de;
 
@@ -53,6 +56,8 @@ namespace world {
 
 static int bspSplitFactor = 7;  // cvar
 
+DE_STATIC_STRING(SECTOR_VISIBILITY_CACHE_CATEGORY, "SectorVisibility");
+
 /*
  * Additional data for all dummy elements.
  */
@@ -167,6 +172,9 @@ DE_PIMPL(Map)
     nodepile_t                    lineNodes;
     nodeindex_t *                 lineLinks = nullptr; ///< Indices to roots.
 
+    std::unique_ptr<SectorVisibility> sectorVisibility; ///< Determined on demand.
+    std::unique_ptr<Block>            rejectMatrix;     ///< Determined on demand.
+
     Impl(Public *i) : Base(i)
     {
         sky.reset(Factory::newSky(nullptr));
@@ -208,6 +216,73 @@ DE_PIMPL(Map)
         polyobjBlockmap.reset();
         lineBlockmap.reset();
         subspaceBlockmap.reset();
+
+        sectorVisibility.reset();
+        rejectMatrix.reset();
+    }
+
+    void initSectorVisibility()
+    {
+        LOG_AS("Map");
+
+        sectorVisibility.reset(new SectorVisibility);
+
+        // The result only depends on the geometry, so it may already have been cached.
+        const Block geometryId = SectorVisibility::geometryId(self());
+        try
+        {
+            if (Block cached = MetadataBank::get().check(SECTOR_VISIBILITY_CACHE_CATEGORY(), geometryId))
+            {
+                cached = cached.decompressed();
+                Reader(cached).withHeader() >> *sectorVisibility;
+                if (sectorVisibility->sectorCount() == sectors.sizei())
+                {
+                    LOGDEV_MAP_VERBOSE("Using cached sector visibility");
+                    return;
+                }
+            }
+        }
+        catch (const Error &er)
+        {
+            LOGDEV_MAP_WARNING("Corrupt cached sector visibility: %s") << er.asText();
+        }
+
+        Time begunAt;
+        sectorVisibility->build(self());
+        LOG_MAP_VERBOSE("Sector visibility determined in %.2f seconds") << begunAt.since();
+
+        Block buf;
+        Writer(buf).withHeader() << *sectorVisibility;
+        MetadataBank::get().setMetadata(SECTOR_VISIBILITY_CACHE_CATEGORY(), geometryId, buf.compressed());
+    }
+
+    void initRejectMatrix()
+    {
+        LOG_AS("Map");
+
+        rejectMatrix.reset(new Block);
+
+        // Prefer the REJECT lump of the map, if it has one worth using.
+        if (self().hasManifest() && self().manifest().hasRecognizer())
+        {
+            const auto &lumps = self().manifest().recognizer().lumps();
+            auto found = lumps.find(res::Id1MapRecognizer::RejectData);
+            if (found != lumps.end() && found->second)
+            {
+                res::File1 &lump = *found->second;
+                Block data(lump.size());
+                lump.read(data.data(), false /*don't cache*/);
+                if (isUsefulRejectMatrix(data, sectors.sizei()))
+                {
+                    LOGDEV_MAP_VERBOSE("Using the REJECT lump of the map");
+                    *rejectMatrix = data;
+                    return;
+                }
+            }
+        }
+
+        *rejectMatrix = buildRejectMatrix(self());
+        LOGDEV_MAP_VERBOSE("Built REJECT matrix from sector visibility");
     }
 
     void recordBeingDeleted(Record &record)
@@ -1405,6 +1480,34 @@ LoopResult Map::forAllLinesInBox(const AABoxd &box, int flags,
     return result;
 }
 
+LoopResult Map::forAllLinesInBoxConcurrently(const AABoxd &box, int flags,
+                                             const std::function<LoopResult (Line &line)> &func) const
+{
+    LoopResult result = LoopContinue;
+
+    // Process polyobj lines?
+    if ((flags & LIF_POLYOBJ) && polyobjCount())
+    {
+        result = polyobjBlockmap().forAllInBox(box, [&func] (void *object) {
+            for (Line *line : reinterpret_cast<Polyobj *>(object)->lines())
+            {
+                if (auto result = func(*line)) return result;
+            }
+            return LoopResult(); // continue
+        });
+    }
+
+    // Process sector lines?
+    if (!result && (flags & LIF_SECTOR))
+    {
+        result = lineBlockmap().forAllInBox(box, [&func] (void *object) {
+            return func(*reinterpret_cast<Line *>(object));
+        });
+    }
+
+    return result;
+}
+
 LoopResult Map::forAllMobjsTouchingLine(Line &line, const std::function<LoopResult (mobj_t &)> &func) const
 {
     /// @todo Optimize: It should not be necessary to collate the objects first in
@@ -1835,6 +1938,24 @@ const Blockmap &Map::subspaceBlockmap() const
     throw MissingBlockmapError("Map::subspaceBlockmap", "Convex subspace blockmap is not initialized");
 }
 
+const SectorVisibility &Map::sectorVisibility() const
+{
+    if (!d->sectorVisibility)
+    {
+        d->initSectorVisibility();
+    }
+    return *d->sectorVisibility;
+}
+
+const Block &Map::rejectMatrix() const
+{
+    if (!d->rejectMatrix)
+    {
+        d->initRejectMatrix();
+    }
+    return *d->rejectMatrix;
+}
+
 int Map::unlink(mobj_t &mob)
 {
     int links = 0;
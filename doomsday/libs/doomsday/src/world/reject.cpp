@@ -1,13 +1,10 @@
-/** @file reject.h World map sector LOS reject LUT building.
+/** @file reject.cpp World map sector LOS reject LUT building.
  *
  * @authors Copyright © 2007-2013 Daniel Swanson <danij@dengine.net>
  * @authors Copyright © 2000-2007 Andrew Apted <ajapted@gmail.com>
  * @authors Copyright © 1998-2000 Colin Reed <cph@moria.org.uk>
  * @authors Copyright © 1998-2000 Lee Killough <killough@rsn.hp.com>
  *
- * Based on glBSP 2.24 (in turn, based on BSP 2.3).
- * @see http://sourceforge.net/projects/glbsp/
- *
  * @par License
  * GPL: http://www.gnu.org/licenses/gpl.html
  *
@@ -23,92 +20,71 @@
  * 02110-1301 USA</small>
  */
 
-#if 0 // Needs updating.
-#include <cmath>
-
-#include "de_base.h"
-#include "world/map.h"
+#include "doomsday/world/reject.h"
+#include "doomsday/world/map.h"
+#include "doomsday/world/line.h"
+#include "doomsday/world/sector.h"
+#include "doomsday/world/sectorvisibility.h"
 
 using namespace de;
 
-void BuildRejectForMap(const Map &map)
-{
-    int *secGroups = M_Malloc(sizeof(int) * map.sectorCount());
-    int group = 0;
+namespace world {
 
-    for(uint i = 0; i < map.sectorCount(); ++i)
+Block buildRejectMatrix(const Map &map)
+{
+    const SectorVisibility &pvs = map.sectorVisibility();
+    const dsize count = dsize(pvs.sectorCount());
+
+    // Rejected pairs are the ones that are not potentially visible. The bits
+    // are packed in the same order, so the matrix can be inverted bytewise.
+    Block matrix(pvs.matrix());
+    Byte *bits = matrix.data();
+    for (dsize i = 0; i < matrix.size(); ++i)
     {
-        Sector &sector = map.sectors[i];
-        secGroups[i] = group++;
-        sector.rejNext = sector.rejPrev = &sector;
+        bits[i] = Byte(~bits[i]);
     }
 
-    for(uint i = 0; i < map.lineCount(); ++i)
+    // Sectors that share a two-sided line or a "one-way window" can always see each
+    // other (LineSightTest lets sight through both), whatever the visibility data
+    // says. Never reject them, so sight checks cannot fail across a window line.
+    map.forAllLines([bits, count] (Line &line)
     {
-        Line *line = &map.lines[i];
-
-        if(!line->front().hasSector() || !line->back().hasSector())
-            continue;
+        if (line.definesPolyobj() || !line.front().hasSector()) return LoopContinue;
 
-        Sector *sec1 = line->front().sectorPtr();
-        Sector *sec2 = line->back().sectorPtr();
+        const Sector *back = line.back().hasSector()? line.back().sectorPtr()
+                                                    : line.bspWindowSector();
+        if (!back) return LoopContinue;
 
-        if(!sec1 || !sec2 || sec1 == sec2)
-            continue;
+        const dsize s1 = dsize(line.front().sector().indexInMap());
+        const dsize s2 = dsize(back->indexInMap());
+        if (s1 >= count || s2 >= count) return LoopContinue;
 
-        // Already in the same group?
-        if(secGroups[sec1->index] == secGroups[sec2->index])
-            continue;
+        const dsize p1 = s1 * count + s2;
+        const dsize p2 = s2 * count + s1;
+        bits[p1 >> 3] &= Byte(~(1 << (p1 & 7)));
+        bits[p2 >> 3] &= Byte(~(1 << (p2 & 7)));
+        return LoopContinue;
+    });
 
-        // Swap sectors so that the smallest group is added to the biggest
-        // group. This is based on the assumption that sector numbers in
-        // wads will generally increase over the set of lines, and so
-        // (by swapping) we'll tend to add small groups into larger
-        // groups, thereby minimising the updates to 'rej_group' fields
-        // that is required when merging.
-        Sector *p = 0;
-        if(secGroups[sec1->index] > secGroups[sec2->index])
-        {
-            p = sec1;
-            sec1 = sec2;
-            sec2 = p;
-        }
-
-        // Update the group numbers in the second group
-        secGroups[sec2->index] = secGroups[sec1->index];
-        for(p = sec2->rejNext; p != sec2; p = p->rejNext)
-        {
-            secGroups[p->index] = secGroups[sec1->index];
-        }
-
-        // Merge 'em baby...
-        sec1->rejNext->rejPrev = sec2;
-        sec2->rejNext->rejPrev = sec1;
-
-        p = sec1->rejNext;
-        sec1->rejNext = sec2->rejNext;
-        sec2->rejNext = p;
+    // Clear the unused bits at the end.
+    if (const dsize used = (count * count) & 7)
+    {
+        bits[matrix.size() - 1] &= Byte((1 << used) - 1);
     }
+    return matrix;
+}
 
-    size_t rejectSize = (map.sectorCount() * map.sectorCount() + 7) / 8;
-    byte *matrix = Z_Calloc(rejectSize, PU_MAPSTATIC, 0);
+bool isUsefulRejectMatrix(const Block &rejectData, int sectorCount)
+{
+    const dsize needed = (dsize(sectorCount) * dsize(sectorCount) + 7) / 8;
+    if (rejectData.size() < needed) return false;
 
-    for(int view = 0; view < map.sectorCount(); ++view)
-    for(int target = 0; target < view; ++target)
+    const Byte *bits = rejectData.cdata();
+    for (dsize i = 0; i < needed; ++i)
     {
-        if(secGroups[view] == secGroups[target])
-            continue;
-
-        // For symmetry, do two bits at a time.
-        int p1 = view * map.sectorCount() + target;
-        int p2 = target * map.sectorCount() + view;
-
-        matrix[p1 >> 3] |= (1 << (p1 & 7));
-        matrix[p2 >> 3] |= (1 << (p2 & 7));
+        if (bits[i]) return true;
     }
-
-    M_Free(secGroups);
-
-    return matrix;
+    return false; // All zero.
 }
-#endif
+
+} // namespace world
@@ -0,0 +1,418 @@
+/** @file sectorvisibility.cpp  Potentially visible set of map sectors.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "doomsday/world/sectorvisibility.h"
+#include "doomsday/world/map.h"
+#include "doomsday/world/line.h"
+#include "doomsday/world/sector.h"
+#include "doomsday/world/vertex.h"
+
+#include <de/reader.h>
+#include <de/writer.h>
+#include <de/vector.h>
+#include <cmath>
+
+using namespace de;
+
+namespace world {
+
+/// Increment when the algorithm changes so that cached results are discarded.
+static const duint8 SECTOR_VISIBILITY_VERSION = 3;
+
+/// Points this close to a line are considered to be on it.
+static const double EPSILON = 1.0 / 128;
+
+/// Maximum number of portals visited per source sector before giving up and
+/// considering the entire connected group visible.
+static const int MAX_FLOW_STEPS = 0x20000;
+
+/// Maximum length of a chain of portals (bounds the recursion).
+static const int MAX_FLOW_DEPTH = 512;
+
+namespace internal {
+
+/// Line segment shared by two different sectors, directed from one to the other.
+struct Portal
+{
+    Vec2d a, b;
+    Vec2d normal;  ///< Unit normal pointing into the target sector.
+    int   line;
+    int   target;  ///< Index of the sector on the far side.
+};
+
+struct Winding
+{
+    Vec2d a, b;
+};
+
+/**
+ * Keeps the part of @a seg that lies on the positive side of the line through
+ * @a point with @a normal (points on the line are kept).
+ *
+ * @return  @c false if nothing remains.
+ */
+static bool clipToHalfPlane(Winding &seg, const Vec2d &point, const Vec2d &normal)
+{
+    const double da = (seg.a - point).dot(normal);
+    const double db = (seg.b - point).dot(normal);
+
+    if (da >= -EPSILON && db >= -EPSILON) return true;
+    if (da <  -EPSILON && db <  -EPSILON) return false;
+
+    const Vec2d cross = seg.a + (seg.b - seg.a) * (da / (da - db));
+    if (da < -EPSILON) seg.a = cross;
+    else               seg.b = cross;
+    return true;
+}
+
+/**
+ * Clips @a target with the lines that separate @a source from @a pass. A line of
+ * sight that crosses the source and then the pass can only continue on the pass
+ * side of each separating line. Degenerate separators are ignored, which errs
+ * on the side of visibility.
+ */
+static bool clipToSeparators(Winding &target, const Winding &source, const Winding &pass)
+{
+    const Vec2d src[2] = { source.a, source.b };
+    const Vec2d pas[2] = { pass.a,   pass.b   };
+
+    for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 2; ++j)
+    {
+        const Vec2d  dir = pas[j] - src[i];
+        const double len = dir.length();
+        if (len < EPSILON) continue;
+
+        const Vec2d  normal   = Vec2d(-dir.y, dir.x) / len;
+        const double srcSide  = (src[i ^ 1] - src[i]).dot(normal);
+        const double passSide = (pas[j ^ 1] - src[i]).dot(normal);
+
+        if (srcSide > EPSILON && passSide < -EPSILON)
+        {
+            if (!clipToHalfPlane(target, src[i], -normal)) return false;
+        }
+        else if (srcSide < -EPSILON && passSide > EPSILON)
+        {
+            if (!clipToHalfPlane(target, src[i], normal)) return false;
+        }
+    }
+    return true;
+}
+
+struct Flow
+{
+    DE_ERROR(BudgetExceededError);
+
+    const List<List<Portal>> &portals;  ///< Outgoing portals of each sector.
+    List<duint8>              onPath;   ///< Lines crossed by the current chain.
+    Byte *                    row;      ///< Visibility bits of the source sector.
+    const Portal *            source = nullptr;
+    int                       steps  = 0;
+
+    Flow(const List<List<Portal>> &portals, int lineCount, Byte *row)
+        : portals(portals)
+        , onPath(dsize(lineCount), 0)
+        , row(row)
+    {}
+
+    inline void markVisible(int sector)
+    {
+        row[sector >> 3] |= Byte(1 << (sector & 7));
+    }
+
+    void begin(const Portal &from)
+    {
+        source = &from;
+        markVisible(from.target);
+        onPath[from.line] = 1;
+        enter(Winding{from.a, from.b}, from, 1);
+        onPath[from.line] = 0;
+    }
+
+    void enter(const Winding &pass, const Portal &passPortal, int depth)
+    {
+        if (depth > MAX_FLOW_DEPTH)
+        {
+            throw BudgetExceededError("Flow::enter", "Portal chain too long");
+        }
+        const Winding sourceWinding{source->a, source->b};
+
+        for (const Portal &next : portals.at(passPortal.target))
+        {
+            if (onPath[next.line]) continue;
+
+            if (++steps > MAX_FLOW_STEPS)
+            {
+                throw BudgetExceededError("Flow::enter", "Too many portals");
+            }
+
+            // A line of sight continues away from both the source and the pass.
+            Winding seen{next.a, next.b};
+            if (!clipToHalfPlane(seen, source->a, source->normal)) continue;
+            if (!clipToHalfPlane(seen, pass.a, passPortal.normal)) continue;
+            if (&passPortal != source)
+            {
+                if (!clipToSeparators(seen, sourceWinding, pass)) continue;
+            }
+
+            markVisible(next.target);
+
+            onPath[next.line] = 1;
+            enter(seen, next, depth + 1);
+            onPath[next.line] = 0;
+        }
+    }
+};
+
+/**
+ * Finds the sector that is first reached from @a origin in direction @a dir, by
+ * looking at the side of the nearest line that faces @a origin. Self-referencing
+ * lines are ignored, because they do not bound their sector.
+ *
+ * @return Sector index, or -1 if nothing is found (or the line is one-sided).
+ */
+static int findSectorAround(const List<SectorVisibility::Edge> &edges, const Vec2d &origin,
+                            const Vec2d &dir)
+{
+    double nearest = 0;
+    int    sector  = -1;
+    for (const auto &edge : edges)
+    {
+        if (edge.front == edge.back) continue;
+
+        const Vec2d  span  = edge.to - edge.from;
+        const double denom = dir.cross(span);
+        if (std::abs(denom) < EPSILON) continue;  // Parallel.
+
+        const Vec2d  delta = edge.from - origin;
+        const double t     = delta.cross(span) / denom;
+        const double u     = delta.cross(dir)  / denom;
+        if (t <= EPSILON || u < 0 || u > 1) continue;
+        if (sector >= 0 && t >= nearest) continue;
+
+        // The front side is on the right.
+        const bool inFront = (origin - edge.from).dot(Vec2d(span.y, -span.x)) > 0;
+        nearest = t;
+        sector  = inFront? edge.front : edge.back;
+    }
+    return sector;
+}
+
+static int findGroup(List<int> &groups, int sector)
+{
+    while (groups[sector] != sector)
+    {
+        groups[sector] = groups[groups[sector]];
+        sector = groups[sector];
+    }
+    return sector;
+}
+
+} // namespace internal
+
+using namespace internal;
+
+SectorVisibility::SectorVisibility() : _count(0)
+{}
+
+void SectorVisibility::build(const Map &map)
+{
+    List<Edge> edges;
+    map.forAllLines([&edges] (Line &line)
+    {
+        if (line.definesPolyobj()) return LoopContinue;
+        if (!line.front().hasSector()) return LoopContinue;
+
+        // Sight passes through "one-way windows" although they have no back sector.
+        const Sector *backSector = line.back().hasSector()? line.back().sectorPtr()
+                                                          : line.bspWindowSector();
+        edges << Edge{line.from().origin(), line.to().origin(),
+                      line.front().sector().indexInMap(),
+                      backSector? backSector->indexInMap() : -1};
+        return LoopContinue;
+    });
+    build(map.sectorCount(), edges);
+}
+
+void SectorVisibility::build(int sectorCount, const List<Edge> &edges)
+{
+    _count = sectorCount;
+
+    const dsize rowBits = dsize(_count);
+    _matrix = Block((rowBits * rowBits + 7) / 8);
+    _matrix.fill(0);
+    if (!_count) return;
+
+    // Collect the portals and the connected sector groups.
+    List<List<Portal>> portals(_count);
+    List<int> groups(_count);
+    for (int i = 0; i < _count; ++i) groups[i] = i;
+
+    auto addPortal = [&portals, &groups] (const Edge &edge, const Vec2d &toBack, int line,
+                                          int front, int back)
+    {
+        portals[front] << Portal{edge.from, edge.to,  toBack, line, back};
+        portals[back]  << Portal{edge.from, edge.to, -toBack, line, front};
+        groups[findGroup(groups, front)] = findGroup(groups, back);
+    };
+
+    List<bool> surrounded(_count, true);  // False if the surroundings are unknown.
+    for (int i = 0; i < edges.sizei(); ++i)
+    {
+        const Edge &edge = edges[i];
+        if (edge.back < 0 || edge.front >= _count || edge.back >= _count) continue;
+
+        const Vec2d d = edge.to - edge.from;
+        if (d.length() < EPSILON) continue;
+
+        // The front side is on the right.
+        const Vec2d toFront = Vec2d(d.y, -d.x).normalize();
+
+        if (edge.front != edge.back)
+        {
+            addPortal(edge, -toFront, i, edge.front, edge.back);
+            continue;
+        }
+
+        // A self-referencing line leads to whatever sector is around it.
+        const Vec2d mid = (edge.from + edge.to) / 2;
+        bool found = false;
+        for (const Vec2d &dir : {toFront, -toFront})
+        {
+            const int around = findSectorAround(edges, mid, dir);
+            if (around >= 0 && around < _count && around != edge.front)
+            {
+                addPortal(edge, dir, i, edge.front, around);
+                found = true;
+            }
+        }
+        if (!found) surrounded[edge.front] = false;
+    }
+
+    Byte *bits = _matrix.data();
+    Block rowData((rowBits + 7) / 8);
+    for (int from = 0; from < _count; ++from)
+    {
+        // Rows of the matrix are not byte-aligned, so gather each row separately.
+        rowData.fill(0);
+        Flow flow(portals, edges.sizei(), rowData.data());
+        flow.markVisible(from);
+        try
+        {
+            for (const Portal &portal : portals.at(from))
+            {
+                flow.begin(portal);
+            }
+        }
+        catch (const Flow::BudgetExceededError &)
+        {
+            // Too complex to determine; everything reachable may be visible.
+            const int group = findGroup(groups, from);
+            for (int to = 0; to < _count; ++to)
+            {
+                if (findGroup(groups, to) == group) flow.markVisible(to);
+            }
+        }
+
+        const dsize rowStart = dsize(from) * rowBits;
+        for (int to = 0; to < _count; ++to)
+        {
+            if (rowData.at(dsize(to) >> 3) & (1 << (to & 7)))
+            {
+                const dsize bit = rowStart + dsize(to);
+                bits[bit >> 3] |= Byte(1 << (bit & 7));
+            }
+        }
+    }
+
+    // Lines of sight work both ways. A sector with unknown surroundings may see and
+    // be seen by everything.
+    for (int from = 0; from < _count; ++from)
+    for (int to = 0; to < from; ++to)
+    {
+        const dsize p1 = dsize(from) * rowBits + dsize(to);
+        const dsize p2 = dsize(to) * rowBits + dsize(from);
+        if ((bits[p1 >> 3] & (1 << (p1 & 7))) || (bits[p2 >> 3] & (1 << (p2 & 7))) ||
+            !surrounded[from] || !surrounded[to])
+        {
+            bits[p1 >> 3] |= Byte(1 << (p1 & 7));
+            bits[p2 >> 3] |= Byte(1 << (p2 & 7));
+        }
+    }
+}
+
+Block SectorVisibility::geometryId(const Map &map) // static
+{
+    Block data;
+    Writer writer(data);
+    writer << SECTOR_VISIBILITY_VERSION << dint32(map.sectorCount()) << dint32(map.lineCount());
+    map.forAllLines([&writer] (Line &line)
+    {
+        writer << line.from().origin().x << line.from().origin().y
+               << line.to  ().origin().x << line.to  ().origin().y
+               << dint32(line.front().hasSector()? line.front().sector().indexInMap() : -1)
+               << dint32(line.back ().hasSector()? line.back ().sector().indexInMap() : -1)
+               << dint32(line.isBspWindow()? line.bspWindowSector()->indexInMap() : -1)
+               << duint8(line.definesPolyobj()? 1 : 0);
+        return LoopContinue;
+    });
+    return data.md5Hash();
+}
+
+int SectorVisibility::sectorCount() const
+{
+    return _count;
+}
+
+int SectorVisibility::visibleCount(int from) const
+{
+    if (from < 0 || from >= _count) return _count;
+    int count = 0;
+    for (int to = 0; to < _count; ++to)
+    {
+        if (isVisible(from, to)) count++;
+    }
+    return count;
+}
+
+const Block &SectorVisibility::matrix() const
+{
+    return _matrix;
+}
+
+void SectorVisibility::operator >> (Writer &to) const
+{
+    to << SECTOR_VISIBILITY_VERSION << dint32(_count) << _matrix;
+}
+
+void SectorVisibility::operator << (Reader &from)
+{
+    duint8 version;
+    dint32 count;
+    from >> version >> count >> _matrix;
+    if (version != SECTOR_VISIBILITY_VERSION ||
+        _matrix.size() != (dsize(count) * dsize(count) + 7) / 8)
+    {
+        _count = 0;
+        _matrix.clear();
+        throw DeserializationError("SectorVisibility::operator <<", "Invalid visibility data");
+    }
+    _count = count;
+}
+
+}  // namespace world
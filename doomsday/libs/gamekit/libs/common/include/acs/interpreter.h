@@ -60,7 +60,7 @@ struct Interpreter
         void drop();
     } locals;
     int args[ACS_INTERPRETER_MAX_SCRIPT_ARGS];
-    const int *pcodePtr;
+    const Module::Instruction *pc;  ///< Next instruction to execute.
 
     System &scriptSys() const;
 
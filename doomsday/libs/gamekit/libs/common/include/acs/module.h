@@ -48,12 +48,64 @@ public:
     /// Required/referenced (script) entry point data is missing. @ingroup errors
     DE_ERROR(MissingEntryPointError);
 
+    /// Referenced instruction is missing. @ingroup errors
+    DE_ERROR(MissingInstructionError);
+
+    /**
+     * Instruction opcodes. The bytecode format defines opcodes up to OpcodeCount;
+     * the rest are superinstructions that replace common sequences of instructions
+     * when the module is loaded.
+     */
+    enum Opcode
+    {
+        // Bytecode opcodes that are referred to by name:
+        Terminate       = 1,
+        PushNumber      = 3,
+        EQ              = 19,
+        NE, LT, GT, LE, GE,
+        AssignScriptVar = 25,
+        AssignMapVar,
+        AssignWorldVar,
+        PushScriptVar,
+        Goto            = 52,
+        IfGoto,
+        Restart         = 69,
+        IfNotGoto       = 79,
+        CaseGoto        = 84,
+
+        OpcodeCount     = 102,
+
+        PushNumber2 = OpcodeCount,    ///< PushNumber, PushNumber
+        AssignScriptVarDirect,        ///< PushNumber, AssignScriptVar
+        AssignMapVarDirect,           ///< PushNumber, AssignMapVar
+        AssignWorldVarDirect,         ///< PushNumber, AssignWorldVar
+        CompareScriptVarIfNotGoto,    ///< PushScriptVar, PushNumber, (EQ|NE|LT|GT|LE|GE), IfNotGoto
+        InvalidOpcode,                ///< Unknown opcode, or the code ends unexpectedly.
+
+        TotalOpcodeCount
+    };
+
+    /**
+     * Pre-decoded instruction. Operands are in host byte order and jump targets are
+     * resolved, so the interpreter does not need to look at the bytecode itself.
+     */
+    struct Instruction
+    {
+        static const int MAX_OPERANDS = 6;
+
+        de::dint32 opcode = InvalidOpcode;
+        de::dint32 operands[MAX_OPERANDS] {};
+        const Instruction *target = nullptr;  ///< Jump target (if any).
+        const Instruction *next   = nullptr;  ///< Following instruction (after any fused ones).
+        de::dint32 offset = 0;                ///< Position in the bytecode (in bytes).
+    };
+
     /**
      * Stores information about an ACS script entry point.
      */
     struct EntryPoint
     {
-        const int *pcodePtr       = nullptr;
+        const Instruction *start  = nullptr;
         bool startWhenMapBegins   = false;
         de::dint32 scriptNumber   = 0;
         de::dint32 scriptArgCount = 0;
@@ -107,6 +159,13 @@ public:
      */
     const de::Block &pcode() const;
 
+    /**
+     * Looks up the pre-decoded instruction at the given position in the bytecode.
+     *
+     * @param offset  Position of the instruction in the bytecode (in bytes).
+     */
+    const Instruction &instruction(de::dint32 offset) const;
+
 private:
     Module();
 
@@ -126,6 +126,11 @@ public:
     void waitForScript (int number);
     void waitForSector (int tag);
 
+    /**
+     * Returns the tag or script number the script is waiting for (if waiting).
+     */
+    int waitValue() const;
+
     void polyobjFinished(int tag);
     void sectorFinished (int tag);
 
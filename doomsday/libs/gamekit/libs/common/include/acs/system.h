@@ -98,6 +98,17 @@ public:  // Scripts: -----------------------------------------------------------
      */
     de::LoopResult forAllScripts(std::function<de::LoopResult (Script &)> func) const;
 
+    /**
+     * Puts @a script to wait until the script @a scriptNumber has terminated.
+     */
+    void waitForScript(Script &script, int scriptNumber);
+
+    /**
+     * To be called when @a script has terminated, to resume any scripts that are
+     * waiting for it.
+     */
+    void scriptTerminated(const Script &script);
+
     /**
      * Defer a script start task until the identified map is next current.
      *
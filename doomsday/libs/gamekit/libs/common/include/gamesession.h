@@ -188,6 +188,11 @@ public:  // Saved session management -------------------------------------------
     /**
      * Save the current game state to a new @em user saved session.
      *
+     * The game state is captured immediately, but the package is compressed and
+     * written to disk in the background. The user is notified when the save is
+     * complete. Loading, copying or removing saved sessions, and ending the game
+     * session, first wait for any pending saves to finish.
+     *
      * @param saveName         Name of the new saved session.
      * @param userDescription  Textual description of the current game state provided either
      *                         by the user or possibly generated automatically.
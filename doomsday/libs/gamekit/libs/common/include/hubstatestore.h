@@ -0,0 +1,98 @@
+/** @file hubstatestore.h  In-memory store of serialized map states in a hub.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+
+#ifndef LIBCOMMON_HUBSTATESTORE_H
+#define LIBCOMMON_HUBSTATESTORE_H
+
+#include <de/block.h>
+#include <de/string.h>
+#include <functional>
+
+/**
+ * Serialized states of the maps visited in the current hub, kept uncompressed in
+ * memory. Moving between the maps of a hub then doesn't require rewriting and
+ * reinflating the game state package.
+ *
+ * The total size of the stored states is limited by a budget. When the budget is
+ * exceeded, the least recently stored states are passed to the commit function
+ * (which writes them to the package) and removed from the store.
+ *
+ * @ingroup libcommon
+ */
+class HubStateStore
+{
+public:
+    /**
+     * Called to write a map state to permanent storage.
+     *
+     * @param mapPath  Path of the map URI.
+     * @param state    Serialized map state.
+     */
+    typedef std::function<void (const de::String &mapPath, const de::Block &state)> CommitFunc;
+
+    static const de::dsize DEFAULT_BUDGET = 32 * 1024 * 1024;
+
+public:
+    HubStateStore(de::dsize budget = DEFAULT_BUDGET);
+
+    void setCommitFunc(const CommitFunc &func);
+
+    void setBudget(de::dsize bytes);
+
+    de::dsize budget() const;
+
+    /**
+     * Returns the total size of the stored states in bytes.
+     */
+    de::dsize size() const;
+
+    int count() const;
+
+    bool has(const de::String &mapPath) const;
+
+    /**
+     * Stores a map state, replacing any previous state of the same map. If the store
+     * goes over the budget, the oldest states are committed. The new state is kept
+     * regardless of its size.
+     */
+    void insert(const de::String &mapPath, const de::Block &state);
+
+    /**
+     * Removes a map state from the store and returns it.
+     *
+     * @return Serialized map state. Empty if the map is not in the store.
+     */
+    de::Block take(const de::String &mapPath);
+
+    /**
+     * Commits all the stored states (oldest first) and clears the store.
+     */
+    void commitAll();
+
+    /**
+     * Removes all stored states without committing them.
+     */
+    void clear();
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // LIBCOMMON_HUBSTATESTORE_H
@@ -45,6 +45,12 @@ DE_EXTERN_C mobj_t *PuffSpawned;
 extern "C" {
 #endif
 
+/**
+ * Prepares the sector line-of-sight rejection matrix for the current map (either
+ * the REJECT lump of the map, or one built from the sector visibility).
+ */
+void P_InitReject(void);
+
 /**
  * Look from eyes of the @a beholder to any part of the @a target.
  *
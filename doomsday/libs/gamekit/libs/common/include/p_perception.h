@@ -0,0 +1,78 @@
+/** @file p_perception.h  Concurrent line of sight evaluation for monsters.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef LIBCOMMON_P_PERCEPTION_H
+#define LIBCOMMON_P_PERCEPTION_H
+
+#include "common.h"
+
+/*
+ * The perception phase runs before the thinkers of a tic. It gathers the sight
+ * checks that monsters are about to make (against their target, or against the
+ * players when looking for one) and evaluates them concurrently. The results are
+ * then used by P_CheckSight() during the serial thinker pass.
+ *
+ * A result is only used if neither mobj has moved and no plane or polyobj has
+ * moved since the perception phase; otherwise the sight check is done normally.
+ * The game therefore behaves exactly as if all checks were done serially.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Prepares the perception phase for the current map. Called during map setup.
+ */
+void P_InitPerception(void);
+
+/**
+ * Evaluates the sight checks expected during the upcoming thinker pass.
+ */
+void P_RunPerception(void);
+
+/**
+ * Discards the results of the perception phase. Called after the thinker pass.
+ */
+void P_EndPerception(void);
+
+/**
+ * Notifies the perception phase that map geometry affecting lines of sight has
+ * changed (for instance, a polyobj has moved). Plane height changes are noticed
+ * automatically.
+ */
+void P_PerceptionGeometryChanged(void);
+
+/**
+ * Looks up the result of a line of sight check from the eyes of @a beholder to
+ * @a target (see P_CheckSight()) made during the perception phase.
+ *
+ * @param beholder  Mobj doing the looking.
+ * @param target    Mobj being looked at.
+ * @param visible   The result is written here.
+ *
+ * @return  @c true if a valid result was found.
+ */
+dd_bool P_PerceivedLineSight(const mobj_t *beholder, const mobj_t *target, dd_bool *visible);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // LIBCOMMON_P_PERCEPTION_H
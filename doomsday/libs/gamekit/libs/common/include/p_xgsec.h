@@ -23,6 +23,7 @@
 
 #include "g_common.h"
 #ifdef __cplusplus
+#  include <de/list.h>
 #  include <de/vector.h>
 #  include <doomsday/world/material.h>
 #endif
@@ -206,6 +207,12 @@ void XS_ChangePlaneMaterial(Sector &sector, bool ceiling, world_Material &newMat
 
 void XS_ChangePlaneColor(Sector &sector, bool ceiling, const de::Vec3f &newColor, bool isDelta = false);
 
+/**
+ * Returns the sectors that have an XG sector type with the act-tag @a actTag, in
+ * map index order.
+ */
+de::List<Sector *> XS_ActTaggedSectors(int actTag);
+
 #endif
 
 #endif // LIBCOMMON_XG_SECTORTYPE_H
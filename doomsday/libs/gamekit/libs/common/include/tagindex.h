@@ -0,0 +1,114 @@
+/** @file tagindex.h  Map elements indexed by tag.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef LIBCOMMON_TAGINDEX_H
+#define LIBCOMMON_TAGINDEX_H
+
+#include "common.h"
+
+#include <de/hash.h>
+#include <de/list.h>
+#include <algorithm>
+
+/**
+ * Index of map elements (lines, sectors) by an integer tag.
+ *
+ * The elements of each tag are kept in map index order, so iterating them visits
+ * the elements in the same order as a linear scan through the whole map would.
+ * The index is updated incrementally with set() whenever the tag of an element
+ * changes.
+ */
+template <typename Type>
+class TagIndex
+{
+public:
+    using Elements = de::List<Type *>;
+
+    void clear()
+    {
+        _elements.clear();
+        _tags.clear();
+    }
+
+    /**
+     * Associates @a elem with @a tag, replacing any previous association.
+     */
+    void set(Type *elem, int tag)
+    {
+        DE_ASSERT(elem);
+        auto found = _tags.find(elem);
+        if (found != _tags.end())
+        {
+            if (found->second == tag) return;
+            removeFromTag(elem, found->second);
+        }
+        Elements &elems = _elements[tag];
+        const int index = P_ToIndex(elem);
+        elems.insert(std::lower_bound(elems.begin(), elems.end(), index,
+                                      [] (Type *a, int idx) { return P_ToIndex(a) < idx; }),
+                     elem);
+        _tags.insert(elem, tag);
+    }
+
+    void remove(Type *elem)
+    {
+        auto found = _tags.find(elem);
+        if (found == _tags.end()) return;
+        removeFromTag(elem, found->second);
+        _tags.erase(found);
+    }
+
+    /**
+     * Returns the elements associated with @a tag (in map index order), or
+     * @c nullptr if there are none.
+     */
+    const Elements *find(int tag) const
+    {
+        auto found = _elements.find(tag);
+        if (found == _elements.end()) return nullptr;
+        return &found->second;
+    }
+
+    /**
+     * Returns a copy of the elements associated with @a tag. Use this when the
+     * index may be modified while iterating.
+     */
+    Elements elements(int tag) const
+    {
+        if (const Elements *elems = find(tag)) return *elems;
+        return Elements();
+    }
+
+private:
+    void removeFromTag(Type *elem, int tag)
+    {
+        auto found = _elements.find(tag);
+        if (found == _elements.end()) return;
+        found->second.removeOne(elem);
+        if (found->second.isEmpty())
+        {
+            _elements.erase(found);
+        }
+    }
+
+    de::Hash<int, Elements> _elements;
+    de::Hash<Type *, int>   _tags;
+};
+
+#endif // LIBCOMMON_TAGINDEX_H
@@ -56,6 +56,9 @@ public:
      * the specified @a mobj from the thing archive. If the given mobj is already
      * present in the archived, the existing archive Id is returned.
      *
+     * New Ids are assigned in the order of first use, so the same game state always
+     * produces the same Ids. The lookup takes constant time.
+     *
      * @param mobj  Mobj to lookup the archive Id for.
      *
      * @return  Identifier for the specified mobj (may be zero).
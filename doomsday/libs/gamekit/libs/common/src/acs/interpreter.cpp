@@ -46,10 +46,15 @@ namespace internal
         Terminate
     };
 
-    typedef CommandResult (*CommandFunc) (acs::Interpreter &);
+    using Instruction = acs::Module::Instruction;
 
-/// Helper macro for declaring ACScript command functions.
-#define ACS_COMMAND(Name) CommandResult cmd##Name(acs::Interpreter &interp)
+    typedef CommandResult (*CommandFunc) (acs::Interpreter &, const Instruction &);
+
+/// Helper macros for declaring ACScript command functions.
+#define ACS_COMMAND(Name) \
+    CommandResult cmd##Name(acs::Interpreter &interp, const Instruction &)
+#define ACS_COMMAND_WITH_OPERANDS(Name) \
+    CommandResult cmd##Name(acs::Interpreter &interp, const Instruction &insn)
 
     static String printBuffer;
 
@@ -74,24 +79,24 @@ namespace internal
         return Stop;
     }
 
-    ACS_COMMAND(PushNumber)
+    ACS_COMMAND_WITH_OPERANDS(PushNumber)
     {
-        interp.locals.push(DD_LONG(*interp.pcodePtr++));
+        interp.locals.push(insn.operands[0]);
         return Continue;
     }
 
-    ACS_COMMAND(LSpec1)
+    ACS_COMMAND_WITH_OPERANDS(LSpec1)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
         specArgs[0] = interp.locals.pop();
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side, interp.activator);
 
         return Continue;
     }
 
-    ACS_COMMAND(LSpec2)
+    ACS_COMMAND_WITH_OPERANDS(LSpec2)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
         specArgs[1] = interp.locals.pop();
         specArgs[0] = interp.locals.pop();
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side, interp.activator);
@@ -99,9 +104,9 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(LSpec3)
+    ACS_COMMAND_WITH_OPERANDS(LSpec3)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
         specArgs[2] = interp.locals.pop();
         specArgs[1] = interp.locals.pop();
         specArgs[0] = interp.locals.pop();
@@ -110,9 +115,9 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(LSpec4)
+    ACS_COMMAND_WITH_OPERANDS(LSpec4)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
         specArgs[3] = interp.locals.pop();
         specArgs[2] = interp.locals.pop();
         specArgs[1] = interp.locals.pop();
@@ -122,9 +127,9 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(LSpec5)
+    ACS_COMMAND_WITH_OPERANDS(LSpec5)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
         specArgs[4] = interp.locals.pop();
         specArgs[3] = interp.locals.pop();
         specArgs[2] = interp.locals.pop();
@@ -136,60 +141,60 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(LSpec1Direct)
+    ACS_COMMAND_WITH_OPERANDS(LSpec1Direct)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
-        specArgs[0] = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
+        specArgs[0] = insn.operands[1];
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side,
                              interp.activator);
 
         return Continue;
     }
 
-    ACS_COMMAND(LSpec2Direct)
+    ACS_COMMAND_WITH_OPERANDS(LSpec2Direct)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
-        specArgs[0] = DD_LONG(*interp.pcodePtr++);
-        specArgs[1] = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
+        specArgs[0] = insn.operands[1];
+        specArgs[1] = insn.operands[2];
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side,
                              interp.activator);
 
         return Continue;
     }
 
-    ACS_COMMAND(LSpec3Direct)
+    ACS_COMMAND_WITH_OPERANDS(LSpec3Direct)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
-        specArgs[0] = DD_LONG(*interp.pcodePtr++);
-        specArgs[1] = DD_LONG(*interp.pcodePtr++);
-        specArgs[2] = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
+        specArgs[0] = insn.operands[1];
+        specArgs[1] = insn.operands[2];
+        specArgs[2] = insn.operands[3];
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side,
                              interp.activator);
 
         return Continue;
     }
 
-    ACS_COMMAND(LSpec4Direct)
+    ACS_COMMAND_WITH_OPERANDS(LSpec4Direct)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
-        specArgs[0] = DD_LONG(*interp.pcodePtr++);
-        specArgs[1] = DD_LONG(*interp.pcodePtr++);
-        specArgs[2] = DD_LONG(*interp.pcodePtr++);
-        specArgs[3] = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
+        specArgs[0] = insn.operands[1];
+        specArgs[1] = insn.operands[2];
+        specArgs[2] = insn.operands[3];
+        specArgs[3] = insn.operands[4];
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side,
                              interp.activator);
 
         return Continue;
     }
 
-    ACS_COMMAND(LSpec5Direct)
+    ACS_COMMAND_WITH_OPERANDS(LSpec5Direct)
     {
-        int special = DD_LONG(*interp.pcodePtr++);
-        specArgs[0] = DD_LONG(*interp.pcodePtr++);
-        specArgs[1] = DD_LONG(*interp.pcodePtr++);
-        specArgs[2] = DD_LONG(*interp.pcodePtr++);
-        specArgs[3] = DD_LONG(*interp.pcodePtr++);
-        specArgs[4] = DD_LONG(*interp.pcodePtr++);
+        int special = insn.operands[0];
+        specArgs[0] = insn.operands[1];
+        specArgs[1] = insn.operands[2];
+        specArgs[2] = insn.operands[3];
+        specArgs[3] = insn.operands[4];
+        specArgs[4] = insn.operands[5];
         P_ExecuteLineSpecial(special, specArgs, interp.line, interp.side,
                              interp.activator);
 
@@ -269,183 +274,179 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(AssignScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(AssignScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)] = interp.locals.pop();
+        interp.args[insn.operands[0]] = interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(AssignMapVar)
+    ACS_COMMAND_WITH_OPERANDS(AssignMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)] = interp.locals.pop();
+        interp.scriptSys().mapVars[insn.operands[0]] = interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(AssignWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(AssignWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)] = interp.locals.pop();
+        interp.scriptSys().worldVars[insn.operands[0]] = interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(PushScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(PushScriptVar)
     {
-        interp.locals.push(interp.args[DD_LONG(*interp.pcodePtr++)]);
+        interp.locals.push(interp.args[insn.operands[0]]);
         return Continue;
     }
 
-    ACS_COMMAND(PushMapVar)
+    ACS_COMMAND_WITH_OPERANDS(PushMapVar)
     {
-        interp.locals.push(interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)]);
+        interp.locals.push(interp.scriptSys().mapVars[insn.operands[0]]);
         return Continue;
     }
 
-    ACS_COMMAND(PushWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(PushWorldVar)
     {
-        interp.locals.push(interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)]);
+        interp.locals.push(interp.scriptSys().worldVars[insn.operands[0]]);
         return Continue;
     }
 
-    ACS_COMMAND(AddScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(AddScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)] += interp.locals.pop();
+        interp.args[insn.operands[0]] += interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(AddMapVar)
+    ACS_COMMAND_WITH_OPERANDS(AddMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)] += interp.locals.pop();
+        interp.scriptSys().mapVars[insn.operands[0]] += interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(AddWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(AddWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)] += interp.locals.pop();
+        interp.scriptSys().worldVars[insn.operands[0]] += interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(SubScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(SubScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)] -= interp.locals.pop();
+        interp.args[insn.operands[0]] -= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(SubMapVar)
+    ACS_COMMAND_WITH_OPERANDS(SubMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)] -= interp.locals.pop();
+        interp.scriptSys().mapVars[insn.operands[0]] -= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(SubWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(SubWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)] -= interp.locals.pop();
+        interp.scriptSys().worldVars[insn.operands[0]] -= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(MulScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(MulScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)] *= interp.locals.pop();
+        interp.args[insn.operands[0]] *= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(MulMapVar)
+    ACS_COMMAND_WITH_OPERANDS(MulMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)] *= interp.locals.pop();
+        interp.scriptSys().mapVars[insn.operands[0]] *= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(MulWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(MulWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)] *= interp.locals.pop();
+        interp.scriptSys().worldVars[insn.operands[0]] *= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(DivScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(DivScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)] /= interp.locals.pop();
+        interp.args[insn.operands[0]] /= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(DivMapVar)
+    ACS_COMMAND_WITH_OPERANDS(DivMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)] /= interp.locals.pop();
+        interp.scriptSys().mapVars[insn.operands[0]] /= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(DivWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(DivWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)] /= interp.locals.pop();
+        interp.scriptSys().worldVars[insn.operands[0]] /= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(ModScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(ModScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)] %= interp.locals.pop();
+        interp.args[insn.operands[0]] %= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(ModMapVar)
+    ACS_COMMAND_WITH_OPERANDS(ModMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)] %= interp.locals.pop();
+        interp.scriptSys().mapVars[insn.operands[0]] %= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(ModWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(ModWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)] %= interp.locals.pop();
+        interp.scriptSys().worldVars[insn.operands[0]] %= interp.locals.pop();
         return Continue;
     }
 
-    ACS_COMMAND(IncScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(IncScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)]++;
+        interp.args[insn.operands[0]]++;
         return Continue;
     }
 
-    ACS_COMMAND(IncMapVar)
+    ACS_COMMAND_WITH_OPERANDS(IncMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)]++;
+        interp.scriptSys().mapVars[insn.operands[0]]++;
         return Continue;
     }
 
-    ACS_COMMAND(IncWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(IncWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)]++;
+        interp.scriptSys().worldVars[insn.operands[0]]++;
         return Continue;
     }
 
-    ACS_COMMAND(DecScriptVar)
+    ACS_COMMAND_WITH_OPERANDS(DecScriptVar)
     {
-        interp.args[DD_LONG(*interp.pcodePtr++)]--;
+        interp.args[insn.operands[0]]--;
         return Continue;
     }
 
-    ACS_COMMAND(DecMapVar)
+    ACS_COMMAND_WITH_OPERANDS(DecMapVar)
     {
-        interp.scriptSys().mapVars[DD_LONG(*interp.pcodePtr++)]--;
+        interp.scriptSys().mapVars[insn.operands[0]]--;
         return Continue;
     }
 
-    ACS_COMMAND(DecWorldVar)
+    ACS_COMMAND_WITH_OPERANDS(DecWorldVar)
     {
-        interp.scriptSys().worldVars[DD_LONG(*interp.pcodePtr++)]--;
+        interp.scriptSys().worldVars[insn.operands[0]]--;
         return Continue;
     }
 
-    ACS_COMMAND(Goto)
+    ACS_COMMAND_WITH_OPERANDS(Goto)
     {
-        interp.pcodePtr = (const int *) (interp.scriptSys().module().pcode().constData() + DD_LONG(*interp.pcodePtr));
+        interp.pc = insn.target;
         return Continue;
     }
 
-    ACS_COMMAND(IfGoto)
+    ACS_COMMAND_WITH_OPERANDS(IfGoto)
     {
         if(interp.locals.pop())
         {
-            interp.pcodePtr = (const int *) (interp.scriptSys().module().pcode().constData() + DD_LONG(*interp.pcodePtr));
-        }
-        else
-        {
-            interp.pcodePtr++;
+            interp.pc = insn.target;
         }
         return Continue;
     }
@@ -462,9 +463,9 @@ namespace internal
         return Stop;
     }
 
-    ACS_COMMAND(DelayDirect)
+    ACS_COMMAND_WITH_OPERANDS(DelayDirect)
     {
-        interp.delayCount = DD_LONG(*interp.pcodePtr++);
+        interp.delayCount = insn.operands[0];
         return Stop;
     }
 
@@ -476,10 +477,10 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(RandomDirect)
+    ACS_COMMAND_WITH_OPERANDS(RandomDirect)
     {
-        int low  = DD_LONG(*interp.pcodePtr++);
-        int high = DD_LONG(*interp.pcodePtr++);
+        int low  = insn.operands[0];
+        int high = insn.operands[1];
         interp.locals.push(low + (P_Random() % (high - low + 1)));
         return Continue;
     }
@@ -496,10 +497,10 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(ThingCountDirect)
+    ACS_COMMAND_WITH_OPERANDS(ThingCountDirect)
     {
-        int type = DD_LONG(*interp.pcodePtr++);
-        int tid  = DD_LONG(*interp.pcodePtr++);
+        int type = insn.operands[0];
+        int tid  = insn.operands[1];
         // Anything to count?
         if(type + tid)
         {
@@ -514,9 +515,9 @@ namespace internal
         return Stop;
     }
 
-    ACS_COMMAND(TagWaitDirect)
+    ACS_COMMAND_WITH_OPERANDS(TagWaitDirect)
     {
-        interp.script().waitForSector(DD_LONG(*interp.pcodePtr++));
+        interp.script().waitForSector(insn.operands[0]);
         return Stop;
     }
 
@@ -526,9 +527,9 @@ namespace internal
         return Stop;
     }
 
-    ACS_COMMAND(PolyWaitDirect)
+    ACS_COMMAND_WITH_OPERANDS(PolyWaitDirect)
     {
-        interp.script().waitForPolyobj(DD_LONG(*interp.pcodePtr++));
+        interp.script().waitForPolyobj(insn.operands[0]);
         return Stop;
     }
 
@@ -557,11 +558,11 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(ChangeFloorDirect)
+    ACS_COMMAND_WITH_OPERANDS(ChangeFloorDirect)
     {
-        int tag = DD_LONG(*interp.pcodePtr++);
+        int tag = insn.operands[0];
 
-        AutoStr *path = Str_PercentEncode(AutoStr_FromTextStd(interp.scriptSys().module().constant(DD_LONG(*interp.pcodePtr++))));
+        AutoStr *path = Str_PercentEncode(AutoStr_FromTextStd(interp.scriptSys().module().constant(insn.operands[1])));
         uri_s *uri = Uri_NewWithPath3("Flats", Str_Text(path));
 
         world_Material *mat = (world_Material *) P_ToPtr(DMU_MATERIAL, Materials_ResolveUri(uri));
@@ -607,11 +608,11 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(ChangeCeilingDirect)
+    ACS_COMMAND_WITH_OPERANDS(ChangeCeilingDirect)
     {
-        int tag = DD_LONG(*interp.pcodePtr++);
+        int tag = insn.operands[0];
 
-        AutoStr *path = Str_PercentEncode(AutoStr_FromTextStd(interp.scriptSys().module().constant(DD_LONG(*interp.pcodePtr++))));
+        AutoStr *path = Str_PercentEncode(AutoStr_FromTextStd(interp.scriptSys().module().constant(insn.operands[1])));
         uri_s *uri = Uri_NewWithPath3("Flats", Str_Text(path));
 
         world_Material *mat = (world_Material *) P_ToPtr(DMU_MATERIAL, Materials_ResolveUri(uri));
@@ -634,7 +635,7 @@ namespace internal
 
     ACS_COMMAND(Restart)
     {
-        interp.pcodePtr = interp.script().entryPoint().pcodePtr;
+        interp.pc = interp.script().entryPoint().start;
         return Continue;
     }
 
@@ -694,15 +695,11 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(IfNotGoto)
+    ACS_COMMAND_WITH_OPERANDS(IfNotGoto)
     {
-        if(interp.locals.pop())
+        if(!interp.locals.pop())
         {
-            interp.pcodePtr++;
-        }
-        else
-        {
-            interp.pcodePtr = (const int *) (interp.scriptSys().module().pcode().constData() + DD_LONG(*interp.pcodePtr));
+            interp.pc = insn.target;
         }
         return Continue;
     }
@@ -715,13 +712,13 @@ namespace internal
 
     ACS_COMMAND(ScriptWait)
     {
-        interp.script().waitForScript(interp.locals.pop());
+        interp.scriptSys().waitForScript(interp.script(), interp.locals.pop());
         return Stop;
     }
 
-    ACS_COMMAND(ScriptWaitDirect)
+    ACS_COMMAND_WITH_OPERANDS(ScriptWaitDirect)
     {
-        interp.script().waitForScript(DD_LONG(*interp.pcodePtr++));
+        interp.scriptSys().waitForScript(interp.script(), insn.operands[0]);
         return Stop;
     }
 
@@ -734,17 +731,13 @@ namespace internal
         return Continue;
     }
 
-    ACS_COMMAND(CaseGoto)
+    ACS_COMMAND_WITH_OPERANDS(CaseGoto)
     {
-        if(interp.locals.top() == DD_LONG(*interp.pcodePtr++))
+        if(interp.locals.top() == insn.operands[0])
         {
-            interp.pcodePtr = (const int *) (interp.scriptSys().module().pcode().constData() + DD_LONG(*interp.pcodePtr));
+            interp.pc = insn.target;
             interp.locals.drop();
         }
-        else
-        {
-            interp.pcodePtr++;
-        }
         return Continue;
     }
 
@@ -1026,42 +1019,97 @@ namespace internal
         return Continue;
     }
 
-    static const CommandFunc &findCommand(int name)
+    // Superinstructions (see acs::Module::fuseInstructions()):
+
+    ACS_COMMAND_WITH_OPERANDS(PushNumber2)
+    {
+        interp.locals.push(insn.operands[0]);
+        interp.locals.push(insn.operands[1]);
+        return Continue;
+    }
+
+    ACS_COMMAND_WITH_OPERANDS(AssignScriptVarDirect)
+    {
+        interp.args[insn.operands[1]] = insn.operands[0];
+        return Continue;
+    }
+
+    ACS_COMMAND_WITH_OPERANDS(AssignMapVarDirect)
+    {
+        interp.scriptSys().mapVars[insn.operands[1]] = insn.operands[0];
+        return Continue;
+    }
+
+    ACS_COMMAND_WITH_OPERANDS(AssignWorldVarDirect)
+    {
+        interp.scriptSys().worldVars[insn.operands[1]] = insn.operands[0];
+        return Continue;
+    }
+
+    ACS_COMMAND_WITH_OPERANDS(CompareScriptVarIfNotGoto)
     {
-        static CommandFunc const cmds[] =
+        const int value    = interp.args[insn.operands[0]];
+        const int constant = insn.operands[1];
+        bool result;
+        switch(insn.operands[2])
         {
-            cmdNOP, cmdTerminate, cmdSuspend, cmdPushNumber, cmdLSpec1, cmdLSpec2,
-            cmdLSpec3, cmdLSpec4, cmdLSpec5, cmdLSpec1Direct, cmdLSpec2Direct,
-            cmdLSpec3Direct, cmdLSpec4Direct, cmdLSpec5Direct, cmdAdd,
-            cmdSubtract, cmdMultiply, cmdDivide, cmdModulus, cmdEQ, cmdNE,
-            cmdLT, cmdGT, cmdLE, cmdGE, cmdAssignScriptVar, cmdAssignMapVar,
-            cmdAssignWorldVar, cmdPushScriptVar, cmdPushMapVar,
-            cmdPushWorldVar, cmdAddScriptVar, cmdAddMapVar, cmdAddWorldVar,
-            cmdSubScriptVar, cmdSubMapVar, cmdSubWorldVar, cmdMulScriptVar,
-            cmdMulMapVar, cmdMulWorldVar, cmdDivScriptVar, cmdDivMapVar,
-            cmdDivWorldVar, cmdModScriptVar, cmdModMapVar, cmdModWorldVar,
-            cmdIncScriptVar, cmdIncMapVar, cmdIncWorldVar, cmdDecScriptVar,
-            cmdDecMapVar, cmdDecWorldVar, cmdGoto, cmdIfGoto, cmdDrop,
-            cmdDelay, cmdDelayDirect, cmdRandom, cmdRandomDirect,
-            cmdThingCount, cmdThingCountDirect, cmdTagWait, cmdTagWaitDirect,
-            cmdPolyWait, cmdPolyWaitDirect, cmdChangeFloor,
-            cmdChangeFloorDirect, cmdChangeCeiling, cmdChangeCeilingDirect,
-            cmdRestart, cmdAndLogical, cmdOrLogical, cmdAndBitwise,
-            cmdOrBitwise, cmdEorBitwise, cmdNegateLogical, cmdLShift,
-            cmdRShift, cmdUnaryMinus, cmdIfNotGoto, cmdLineSide, cmdScriptWait,
-            cmdScriptWaitDirect, cmdClearLineSpecial, cmdCaseGoto,
-            cmdBeginPrint, cmdEndPrint, cmdPrintString, cmdPrintNumber,
-            cmdPrintCharacter, cmdPlayerCount, cmdGameType, cmdGameSkill,
-            cmdTimer, cmdSectorSound, cmdAmbientSound, cmdSoundSequence,
-            cmdSetLineTexture, cmdSetLineBlocking, cmdSetLineSpecial,
-            cmdThingSound, cmdEndPrintBold
-        };
-        static const int numCmds = sizeof(cmds) / sizeof(cmds[0]);
-        if(name >= 0 && name < numCmds) return cmds[name];
-        /// @throw Error  Invalid command name specified.
-        throw Error("acs::Interpreter::findCommand", "Unknown command #" + String::asText(name));
+        case acs::Module::EQ: result = (value == constant); break;
+        case acs::Module::NE: result = (value != constant); break;
+        case acs::Module::LT: result = (value <  constant); break;
+        case acs::Module::GT: result = (value >  constant); break;
+        case acs::Module::LE: result = (value <= constant); break;
+        default:              result = (value >= constant); break;
+        }
+        if(!result)
+        {
+            interp.pc = insn.target;
+        }
+        return Continue;
     }
 
+    ACS_COMMAND_WITH_OPERANDS(Invalid)
+    {
+        DE_UNUSED(interp);
+        /// @throw Error  Invalid command name specified.
+        throw Error("acs::Interpreter", "Unknown command #" + String::asText(insn.operands[0]) +
+                                        " at offset " + String::asText(insn.offset));
+    }
+
+    /// Commands indexed by opcode. Opcodes are validated when the module is loaded.
+    static const CommandFunc commands[] =
+    {
+        cmdNOP, cmdTerminate, cmdSuspend, cmdPushNumber, cmdLSpec1, cmdLSpec2,
+        cmdLSpec3, cmdLSpec4, cmdLSpec5, cmdLSpec1Direct, cmdLSpec2Direct,
+        cmdLSpec3Direct, cmdLSpec4Direct, cmdLSpec5Direct, cmdAdd,
+        cmdSubtract, cmdMultiply, cmdDivide, cmdModulus, cmdEQ, cmdNE,
+        cmdLT, cmdGT, cmdLE, cmdGE, cmdAssignScriptVar, cmdAssignMapVar,
+        cmdAssignWorldVar, cmdPushScriptVar, cmdPushMapVar,
+        cmdPushWorldVar, cmdAddScriptVar, cmdAddMapVar, cmdAddWorldVar,
+        cmdSubScriptVar, cmdSubMapVar, cmdSubWorldVar, cmdMulScriptVar,
+        cmdMulMapVar, cmdMulWorldVar, cmdDivScriptVar, cmdDivMapVar,
+        cmdDivWorldVar, cmdModScriptVar, cmdModMapVar, cmdModWorldVar,
+        cmdIncScriptVar, cmdIncMapVar, cmdIncWorldVar, cmdDecScriptVar,
+        cmdDecMapVar, cmdDecWorldVar, cmdGoto, cmdIfGoto, cmdDrop,
+        cmdDelay, cmdDelayDirect, cmdRandom, cmdRandomDirect,
+        cmdThingCount, cmdThingCountDirect, cmdTagWait, cmdTagWaitDirect,
+        cmdPolyWait, cmdPolyWaitDirect, cmdChangeFloor,
+        cmdChangeFloorDirect, cmdChangeCeiling, cmdChangeCeilingDirect,
+        cmdRestart, cmdAndLogical, cmdOrLogical, cmdAndBitwise,
+        cmdOrBitwise, cmdEorBitwise, cmdNegateLogical, cmdLShift,
+        cmdRShift, cmdUnaryMinus, cmdIfNotGoto, cmdLineSide, cmdScriptWait,
+        cmdScriptWaitDirect, cmdClearLineSpecial, cmdCaseGoto,
+        cmdBeginPrint, cmdEndPrint, cmdPrintString, cmdPrintNumber,
+        cmdPrintCharacter, cmdPlayerCount, cmdGameType, cmdGameSkill,
+        cmdTimer, cmdSectorSound, cmdAmbientSound, cmdSoundSequence,
+        cmdSetLineTexture, cmdSetLineBlocking, cmdSetLineSpecial,
+        cmdThingSound, cmdEndPrintBold,
+
+        cmdPushNumber2, cmdAssignScriptVarDirect, cmdAssignMapVarDirect,
+        cmdAssignWorldVarDirect, cmdCompareScriptVarIfNotGoto, cmdInvalid
+    };
+    static_assert(sizeof(commands) / sizeof(commands[0]) == acs::Module::TotalOpcodeCount,
+                  "ACS command table does not match the opcodes");
+
 #endif  // __JHEXEN__
 
 } // namespace internal
@@ -1079,7 +1127,7 @@ thinker_t *Interpreter::newThinker(Script &script, const Script::Args &scriptArg
     th->thinker.function = (thinkfunc_t) acs_Interpreter_Think;
 
     th->_script    = &script;
-    th->pcodePtr   = ep.pcodePtr;
+    th->pc         = ep.start;
     th->delayCount = delayCount;
     th->activator  = activator;
     th->line       = line;
@@ -1111,8 +1159,12 @@ void Interpreter::think()
 
         currentScriptNumber = script().entryPoint().scriptNumber;
 
-        while((action = findCommand(DD_LONG(*pcodePtr++))(*this)) == Continue)
-        {}
+        do
+        {
+            const Module::Instruction &insn = *pc;
+            pc = insn.next;
+            action = commands[insn.opcode](*this, insn);
+        } while(action == Continue);
 
         currentScriptNumber = -1;
     }
@@ -1124,11 +1176,7 @@ void Interpreter::think()
         script().setState(Script::Inactive);
 
         // Notify any scripts which are waiting for this script to finish.
-        scriptSys().forAllScripts([this] (Script &otherScript)
-        {
-            otherScript.resumeIfWaitingForScript(script());
-            return LoopContinue;
-        });
+        scriptSys().scriptTerminated(script());
 
         Thinker_Remove(&thinker);
     }
@@ -1203,7 +1251,8 @@ void Interpreter::write(MapStateWriter *msw) const
     {
         Writer_WriteInt32(writer, args[i]);
     }
-    Writer_WriteInt32(writer, ((const dbyte *)pcodePtr) - (const dbyte *)scriptSys().module().pcode().constData());
+    DE_ASSERT(pc);
+    Writer_WriteInt32(writer, pc->offset);
 }
 
 int Interpreter::read(MapStateReader *msr)
@@ -1258,7 +1307,7 @@ int Interpreter::read(MapStateReader *msr)
             args[i] = Reader_ReadInt32(reader);
         }
 
-        pcodePtr = (const int *) (scriptSys().module().pcode().constData() + Reader_ReadInt32(reader));
+        pc = &scriptSys().module().instruction(Reader_ReadInt32(reader));
     }
     else
     {
@@ -1298,7 +1347,7 @@ int Interpreter::read(MapStateReader *msr)
             args[i] = Reader_ReadInt32(reader);
         }
 
-        pcodePtr = (const int *) (scriptSys().module().pcode().constData() + Reader_ReadInt32(reader));
+        pc = &scriptSys().module().instruction(Reader_ReadInt32(reader));
     }
 
     thinker.function = (thinkfunc_t) acs_Interpreter_Think;
@@ -32,12 +32,25 @@ using namespace de;
 
 namespace acs {
 
+/// Number of operands following each opcode in the bytecode.
+static const dint8 operandCounts[Module::OpcodeCount] =
+{
+    0, 0, 0, 1, 1, 1, 1, 1, 1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0,  //   0
+    0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  //  20
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 1, 0, 2, 0,  //  40
+    2, 0, 1, 0, 1, 0, 2, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,  //  60
+    0, 0, 1, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  //  80
+    0, 0                                                         // 100
+};
+
 DE_PIMPL_NOREF(Module)
 {
     Block                  pcode;
     List<EntryPoint>       entryPoints;
     KeyMap<int, EntryPoint *> epByScriptNumberLut;
     List<String>           constants;
+    List<Instruction>      code;               ///< Pre-decoded instructions, in bytecode order.
+    KeyMap<dint32, dint>   codeIndexByOffset;
 
     void buildEntryPointLut()
     {
@@ -47,6 +60,152 @@ DE_PIMPL_NOREF(Module)
             epByScriptNumberLut.insert(ep.scriptNumber, &ep);
         }
     }
+
+    bool readWord(dint32 offset, dint32 &value) const
+    {
+        if (offset < 0 || dsize(offset) + 4 > pcode.size()) return false;
+        de::Reader from(pcode);
+        from.setOffset(dsize(offset));
+        from >> value;
+        return true;
+    }
+
+    struct DecodedInstruction
+    {
+        Instruction insn;
+        dint32 nextOffset   = -1;  ///< Execution continues here, unless there is a jump.
+        dint32 targetOffset = -1;
+    };
+
+    DecodedInstruction decodeInstruction(dint32 offset) const
+    {
+        DecodedInstruction decoded;
+        Instruction &insn = decoded.insn;
+        insn.offset = offset;
+
+        dint32 opcode = -1;
+        if (!readWord(offset, opcode) || opcode < 0 || opcode >= OpcodeCount)
+        {
+            insn.opcode      = InvalidOpcode;
+            insn.operands[0] = opcode;
+            return decoded;
+        }
+        const int count = operandCounts[opcode];
+        for (int i = 0; i < count; ++i)
+        {
+            if (!readWord(offset + 4 * (1 + i), insn.operands[i]))
+            {
+                // The code ends in the middle of the instruction.
+                insn.opcode      = InvalidOpcode;
+                insn.operands[0] = opcode;
+                return decoded;
+            }
+        }
+        insn.opcode = opcode;
+
+        if (opcode == Goto || opcode == IfGoto || opcode == IfNotGoto ||
+            opcode == CaseGoto)
+        {
+            decoded.targetOffset = insn.operands[count - 1];
+        }
+        if (opcode != Terminate && opcode != Goto && opcode != Restart)
+        {
+            decoded.nextOffset = offset + 4 * (1 + count);
+        }
+        return decoded;
+    }
+
+    /**
+     * Decodes all the instructions that can be reached from the given positions in
+     * the bytecode. Data that is not code is never looked at.
+     */
+    void decode(const List<dint32> &startOffsets)
+    {
+        KeyMap<dint32, DecodedInstruction> decoded;
+        List<dint32> pending = startOffsets;
+        while (!pending.isEmpty())
+        {
+            const dint32 offset = pending.takeLast();
+            if (decoded.contains(offset)) continue;
+
+            const auto result = decodeInstruction(offset);
+            if (result.nextOffset   >= 0) pending << result.nextOffset;
+            if (result.targetOffset >= 0) pending << result.targetOffset;
+            decoded.insert(offset, result);
+        }
+
+        // Instructions are linked with pointers, so the list must not change size
+        // after this.
+        code.clear();
+        code.reserve(decoded.size());
+        codeIndexByOffset.clear();
+        for (const auto &i : decoded)
+        {
+            codeIndexByOffset.insert(i.first, code.sizei());
+            code << i.second.insn;
+        }
+        for (const auto &i : decoded)
+        {
+            Instruction &insn = code[codeIndexByOffset[i.first]];
+            if (i.second.nextOffset >= 0)
+            {
+                insn.next = &code[codeIndexByOffset[i.second.nextOffset]];
+            }
+            if (i.second.targetOffset >= 0)
+            {
+                insn.target = &code[codeIndexByOffset[i.second.targetOffset]];
+            }
+        }
+
+        fuseInstructions();
+    }
+
+    /**
+     * Replaces common sequences of instructions with superinstructions. Only the first
+     * instruction of a sequence is replaced; the rest remain in place, so jumps into
+     * the middle of a sequence (and positions in saved games) are still valid.
+     */
+    void fuseInstructions()
+    {
+        auto is = [] (const Instruction *insn, dint32 opcode) {
+            return insn && insn->opcode == opcode;
+        };
+
+        // Instructions later in the code have not been fused yet when looking
+        // at the ones following the current instruction.
+        for (Instruction &insn : code)
+        {
+            const Instruction *n1 = insn.next;
+            if (insn.opcode == PushNumber && n1)
+            {
+                if (n1->opcode == PushNumber)
+                {
+                    insn.opcode      = PushNumber2;
+                    insn.operands[1] = n1->operands[0];
+                    insn.next        = n1->next;
+                }
+                else if (n1->opcode >= AssignScriptVar && n1->opcode <= AssignWorldVar)
+                {
+                    insn.opcode      = AssignScriptVarDirect + (n1->opcode - AssignScriptVar);
+                    insn.operands[1] = n1->operands[0];  // variable
+                    insn.next        = n1->next;
+                }
+            }
+            else if (insn.opcode == PushScriptVar && is(n1, PushNumber))
+            {
+                const Instruction *n2 = n1->next;
+                if (n2 && n2->opcode >= EQ && n2->opcode <= GE && is(n2->next, IfNotGoto))
+                {
+                    const Instruction *n3 = n2->next;
+                    insn.opcode      = CompareScriptVarIfNotGoto;
+                    insn.operands[1] = n1->operands[0];  // constant
+                    insn.operands[2] = n2->opcode;       // comparison
+                    insn.target      = n3->target;
+                    insn.next        = n3->next;
+                }
+            }
+        }
+    }
 };
 
 Module::Module() : d(new Impl)
@@ -86,6 +245,7 @@ Module *Module::newFromBytecode(const Block &bytecode)  // static
     dint32 numEntryPoints;
     from >> numEntryPoints;
     module->d->entryPoints.reserve(numEntryPoints);
+    List<dint32> entryOffsets;
     for(dint32 i = 0; i < numEntryPoints; ++i)
     {
 #define OPEN_SCRIPTS_BASE 1000
@@ -105,7 +265,7 @@ Module *Module::newFromBytecode(const Block &bytecode)  // static
         {
             throw FormatError("acs::Module", "Invalid script entrypoint offset");
         }
-        ep.pcodePtr = reinterpret_cast<const int *>(module->d->pcode.constData() + offset);
+        entryOffsets << offset;
 
         from >> ep.scriptArgCount;
         if(ep.scriptArgCount > ACS_INTERPRETER_MAX_SCRIPT_ARGS)
@@ -119,6 +279,13 @@ Module *Module::newFromBytecode(const Block &bytecode)  // static
 
 #undef OPEN_SCRIPTS_BASE
     }
+    // Decode the scripts for the interpreter.
+    module->d->decode(entryOffsets);
+    for (dint i = 0; i < module->d->entryPoints.sizei(); ++i)
+    {
+        module->d->entryPoints[i].start = &module->instruction(entryOffsets[i]);
+    }
+
     // Prepare a script-number => EntryPoint LUT.
     module->d->buildEntryPointLut();
 
@@ -200,4 +367,13 @@ const Block &Module::pcode() const
     return d->pcode;
 }
 
+const Module::Instruction &Module::instruction(dint32 offset) const
+{
+    auto found = d->codeIndexByOffset.find(offset);
+    if (found != d->codeIndexByOffset.end()) return d->code[found->second];
+    /// @throw MissingInstructionError  No instruction at the specified position.
+    throw MissingInstructionError("acs::Module::instruction",
+                                  "No instruction at offset " + String::asText(offset));
+}
+
 } // namespace acs
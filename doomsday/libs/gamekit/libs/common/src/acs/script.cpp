@@ -172,6 +172,11 @@ void Script::waitForSector(int tag)
     d->wait(WaitingForSector, tag);
 }
 
+int Script::waitValue() const
+{
+    return d->waitValue;
+}
+
 void Script::polyobjFinished(int tag)
 {
     if(d->state == WaitingForPolyobj && d->waitValue == tag)
@@ -21,6 +21,7 @@
 
 #include "acs/system.h"
 
+#include <de/hash.h>
 #include <de/iserializable.h>
 #include <de/log.h>
 #include <de/nativepath.h>
@@ -36,6 +37,8 @@ DE_PIMPL_NOREF(System)
 {
     std::unique_ptr<Module> currentModule;
     List<Script *> scripts;  ///< Scripts for the current module (if any).
+    Hash<dint, Script *> scriptsByNumber;
+    Hash<dint, List<Script *>> waiters;  ///< Scripts waiting for a script to terminate.
 
     /**
      * When a script must be started on a map that is not currently loaded -
@@ -96,6 +99,8 @@ DE_PIMPL_NOREF(System)
 
     void clearScripts()
     {
+        waiters.clear();
+        scriptsByNumber.clear();
         deleteAll(scripts); scripts.clear();
     }
 
@@ -106,10 +111,26 @@ DE_PIMPL_NOREF(System)
         currentModule->forAllEntryPoints([this] (const Module::EntryPoint &ep)
         {
             scripts << new Script(ep);
+            scriptsByNumber.insert(ep.scriptNumber, scripts.last());
             return LoopContinue;
         });
     }
 
+    /**
+     * Rebuilds the waiter index from the script states (e.g., after deserialization).
+     */
+    void findWaiters()
+    {
+        waiters.clear();
+        for (Script *script : scripts)
+        {
+            if (script->state() == Script::WaitingForScript)
+            {
+                waiters[script->waitValue()] << script;
+            }
+        }
+    }
+
     void clearTasks()
     {
         deleteAll(tasks); tasks.clear();
@@ -180,24 +201,15 @@ dint System::scriptCount() const
 
 bool System::hasScript(dint scriptNumber) const
 {
-    for(const Script *script : d->scripts)
-    {
-        if(script->entryPoint().scriptNumber == scriptNumber)
-        {
-            return true;
-        }
-    }
-    return false;
+    return d->scriptsByNumber.contains(scriptNumber);
 }
 
 Script &System::script(dint scriptNumber) const
 {
-    for(const Script *script : d->scripts)
+    auto found = d->scriptsByNumber.find(scriptNumber);
+    if(found != d->scriptsByNumber.end())
     {
-        if(script->entryPoint().scriptNumber == scriptNumber)
-        {
-            return *const_cast<Script *>(script);
-        }
+        return *found->second;
     }
     /// @throw MissingScriptError  Invalid script number specified.
     throw MissingScriptError("acs::System::script", "Unknown script #" + String::asText(scriptNumber));
@@ -212,6 +224,25 @@ LoopResult System::forAllScripts(std::function<LoopResult (Script &)> func) cons
     return LoopContinue;
 }
 
+void System::waitForScript(Script &script, dint scriptNumber)
+{
+    script.waitForScript(scriptNumber);
+    d->waiters[scriptNumber] << &script;
+}
+
+void System::scriptTerminated(const Script &script)
+{
+    const dint scriptNumber = script.entryPoint().scriptNumber;
+    if(!d->waiters.contains(scriptNumber)) return;
+
+    // Scripts that have stopped waiting in the meantime are ignored.
+    const List<Script *> waiting = d->waiters.take(scriptNumber);
+    for(Script *waiter : waiting)
+    {
+        waiter->resumeIfWaitingForScript(script);
+    }
+}
+
 bool System::deferScriptStart(const res::Uri &mapUri, dint scriptNumber,
     const Script::Args &scriptArgs)
 {
@@ -288,6 +319,7 @@ void System::readMapState(MapStateReader *msr)
 
     // Read each script state.
     for(auto *script : d->scripts) script->read(reader);
+    d->findWaiters();
 
     // Read each variable.
     for(auto &var : mapVars) var = Reader_ReadInt32(reader);
@@ -23,11 +23,16 @@
 #include <de/app.h>
 #include <de/commandline.h>
 #include <de/arrayvalue.h>
+#include <de/directoryfeed.h>
+#include <de/keymap.h>
+#include <de/loop.h>
 #include <de/numbervalue.h>
 #include <de/recordvalue.h>
 #include <de/packageloader.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 #include <de/textvalue.h>
+#include <de/writer.h>
 #include <de/ziparchive.h>
 #include <doomsday/doomsdayapp.h>
 #include <doomsday/gamestatefolder.h>
@@ -41,6 +46,7 @@
 #include "g_game.h"
 #include "hu_menu.h"
 #include "hu_inventory.h"
+#include "hubstatestore.h"
 #include "mapstatewriter.h"
 #include "p_inventory.h"
 #include "p_map.h"
@@ -58,6 +64,17 @@
 #  include "hereticv13mapstatereader.h"
 #endif
 
+#if defined(WIN32)
+#  include <io.h>
+#endif
+#if defined(UNIX)
+#  include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+
 using namespace de;
 
 namespace common {
@@ -105,6 +122,7 @@ using namespace internal;
 
 DE_STATIC_STRING(internalSavePath, "/home/cache/internal.save");
 static GameSession theSession;
+static dint hubStateBudget = HubStateStore::DEFAULT_BUDGET >> 20; // MiB
 
 DE_PIMPL(GameSession)
 , public GameStateFolder::IMapStateReaderFactory
@@ -118,8 +136,47 @@ DE_PIMPL(GameSession)
 
     acs::System acscriptSys;  ///< The One acs::System instance.
 
+    /**
+     * Contents of a user saved session, captured from the game state so that the
+     * package can be compressed and written in the background.
+     */
+    struct SaveSnapshot
+    {
+        String                savePath;    ///< Destination in the file system.
+        NativePath            nativePath;  ///< Destination native file.
+        GameStateMetadata     metadata;
+        KeyMap<String, Block> entries;     ///< Package contents by path.
+        String                error;       ///< Set if writing failed.
+        std::atomic_bool      written{false};
+    };
+    List<std::shared_ptr<SaveSnapshot>> pendingSaves;  ///< The first one is being written.
+    TaskPool saveTasks;
+    std::shared_ptr<int> saveToken { new int };  ///< Replaced to cancel queued saveWritten() calls.
+
+    HubStateStore hubStates;  ///< Departed maps of the current hub (not yet in the package).
+    bool hubStatesEvicted = false;
+
     Impl(Public *i) : Base(i)
-    {}
+    {
+        // States that don't fit in the budget go to the internal .save package.
+        hubStates.setCommitFunc([this] (const String &mapPath, const Block &state)
+        {
+            auto &saved = App::rootFolder().locate<GameStateFolder>(internalSavePath());
+            saved.locate<Folder>("maps").replaceFile(mapPath + "State") << state;
+            hubStatesEvicted = true;
+        });
+    }
+
+    ~Impl()
+    {
+        // Saves are not completed any more, but the files are still written.
+        saveToken.reset();
+        saveTasks.waitForDone();
+        for (const auto &snapshot : pendingSaves)
+        {
+            if (!snapshot->written) writeSave(*snapshot);
+        }
+    }
 
     inline String userSavePath(const String &fileName)
     {
@@ -143,6 +200,7 @@ DE_PIMPL(GameSession)
     {
         // Perform necessary prep.
         cleanupInternalSave();
+        hubStates.clear();
 
         G_StopDemo();
 
@@ -232,14 +290,15 @@ DE_PIMPL(GameSession)
     }
 
     /**
-     * Write the current map state to a file and notify the application about the change
-     * in the game state folder.
+     * Serialize the current map state and notify the application about the change in
+     * the game state folder.
      *
-     * @param dest            Destination file for the serialized map state.
      * @param saveFolder      Folder containing the save.
      * @param excludePlayers  Should players be excluded from the state?
+     *
+     * @return Serialized map state.
      */
-    void serializeCurrentMapState(File &dest, GameStateFolder &saveFolder, bool excludePlayers = false)
+    Block serializeMapState(GameStateFolder &saveFolder, bool excludePlayers = false)
     {
         Block data;
         SV_OpenFileForWrite(data);
@@ -251,18 +310,33 @@ DE_PIMPL(GameSession)
         Writer_Delete(writer);
         SV_CloseFile();
 
-        // Write to the file.
-        dest << data;
-
         DoomsdayApp::app().gameSessionWasSaved(self(), saveFolder);
         //self().setThinkerMapping(nullptr);
+        return data;
+    }
+
+    /**
+     * Write the current map state to a file (see serializeMapState()).
+     *
+     * @param dest            Destination file for the serialized map state.
+     * @param saveFolder      Folder containing the save.
+     * @param excludePlayers  Should players be excluded from the state?
+     */
+    void serializeCurrentMapState(File &dest, GameStateFolder &saveFolder, bool excludePlayers = false)
+    {
+        dest << serializeMapState(saveFolder, excludePlayers);
     }
 
     /**
      * Update/create a new GameStateFolder at the specified @a path from the current
      * game state.
+     *
+     * @param flush  Write the updated package to its source file. If @c false, the
+     *               changes are only kept in memory until the package is flushed
+     *               later (or destroyed).
      */
-    GameStateFolder &updateGameStateFolder(const String &path, const GameStateMetadata &metadata)
+    GameStateFolder &updateGameStateFolder(const String &path, const GameStateMetadata &metadata,
+                                           bool flush = true)
     {
         DE_ASSERT(self().hasBegun());
 
@@ -307,12 +381,214 @@ DE_PIMPL(GameSession)
         //DoomsdayApp::app().gameSessionWasSaved(self(), *saved);
         //self().setThinkerMapping(nullptr);
 
-        saved->flush();  // No need to populate; FS2 Files already in sync with source data.
+        if (flush)
+        {
+            saved->flush();  // No need to populate; FS2 Files already in sync with source data.
+        }
         saved->cacheMetadata(metadata);  // Avoid immediately reopening the .save package.
 
         return *saved;
     }
 
+    static void collectSaveEntries(const Folder &folder, const String &prefix,
+                                   KeyMap<String, Block> &entries)
+    {
+        folder.forContents([&prefix, &entries] (String, File &file)
+        {
+            const String path = prefix / file.name();
+            if (const auto *subFolder = maybeAs<Folder>(file))
+            {
+                collectSaveEntries(*subFolder, path, entries);
+            }
+            else
+            {
+                file >> entries[path];
+            }
+            return LoopContinue;
+        });
+    }
+
+    /**
+     * Captures the contents of the @a source package for writing them to @a savePath.
+     * The entries are not compressed here, so this is quick.
+     *
+     * @return Snapshot. Its native path is empty if @a savePath is not in a native
+     * directory.
+     */
+    std::shared_ptr<SaveSnapshot> captureSave(const String &savePath, const GameStateFolder &source)
+    {
+        std::shared_ptr<SaveSnapshot> snapshot(new SaveSnapshot);
+        snapshot->savePath = savePath;
+        snapshot->metadata = source.metadata();
+        collectSaveEntries(source, "", snapshot->entries);
+
+        const Folder &folder = App::fileSystem().makeFolder(savePath.fileNamePath());
+        if (const auto *feed = folder.primaryFeedMaybeAs<DirectoryFeed>())
+        {
+            snapshot->nativePath = feed->nativePath() / String(savePath.fileName());
+        }
+        return snapshot;
+    }
+
+    /**
+     * Writes @a data to a native file and makes sure it has reached the disk.
+     *
+     * @return @c true if successful.
+     */
+    static bool writeNativeFile(const NativePath &path, const Block &data)
+    {
+#if defined(WIN32)
+        FILE *file = _wfopen(String(path.c_str()).toWideString().c_str(), L"wb");
+#else
+        FILE *file = fopen(path.c_str(), "wb");
+#endif
+        if (!file) return false;
+
+        bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+        ok = fflush(file) == 0 && ok;
+#if defined(WIN32)
+        ok = _commit(_fileno(file)) == 0 && ok;
+#elif defined(UNIX)
+        ok = fsync(fileno(file)) == 0 && ok;
+#endif
+        return fclose(file) == 0 && ok;
+    }
+
+    /**
+     * Compresses the snapshot into a .save package and writes it to the native file.
+     * The package is first written to a temporary file that then replaces the
+     * destination, so an existing save remains intact if writing fails. Can be called
+     * in any thread.
+     */
+    static void writeSave(SaveSnapshot &snapshot)
+    {
+        try
+        {
+            ZipArchive arch;
+            for (const auto &entry : snapshot.entries)
+            {
+                arch.add(entry.first, entry.second);
+            }
+            Block data;
+            de::Writer(data) << arch;
+
+            // The data must be on disk before it replaces the old save.
+            const NativePath tempPath = snapshot.nativePath.toString() + ".tmp";
+            if (!writeNativeFile(tempPath, data))
+            {
+                tempPath.remove();
+                throw Error("GameSession::writeSave", "Failed to write " + tempPath.toString());
+            }
+            if (!tempPath.renameTo(snapshot.nativePath))
+            {
+                tempPath.remove();
+                throw Error("GameSession::writeSave",
+                            "Failed to replace " + snapshot.nativePath.toString());
+            }
+        }
+        catch (const Error &er)
+        {
+            snapshot.error = er.asText();
+        }
+        snapshot.written = true;
+    }
+
+    void writeSaveInBackground(const std::shared_ptr<SaveSnapshot> &snapshot)
+    {
+        pendingSaves << snapshot;
+        if (pendingSaves.size() == 1)
+        {
+            startWritingSave();
+        }
+    }
+
+    void startWritingSave()
+    {
+        std::shared_ptr<SaveSnapshot> snapshot = pendingSaves.first();
+        std::weak_ptr<int> token = saveToken;
+        saveTasks.start([this, snapshot, token] ()
+        {
+            writeSave(*snapshot);
+            Loop::mainCall([this, token] ()
+            {
+                // Cancelled if the session has finished the saves itself or is gone.
+                if (!token.expired()) saveWritten();
+            });
+        });
+    }
+
+    void saveWritten()
+    {
+        if (pendingSaves.isEmpty() || !pendingSaves.first()->written) return;
+
+        const auto snapshot = pendingSaves.takeFirst();
+        if (!pendingSaves.isEmpty())
+        {
+            startWritingSave();
+        }
+        completeSave(*snapshot);
+    }
+
+    /**
+     * Waits until all the saves being written in the background are complete.
+     */
+    void finishPendingSaves()
+    {
+        if (pendingSaves.isEmpty()) return;
+
+        saveTasks.waitForDone();
+        saveToken.reset(new int);  // Calls to saveWritten() are no longer needed.
+        while (!pendingSaves.isEmpty())
+        {
+            const auto snapshot = pendingSaves.takeFirst();
+            if (!snapshot->written)
+            {
+                writeSave(*snapshot);
+            }
+            completeSave(*snapshot);
+        }
+    }
+
+    /**
+     * Updates the file system after a save has been written and notifies the user.
+     */
+    void completeSave(const SaveSnapshot &snapshot)
+    {
+        LOG_AS("GameSession");
+
+        if (snapshot.error)
+        {
+            LOG_RES_WARNING("Error saving game session to '%s':\n")
+                    << snapshot.savePath << snapshot.error;
+            return;
+        }
+
+        // The native file has been replaced; the old file object is out of date.
+        Folder &folder = App::rootFolder().locate<Folder>(snapshot.savePath.fileNamePath());
+        if (File *old = folder.tryLocateFile(snapshot.savePath.fileName()))
+        {
+            delete folder.remove(*old);
+        }
+        folder.populate(Folder::PopulateOnlyThisFolder);
+        if (auto *saved = App::rootFolder().tryLocate<GameStateFolder>(snapshot.savePath))
+        {
+            saved->cacheMetadata(snapshot.metadata);  // Avoid immediately opening the .save package.
+        }
+        LOG_RES_VERBOSE("Saved \"%s\"") << snapshot.savePath;
+
+        notifyGameSaved();
+    }
+
+    static void notifyGameSaved()
+    {
+        P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
+
+        // Notify the engine that the game was saved.
+        /// @todo After the engine has the primary responsibility of saving the game,
+        /// this notification is unnecessary.
+        Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+    }
+
 #if __JDOOM__ || __JDOOM64__
     /**
      * @todo fixme: (Kludge) Assumes the original mobj info tic timing values have
@@ -536,6 +812,7 @@ DE_PIMPL(GameSession)
         {
             // Perform necessary prep.
             cleanupInternalSave();
+            hubStates.clear();
 
             // Copy the save to the internal savegame.
             AbstractSession::copySaved(internalSavePath(), savePath);
@@ -1043,6 +1320,8 @@ bool GameSession::progressRestoredOnReload() const
 
 void GameSession::end()
 {
+    d->finishPendingSaves();
+
     if (!hasBegun()) return;
 
     // Reset state of relevant subsystems.
@@ -1055,6 +1334,7 @@ void GameSession::end()
     }
 
     AbstractSession::removeSaved(internalSavePath());
+    d->hubStates.clear();
 
     setInProgress(false);
     LOG_MSG("Game ended");
@@ -1217,24 +1497,24 @@ void GameSession::leaveMap(const res::Uri &nextMapUri, uint nextMapEntryPoint)
         {
             // Clear all saved map states in the current hub.
             mapsFolder.destroyAllFiles();
+            d->hubStates.clear();
         }
 #if __JHEXEN__
         else
         {
-            File &outFile = mapsFolder.replaceFile(mapUri().path() + "State");
-            //MapStateWriter mapStateWriter;
-            //self().setThinkerMapping(&mapStateWriter);
-            d->serializeCurrentMapState(outFile, *saved, true /*exclude players*/);
-            //DoomsdayApp::app().gameSessionWasSaved(*this, *saved);
-            //self().setThinkerMapping(nullptr);
-
-            // We'll flush whole package soon.
+            // Keep the state in memory until the game is saved, so the package
+            // doesn't need to be rewritten on every hub transition.
+            d->hubStates.setBudget(dsize(hubStateBudget) << 20);
+            d->hubStates.insert(mapUri().path().toString(),
+                                d->serializeMapState(*saved, true /*exclude players*/));
+            if (d->hubStatesEvicted)
+            {
+                // Compress the evicted states in the package.
+                saved->flush();
+                d->hubStatesEvicted = false;
+            }
         }
 #endif
-
-        // Ensure changes are written to disk right away (otherwise would stay
-        // in memory only).
-        saved->flush();
     }
 
 #if __JHEXEN__
@@ -1261,7 +1541,15 @@ void GameSession::leaveMap(const res::Uri &nextMapUri, uint nextMapEntryPoint)
     d->setMapAndEntryPoint(nextMapUri, nextMapEntryPoint);
 
     // Are we revisiting a previous map?
-    const bool revisit = saved && saved->hasState(String("maps") / mapUri().path());
+    const String mapPath = mapUri().path().toString();
+    const bool revisit = saved && (d->hubStates.has(mapPath) ||
+                                   saved->hasState(String("maps") / mapPath));
+    if (revisit && d->hubStates.has(mapPath))
+    {
+        // The state is read from the package. The package is not flushed, so this
+        // is just a copy in memory.
+        saved->locate<Folder>("maps").replaceFile(mapPath + "State") << d->hubStates.take(mapPath);
+    }
 
     d->reloadMap(revisit);
 
@@ -1315,7 +1603,8 @@ void GameSession::leaveMap(const res::Uri &nextMapUri, uint nextMapEntryPoint)
         //DoomsdayApp::app().gameSessionWasSaved(*this, *saved);
         //setThinkerMapping(nullptr);
 
-        saved->flush(); // Write all changes to the package.
+        // The package is written to disk when the game is saved or a new session
+        // begins; there's no need to recompress it on every map change.
         saved->cacheMetadata(metadata); // Avoid immediately reopening the .save package.
     }
 }
@@ -1355,21 +1644,31 @@ void GameSession::save(const String &saveName, const String &userDescription)
         GameStateMetadata metadata = d->metadata();
         metadata.set("userDescription", chooseSaveDescription(savePath, userDescription));
 
-        // Update the existing internal .save package.
-        d->updateGameStateFolder(internalSavePath(), metadata);
+        // The states of the other maps in the hub are part of the save.
+        d->hubStates.commitAll();
+        d->hubStatesEvicted = false;
+
+        // Update the existing internal .save package. It doesn't need to be written
+        // to disk now; only the copy in the destination slot does.
+        GameStateFolder &internalSave =
+                d->updateGameStateFolder(internalSavePath(), metadata, false);
 
         // In networked games the server tells the clients to save also.
         NetSv_SaveGame(metadata.getui("sessionId"));
 
-        // Copy the internal saved session to the destination slot.
-        AbstractSession::copySaved(savePath, internalSavePath());
-
-        P_SetMessage(&players[CONSOLEPLAYER], TXT_GAMESAVED);
-
-        // Notify the engine that the game was saved.
-        /// @todo After the engine has the primary responsibility of saving the game,
-        /// this notification is unnecessary.
-        Plug_Notify(DD_NOTIFY_GAME_SAVED, nullptr);
+        // Copy the internal saved session to the destination slot. The package is
+        // compressed and written in the background.
+        auto snapshot = d->captureSave(savePath, internalSave);
+        if (snapshot->nativePath.isEmpty())
+        {
+            internalSave.flush();
+            AbstractSession::copySaved(savePath, internalSavePath());
+            Impl::notifyGameSaved();
+        }
+        else
+        {
+            d->writeSaveInBackground(snapshot);
+        }
     }
     catch (const Error &er)
     {
@@ -1381,6 +1680,8 @@ void GameSession::save(const String &saveName, const String &userDescription)
 /// @todo Use busy mode here.
 void GameSession::load(const String &saveName)
 {
+    d->finishPendingSaves();
+
     const String savePath = d->userSavePath(saveName);
     LOG_MSG("Loading game from \"%s\"...") << savePath;
     d->loadSaved(savePath);
@@ -1389,18 +1690,29 @@ void GameSession::load(const String &saveName)
 
 void GameSession::copySaved(const String &destName, const String &sourceName)
 {
+    d->finishPendingSaves();
     AbstractSession::copySaved(d->userSavePath(destName), d->userSavePath(sourceName));
     LOG_MSG("Copied savegame \"%s\" to \"%s\"") << sourceName << destName;
 }
 
 void GameSession::removeSaved(const String &saveName)
 {
+    d->finishPendingSaves();
     AbstractSession::removeSaved(d->userSavePath(saveName));
 }
 
 String GameSession::savedUserDescription(const String &saveName)
 {
     const String savePath = d->userSavePath(saveName);
+
+    // A save that is still being written has the latest description.
+    for (auto i = d->pendingSaves.rbegin(); i != d->pendingSaves.rend(); ++i)
+    {
+        if (!(*i)->savePath.compareWithoutCase(savePath))
+        {
+            return (*i)->metadata.gets("userDescription", "");
+        }
+    }
     if (const auto *saved = App::rootFolder().tryLocate<GameStateFolder>(savePath))
     {
         return saved->metadata().gets("userDescription", "");
@@ -1428,6 +1740,9 @@ void GameSession::consoleRegister()  // static
     C_VAR_URIPTR ("map-id",         &gsvMap,        READONLYCVAR, 0, 0);
 
 #undef READONLYCVAR
+
+    // Memory for the states of visited hub maps (MiB).
+    C_VAR_INT    ("game-hubstate-budget", &hubStateBudget, 0, 1, 1024);
 }
 
 } // namespace common
@@ -0,0 +1,126 @@
+/** @file hubstatestore.cpp  In-memory store of serialized map states in a hub.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "hubstatestore.h"
+
+#include <de/list.h>
+
+using namespace de;
+
+DE_PIMPL_NOREF(HubStateStore)
+{
+    struct State
+    {
+        String mapPath;
+        Block  data;
+    };
+    List<State> states; // Oldest first.
+    dsize budget = DEFAULT_BUDGET;
+    dsize size = 0;
+    CommitFunc commit;
+
+    int find(const String &mapPath) const
+    {
+        for (int i = 0; i < states.sizei(); ++i)
+        {
+            if (!states[i].mapPath.compareWithoutCase(mapPath)) return i;
+        }
+        return -1;
+    }
+
+    void commitFirst()
+    {
+        const State state = states.takeFirst();
+        size -= state.data.size();
+        if (commit) commit(state.mapPath, state.data);
+    }
+};
+
+HubStateStore::HubStateStore(dsize budget) : d(new Impl)
+{
+    d->budget = budget;
+}
+
+void HubStateStore::setCommitFunc(const CommitFunc &func)
+{
+    d->commit = func;
+}
+
+void HubStateStore::setBudget(dsize bytes)
+{
+    d->budget = bytes;
+}
+
+dsize HubStateStore::budget() const
+{
+    return d->budget;
+}
+
+dsize HubStateStore::size() const
+{
+    return d->size;
+}
+
+int HubStateStore::count() const
+{
+    return d->states.sizei();
+}
+
+bool HubStateStore::has(const String &mapPath) const
+{
+    return d->find(mapPath) >= 0;
+}
+
+void HubStateStore::insert(const String &mapPath, const Block &state)
+{
+    take(mapPath);
+
+    d->states << Impl::State{mapPath, state};
+    d->size += state.size();
+
+    // Keep the new state even if it alone exceeds the budget.
+    while (d->size > d->budget && d->states.size() > 1)
+    {
+        d->commitFirst();
+    }
+}
+
+Block HubStateStore::take(const String &mapPath)
+{
+    const int idx = d->find(mapPath);
+    if (idx < 0) return Block();
+
+    Impl::State state = d->states.takeAt(idx);
+    d->size -= state.data.size();
+    return state.data;
+}
+
+void HubStateStore::commitAll()
+{
+    while (!d->states.isEmpty())
+    {
+        d->commitFirst();
+    }
+}
+
+void HubStateStore::clear()
+{
+    d->states.clear();
+    d->size = 0;
+}
@@ -27,6 +27,8 @@
 #include "p_actor.h"
 
 #include <doomsday/world/mobj.h>
+#include <de/hash.h>
+#include <de/list.h>
 
 #if __JDOOM64__
 # define RESPAWNTICS            (4 * TICSPERSEC)
@@ -489,27 +491,20 @@ void P_PurgeDeferredSpawns()
 
 #ifdef __JHEXEN__
 
-/// @todo Remove fixed limit.
-#define MAX_TID_COUNT           200
-
-static int TIDList[MAX_TID_COUNT + 1];  // +1 for termination marker
-static mobj_t *TIDMobj[MAX_TID_COUNT];
+/**
+ * Mobjs with a thing ID, indexed by TID. The position of a mobj in the list of its
+ * TID remains unchanged until it is removed (the slot is then set to @c nullptr and
+ * may be reused), so search positions remain valid while mobjs come and go.
+ */
+static de::Hash<int, de::List<mobj_t *>> tidMobjs;
 
-static int insertThinkerInIdListWorker(thinker_t *th, void *context)
+static int insertThinkerInIdListWorker(thinker_t *th, void *)
 {
     mobj_t *mo = (mobj_t *)th;
-    int *count = (int *) context;
 
     if(mo->tid != 0)
     {
-        // Add to list.
-        if(*count == MAX_TID_COUNT)
-        {
-            Con_Error("P_CreateTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
-        }
-
-        TIDList[*count] = mo->tid;
-        TIDMobj[(*count)++] = mo;
+        tidMobjs[mo->tid].append(mo);
     }
 
     return false; // Continue iteration.
@@ -517,43 +512,28 @@ static int insertThinkerInIdListWorker(thinker_t *th, void *context)
 
 void P_CreateTIDList()
 {
-    int count = 0;
-    Thinker_Iterate(P_MobjThinker, insertThinkerInIdListWorker, &count);
-
-    // Add termination marker
-    TIDList[count] = 0;
+    tidMobjs.clear();
+    Thinker_Iterate(P_MobjThinker, insertThinkerInIdListWorker, nullptr);
 }
 
 void P_MobjInsertIntoTIDList(mobj_t *mo, int tid)
 {
     DE_ASSERT(mo != 0);
 
-    int index = -1;
-    int i = 0;
-    for(; TIDList[i] != 0; ++i)
-    {
-        if(TIDList[i] == -1)
-        {
-            // Found empty slot
-            index = i;
-            break;
-        }
-    }
+    mo->tid = tid;
+    if(!tid) return;
 
-    if(index == -1)
+    de::List<mobj_t *> &slots = tidMobjs[tid];
+    for(mobj_t *&slot : slots)
     {
-        // Append required
-        if(i == MAX_TID_COUNT)
+        if(!slot)
         {
-            Con_Error("P_MobjInsertIntoTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
+            // Found empty slot
+            slot = mo;
+            return;
         }
-        index = i;
-        TIDList[index + 1] = 0;
     }
-
-    mo->tid = tid;
-    TIDList[index] = tid;
-    TIDMobj[index] = mo;
+    slots.append(mo);
 }
 
 void P_MobjRemoveFromTIDList(mobj_t *mo)
@@ -561,14 +541,27 @@ void P_MobjRemoveFromTIDList(mobj_t *mo)
     if(!mo || !mo->tid)
         return;
 
-    for(int i = 0; TIDList[i] != 0; ++i)
+    auto found = tidMobjs.find(mo->tid);
+    if(found != tidMobjs.end())
     {
-        if(TIDMobj[i] == mo)
+        de::List<mobj_t *> &slots = found->second;
+        for(mobj_t *&slot : slots)
         {
-            TIDList[i] = -1;
-            TIDMobj[i] = 0;
-            mo->tid = 0;
-            return;
+            if(slot == mo)
+            {
+                slot = nullptr;
+                break;
+            }
+        }
+
+        // Trailing empty slots can be dropped without affecting search positions.
+        while(!slots.isEmpty() && !slots.back())
+        {
+            slots.pop_back();
+        }
+        if(slots.isEmpty())
+        {
+            tidMobjs.erase(found);
         }
     }
 
@@ -579,12 +572,17 @@ mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
 {
     DE_ASSERT(searchPosition != 0);
 
-    for(int i = *searchPosition + 1; TIDList[i] != 0; ++i)
+    auto found = tidMobjs.find(tid);
+    if(found != tidMobjs.end())
     {
-        if(TIDList[i] == tid)
+        const de::List<mobj_t *> &slots = found->second;
+        for(int i = *searchPosition + 1; i < slots.sizei(); ++i)
         {
-            *searchPosition = i;
-            return TIDMobj[i];
+            if(slots[i])
+            {
+                *searchPosition = i;
+                return slots[i];
+            }
         }
     }
 
@@ -33,6 +33,7 @@
 #include "gamesession.h"
 #include "dmu_lib.h"
 #include "p_mapspec.h"
+#include "p_perception.h"
 #include "p_terraintype.h"
 #include "p_tick.h"
 #include "p_actor.h"
@@ -40,6 +41,8 @@
 #include "p_mapsetup.h"
 
 #include <doomsday/world/lineopening.h>
+#include <doomsday/world/map.h>
+#include <doomsday/world/world.h>
 
 /*
  * Try move variables:
@@ -83,7 +86,7 @@ static float aimSlope;
 static float topSlope, bottomSlope; ///< Slopes to top and bottom of target.
 
 /// Sector >= Sector line-of-sight rejection.
-static byte *rejectMatrix;
+static const byte *rejectMatrix;
 
 coord_t P_GetGravity()
 {
@@ -94,6 +97,20 @@ coord_t P_GetGravity()
     return *((coord_t *) DD_GetVariable(DD_MAP_GRAVITY));
 }
 
+void P_InitReject()
+{
+    rejectMatrix = nullptr;
+
+    if(!world::World::get().hasMap()) return;
+
+    // The matrix remains valid for the lifetime of the map.
+    const de::Block &matrix = world::World::get().map().rejectMatrix();
+    if(matrix.size() >= (de::dsize(numsectors) * de::dsize(numsectors) + 7) / 8)
+    {
+        rejectMatrix = matrix.cdata();
+    }
+}
+
 /**
  * Checks the reject matrix to find out if the two sectors are visible
  * from each other.
@@ -142,6 +159,13 @@ dd_bool P_CheckSight(const mobj_t *beholder, const mobj_t *target)
         from[VZ] += beholder->height + -(beholder->height / 4);
     }
 
+    // Perhaps this was already checked during the perception phase?
+    dd_bool visible;
+    if(P_PerceivedLineSight(beholder, target, &visible))
+    {
+        return visible;
+    }
+
     return P_CheckLineSight(from, target->origin, 0, target->height, 0);
 }
 
@@ -42,6 +42,8 @@
 #include "hu_stuff.h"
 #include "hud/widgets/automapwidget.h"
 #include "p_actor.h"
+#include "p_map.h"
+#include "p_perception.h"
 #include "p_scroll.h"
 #include "p_start.h"
 #include "p_tick.h"
@@ -935,6 +937,8 @@ void P_FinalizeMapChange(const uri_s *mapUri_)
 
     // Set up world state.
     P_BuildAllTagLists();
+    P_InitReject();
+    P_InitPerception();
 
 #if !__JHEXEN__
     // Init extended generalized lines and sectors.
@@ -0,0 +1,246 @@
+/** @file p_perception.cpp  Concurrent line of sight evaluation for monsters.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "common.h"
+#include "p_perception.h"
+
+#include "p_actor.h"
+#include "player.h"
+
+#include <doomsday/world/linesighttest.h>
+#include <doomsday/world/map.h>
+#include <doomsday/world/plane.h>
+#include <doomsday/world/sector.h>
+#include <doomsday/world/world.h>
+#include <de/hash.h>
+#include <de/list.h>
+#include <de/taskpool.h>
+
+using namespace de;
+
+/// Fewer checks than this are not worth distributing to worker threads.
+#define PERCEPTION_MIN_CHECKS       32
+
+/// Number of checks evaluated by a single task.
+#define PERCEPTION_CHECKS_PER_TASK  64
+
+struct SightCheck
+{
+    const mobj_t *beholder;
+    const mobj_t *target;
+    Vec3d from;
+    Vec3d to;
+    coord_t targetHeight;
+    bool visible;
+};
+
+struct BeholderChecks
+{
+    int first;
+    int count;
+};
+
+/// Incremented whenever planes or polyobjs move.
+static duint32 perceptionGeometryRevision;
+
+struct PerceptionPlaneObserver : public world::Plane::IHeightChangeObserver
+{
+    void planeHeightChanged(world::Plane &) override
+    {
+        perceptionGeometryRevision++;
+    }
+};
+
+static PerceptionPlaneObserver perceptionPlaneObserver;
+
+static List<SightCheck> sightChecks;
+static Hash<const mobj_t *, BeholderChecks> sightChecksByBeholder;
+static duint32 sightChecksRevision;
+static bool sightChecksValid;
+
+/**
+ * Line of sight originates from the "eyes" of the beholder (same as P_CheckSight()).
+ */
+static Vec3d eyeOrigin(const mobj_t *beholder)
+{
+    Vec3d from(beholder->origin);
+    if(!P_MobjIsCamera(beholder))
+    {
+        from.z += beholder->height + -(beholder->height / 4);
+    }
+    return from;
+}
+
+/// Positions must match exactly for a result to be reused.
+static inline bool samePoint(const Vec3d &a, const Vec3d &b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static void addSightCheck(const mobj_t *beholder, const mobj_t *target)
+{
+    if(!target || !Mobj_Sector(target) || P_MobjIsCamera(target)) return;
+
+    sightChecks << SightCheck{beholder, target, eyeOrigin(beholder), Vec3d(target->origin),
+                             target->height, false};
+}
+
+static int gatherSightChecksWorker(thinker_t *th, void *)
+{
+    const mobj_t *mo = (const mobj_t *) th;
+
+    // Only monsters that are about to act are considered.
+    if(mo->player || mo->health <= 0 || !(mo->flags & MF_COUNTKILL)) return false;
+    if(mo->tics != 1) return false;
+    if(!Mobj_Sector(mo)) return false;
+
+    const int first = sightChecks.sizei();
+
+    if(mo->target && mo->target->health > 0)
+    {
+        // Chasing: is the target still visible?
+        addSightCheck(mo, mo->target);
+    }
+    else
+    {
+        // Looking for players.
+        for(int i = 0; i < MAXPLAYERS; ++i)
+        {
+            const player_t *player = &players[i];
+            if(!player->plr->inGame || player->health <= 0) continue;
+            addSightCheck(mo, player->plr->mo);
+        }
+    }
+
+    if(sightChecks.sizei() > first)
+    {
+        sightChecksByBeholder.insert(mo, BeholderChecks{first, sightChecks.sizei() - first});
+    }
+    return false; // Continue iteration.
+}
+
+static TaskPool &perceptionTasks()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+void P_InitPerception()
+{
+    P_EndPerception();
+
+    if(!world::World::get().hasMap()) return;
+
+    world::World::get().map().forAllSectors([] (world::Sector &sector)
+    {
+        sector.forAllPlanes([] (world::Plane &plane)
+        {
+            plane.audienceForHeightChange() += perceptionPlaneObserver;
+            return LoopContinue;
+        });
+        return LoopContinue;
+    });
+}
+
+void P_RunPerception()
+{
+    P_EndPerception();
+
+    // Clients rely on the server.
+    if(IS_CLIENT) return;
+    if(!world::World::get().hasMap()) return;
+
+    Thinker_Iterate(P_MobjThinker, gatherSightChecksWorker, nullptr);
+
+    if(sightChecks.sizei() < PERCEPTION_MIN_CHECKS)
+    {
+        // Not worth it; check serially as usual.
+        P_EndPerception();
+        return;
+    }
+
+    // The map is not modified until all tasks are done. Each task writes the
+    // results of its own checks only, so the outcome does not depend on timing.
+    const world::BspTree &bspRoot = world::World::get().map().bspTree();
+    for(int first = 0; first < sightChecks.sizei(); first += PERCEPTION_CHECKS_PER_TASK)
+    {
+        const int last = de::min(first + PERCEPTION_CHECKS_PER_TASK, sightChecks.sizei());
+        perceptionTasks().start([&bspRoot, first, last] ()
+        {
+            for(int i = first; i < last; ++i)
+            {
+                SightCheck &check = sightChecks[i];
+                check.visible = world::LineSightTest(check.from, check.to, 0, float(check.targetHeight))
+                                    .traceConcurrently(bspRoot);
+            }
+        });
+    }
+    perceptionTasks().waitForDone();
+
+    sightChecksRevision = perceptionGeometryRevision;
+    sightChecksValid    = true;
+}
+
+void P_EndPerception()
+{
+    sightChecks.clear();
+    sightChecksByBeholder.clear();
+    sightChecksValid = false;
+}
+
+void P_PerceptionGeometryChanged()
+{
+    perceptionGeometryRevision++;
+}
+
+dd_bool P_PerceivedLineSight(const mobj_t *beholder, const mobj_t *target, dd_bool *visible)
+{
+    DE_ASSERT(visible);
+
+    if(!sightChecksValid) return false;
+
+    if(sightChecksRevision != perceptionGeometryRevision)
+    {
+        // Something has moved; the results are no longer reliable.
+        P_EndPerception();
+        return false;
+    }
+
+    auto found = sightChecksByBeholder.find(beholder);
+    if(found == sightChecksByBeholder.end()) return false;
+
+    const BeholderChecks &checks = found->second;
+    for(int i = checks.first; i < checks.first + checks.count; ++i)
+    {
+        const SightCheck &check = sightChecks[i];
+        if(check.target != target) continue;
+
+        // Have either of the mobjs moved since?
+        if(!samePoint(check.from, eyeOrigin(beholder)) ||
+           !samePoint(check.to, Vec3d(target->origin)) ||
+           check.targetHeight != target->height)
+        {
+            return false;
+        }
+
+        *visible = check.visible;
+        return true;
+    }
+    return false;
+}
@@ -28,6 +28,7 @@
 #include "hu_menu.h"
 #include "hu_msg.h"
 #include "p_actor.h"
+#include "p_perception.h"
 #include "p_user.h"
 #include "player.h"
 #include "r_common.h"
@@ -73,7 +74,10 @@ void P_DoTick()
        !Get(DD_PLAYBACK) && mapTime > 1)
         return;
 
+    // Evaluate the monsters' sight checks concurrently before they think.
+    P_RunPerception();
     Thinker_Run();
+    P_EndPerception();
 
 #if __JDOOM__ || __JDOOM64__ || __JHERETIC__
     // Extended lines and sectors.
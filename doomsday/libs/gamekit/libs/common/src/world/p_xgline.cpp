@@ -43,6 +43,7 @@
 #include "p_tick.h"
 #include "p_sound.h"
 #include "p_switch.h"
+#include "tagindex.h"
 
 using namespace de;
 
@@ -137,6 +138,9 @@ static linetype_t typebuffer;
 static char msgbuf[80];
 ThinkerT<mobj_s> dummyThing;
 
+/// Lines with an XG line type, indexed by act-tag.
+static TagIndex<Line> actTaggedLines;
+
 struct mobj_s *XG_DummyThing()
 {
     return dummyThing;
@@ -925,6 +929,10 @@ void XL_SetLineType(Line *line, int id)
         xline->xg->timer       = 0;
         xline->xg->tickerTimer = 0;
         std::memcpy(&xline->xg->info, &typebuffer, sizeof(linetype_t));
+        if(!P_IsDummy(line))
+        {
+            actTaggedLines.set(line, typebuffer.actTag);
+        }
 
         // Initial active state.
         xline->xg->active      = (typebuffer.flags & LTF_ACTIVE) != 0;
@@ -959,6 +967,7 @@ void XL_SetLineType(Line *line, int id)
 void XL_Init()
 {
     dummyThing.Thinker::zap();
+    actTaggedLines.clear();
 
     // Clients rely on the server, they don't do XG themselves.
     if(IS_CLIENT) return;
@@ -1087,12 +1096,27 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
             }
         }
     }
+    else if(refType == LPREF_ACT_TAGGED_FLOORS || refType == LPREF_ACT_TAGGED_CEILINGS)
+    {
+        // Use the act-tag index (a copy, as the callback may change sector types).
+        for(Sector *sec : XS_ActTaggedSectors(ref))
+        {
+            xsector_t *xsec = P_ToXSector(sec);
+            if(!xsec->xg || xsec->xg->info.actTag != ref)
+                continue; // Changed during the traversal.
+
+            if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
+               context, activator))
+            {
+               return false;
+            }
+        }
+    }
     else
     {
         for(int i = 0; i < numsectors; ++i)
         {
             Sector *sec     = (Sector *)P_ToPtr(DMU_SECTOR, i);
-            xsector_t *xsec = P_ToXSector(sec);
 
             if(refType == LPREF_ALL_FLOORS || refType == LPREF_ALL_CEILINGS)
             {
@@ -1103,17 +1127,6 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
                 }
             }
 
-            if((refType == LPREF_ACT_TAGGED_FLOORS ||
-                refType == LPREF_ACT_TAGGED_CEILINGS) && xsec->xg &&
-                xsec->xg->info.actTag == ref)
-            {
-                if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
-                   context, activator))
-                {
-                   return false;
-                }
-            }
-
             // Reference all sectors with (at least) one mobj of specified
             // type inside.
             if(refType == LPREF_THING_EXIST_FLOORS ||
@@ -1247,26 +1260,26 @@ int XL_TraverseLines(Line* line, int rtype, int ref, void* data,
             }
         }
     }
-    else
+    else if(reftype == LREF_ACT_TAGGED)
+    {
+        // Use the act-tag index (a copy, as the callback may change line types).
+        for(Line *tagged : actTaggedLines.elements(ref))
+        {
+            xline_t *xl = P_ToXLine(tagged);
+            if(!xl->xg || xl->xg->info.actTag != ref)
+                continue; // Changed during the traversal.
+
+            if(!func(tagged, true, data, context, activator))
+                return false;
+        }
+    }
+    else if(reftype == LREF_ALL)
     {
         for(i = 0; i < numlines; ++i)
         {
             iter = (Line *)P_ToPtr(DMU_LINE, i);
-            if(reftype == LREF_ALL)
-            {
-                if(!func(iter, true, data, context, activator))
-                    return false;
-            }
-            else if(reftype == LREF_ACT_TAGGED)
-            {
-                xline_t *xl = P_ToXLine(iter);
-
-                if(xl->xg && xl->xg->info.actTag == ref)
-                {
-                    if(!func(iter, true, data, context, activator))
-                        return false;
-                }
-            }
+            if(!func(iter, true, data, context, activator))
+                return false;
         }
     }
     return true;
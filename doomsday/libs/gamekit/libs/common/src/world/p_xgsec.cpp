@@ -45,6 +45,7 @@
 #include "p_sound.h"
 #include "p_terraintype.h"
 #include "p_tick.h"
+#include "tagindex.h"
 
 #define MAX_VALS        128
 
@@ -104,6 +105,9 @@
 
 void XS_DoChain(Sector *sec, int ch, int activating, void *actThing);
 
+/// Sectors with an XG sector type, indexed by act-tag.
+static TagIndex<Sector> actTaggedSectors;
+
 /**
  * Lookup a sectortype_t with the given @a id and if found - copy it into @a outBuffer.
  *
@@ -324,6 +328,7 @@ void XS_SetSectorType(Sector *sec, int special)
 
         // Get the type info.
         std::memcpy(&xsec->xg->info, &secType, sizeof(secType));
+        actTaggedSectors.set(sec, secType.actTag);
 
         // Init the state.
         xgsector_t *xg     = xsec->xg;
@@ -395,6 +400,7 @@ void XS_SetSectorType(Sector *sec, int special)
 
         // Free previously allocated XG data.
         Z_Free(xsec->xg); xsec->xg = nullptr;
+        actTaggedSectors.remove(sec);
 
         // Just set it, then. Must be a standard sector type...
         // Mind you, we're not going to spawn any standard flash funcs
@@ -408,6 +414,8 @@ void XS_Init()
     /*  // Clients rely on the server, they don't do XG themselves.
     if(IS_CLIENT) return; */
 
+    actTaggedSectors.clear();
+
     if(numsectors <= 0) return;
 
     for(int i = 0; i < numsectors; ++i)
@@ -911,53 +919,22 @@ Sector *XS_FindActTagged(int tag)
 {
     LOG_AS("XS_FindActTagged");
 
-    int k;
-    int foundcount = 0;
-    int retsectorid = 0;
-    Sector *sec, *retsector;
-    xsector_t *xsec;
-
-    retsector = NULL;
+    const TagIndex<Sector>::Elements *found = actTaggedSectors.find(tag);
+    if(!found)
+        return NULL;
 
-    for(k = 0; k < numsectors; ++k)
+    if(xgDev && found->size() > 1)
     {
-        sec = (Sector *) P_ToPtr(DMU_SECTOR, k);
-        xsec = P_ToXSector(sec);
-        if(xsec->xg)
-        {
-            if(xsec->xg->info.actTag == tag)
-            {
-                if(xgDev)
-                {
-                    if(foundcount == 0)
-                    {
-                        retsector = sec;
-                        retsectorid = k;
-                    }
-                }
-                else
-                {
-                    return sec;
-                }
-
-                foundcount++;
-            }
-        }
+        LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
+        LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", P_ToIndex(found->front()));
     }
 
-    if(xgDev)
-    {
-        if(foundcount > 1)
-        {
-            LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
-            LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", retsectorid);
-        }
-
-        if(retsector)
-            return retsector;
-    }
+    return found->front();
+}
 
-    return NULL;
+de::List<Sector *> XS_ActTaggedSectors(int actTag)
+{
+    return actTaggedSectors.elements(actTag);
 }
 
 #define FSETHF_MIN          0x1 // Get min. If not set, get max.
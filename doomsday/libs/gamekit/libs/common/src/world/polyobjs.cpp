@@ -28,6 +28,7 @@
 #include "p_actor.h"
 #include "p_map.h"
 #include "p_mapspec.h"
+#include "p_perception.h"
 #include "p_mapsetup.h"
 #include "p_start.h"
 
@@ -101,6 +102,7 @@ void T_RotatePoly(void *polyThinker)
     uint absSpeed;
     Polyobj *po = Polyobj_ByTag(pe->polyobj);
 
+    P_PerceptionGeometryChanged();
     if(Polyobj_Rotate(po, pe->intSpeed))
     {
         absSpeed = abs(pe->intSpeed);
@@ -242,6 +244,7 @@ void T_MovePoly(void *polyThinker)
     polyevent_t *pe = (polyevent_t *)polyThinker;
     Polyobj *po = Polyobj_ByTag(pe->polyobj);
 
+    P_PerceptionGeometryChanged();
     if(Polyobj_MoveXY(po, pe->speed[MX], pe->speed[MY]))
     {
         const uint absSpeed = abs(pe->intSpeed);
@@ -476,6 +479,7 @@ void T_PolyDoor(void *polyDoorThinker)
     switch(pd->type)
     {
     case PODOOR_SLIDE:
+        P_PerceptionGeometryChanged();
         if(Polyobj_MoveXY(po, pd->speed[MX], pd->speed[MY]))
         {
             int absSpeed = abs(pd->intSpeed);
@@ -525,6 +529,7 @@ void T_PolyDoor(void *polyDoorThinker)
         break;
 
     case PODOOR_SWING:
+        P_PerceptionGeometryChanged();
         if(Polyobj_Rotate(po, pd->intSpeed))
         {
             int absSpeed = abs(pd->intSpeed);
@@ -24,6 +24,7 @@
 #include "mobj.h"
 #include "p_saveg.h" /// @todo remove me
 #include <de/legacy/memory.h>
+#include <de/hash.h>
 
 #if __JHEXEN__
 /// Symbolic identifier used to mark references to players.
@@ -37,12 +38,17 @@ DE_PIMPL(ThingArchive)
     const mobj_t **things;
     bool excludePlayers;
 
+    /// Index of each archived mobj in @ref things (the reverse mapping).
+    de::Hash<const mobj_t *, uint> indices;
+    uint firstUnused; ///< No unused elements in @ref things before this.
+
     Impl(Public *i)
         : Base(i)
         , version(0)
         , size(0)
         , things(0)
         , excludePlayers(false)
+        , firstUnused(0)
     {}
 
     ~Impl()
@@ -65,6 +71,39 @@ DE_PIMPL(ThingArchive)
         }
         return false; // Continue iteration.
     }
+
+    void allocate(uint newSize)
+    {
+        size        = newSize;
+        things      = reinterpret_cast<const mobj_t **>(M_Calloc(size * sizeof(*things)));
+        firstUnused = 0;
+        indices.clear();
+        indices.reserve(size);
+    }
+
+    void set(uint index, const mobj_t *mo)
+    {
+        if (const mobj_t *old = things[index])
+        {
+            auto found = indices.find(old);
+            if (found != indices.end() && found->second == index)
+            {
+                indices.erase(found);
+            }
+        }
+        things[index] = mo;
+
+        // The lowest index is used if the same mobj is in the archive many times.
+        auto found = indices.find(mo);
+        if (found == indices.end() || found->second > index)
+        {
+            indices[mo] = index;
+        }
+        while (firstUnused < size && things[firstUnused])
+        {
+            firstUnused++;
+        }
+    }
 };
 
 ThingArchive::ThingArchive(int version) : d(new Impl(this))
@@ -91,12 +130,13 @@ void ThingArchive::clear()
 {
     M_Free(d->things); d->things = 0;
     d->size = 0;
+    d->firstUnused = 0;
+    d->indices.clear();
 }
 
 void ThingArchive::initForLoad(uint size)
 {
-    d->size   = size;
-    d->things = reinterpret_cast<const mobj_t **>(M_Calloc(d->size * sizeof(*d->things)));
+    d->allocate(size);
 }
 
 void ThingArchive::initForSave(bool excludePlayers)
@@ -107,8 +147,7 @@ void ThingArchive::initForSave(bool excludePlayers)
     parm.excludePlayers = excludePlayers;
     Thinker_Iterate(P_MobjThinker, Impl::countMobjThinkersToArchive, &parm);
 
-    d->size           = parm.count;
-    d->things         = reinterpret_cast<const mobj_t **>(M_Calloc(d->size * sizeof(*d->things)));
+    d->allocate(parm.count);
     d->excludePlayers = excludePlayers;
 }
 
@@ -131,7 +170,7 @@ void ThingArchive::insert(const mobj_t *mo, SerialId serialId)
 
     DE_ASSERT(d->things != 0);
     DE_ASSERT((unsigned)serialId < d->size);
-    d->things[serialId] = const_cast<mobj_t *>(mo);
+    d->set(uint(serialId), mo);
 }
 
 ThingArchive::SerialId ThingArchive::serialIdFor(const mobj_t *mo)
@@ -153,32 +192,22 @@ ThingArchive::SerialId ThingArchive::serialIdFor(const mobj_t *mo)
     }
 #endif
 
-    uint firstUnused = 0;
-    bool found = false;
-    for (uint i = 0; i < d->size; ++i)
+    auto found = d->indices.find(mo);
+    if (found != d->indices.end())
     {
-        if (!d->things[i] && !found)
-        {
-            firstUnused = i;
-            found = true;
-            continue;
-        }
-
-        if (d->things[i] == mo)
-        {
-            return i + 1;
-        }
+        return found->second + 1;
     }
 
-    if (!found)
+    if (d->firstUnused >= d->size)
     {
         Con_Error("ThingArchive::serialIdFor: Thing archive exhausted!");
         return 0; // No number available!
     }
 
-    // Insert it in the archive.
-    d->things[firstUnused] = mo;
-    return firstUnused + 1;
+    // Insert it in the archive. Identifiers are assigned in order of first use.
+    const uint index = d->firstUnused;
+    d->set(index, mo);
+    return index + 1;
 }
 
 mobj_t *ThingArchive::mobj(SerialId serialId, void *address)
@@ -52,6 +52,12 @@ class GLBuffer;
  * having a ModelDrawable instance, one needs to create a
  * ModelDrawable::Animator and pass it to the draw() method.
  *
+ * The evaluated bone transformations (poses) are cached, so instances that play
+ * the same animation at the same point in time share them. setPoseTimeStep() can
+ * be used to share poses between instances at nearly the same point in time.
+ * preparePoses() can be used to evaluate the poses of many animators in parallel
+ * before drawing.
+ *
  * @par Textures and materials
  *
  * The model is composed of one or more meshes. Each mesh has a set of texture
@@ -426,6 +432,20 @@ public:
 
     int animationCount() const;
 
+    /**
+     * Sets the interval at which the animation poses are evaluated. Instances whose
+     * animation times fall in the same interval share the same pose. By default
+     * poses are evaluated at the exact animation time.
+     *
+     * Must not be called while preparePoses() is running.
+     *
+     * @param seconds  Interval in seconds of animation time, or zero to use the exact
+     *                 animation time.
+     */
+    void setPoseTimeStep(ddouble seconds);
+
+    ddouble poseTimeStep() const;
+
     int meshCount() const;
 
     /**
@@ -556,6 +576,19 @@ public:
     void drawInstanced(const GLBuffer &instanceAttribs,
                        const Animator *animation = nullptr) const;
 
+    /**
+     * Evaluates the current poses of many animators in parallel using worker
+     * threads. The poses are kept in the pose caches of the animators' models, so
+     * drawing with the animators afterwards does not evaluate them again. Instances
+     * of the same animation at the same point in time share a pose.
+     *
+     * Animator::currentTime() and Animator::extraRotationForNode() are called in
+     * the worker threads, so they must not modify the animators.
+     *
+     * @param animators  Animators whose poses to evaluate.
+     */
+    static void preparePoses(const List<const Animator *> &animators);
+
     /**
      * When a draw operation is ongoing, returns the current rendering pass.
      * Otherwise returns nullptr.
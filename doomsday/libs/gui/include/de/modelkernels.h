@@ -0,0 +1,117 @@
+/** @file modelkernels.h  Vertex processing kernels for key-frame models.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBGUI_MODELKERNELS_H
+#define LIBGUI_MODELKERNELS_H
+
+#include "libgui.h"
+#include <de/vector.h>
+
+namespace de {
+
+/**
+ * Data-parallel kernels for the per-vertex work of key-frame (MD2/DMD) models:
+ * interpolating between two frames and shading the vertices with directional
+ * lights.
+ *
+ * The kernels use SSE2 or NEON when available, with a scalar fallback. The scalar
+ * versions are always available in the @c modelkernels::scalar namespace, for
+ * reference. Results of the two may differ by rounding.
+ *
+ * @ingroup gl
+ */
+namespace modelkernels {
+
+/**
+ * Vertex of a key-frame: position followed by the normal.
+ */
+struct KeyFrameVertex
+{
+    Vec3f pos;
+    Vec3f norm;
+};
+
+/**
+ * Directional light in model space.
+ */
+struct DirectionalLight
+{
+    Vec3f direction;   ///< Normalized.
+    Vec3f color;
+    float offset;      ///< Added to the strength (shifts the terminator).
+    float lightSide;   ///< Factor for positive strength.
+    float darkSide;    ///< Factor for negative strength.
+    bool affectedByAmbient; ///< Light is limited by the ambient color.
+};
+
+/**
+ * Returns the name of the instruction set used by the kernels.
+ */
+LIBGUI_PUBLIC const char *instructionSet();
+
+/**
+ * Interpolates linearly between two key-frames.
+ *
+ * @param inter    Interpolation factor (0 = @a from, 1 = @a to).
+ * @param count    Number of vertices.
+ * @param from     Vertices of the first frame.
+ * @param to       Vertices of the second frame.
+ * @param posOut   Interpolated positions are written here.
+ * @param normOut  Interpolated normals are written here.
+ */
+LIBGUI_PUBLIC void lerpKeyFrames(float inter, dsize count,
+                                 const KeyFrameVertex *from, const KeyFrameVertex *to,
+                                 Vec3f *posOut, Vec3f *normOut);
+
+/**
+ * Copies the positions and normals of a key-frame to separate arrays.
+ */
+LIBGUI_PUBLIC void copyKeyFrame(dsize count, const KeyFrameVertex *frame,
+                                Vec3f *posOut, Vec3f *normOut);
+
+/**
+ * Calculates vertex colors from normals lit by directional lights. The lights
+ * that are affected by ambient light cannot make a vertex darker than the ambient
+ * color; the others are added on top.
+ *
+ * @param count       Number of vertices.
+ * @param normals     Vertex normals (in model space).
+ * @param lights      Lights (in model space).
+ * @param lightCount  Number of lights.
+ * @param ambient     Ambient color. Alpha is used as the alpha of all vertices.
+ * @param colorOut    Colors are written here.
+ */
+LIBGUI_PUBLIC void shadeVertices(dsize count, const Vec3f *normals,
+                                 const DirectionalLight *lights, dsize lightCount,
+                                 const Vec4f &ambient, Vec4ub *colorOut);
+
+namespace scalar {
+
+LIBGUI_PUBLIC void lerpKeyFrames(float inter, dsize count,
+                                 const KeyFrameVertex *from, const KeyFrameVertex *to,
+                                 Vec3f *posOut, Vec3f *normOut);
+
+LIBGUI_PUBLIC void shadeVertices(dsize count, const Vec3f *normals,
+                                 const DirectionalLight *lights, dsize lightCount,
+                                 const Vec4f &ambient, Vec4ub *colorOut);
+
+} // namespace scalar
+} // namespace modelkernels
+} // namespace de
+
+#endif // LIBGUI_MODELKERNELS_H
@@ -28,7 +28,9 @@
 #include <de/glprogram.h>
 #include <de/glstate.h>
 #include <de/gluniform.h>
+#include <de/guard.h>
 #include <de/matrix.h>
+#include <de/taskpool.h>
 #include <de/texturebank.h>
 #include <de/hash.h>
 
@@ -40,7 +42,11 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstring>
+#include <list>
 
 namespace de {
 namespace internal {
@@ -245,6 +251,47 @@ static ddouble ticksToSeconds(ddouble ticks, const aiAnimation &anim)
     return ticks / secondsToTicks(1.0, anim);
 }
 
+/**
+ * Finds the animation key preceding @a time with a binary search. There must be at
+ * least two keys. The result is clamped so that there is always a following key to
+ * interpolate to.
+ */
+template <typename Key>
+static duint findPrecedingKey(ddouble time, const Key *keys, duint count)
+{
+    DE_ASSERT(count >= 2);
+    const Key *following = std::upper_bound(keys + 1, keys + count - 1, time,
+                                            [] (ddouble t, const Key &key) {
+        return t < key.mTime;
+    });
+    return duint(following - keys) - 1;
+}
+
+/// The least recently used poses are discarded when the cache grows larger than this.
+static const dsize MAX_CACHED_POSES = 256;
+
+/// Number of animators whose poses are evaluated by a single task.
+static const int POSES_PER_TASK = 8;
+
+static TaskPool &modelPoseTasks()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+static inline duint64 combinePoseHash(duint64 hash, duint64 value)
+{
+    return (hash ^ value) * 0x100000001b3ull;
+}
+
+template <typename Type>
+static inline duint64 poseHashBits(Type value)
+{
+    duint64 bits = 0;
+    std::memcpy(&bits, &value, sizeof(value));
+    return bits;
+}
+
 /// Bone used for vertices that have no bones.
 static String const DUMMY_BONE_NAME{"__deng_dummy-bone__"};
 
@@ -747,6 +794,7 @@ DE_PIMPL(ModelDrawable)
         nodeNameToPtr.clear();
         nodeNameToPtr.insert("", scene->mRootNode);
         buildNodeLookup(*scene->mRootNode);
+        buildFlatNodes();
 
         glData.initMaterials();
 
@@ -787,6 +835,13 @@ DE_PIMPL(ModelDrawable)
         bones.clear();
         animNameToIndex.clear();
         meshIndexRanges.clear();
+        flatNodes.clear();
+        flatNodeIndex.clear();
+        animChannels.clear();
+        {
+            DE_GUARD(poseCache);
+            poseCache.value.clear();
+        }
         importer.reset();
         scene = glData.scene = nullptr;
     }
@@ -1083,115 +1138,288 @@ DE_PIMPL(ModelDrawable)
 
 //- Animation ---------------------------------------------------------------------------
 
-    struct AccumData
+    /**
+     * Node of the hierarchy flattened in depth-first order. The descendants of a node
+     * immediately follow it in the array.
+     */
+    struct FlatNode
     {
-        const Animator &   animator;
-        ddouble            time = 0.0;
-        const aiAnimation *anim = nullptr;
-        List<Mat4f>        finalTransforms;
+        const aiNode *node;
+        String        name;
+        int           parent;    ///< Index of the parent node, or -1.
+        int           boneIndex; ///< Index of the bone, or -1.
+        int           end;       ///< Index after the last descendant.
+    };
 
-        AccumData(const Animator &animator, int boneCount)
-            : animator(animator)
-            , finalTransforms(boneCount)
-        {}
+    /**
+     * Identifies an evaluated pose, i.e., the bone transformations of an animation
+     * sequence at a specific point in time.
+     */
+    struct PoseKey
+    {
+        int     animId   = -1; ///< Animation sequence, or -1 for none.
+        int     rootNode = 0;  ///< Flat index of the animated node.
+        ddouble time     = 0;  ///< Wrapped time in ticks (start of the pose time step).
+        List<std::pair<int, Vec4f>> extraRotations; ///< Flat node index, axis and angle.
 
-        const aiNodeAnim *findNodeAnim(const aiNode &node) const
+        bool operator==(const PoseKey &other) const
         {
-            if (!anim) return nullptr;
-            for (duint i = 0; i < anim->mNumChannels; ++i)
+            if (animId != other.animId || rootNode != other.rootNode || time != other.time ||
+                extraRotations.size() != other.extraRotations.size())
             {
-                const aiNodeAnim *na = anim->mChannels[i];
-                if (na->mNodeName == node.mName)
+                return false;
+            }
+            for (dsize i = 0; i < extraRotations.size(); ++i)
+            {
+                const auto &a = extraRotations.at(i);
+                const auto &b = other.extraRotations.at(i);
+                if (a.first != b.first ||
+                    a.second.x != b.second.x || a.second.y != b.second.y ||
+                    a.second.z != b.second.z || a.second.w != b.second.w)
                 {
-                    return na;
+                    return false;
                 }
             }
-            return nullptr;
+            return true;
         }
     };
 
-    void accumulateAnimationTransforms(const Animator &animator,
-                                       ddouble time,
-                                       const aiAnimation *animSeq,
-                                       const aiNode &rootNode) const
+    struct PoseKeyHash
     {
-        AccumData data(animator, boneCount());
-        data.anim = animSeq;
-        // Wrap animation time.
-        data.time = animSeq? std::fmod(secondsToTicks(time, *animSeq), animSeq->mDuration) : time;
+        dsize operator()(const PoseKey &key) const
+        {
+            duint64 hash = 0xcbf29ce484222325ull;
+            hash = combinePoseHash(hash, duint64(key.animId));
+            hash = combinePoseHash(hash, duint64(key.rootNode));
+            hash = combinePoseHash(hash, poseHashBits(key.time));
+            for (const auto &rot : key.extraRotations)
+            {
+                hash = combinePoseHash(hash, duint64(rot.first));
+                hash = combinePoseHash(hash, poseHashBits(rot.second.w));
+            }
+            return dsize(hash);
+        }
+    };
+
+    typedef List<Mat4f> BonePalette;
 
-        accumulateTransforms(rootNode, data);
+    List<FlatNode>                   flatNodes;
+    Hash<const aiNode *, int>        flatNodeIndex;
+    List<List<const aiNodeAnim *>>   animChannels;  ///< [animId][flat node index]
+    struct PoseCache
+    {
+        typedef std::list<std::pair<PoseKey, BonePalette>> Entries;
+
+        Entries entries; ///< Most recently used first.
+        Hash<PoseKey, Entries::iterator, PoseKeyHash> index;
 
-        // Update the resulting matrices in the uniform.
-        for (int i = 0; i < boneCount(); ++i)
+        void clear()
         {
-            uBoneMatrices.set(i, data.finalTransforms.at(i));
+            index.clear();
+            entries.clear();
         }
-    }
+    };
+    mutable LockableT<PoseCache> poseCache;
+    mutable BonePalette              drawPalette;
+    ddouble                          poseTimeStep = 0; ///< Seconds; zero for exact times.
 
-    void accumulateTransforms(const aiNode &node, AccumData &data,
-                              const Mat4f &parentTransform = Mat4f()) const
+    void buildFlatNodes()
     {
-        Mat4f nodeTransform = convertMatrix(node.mTransformation);
+        flatNodes.clear();
+        flatNodeIndex.clear();
+        addFlatNode(*scene->mRootNode, -1);
 
-        // Additional rotation?
-        const Vec4f axisAngle = data.animator.extraRotationForNode(node.mName.C_Str());
+        // Look up the animation channel of each node in advance.
+        animChannels.clear();
+        for (duint i = 0; i < scene->mNumAnimations; ++i)
+        {
+            const aiAnimation &anim = *scene->mAnimations[i];
+            List<const aiNodeAnim *> channels(flatNodes.size(), nullptr);
+            for (dsize n = 0; n < flatNodes.size(); ++n)
+            {
+                for (duint c = 0; c < anim.mNumChannels; ++c)
+                {
+                    if (anim.mChannels[c]->mNodeName == flatNodes.at(n).node->mName)
+                    {
+                        channels[n] = anim.mChannels[c];
+                        break;
+                    }
+                }
+            }
+            animChannels << channels;
+        }
+    }
+
+    void addFlatNode(const aiNode &node, int parent)
+    {
+        const int index = flatNodes.sizei();
+        const String name = node.mName.C_Str();
+        flatNodes << FlatNode{&node, name, parent, findBone(name), 0};
+        flatNodeIndex.insert(&node, index);
 
-        // Transform according to the animation sequence.
-        if (const aiNodeAnim *anim = data.findNodeAnim(node))
+        for (duint i = 0; i < node.mNumChildren; ++i)
         {
-            // Interpolate for this point in time.
-            const Mat4f translation = Mat4f::translate(interpolatePosition(data.time, *anim));
-            const Mat4f scaling     = Mat4f::scale(interpolateScaling(data.time, *anim));
-            Mat4f       rotation    = convertMatrix(aiMatrix4x4(interpolateRotation(data.time, *anim).GetMatrix()));
+            addFlatNode(*node.mChildren[i], index);
+        }
+        flatNodes[index].end = flatNodes.sizei();
+    }
 
-            if (!fequal(axisAngle.w, 0))
+    PoseKey makePoseKey(const Animator &animator, ddouble time, int animId, int rootNode) const
+    {
+        PoseKey key;
+        key.animId   = animId;
+        key.rootNode = rootNode;
+        if (animId >= 0)
+        {
+            // Wrap animation time.
+            const aiAnimation &animSeq = *scene->mAnimations[animId];
+            key.time = std::fmod(secondsToTicks(time, animSeq), animSeq.mDuration);
+            if (poseTimeStep > 0)
             {
-                // Include the custom extra rotation.
-                rotation = Mat4f::rotate(axisAngle.w, axisAngle) * rotation;
+                const ddouble stepTicks = secondsToTicks(poseTimeStep, animSeq);
+                key.time = std::floor(key.time / stepTicks) * stepTicks;
             }
-
-            nodeTransform = translation * rotation * scaling;
         }
-        else
+        for (int i = rootNode; i < flatNodes.at(rootNode).end; ++i)
         {
-            // Model does not specify animation information for this node.
-            // Only apply the possible additional rotation.
+            // Additional rotation?
+            const Vec4f axisAngle = animator.extraRotationForNode(flatNodes.at(i).name);
             if (!fequal(axisAngle.w, 0))
             {
-                nodeTransform = Mat4f::rotate(axisAngle.w, axisAngle) * nodeTransform;
+                key.extraRotations << std::make_pair(i, axisAngle);
             }
         }
+        return key;
+    }
 
-        Mat4f globalTransform = parentTransform * nodeTransform;
+    /**
+     * Calls @a func with the key of each pose needed for drawing with @a animator.
+     */
+    template <typename Func>
+    void forAnimatorPoses(const Animator &animator, Func func) const
+    {
+        if (!scene->HasAnimations() || !animator.count())
+        {
+            // If requested, run through the bone transformations even when
+            // no animations are active.
+            if (animator.flags().testFlag(Animator::AlwaysTransformNodes))
+            {
+                func(makePoseKey(animator, 0, -1, 0));
+                return;
+            }
+        }
 
-        int boneIndex = findBone(String(node.mName.C_Str()));
-        if (boneIndex >= 0)
+        // Apply all current animations.
+        for (int i = 0; i < animator.count(); ++i)
         {
-            data.finalTransforms[boneIndex] =
-                    globalInverse * globalTransform * bones.at(boneIndex).offset;
+            const auto &animSeq = animator.at(i);
+
+            // The animation has been validated earlier.
+            DE_ASSERT(duint(animSeq.animId) < scene->mNumAnimations);
+            DE_ASSERT(nodeNameToPtr.contains(animSeq.node));
+
+            func(makePoseKey(animator,
+                             animator.currentTime(i),
+                             animSeq.animId,
+                             flatNodeIndex[nodeNameToPtr[animSeq.node]]));
         }
+    }
 
-        // Descend to child nodes.
-        for (duint i = 0; i < node.mNumChildren; ++i)
+    /**
+     * Finds a previously evaluated pose, or evaluates it and adds it to the cache.
+     * Can be called from any thread.
+     */
+    void findOrEvaluatePose(const PoseKey &key, BonePalette &palette) const
+    {
+        {
+            DE_GUARD(poseCache);
+            auto &cache = poseCache.value;
+            auto found = cache.index.find(key);
+            if (found != cache.index.end())
+            {
+                // Now the most recently used one.
+                cache.entries.splice(cache.entries.begin(), cache.entries, found->second);
+                palette = found->second->second;
+                return;
+            }
+        }
+
+        evaluatePose(key, palette);
+
+        DE_GUARD(poseCache);
+        auto &cache = poseCache.value;
+        if (cache.index.contains(key)) return; // Evaluated in another thread meanwhile.
+        while (cache.entries.size() >= MAX_CACHED_POSES)
         {
-            accumulateTransforms(*node.mChildren[i], data, globalTransform);
+            cache.index.remove(cache.entries.back().first);
+            cache.entries.pop_back();
         }
+        cache.entries.emplace_front(key, palette);
+        cache.index.insert(key, cache.entries.begin());
     }
 
-    template <typename Type>
-    static duint findAnimKey(ddouble time, const Type *keys, duint count)
+    void evaluatePose(const PoseKey &key, BonePalette &palette) const
     {
-        DE_ASSERT(count > 0);
-        for (duint i = 0; i < count - 1; ++i)
+        palette.clear();
+        palette.resize(boneCount()); // Identity.
+
+        const aiNodeAnim *const *channels =
+            (key.animId >= 0? animChannels.at(key.animId).data() : nullptr);
+        const ddouble time = key.time;
+        const int rootNode = key.rootNode;
+        const int end      = flatNodes.at(rootNode).end;
+        auto      extraRot = key.extraRotations.begin();
+
+        List<Mat4f> globalTransforms(end - rootNode);
+        for (int i = rootNode; i < end; ++i)
         {
-            if (time < keys[i + 1].mTime)
+            const FlatNode &flat = flatNodes.at(i);
+            Mat4f nodeTransform = convertMatrix(flat.node->mTransformation);
+
+            Vec4f axisAngle;
+            if (extraRot != key.extraRotations.end() && extraRot->first == i)
+            {
+                axisAngle = extraRot->second;
+                ++extraRot;
+            }
+
+            // Transform according to the animation sequence.
+            if (const aiNodeAnim *anim = (channels? channels[i] : nullptr))
+            {
+                // Interpolate for this point in time.
+                const Mat4f translation = Mat4f::translate(interpolatePosition(time, *anim));
+                const Mat4f scaling     = Mat4f::scale(interpolateScaling(time, *anim));
+                Mat4f       rotation    = convertMatrix(aiMatrix4x4(interpolateRotation(time, *anim).GetMatrix()));
+
+                if (!fequal(axisAngle.w, 0))
+                {
+                    // Include the custom extra rotation.
+                    rotation = Mat4f::rotate(axisAngle.w, axisAngle) * rotation;
+                }
+
+                nodeTransform = translation * rotation * scaling;
+            }
+            else
+            {
+                // Model does not specify animation information for this node.
+                // Only apply the possible additional rotation.
+                if (!fequal(axisAngle.w, 0))
+                {
+                    nodeTransform = Mat4f::rotate(axisAngle.w, axisAngle) * nodeTransform;
+                }
+            }
+
+            // The animated node itself is not affected by its parents.
+            Mat4f &globalTransform = globalTransforms[i - rootNode];
+            globalTransform = (i == rootNode? nodeTransform
+                                            : globalTransforms.at(flat.parent - rootNode) * nodeTransform);
+
+            if (flat.boneIndex >= 0)
             {
-                return i;
+                palette[flat.boneIndex] =
+                        globalInverse * globalTransform * bones.at(flat.boneIndex).offset;
             }
         }
-        DE_ASSERT_FAIL("Failed to find animation key (invalid time?)");
-        return 0;
     }
 
     static Vec3f interpolateVectorKey(ddouble time, const aiVectorKey *keys, duint at)
@@ -1211,7 +1439,7 @@ DE_PIMPL(ModelDrawable)
         }
 
         const aiQuatKey *key =
-            anim.mRotationKeys + findAnimKey(time, anim.mRotationKeys, anim.mNumRotationKeys);
+            anim.mRotationKeys + findPrecedingKey(time, anim.mRotationKeys, anim.mNumRotationKeys);
 
         aiQuaternion interp;
         aiQuaternion::Interpolate(interp,
@@ -1229,8 +1457,8 @@ DE_PIMPL(ModelDrawable)
             return Vec3f(&anim.mScalingKeys[0].mValue.x);
         }
         return interpolateVectorKey(time, anim.mScalingKeys,
-                                    findAnimKey(time, anim.mScalingKeys,
-                                                anim.mNumScalingKeys));
+                                    findPrecedingKey(time, anim.mScalingKeys,
+                                                     anim.mNumScalingKeys));
     }
 
     static Vec3f interpolatePosition(ddouble time, const aiNodeAnim &anim)
@@ -1240,8 +1468,8 @@ DE_PIMPL(ModelDrawable)
             return Vec3f(&anim.mPositionKeys[0].mValue.x);
         }
         return interpolateVectorKey(time, anim.mPositionKeys,
-                                    findAnimKey(time, anim.mPositionKeys,
-                                                anim.mNumPositionKeys));
+                                    findPrecedingKey(time, anim.mPositionKeys,
+                                                     anim.mNumPositionKeys));
     }
 
     void updateMatricesFromAnimation(const Animator *animator) const
@@ -1249,31 +1477,25 @@ DE_PIMPL(ModelDrawable)
         // Cannot do anything without an Animator.
         if (!animator) return;
 
-        if (!scene->HasAnimations() || !animator->count())
+        forAnimatorPoses(*animator, [this] (const PoseKey &key)
         {
-            // If requested, run through the bone transformations even when
-            // no animations are active.
-            if (animator->flags().testFlag(Animator::AlwaysTransformNodes))
+            findOrEvaluatePose(key, drawPalette);
+
+            // Update the resulting matrices in the uniform.
+            for (int i = 0; i < boneCount(); ++i)
             {
-                accumulateAnimationTransforms(*animator, 0, nullptr, *scene->mRootNode);
-                return;
+                uBoneMatrices.set(i, drawPalette.at(i));
             }
-        }
+        });
+    }
 
-        // Apply all current animations.
-        for (int i = 0; i < animator->count(); ++i)
+    void preparePoses(const Animator &animator) const
+    {
+        BonePalette palette;
+        forAnimatorPoses(animator, [this, &palette] (const PoseKey &key)
         {
-            const auto &animSeq = animator->at(i);
-
-            // The animation has been validated earlier.
-            DE_ASSERT(duint(animSeq.animId) < scene->mNumAnimations);
-            DE_ASSERT(nodeNameToPtr.contains(animSeq.node));
-
-            accumulateAnimationTransforms(*animator,
-                                          animator->currentTime(i),
-                                          scene->mAnimations[animSeq.animId],
-                                          *nodeNameToPtr[animSeq.node]);
-        }
+            findOrEvaluatePose(key, palette);
+        });
     }
 
 //- Drawing -----------------------------------------------------------------------------
@@ -1540,6 +1762,22 @@ int ModelDrawable::animationCount() const
     return d->scene->mNumAnimations;
 }
 
+void ModelDrawable::setPoseTimeStep(ddouble seconds)
+{
+    if (fequal(d->poseTimeStep, max(0.0, seconds))) return;
+
+    d->poseTimeStep = max(0.0, seconds);
+
+    // Poses of the old step are not needed any more.
+    DE_GUARD_FOR(d->poseCache, G);
+    d->poseCache.value.clear();
+}
+
+ddouble ModelDrawable::poseTimeStep() const
+{
+    return d->poseTimeStep;
+}
+
 int ModelDrawable::meshCount() const
 {
     if (!d->scene) return 0;
@@ -1710,6 +1948,26 @@ void ModelDrawable::drawInstanced(const GLBuffer &instanceAttribs,
 #endif
 }
 
+void ModelDrawable::preparePoses(const List<const Animator *> &animators) // static
+{
+    for (int first = 0; first < animators.sizei(); first += POSES_PER_TASK)
+    {
+        const int last = min(first + POSES_PER_TASK, animators.sizei());
+        modelPoseTasks().start([&animators, first, last] ()
+        {
+            for (int i = first; i < last; ++i)
+            {
+                const Animator *animator = animators.at(i);
+                if (animator && animator->model().d->scene)
+                {
+                    animator->model().d->preparePoses(*animator);
+                }
+            }
+        });
+    }
+    modelPoseTasks().waitForDone();
+}
+
 const ModelDrawable::Pass *ModelDrawable::currentPass() const
 {
     return d->drawPass;
@@ -0,0 +1,302 @@
+/** @file modelkernels.cpp  Vertex processing kernels for key-frame models.
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/modelkernels.h"
+
+#include <de/math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define DE_MODELKERNELS_SSE2
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  define DE_MODELKERNELS_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace de {
+namespace modelkernels {
+
+static_assert(sizeof(KeyFrameVertex) == 6 * sizeof(float), "KeyFrameVertex must be tightly packed");
+static_assert(sizeof(Vec3f) == 3 * sizeof(float), "Vec3f must be tightly packed");
+static_assert(sizeof(Vec4ub) == 4, "Vec4ub must be tightly packed");
+
+static inline Vec4ub shadeVertex(const Vec3f &normal, const DirectionalLight *lights,
+                                 dsize lightCount, const Vec4f &ambient)
+{
+    Vec3f accum[2]; // Begin with total darkness [color, extra].
+    for (dsize i = 0; i < lightCount; ++i)
+    {
+        const DirectionalLight &light = lights[i];
+
+        float strength = light.direction.dot(normal) + light.offset;
+
+        // Ability to both light and shade.
+        strength *= (strength > 0? light.lightSide : light.darkSide);
+
+        accum[light.affectedByAmbient? 0 : 1] += light.color * de::clamp(-1.f, strength, 1.f);
+    }
+
+    const Vec3f color = (accum[0].max(ambient) + accum[1]).max(Vec3f()).min(Vec3f(1, 1, 1)) * 255;
+    return Vec4ub(dbyte(color.x), dbyte(color.y), dbyte(color.z),
+                  dbyte(de::clamp(0.f, ambient.w, 1.f) * 255));
+}
+
+namespace scalar {
+
+void lerpKeyFrames(float inter, dsize count, const KeyFrameVertex *from, const KeyFrameVertex *to,
+                   Vec3f *posOut, Vec3f *normOut)
+{
+    for (dsize i = 0; i < count; ++i)
+    {
+        posOut[i]  = de::lerp(from[i].pos,  to[i].pos,  inter);
+        normOut[i] = de::lerp(from[i].norm, to[i].norm, inter);
+    }
+}
+
+void shadeVertices(dsize count, const Vec3f *normals, const DirectionalLight *lights,
+                   dsize lightCount, const Vec4f &ambient, Vec4ub *colorOut)
+{
+    for (dsize i = 0; i < count; ++i)
+    {
+        colorOut[i] = shadeVertex(normals[i], lights, lightCount, ambient);
+    }
+}
+
+} // namespace scalar
+
+#if defined(DE_MODELKERNELS_SSE2)
+
+const char *instructionSet()
+{
+    return "SSE2";
+}
+
+void lerpKeyFrames(float inter, dsize count, const KeyFrameVertex *from, const KeyFrameVertex *to,
+                   Vec3f *posOut, Vec3f *normOut)
+{
+    const __m128 t = _mm_set1_ps(inter);
+    const __m128 s = _mm_set1_ps(1.f - inter);
+
+    // Two vertices (12 floats) at a time.
+    dsize i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const float *a = &from[i].pos.x;
+        const float *b = &to[i].pos.x;
+
+        // [p0x p0y p0z n0x] [n0y n0z p1x p1y] [p1z n1x n1y n1z]
+        const __m128 r0 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(b),     t), _mm_mul_ps(_mm_loadu_ps(a),     s));
+        const __m128 r1 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(b + 4), t), _mm_mul_ps(_mm_loadu_ps(a + 4), s));
+        const __m128 r2 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(b + 8), t), _mm_mul_ps(_mm_loadu_ps(a + 8), s));
+
+        // Positions: [p0x p0y p0z p1x] [p1y p1z].
+        const __m128 p0z = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 p1y = _mm_shuffle_ps(r1, r2, _MM_SHUFFLE(0, 0, 3, 3));
+        float *pos = &posOut[i].x;
+        _mm_storeu_ps(pos, _mm_shuffle_ps(r0, p0z, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storel_pi(reinterpret_cast<__m64 *>(pos + 4), _mm_shuffle_ps(p1y, p1y, _MM_SHUFFLE(2, 2, 2, 0)));
+
+        // Normals: [n0x n0y n0z n1x] [n1y n1z].
+        const __m128 n0x = _mm_shuffle_ps(r0, r1, _MM_SHUFFLE(1, 0, 3, 3));
+        const __m128 n0z = _mm_shuffle_ps(r1, r2, _MM_SHUFFLE(1, 1, 1, 1));
+        float *norm = &normOut[i].x;
+        _mm_storeu_ps(norm, _mm_shuffle_ps(n0x, n0z, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storel_pi(reinterpret_cast<__m64 *>(norm + 4), _mm_movehl_ps(r2, r2));
+    }
+    scalar::lerpKeyFrames(inter, count - i, from + i, to + i, posOut + i, normOut + i);
+}
+
+void shadeVertices(dsize count, const Vec3f *normals, const DirectionalLight *lights,
+                   dsize lightCount, const Vec4f &ambient, Vec4ub *colorOut)
+{
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 one      = _mm_set1_ps(1.f);
+    const __m128 minusOne = _mm_set1_ps(-1.f);
+    const __m128 full     = _mm_set1_ps(255.f);
+    const __m128 ambientR = _mm_set1_ps(ambient.x);
+    const __m128 ambientG = _mm_set1_ps(ambient.y);
+    const __m128 ambientB = _mm_set1_ps(ambient.z);
+    const __m128i alpha   = _mm_set1_epi32(int(dbyte(de::clamp(0.f, ambient.w, 1.f) * 255)) << 24);
+
+    // Four vertices at a time.
+    dsize i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const Vec3f *n = normals + i;
+        const __m128 nx = _mm_setr_ps(n[0].x, n[1].x, n[2].x, n[3].x);
+        const __m128 ny = _mm_setr_ps(n[0].y, n[1].y, n[2].y, n[3].y);
+        const __m128 nz = _mm_setr_ps(n[0].z, n[1].z, n[2].z, n[3].z);
+
+        __m128 accum[2][3] = {{zero, zero, zero}, {zero, zero, zero}};
+        for (dsize k = 0; k < lightCount; ++k)
+        {
+            const DirectionalLight &light = lights[k];
+
+            __m128 strength = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                                  _mm_mul_ps(nx, _mm_set1_ps(light.direction.x)),
+                                  _mm_mul_ps(ny, _mm_set1_ps(light.direction.y))),
+                                  _mm_mul_ps(nz, _mm_set1_ps(light.direction.z))),
+                                  _mm_set1_ps(light.offset));
+
+            const __m128 lit = _mm_cmpgt_ps(strength, zero);
+            strength = _mm_mul_ps(strength, _mm_or_ps(_mm_and_ps   (lit, _mm_set1_ps(light.lightSide)),
+                                                      _mm_andnot_ps(lit, _mm_set1_ps(light.darkSide))));
+            strength = _mm_max_ps(_mm_min_ps(strength, one), minusOne);
+
+            __m128 *acc = accum[light.affectedByAmbient? 0 : 1];
+            acc[0] = _mm_add_ps(acc[0], _mm_mul_ps(_mm_set1_ps(light.color.x), strength));
+            acc[1] = _mm_add_ps(acc[1], _mm_mul_ps(_mm_set1_ps(light.color.y), strength));
+            acc[2] = _mm_add_ps(acc[2], _mm_mul_ps(_mm_set1_ps(light.color.z), strength));
+        }
+
+        const __m128 r = _mm_add_ps(_mm_max_ps(accum[0][0], ambientR), accum[1][0]);
+        const __m128 g = _mm_add_ps(_mm_max_ps(accum[0][1], ambientG), accum[1][1]);
+        const __m128 b = _mm_add_ps(_mm_max_ps(accum[0][2], ambientB), accum[1][2]);
+
+        const __m128i ri = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(r, zero), one), full));
+        const __m128i gi = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(g, zero), one), full));
+        const __m128i bi = _mm_cvttps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(b, zero), one), full));
+
+        // Pack to RGBA bytes.
+        const __m128i rgba = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+                                          _mm_or_si128(_mm_slli_epi32(bi, 16), alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(colorOut + i), rgba);
+    }
+    scalar::shadeVertices(count - i, normals + i, lights, lightCount, ambient, colorOut + i);
+}
+
+#elif defined(DE_MODELKERNELS_NEON)
+
+const char *instructionSet()
+{
+    return "NEON";
+}
+
+void lerpKeyFrames(float inter, dsize count, const KeyFrameVertex *from, const KeyFrameVertex *to,
+                   Vec3f *posOut, Vec3f *normOut)
+{
+    const float32x4_t t = vdupq_n_f32(inter);
+    const float32x4_t s = vdupq_n_f32(1.f - inter);
+
+    // Two vertices at a time, deinterleaved into four triplets: p0, n0, p1, n1.
+    dsize i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const float32x4x3_t a = vld3q_f32(&from[i].pos.x);
+        const float32x4x3_t b = vld3q_f32(&to[i].pos.x);
+        float32x4x3_t r;
+        for (int c = 0; c < 3; ++c)
+        {
+            r.val[c] = vaddq_f32(vmulq_f32(b.val[c], t), vmulq_f32(a.val[c], s));
+        }
+        vst3q_lane_f32(&posOut [i    ].x, r, 0);
+        vst3q_lane_f32(&normOut[i    ].x, r, 1);
+        vst3q_lane_f32(&posOut [i + 1].x, r, 2);
+        vst3q_lane_f32(&normOut[i + 1].x, r, 3);
+    }
+    scalar::lerpKeyFrames(inter, count - i, from + i, to + i, posOut + i, normOut + i);
+}
+
+void shadeVertices(dsize count, const Vec3f *normals, const DirectionalLight *lights,
+                   dsize lightCount, const Vec4f &ambient, Vec4ub *colorOut)
+{
+    const float32x4_t zero     = vdupq_n_f32(0.f);
+    const float32x4_t one      = vdupq_n_f32(1.f);
+    const float32x4_t minusOne = vdupq_n_f32(-1.f);
+    const float32x4_t full     = vdupq_n_f32(255.f);
+    const float32x4_t ambientR = vdupq_n_f32(ambient.x);
+    const float32x4_t ambientG = vdupq_n_f32(ambient.y);
+    const float32x4_t ambientB = vdupq_n_f32(ambient.z);
+    const uint32x4_t  alpha    = vdupq_n_u32(duint32(dbyte(de::clamp(0.f, ambient.w, 1.f) * 255)) << 24);
+
+    // Four vertices at a time.
+    dsize i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x3_t n = vld3q_f32(&normals[i].x);
+
+        float32x4_t accum[2][3] = {{zero, zero, zero}, {zero, zero, zero}};
+        for (dsize k = 0; k < lightCount; ++k)
+        {
+            const DirectionalLight &light = lights[k];
+
+            float32x4_t strength = vaddq_f32(vaddq_f32(vaddq_f32(
+                                       vmulq_n_f32(n.val[0], light.direction.x),
+                                       vmulq_n_f32(n.val[1], light.direction.y)),
+                                       vmulq_n_f32(n.val[2], light.direction.z)),
+                                       vdupq_n_f32(light.offset));
+
+            const uint32x4_t lit = vcgtq_f32(strength, zero);
+            strength = vmulq_f32(strength, vbslq_f32(lit, vdupq_n_f32(light.lightSide),
+                                                          vdupq_n_f32(light.darkSide)));
+            strength = vmaxq_f32(vminq_f32(strength, one), minusOne);
+
+            float32x4_t *acc = accum[light.affectedByAmbient? 0 : 1];
+            acc[0] = vaddq_f32(acc[0], vmulq_n_f32(strength, light.color.x));
+            acc[1] = vaddq_f32(acc[1], vmulq_n_f32(strength, light.color.y));
+            acc[2] = vaddq_f32(acc[2], vmulq_n_f32(strength, light.color.z));
+        }
+
+        const float32x4_t r = vaddq_f32(vmaxq_f32(accum[0][0], ambientR), accum[1][0]);
+        const float32x4_t g = vaddq_f32(vmaxq_f32(accum[0][1], ambientG), accum[1][1]);
+        const float32x4_t b = vaddq_f32(vmaxq_f32(accum[0][2], ambientB), accum[1][2]);
+
+        const uint32x4_t ri = vcvtq_u32_f32(vmulq_f32(vminq_f32(vmaxq_f32(r, zero), one), full));
+        const uint32x4_t gi = vcvtq_u32_f32(vmulq_f32(vminq_f32(vmaxq_f32(g, zero), one), full));
+        const uint32x4_t bi = vcvtq_u32_f32(vmulq_f32(vminq_f32(vmaxq_f32(b, zero), one), full));
+
+        // Pack to RGBA bytes.
+        const uint32x4_t rgba = vorrq_u32(vorrq_u32(ri, vshlq_n_u32(gi, 8)),
+                                          vorrq_u32(vshlq_n_u32(bi, 16), alpha));
+        vst1q_u32(reinterpret_cast<uint32_t *>(colorOut + i), rgba);
+    }
+    scalar::shadeVertices(count - i, normals + i, lights, lightCount, ambient, colorOut + i);
+}
+
+#else // No SIMD available.
+
+const char *instructionSet()
+{
+    return "Scalar";
+}
+
+void lerpKeyFrames(float inter, dsize count, const KeyFrameVertex *from, const KeyFrameVertex *to,
+                   Vec3f *posOut, Vec3f *normOut)
+{
+    scalar::lerpKeyFrames(inter, count, from, to, posOut, normOut);
+}
+
+void shadeVertices(dsize count, const Vec3f *normals, const DirectionalLight *lights,
+                   dsize lightCount, const Vec4f &ambient, Vec4ub *colorOut)
+{
+    scalar::shadeVertices(count, normals, lights, lightCount, ambient, colorOut);
+}
+
+#endif
+
+void copyKeyFrame(dsize count, const KeyFrameVertex *frame, Vec3f *posOut, Vec3f *normOut)
+{
+    for (dsize i = 0; i < count; ++i)
+    {
+        posOut[i]  = frame[i].pos;
+        normOut[i] = frame[i].norm;
+    }
+}
+
+} // namespace modelkernels
+} // namespace de
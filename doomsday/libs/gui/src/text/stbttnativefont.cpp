@@ -18,6 +18,7 @@
 
 #include "../src/text/stbttnativefont.h"
 
+#include <de/hash.h>
 #include <de/keymap.h>
 #include <de/string.h>
 #include <de/threadlocal.h>
@@ -142,10 +143,176 @@ struct FontCache // thread-local
 
 static ThreadLocal<FontCache> s_fontCache;
 
+/// When the coverage bitmaps of all fonts and sizes take more memory than this (per
+/// thread), they are all discarded and glyphs are rasterized again as needed.
+static const dsize MAX_GLYPH_BITMAP_BYTES = 4 * 1024 * 1024;
+
+struct GlyphCaches;
+
+/**
+ * Metrics and coverage bitmaps of the glyphs of one font at one pixel size. Glyphs
+ * are looked up and rasterized only the first time they are needed; afterwards
+ * measuring and rasterizing text just copies what is here.
+ */
+struct GlyphCache // thread-local
+{
+    /// Glyphs are positioned at this fraction of a pixel horizontally.
+    static constexpr int SUBPIXEL_STEPS = 4;
+
+    struct Glyph
+    {
+        int index;           ///< Glyph index in the font.
+        int advance;         ///< Unscaled.
+        int leftSideBearing; ///< Unscaled.
+    };
+
+    struct Raster
+    {
+        Rectanglei bounds;               ///< Relative to the origin on the baseline.
+        dsize      offset       = 0;     ///< Start of the coverage bitmap in @ref bitmaps.
+        bool       isRasterized = false;
+    };
+
+    GlyphCaches *         owner = nullptr;
+    const stbtt_fontinfo *font  = nullptr;
+    float                 scale = 1.0f;
+    Hash<int, Glyph>      glyphs;  ///< By code point.
+    Hash<duint64, int>    kerning; ///< By pair of glyph indices.
+    Hash<int, Raster>     rasters; ///< By glyph index and subpixel step.
+    Block                 bitmaps; ///< Packed 8-bit coverage of all rasterized glyphs.
+
+    static int subpixelStep(float fraction)
+    {
+        return de::clamp(0, int(fraction * SUBPIXEL_STEPS), SUBPIXEL_STEPS - 1);
+    }
+
+    static float subpixelShift(int step)
+    {
+        return float(step) / SUBPIXEL_STEPS;
+    }
+
+    const Glyph &glyph(int ucp)
+    {
+        auto found = glyphs.find(ucp);
+        if (found != glyphs.end())
+        {
+            return found->second;
+        }
+        Glyph glyph;
+        glyph.index = stbtt_FindGlyphIndex(font, ucp);
+        stbtt_GetGlyphHMetrics(font, glyph.index, &glyph.advance, &glyph.leftSideBearing);
+        return glyphs.insert(ucp, glyph)->second;
+    }
+
+    int kernAdvance(int glyph1, int glyph2)
+    {
+        const duint64 pair = (duint64(duint32(glyph1)) << 32) | duint32(glyph2);
+        auto found = kerning.find(pair);
+        if (found != kerning.end())
+        {
+            return found->second;
+        }
+        return kerning.insert(pair, stbtt_GetGlyphKernAdvance(font, glyph1, glyph2))->second;
+    }
+
+    /**
+     * Discards all coverage bitmaps. The metrics are kept.
+     */
+    void dropBitmaps()
+    {
+        for (auto &raster : rasters)
+        {
+            raster.second.isRasterized = false;
+        }
+        bitmaps = Block();
+    }
+
+    const Raster &raster(const Glyph &glyph, int step, bool needBitmap);
+};
+
+struct GlyphCaches // thread-local
+{
+    KeyMap<std::pair<const stbtt_fontinfo *, int>, GlyphCache> caches; // by font and pixel size
+    dsize bitmapBytes = 0; ///< Total size of the coverage bitmaps of all caches.
+
+    GlyphCache &get(const stbtt_fontinfo *font, int pixelSize, float scale)
+    {
+        GlyphCache &cache = caches[std::make_pair(font, pixelSize)];
+        cache.owner = this;
+        cache.font  = font;
+        cache.scale = scale;
+        return cache;
+    }
+
+    /**
+     * Accounts for a new coverage bitmap of @a bytes. If the budget would be exceeded,
+     * the bitmaps of all caches are discarded first.
+     */
+    void reserveBitmap(dsize bytes)
+    {
+        if (bitmapBytes + bytes > MAX_GLYPH_BITMAP_BYTES)
+        {
+            for (auto &cache : caches)
+            {
+                cache.second.dropBitmaps();
+            }
+            bitmapBytes = 0;
+        }
+        bitmapBytes += bytes;
+    }
+};
+
+const GlyphCache::Raster &GlyphCache::raster(const Glyph &glyph, int step, bool needBitmap)
+{
+    const int key = glyph.index * SUBPIXEL_STEPS + step;
+    auto found = rasters.find(key);
+    if (found == rasters.end())
+    {
+        Vec2i glyphPoint[2];
+        stbtt_GetGlyphBitmapBoxSubpixel(font,
+                                        glyph.index,
+                                        scale,
+                                        scale,
+                                        subpixelShift(step),
+                                        0.0f,
+                                        &glyphPoint[0].x,
+                                        &glyphPoint[0].y,
+                                        &glyphPoint[1].x,
+                                        &glyphPoint[1].y);
+        Raster raster;
+        raster.bounds = Rectanglei{glyphPoint[0], glyphPoint[1]};
+        found = rasters.insert(key, raster);
+    }
+    Raster &raster = found->second;
+    if (needBitmap && !raster.isRasterized)
+    {
+        const int   width = raster.bounds.width();
+        const dsize size  = dsize(width * raster.bounds.height());
+        owner->reserveBitmap(size); // may drop all bitmaps, including ours
+        raster.offset = bitmaps.size();
+        bitmaps.resize(bitmaps.size() + size);
+        stbtt_MakeGlyphBitmapSubpixel(font,
+                                      bitmaps.data() + raster.offset,
+                                      width,
+                                      raster.bounds.height(),
+                                      width,
+                                      scale,
+                                      scale,
+                                      subpixelShift(step),
+                                      0.0f,
+                                      glyph.index);
+        raster.isRasterized = true;
+    }
+    return raster;
+}
+
+static ThreadLocal<GlyphCaches> s_glyphCaches;
+
 DE_PIMPL(StbTtNativeFont)
 {
     const stbtt_fontinfo *font      = nullptr;
     float                 fontScale = 1.0f;
+    GlyphCache *          glyphs    = nullptr;
 
     int height = 0;
     int ascent = 0;
@@ -158,6 +325,8 @@ DE_PIMPL(StbTtNativeFont)
     Impl(Public *i, const Impl &d)
         : Base(i)
         , font(d.font)
+        , fontScale(d.fontScale)
+        , glyphs(d.glyphs)
         , height(d.height)
         , ascent(d.ascent)
         , descent(d.descent)
@@ -171,7 +340,9 @@ DE_PIMPL(StbTtNativeFont)
 
         if (font)
         {
-            fontScale = stbtt_ScaleForMappingEmToPixels(font, roundi(self().pointSize() * pixelRatio()));
+            const int pixelSize = roundi(self().pointSize() * pixelRatio());
+            fontScale = stbtt_ScaleForMappingEmToPixels(font, pixelSize);
+            glyphs    = &s_glyphCaches.get().get(font, pixelSize, fontScale);
 
             int fontAscent, fontDescent, fontLineGap;
             stbtt_GetFontVMetrics(font, &fontAscent, &fontDescent, &fontLineGap);
@@ -190,6 +361,7 @@ DE_PIMPL(StbTtNativeFont)
         }
         else
         {
+            glyphs = nullptr;
             height = ascent = descent = lineHeight = 0;
         }
     }
@@ -231,33 +403,21 @@ DE_PIMPL(StbTtNativeFont)
         }
         Rectanglei bounds;
         float xPos = 0.0f;
-        int previousUcp = 0;
+        int previousGlyph = -1;
         for (Char ch : text)
         {
-            const int ucp = int(ch.unicode());
-            if (previousUcp)
+            const GlyphCache::Glyph &glyph = glyphs->glyph(int(ch.unicode()));
+            if (previousGlyph >= 0)
             {
-                xPos += fontScale * stbtt_GetCodepointKernAdvance(font, previousUcp, ucp);
+                xPos += fontScale * glyphs->kernAdvance(previousGlyph, glyph.index);
             }
 
-            int advance;
-            int leftSideBearing;
-            Vec2i glyphPoint[2];
-            stbtt_GetCodepointHMetrics(font, ucp, &advance, &leftSideBearing);
             // Why the LSB*0.5? Don't know, but it seems to work nicely...
-            float xLeft  = xPos - fontScale * leftSideBearing * 0.5f;
-            float xShift = xLeft - std::floor(xLeft);
-            stbtt_GetCodepointBitmapBoxSubpixel(font,
-                                                ucp,
-                                                fontScale,
-                                                fontScale,
-                                                xShift,
-                                                0.0f,
-                                                &glyphPoint[0].x,
-                                                &glyphPoint[0].y,
-                                                &glyphPoint[1].x,
-                                                &glyphPoint[1].y);
-            Rectanglei glyphBounds{glyphPoint[0], glyphPoint[1]};
+            const float xLeft = xPos - fontScale * glyph.leftSideBearing * 0.5f;
+            const GlyphCache::Raster &raster =
+                glyphs->raster(glyph, GlyphCache::subpixelStep(xLeft - std::floor(xLeft)), image != nullptr);
+
+            Rectanglei glyphBounds = raster.bounds;
             glyphBounds.move({int(xLeft), 0});
             if (bounds.isNull())
             {
@@ -270,22 +430,11 @@ DE_PIMPL(StbTtNativeFont)
 
             if (image)
             {
-                // Rasterize the glyph.
-                Block raster(glyphBounds.area());
-                stbtt_MakeCodepointBitmapSubpixel(font,
-                                                  raster.data(),
-                                                  glyphBounds.width(),
-                                                  glyphBounds.height(),
-                                                  glyphBounds.width(),
-                                                  fontScale,
-                                                  fontScale,
-                                                  xShift,
-                                                  0.0f,
-                                                  ucp);
-
+                // Draw the glyph's coverage.
+                const duint8 *coverage = glyphs->bitmaps.data() + raster.offset;
                 for (int y = glyphBounds.top(), sy = 0; y < glyphBounds.bottom(); ++y, ++sy)
                 {
-                    const duint8 *src = &raster[sy * glyphBounds.width()];
+                    const duint8 *src = &coverage[sy * glyphBounds.width()];
                     duint32 *dst = image->row32(imageOrigin.y + y);
                     for (int x = glyphBounds.left(), sx = 0; x < glyphBounds.right(); ++x, ++sx)
                     {
@@ -299,9 +448,8 @@ DE_PIMPL(StbTtNativeFont)
                 }
             }
 
-            xPos += fontScale * advance;
-            
-            previousUcp = ucp;
+            xPos += fontScale * glyph.advance;
+            previousGlyph = glyph.index;
         }
         if (advanceWidth)
         {
@@ -309,6 +457,27 @@ DE_PIMPL(StbTtNativeFont)
         }
         return bounds;
     }
+
+    /**
+     * Determines the advance width of a text string. Only the horizontal metrics of
+     * the glyphs are needed for this.
+     */
+    int advance(const String &text)
+    {
+        float xPos = 0.0f;
+        int previousGlyph = -1;
+        for (Char ch : text)
+        {
+            const GlyphCache::Glyph &glyph = glyphs->glyph(int(ch.unicode()));
+            if (previousGlyph >= 0)
+            {
+                xPos += fontScale * glyphs->kernAdvance(previousGlyph, glyph.index);
+            }
+            xPos += fontScale * glyph.advance;
+            previousGlyph = glyph.index;
+        }
+        return roundi(xPos);
+    }
 };
 
 StbTtNativeFont::StbTtNativeFont(const String &family)
@@ -362,9 +531,11 @@ Rectanglei StbTtNativeFont::nativeFontMeasure(const String &text) const
 
 int StbTtNativeFont::nativeFontAdvanceWidth(const String &text) const
 {
-    int advance = 0;
-    d->rasterize(d->transform(text), &advance, nullptr);
-    return advance;
+    if (d->font)
+    {
+        return d->advance(d->transform(text));
+    }
+    return 0;
 }
 
 Image StbTtNativeFont::nativeFontRasterize(const String &      text,
@@ -0,0 +1,404 @@
+/**
+ * @file main.cpp
+ *
+ * Micro-benchmarks for core data structures and scripts. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+/**
+ * Micro-benchmarks for the core data structures and Doomsday Script.
+ *
+ * Usage: bench_core [-list] [-filter <text>] [-iterations <count>] [-samples <count>]
+ *                   [-json <file>]
+ *
+ * Each case has a stable name and is run for a number of iterations per sample. The
+ * median and the fastest time per iteration are reported. With -json, the results are
+ * also written to a file so that different builds can be compared. -filter selects the
+ * cases whose name contains the text, and -iterations overrides the iteration count
+ * of all the selected cases.
+ */
+
+#include <de/textapp.h>
+#include <de/hash.h>
+#include <de/info.h>
+#include <de/list.h>
+#include <de/pathtree.h>
+#include <de/record.h>
+#include <de/stringpool.h>
+#include <de/time.h>
+#include <de/version.h>
+#include <de/scripting/process.h>
+#include <de/scripting/script.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+using namespace de;
+
+/// Results are written here so that the compiler can't omit the work.
+static volatile duint64 sink;
+
+static inline void keep(duint64 value) { sink = sink + value; }
+
+/**
+ * Benchmark case. The setup function prepares the data and returns the operation to
+ * measure; the operation is called with the number of iterations to run.
+ */
+struct Benchmark
+{
+    using Operation = std::function<void (int iterations)>;
+
+    const char *name;
+    int iterations; ///< Default iterations per sample.
+    std::function<Operation ()> setup;
+};
+
+static StringList makeKeys(int count, const char *pattern)
+{
+    StringList keys;
+    for (int i = 0; i < count; ++i) keys << Stringf(pattern, i * 7919 % 10007, i);
+    return keys;
+}
+
+static String makeInfoSource(int count)
+{
+    String src;
+    for (int i = 0; i < count; ++i)
+    {
+        src += Stringf("thing T%i {\n"
+                       "    health: %i\n"
+                       "    label = \"Thing number %i\"\n"
+                       "    speeds <%i, %i, %i>\n"
+                       "    states {\n"
+                       "        spawn: S%i_SPAWN\n"
+                       "        see: S%i_SEE\n"
+                       "    }\n"
+                       "}\n",
+                       i, 100 + i, i, i, i + 1, i + 2, i, i);
+    }
+    return src;
+}
+
+static const char *scriptLoopSource =
+    "total = 0\n"
+    "i = 0\n"
+    "while i < 1000\n"
+    "    total += i * 2 - 1\n"
+    "    i += 1\n"
+    "end\n";
+
+static const char *scriptCallSource =
+    "def clamp(value, low, high)\n"
+    "    if value < low: return low\n"
+    "    if value > high: return high\n"
+    "    return value\n"
+    "end\n"
+    "total = 0\n"
+    "for v in [-5, 3, 12, 7, 99, 0, 4, -1, 8, 10]\n"
+    "    total += clamp(v, 0, 10)\n"
+    "end\n";
+
+static const char *scriptRecordSource =
+    "record obj\n"
+    "obj.pos = [0, 0, 0]\n"
+    "obj.name = 'Thing'\n"
+    "obj.health = 100\n"
+    "i = 0\n"
+    "while i < 100\n"
+    "    obj.health -= 1\n"
+    "    obj.pos = [i, obj.health, 0]\n"
+    "    i += 1\n"
+    "end\n"
+    "result = [obj.name, obj.health, obj.pos]\n";
+
+/// Executes a parsed script in a new process.
+static Benchmark::Operation scriptRunner(const char *source)
+{
+    std::shared_ptr<Script> script(new Script(source));
+    return [script] (int n) {
+        for (int i = 0; i < n; ++i)
+        {
+            Process proc(*script);
+            proc.execute();
+            keep(proc.globals().size());
+        }
+    };
+}
+
+static const List<Benchmark> &benchmarks()
+{
+    static const List<Benchmark> cases {
+        { "string.append", 100000, [] () -> Benchmark::Operation {
+            return [] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    String s;
+                    for (int k = 0; k < 8; ++k) { s += "segment/"; }
+                    keep(s.size());
+                }
+            };
+        }},
+        { "string.compare_nocase", 200000, [] () -> Benchmark::Operation {
+            return [] (int n) {
+                const String a = "/Home/Data/Textures/Flats/FLOOR4_8.png";
+                const String b = "/home/data/textures/flats/floor4_8.PNG";
+                for (int i = 0; i < n; ++i) keep(duint64(a.compareWithoutCase(b)));
+            };
+        }},
+        { "string.split", 50000, [] () -> Benchmark::Operation {
+            return [] (int n) {
+                const String path = "home/data/textures/flats/floor4_8.png";
+                for (int i = 0; i < n; ++i) keep(path.split('/').size());
+            };
+        }},
+        { "list.append_sum_1k", 10000, [] () -> Benchmark::Operation {
+            return [] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    List<int> list;
+                    for (int k = 0; k < 1000; ++k) list << k;
+                    duint64 sum = 0;
+                    for (int v : list) sum += v;
+                    keep(sum);
+                }
+            };
+        }},
+        { "hash.insert_1k", 1000, [] () -> Benchmark::Operation {
+            std::shared_ptr<StringList> keys(new StringList(makeKeys(1000, "key%i_%i")));
+            return [keys] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    Hash<String, int> hash;
+                    for (int k = 0; k < keys->sizei(); ++k) hash.insert(keys->at(k), k);
+                    keep(hash.size());
+                }
+            };
+        }},
+        { "hash.find", 200000, [] () -> Benchmark::Operation {
+            std::shared_ptr<StringList> keys(new StringList(makeKeys(1000, "key%i_%i")));
+            std::shared_ptr<Hash<String, int>> hash(new Hash<String, int>);
+            for (int k = 0; k < keys->sizei(); ++k) hash->insert(keys->at(k), k);
+            return [keys, hash] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    keep(duint64(hash->find(keys->at(i % keys->sizei()))->second));
+                }
+            };
+        }},
+        { "stringpool.intern", 100000, [] () -> Benchmark::Operation {
+            std::shared_ptr<StringList> keys(new StringList(makeKeys(1000, "Texture%i_%i")));
+            std::shared_ptr<StringPool> pool(new StringPool);
+            for (const String &key : *keys) pool->intern(key);
+            return [keys, pool] (int n) {
+                for (int i = 0; i < n; ++i) keep(pool->intern(keys->at(i % keys->sizei())));
+            };
+        }},
+        { "record.lookup", 200000, [] () -> Benchmark::Operation {
+            std::shared_ptr<StringList> keys(new StringList(makeKeys(100, "member%i_%i")));
+            std::shared_ptr<Record> rec(new Record);
+            for (int k = 0; k < keys->sizei(); ++k) rec->addNumber(keys->at(k), k);
+            return [keys, rec] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    keep(duint64(rec->geti(keys->at(i % keys->sizei()))));
+                }
+            };
+        }},
+        { "record.lookup_path", 100000, [] () -> Benchmark::Operation {
+            std::shared_ptr<Record> rec(new Record);
+            rec->addSubrecord("world").addSubrecord("map").addSubrecord("thing")
+                .addNumber("health", 100);
+            return [rec] (int n) {
+                for (int i = 0; i < n; ++i) keep(duint64(rec->geti("world.map.thing.health")));
+            };
+        }},
+        { "record.copy", 2000, [] () -> Benchmark::Operation {
+            std::shared_ptr<Record> rec(new Record);
+            for (const String &key : makeKeys(100, "member%i_%i")) rec->addNumber(key, 1);
+            return [rec] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    Record copy(*rec);
+                    keep(copy.size());
+                }
+            };
+        }},
+        { "path.segment_hash", 100000, [] () -> Benchmark::Operation {
+            return [] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    const Path path("/home/data/textures/flats/floor4_8.png");
+                    duint64 hash = 0;
+                    for (int s = 0; s < path.segmentCount(); ++s)
+                    {
+                        hash += path.segment(s).key().hash;
+                    }
+                    keep(hash);
+                }
+            };
+        }},
+        { "pathtree.find", 100000, [] () -> Benchmark::Operation {
+            std::shared_ptr<StringList> paths(
+                new StringList(makeKeys(1000, "textures/group%i/texture%i.png")));
+            std::shared_ptr<PathTree> tree(new PathTree);
+            for (const String &path : *paths) tree->insert(Path(path));
+            return [paths, tree] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    keep(tree->has(Path(paths->at(i % paths->sizei())),
+                                   PathTree::MatchFull | PathTree::NoBranch));
+                }
+            };
+        }},
+        { "info.parse", 20, [] () -> Benchmark::Operation {
+            const String source = makeInfoSource(200);
+            return [source] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    Info info(source);
+                    keep(info.root().size());
+                }
+            };
+        }},
+        { "script.parse", 2000, [] () -> Benchmark::Operation {
+            return [] (int n) {
+                for (int i = 0; i < n; ++i)
+                {
+                    Script script(String(scriptLoopSource) + scriptCallSource +
+                                  scriptRecordSource);
+                    keep(script.compound().size());
+                }
+            };
+        }},
+        { "script.loop_1k", 100, [] () { return scriptRunner(scriptLoopSource); } },
+        { "script.calls",   2000, [] () { return scriptRunner(scriptCallSource); } },
+        { "script.records", 200, [] () { return scriptRunner(scriptRecordSource); } },
+    };
+    return cases;
+}
+
+struct Result
+{
+    String name;
+    int iterations;
+    int samples;
+    double medianNs; ///< Per iteration.
+    double minNs;
+};
+
+static String resultsToJSON(const List<Result> &results, int samples)
+{
+    String json = Stringf("{\n"
+                          "\t\"suite\": \"core\",\n"
+                          "\t\"version\": \"%s\",\n"
+                          "\t\"time\": \"%s\",\n"
+                          "\t\"samples\": %i,\n"
+                          "\t\"cases\": [",
+                          Version::currentBuild().fullNumber().c_str(),
+                          Time().asText().c_str(),
+                          samples);
+    for (dsize i = 0; i < results.size(); ++i)
+    {
+        const Result &r = results[i];
+        json += Stringf("%s\n\t\t{ \"name\": \"%s\", \"iterations\": %i, "
+                        "\"median_ns\": %.1f, \"min_ns\": %.1f, \"ops_per_sec\": %.0f }",
+                        i > 0? "," : "", r.name.c_str(), r.iterations,
+                        r.medianNs, r.minNs, r.medianNs > 0? 1.0e9 / r.medianNs : 0.0);
+    }
+    return json + "\n\t]\n}\n";
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    using namespace std;
+    int failures = 0;
+    try
+    {
+        TextApp app(makeList(argc, argv));
+        app.initSubsystems(App::DisablePersistentData);
+        const CommandLine &cmdLine = app.commandLine();
+
+        if (cmdLine.has("-list"))
+        {
+            for (const Benchmark &bench : benchmarks()) cout << bench.name << endl;
+        }
+        else
+        {
+            String filter;
+            String jsonPath;
+            String arg;
+            int iterations = 0;
+            int samples = 5;
+            cmdLine.getParameter("-filter", filter);
+            cmdLine.getParameter("-json", jsonPath);
+            if (cmdLine.getParameter("-iterations", arg)) iterations = max(1, arg.toInt());
+            if (cmdLine.getParameter("-samples", arg))    samples    = max(1, arg.toInt());
+
+            List<Result> results;
+            for (const Benchmark &bench : benchmarks())
+            {
+                if (filter && !String(bench.name).contains(filter)) continue;
+
+                const Benchmark::Operation op = bench.setup();
+                const int count = (iterations > 0? iterations : bench.iterations);
+                op(max(1, count / 10)); // Warm up.
+
+                List<double> times;
+                for (int s = 0; s < samples; ++s)
+                {
+                    Time start;
+                    op(count);
+                    times << start.since() * 1.0e9 / count;
+                }
+                std::sort(times.begin(), times.end());
+
+                const Result result{bench.name, count, samples,
+                                    times[times.size() / 2], times.first()};
+                cout << stringf("%-24s %10i it %14.1f ns/it (min %.1f)",
+                                bench.name, count, result.medianNs, result.minNs) << endl;
+                results << result;
+            }
+            if (results.isEmpty())
+            {
+                cout << "No benchmarks match \"" << filter.c_str() << "\"" << endl;
+                failures++;
+            }
+            if (jsonPath)
+            {
+                ofstream out(jsonPath.c_str());
+                out << resultsToJSON(results, samples);
+                if (!out.good())
+                {
+                    cout << "Failed to write " << jsonPath.c_str() << endl;
+                    failures++;
+                }
+            }
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        failures++;
+    }
+    deinit_Foundation();
+    return failures? 1 : 0;
+}
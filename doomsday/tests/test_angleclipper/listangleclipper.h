@@ -0,0 +1,114 @@
+/** @file listangleclipper.h  Angle clipper based on linked lists.
+ *
+ * @authors Copyright © 2003-2017 Jaakko Keränen <jaakko.keranen@iki.fi>
+ * @authors Copyright © 2006-2015 Daniel Swanson <danij@dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef TEST_LISTANGLECLIPPER_H
+#define TEST_LISTANGLECLIPPER_H
+
+#include "render/angleclipper.h"
+
+/**
+ * The angle clipper as it was before the ranges were kept in sorted arrays. The
+ * clip and occlusion ranges are linked lists drawn from element pools.
+ *
+ * Used as the reference for AngleClipper: both must give the same results for the
+ * same sequence of ranges.
+ */
+class ListAngleClipper
+{
+public:
+    ListAngleClipper();
+
+    /**
+     * Returns non-zero if clipnodes cover the whole range [0..360] degrees.
+     */
+    int isFull() const;
+
+    /**
+     * Returns non-zero if the given map-space @param angle is @em not-yet occluded.
+     */
+    int isAngleVisible(binangle_t angle) const;
+
+    /**
+     * Returns non-zero if the given map-space @a point is @em not-yet occluded.
+     *
+     * @param point  Map-space coordinates to test.
+     */
+    int isPointVisible(const de::Vec3d &point) const;
+
+    /**
+     * Returns non-zero if @em any portion of the given map-space, convex face geometry
+     * is @em not-yet occluded.
+     *
+     * @param poly  Map-space convex face geometry to test.
+     */
+    int isPolyVisible(const mesh::Face &poly) const;
+
+public:  // ---------------------------------------------------------------------------
+
+    /**
+     *
+     */
+    void clearRanges();
+
+    /**
+     * @param from
+     * @param to
+     */
+    int safeAddRange(binangle_t from, binangle_t to);
+
+    /**
+     * Add a segment relative to the current viewpoint.
+     *
+     * @param from  Map-space coordinates describing the start-point.
+     * @param to    Map-space coordinates describing the end-point.
+     */
+    void addRangeFromViewRelPoints(const de::Vec2d &from, const de::Vec2d &to);
+
+    /**
+     * Add an occlusion segment relative to the current viewpoint.
+     *
+     * @param from     Map-space coordinates for the start-point.
+     * @param to       Map-space coordinates for the end-point.
+     * @param height
+     * @param topHalf
+     */
+    void addViewRelOcclusion(const de::Vec2d &from, const de::Vec2d &to,
+                             coord_t height, bool topHalf);
+
+    /**
+     * Check a segment relative to the current viewpoint.
+     *
+     * @param from  Map-space coordinates for the start-point.
+     * @param to    Map-space coordinates for the end-point.
+     */
+    int checkRangeFromViewRelPoints(const de::Vec2d &from, const de::Vec2d &to);
+
+#ifdef DE_DEBUG
+    /**
+     * A debugging aid: checks if clipnode links are valid.
+     */
+    void validate();
+#endif
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif  // TEST_LISTANGLECLIPPER_H
@@ -0,0 +1,232 @@
+/**
+ * @file main.cpp
+ *
+ * AngleClipper tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/angleclipper.h"
+#include "render/rend_main.h"
+#include "listangleclipper.h"
+
+#include <de/list.h>
+#include <de/liblegacy.h>
+#include <de/math.h>
+#include <de/time.h>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace de;
+
+// The clipper gets these from the renderer.
+int devNoCulling = 0;
+static Vec3d eyeOrigin;
+Vec3d Rend_EyeOrigin() { return eyeOrigin; }
+
+/**
+ * One call to the clipper, as made during a frame of BSP traversal.
+ */
+struct RangeOp
+{
+    enum Type { CheckRange, AddRange, AddOcclusion, CheckPoint };
+
+    Type    type;
+    Vec2d   from;
+    Vec2d   to;
+    coord_t height  = 0;
+    bool    topHalf = false;
+    Vec3d   point;
+};
+
+using Frame = List<RangeOp>;
+
+/**
+ * Generates the range sequence of one frame. Walls are front facing and get farther
+ * away as the frame goes on. Their ends are snapped to a polar grid around the eye, so
+ * that many of them share vertices and the clipper has ranges to merge. @a angleSteps
+ * is the number of grid steps around the eye; walls are at most @a maxWidth steps wide.
+ */
+static Frame generateFrame(std::mt19937 &rng, const Vec3d &eye, int walls, int angleSteps,
+                           int maxWidth)
+{
+    std::uniform_real_distribution<double> unit(0, 1);
+    const double step = 2 * de::PI / angleSteps;
+
+    auto viewPoint = [&eye] (double angle, double dist) {
+        return Vec2d(eye.x + dist * std::cos(angle), eye.z + dist * std::sin(angle));
+    };
+
+    Frame frame;
+    for (int i = 0; i < walls; ++i)
+    {
+        const double dist  = 64 + (i / 8) * 32 + std::floor(unit(rng) * 3) * 16;
+        const double angle = std::floor(unit(rng) * angleSteps) * step;
+        const double width = (1 + std::floor(unit(rng) * maxWidth)) * step;
+
+        RangeOp op;
+        op.from = viewPoint(angle + width, dist);
+        op.to   = viewPoint(angle, dist);
+
+        const double kind = unit(rng);
+        if (kind < .3)
+        {
+            op.type = RangeOp::CheckRange;
+            frame << op;
+        }
+        else if (kind < .55)
+        {
+            op.type = RangeOp::AddRange;
+            frame << op;
+        }
+        else
+        {
+            // Openings often occlude both above and below.
+            op.type    = RangeOp::AddOcclusion;
+            op.height  = (unit(rng) < .5? 1 : -1) * (8 + std::floor(unit(rng) * 4) * 16);
+            op.topHalf = op.height > 0;
+            op.height += eye.y;
+            frame << op;
+            if (unit(rng) < .5)
+            {
+                op.height  = 2 * eye.y - op.height;
+                op.topHalf = !op.topHalf;
+                frame << op;
+            }
+        }
+
+        // Sprites and lumobjs around the eye.
+        for (int k = 0; k < 4; ++k)
+        {
+            const double pointAngle = unit(rng) * 2 * de::PI;
+            const double pointDist  = 32 + unit(rng) * 800;
+            RangeOp check;
+            check.type  = RangeOp::CheckPoint;
+            check.point = Vec3d(eye.x + pointDist * std::cos(pointAngle),
+                                eye.y + (unit(rng) - .5) * 400,
+                                eye.z + pointDist * std::sin(pointAngle));
+            frame << check;
+        }
+    }
+    return frame;
+}
+
+/**
+ * Replays the frame on @a clipper. The results of the checks are appended to
+ * @a results.
+ */
+template <typename Clipper>
+static void replay(Clipper &clipper, const Frame &frame, List<int> &results)
+{
+    clipper.clearRanges();
+    for (const RangeOp &op : frame)
+    {
+        switch (op.type)
+        {
+        case RangeOp::CheckRange:
+            results << clipper.checkRangeFromViewRelPoints(op.from, op.to);
+            break;
+
+        case RangeOp::AddRange:
+            clipper.addRangeFromViewRelPoints(op.from, op.to);
+            break;
+
+        case RangeOp::AddOcclusion:
+            clipper.addViewRelOcclusion(op.from, op.to, op.height, op.topHalf);
+            break;
+
+        case RangeOp::CheckPoint:
+            results << clipper.isPointVisible(op.point);
+            break;
+        }
+    }
+    results << clipper.isFull();
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    Libdeng_Init();
+    using namespace std;
+    try
+    {
+        std::mt19937 rng(1234);
+
+        AngleClipper     clipper;
+        ListAngleClipper reference;
+
+        // Both clippers must agree on every check, with coarse and fine vertex grids
+        // and with narrow and wide walls.
+        for (const int angleSteps : {16, 32, 128, 1024})
+        {
+            for (const int maxWidth : {2, 6, 20})
+            {
+                int mismatches = 0;
+                for (int i = 0; i < 200; ++i)
+                {
+                    eyeOrigin = Vec3d(rng() % 1000, 41, rng() % 1000);
+                    const Frame frame = generateFrame(rng, eyeOrigin, 50 + rng() % 400,
+                                                      angleSteps, maxWidth);
+                    List<int> results, expected;
+                    replay(clipper,   frame, results);
+                    replay(reference, frame, expected);
+                    if (results != expected) mismatches++;
+                }
+                cout << stringf("Grid %i, width %i: %i frames differ from the reference",
+                                angleSteps, maxWidth, mismatches) << endl;
+                DE_ASSERT(mismatches == 0);
+            }
+        }
+
+        // Timing with long frames.
+        {
+            List<Frame> frames;
+            List<Vec3d> eyes;
+            for (int i = 0; i < 100; ++i)
+            {
+                eyes << Vec3d(rng() % 1000, 41, rng() % 1000);
+                frames << generateFrame(rng, eyes.last(), 1500, 1024, 6);
+            }
+
+            auto timeReplay = [&frames, &eyes] (auto &clipper) {
+                List<int> results;
+                Time start;
+                for (dsize i = 0; i < frames.size(); ++i)
+                {
+                    eyeOrigin = eyes[i];
+                    results.clear();
+                    replay(clipper, frames[i], results);
+                }
+                return start.since();
+            };
+            const double arrayTime = timeReplay(clipper);
+            const double listTime  = timeReplay(reference);
+
+            cout << stringf("Replayed %zu frames: sorted arrays %.2f ms, linked lists %.2f ms",
+                            frames.size(), arrayTime * 1000, listTime * 1000) << endl;
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    Libdeng_Shutdown();
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
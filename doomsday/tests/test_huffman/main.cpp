@@ -0,0 +1,140 @@
+/**
+ * @file main.cpp
+ *
+ * Huffman codec tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/huffman.h>
+#include <de/list.h>
+#include <de/time.h>
+#include <iostream>
+
+using namespace de;
+
+/**
+ * Generates a packet that resembles a server frame: mostly zeros and small deltas,
+ * with some arbitrary bytes mixed in.
+ */
+static Block makePacket(duint32 &seed, dsize size)
+{
+    Block packet(size);
+    for (dsize i = 0; i < size; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        const duint32 r = seed >> 8;
+        packet.data()[i] = ((r & 3) != 0? dbyte(0) : (r & 16)? dbyte((r >> 5) & 7) : dbyte(r >> 12));
+    }
+    return packet;
+}
+
+static Block bytes(std::initializer_list<dbyte> values)
+{
+    Block block(values.size());
+    dsize i = 0;
+    for (dbyte b : values) block.data()[i++] = b;
+    return block;
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    using namespace std;
+    try
+    {
+        // The encoded format must stay the same (these were produced by the
+        // original tree-based coder).
+        {
+            struct { Block input; Block encoded; } const vectors[] = {
+                { Block(), bytes({0x02}) },
+                { bytes({0x00}), bytes({0x1c}) },
+                { Block("Hello, Doomsday!"),
+                  bytes({0xf4, 0x23, 0x17, 0x00, 0x80, 0x50, 0x76, 0xa2, 0x8a,
+                         0x10, 0x21, 0xb1, 0x5c, 0xf3, 0x27, 0x0a, 0x06, 0x08}) },
+                { bytes({0x00, 0x00, 0x00, 0x12, 0x12, 0x44, 0x43, 0x80, 0xff, 0xfe}),
+                  bytes({0xfe, 0x11, 0xab, 0x2b, 0x63, 0x0e}) },
+            };
+            for (const auto &vec : vectors)
+            {
+                const Block encoded = codec::huffmanEncode(vec.input);
+                if (encoded != vec.encoded)
+                {
+                    cout << "Unexpected encoding: " << encoded.asHexadecimalText() << endl;
+                }
+                DE_ASSERT(encoded == vec.encoded);
+                DE_ASSERT(codec::huffmanDecode(vec.encoded) == vec.input);
+            }
+
+            Block all(256);
+            for (int i = 0; i < 256; ++i) all.data()[i] = dbyte(i);
+            const Block encoded = codec::huffmanEncode(all);
+            duint32 hash = 0;
+            for (dsize i = 0; i < encoded.size(); ++i) hash = hash * 31 + encoded.data()[i];
+            cout << stringf("All byte values: %zu bytes, hash %u", encoded.size(), hash) << endl;
+            DE_ASSERT(encoded.size() == 288);
+            DE_ASSERT(hash == 2326545573u);
+            DE_ASSERT(codec::huffmanDecode(encoded) == all);
+        }
+
+        // Round trip and throughput.
+        {
+            duint32 seed = 1;
+            List<Block> packets;
+            dsize totalBytes = 0;
+            for (int i = 0; i < 5000; ++i)
+            {
+                packets << makePacket(seed, 16 + (seed >> 20) % 1400);
+                totalBytes += packets.last().size();
+            }
+
+            List<Block> encoded;
+            Time start;
+            for (const Block &packet : packets)
+            {
+                encoded << codec::huffmanEncode(packet);
+            }
+            const double encodeTime = start.since();
+
+            dsize encodedBytes = 0;
+            int mismatches = 0;
+            start = Time();
+            for (dsize i = 0; i < packets.size(); ++i)
+            {
+                if (codec::huffmanDecode(encoded[i]) != packets[i]) mismatches++;
+                encodedBytes += encoded[i].size();
+            }
+            const double decodeTime = start.since();
+
+            const double mb = totalBytes / 1.0e6;
+            cout << stringf("%i packets, %zu bytes coded to %zu bytes (%.1f%%)",
+                            packets.sizei(), totalBytes, encodedBytes,
+                            100.0 * encodedBytes / totalBytes) << endl;
+            cout << stringf("Encode: %.1f MB/s, decode (with comparison): %.1f MB/s",
+                            mb / encodeTime, mb / decodeTime) << endl;
+            cout << mismatches << " packets did not survive the round trip" << endl;
+            DE_ASSERT(mismatches == 0);
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file main.cpp
+ *
+ * LumpCache tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <doomsday/filesys/lumpcache.h>
+#include <de/legacy/memory.h>
+#include <de/list.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace de;
+
+static uint8_t *makeLump(uint idx, dsize size)
+{
+    auto *data = reinterpret_cast<uint8_t *>(M_Malloc(size));
+    std::memset(data, int(idx & 0xff), size);
+    return data;
+}
+
+/// Checks if a lump is cached without keeping it locked.
+static bool isCached(LumpCache &cache, uint idx)
+{
+    if (!cache.lock(idx)) return false;
+    cache.unlock(idx);
+    return true;
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    using namespace std;
+    try
+    {
+        // Least recently used lumps are evicted first; locked ones are kept.
+        {
+            LumpCache cache(8);
+            cache.setBudget(3000);
+
+            for (uint i = 0; i < 3; ++i)
+            {
+                cache.insertAndLock(i, makeLump(i, 1000), 1000);
+                cache.unlock(i);
+            }
+            isCached(cache, 0);                         // 1 is now the least recently used.
+            const uint8_t *pinned = cache.lock(2);
+            cache.insertAndLock(3, makeLump(3, 1000), 1000);
+            cache.unlock(3);
+            const bool evicted1 = !isCached(cache, 1);
+            DE_ASSERT(evicted1);
+
+            // Lump 2 is locked, so 0 is evicted instead.
+            cache.insertAndLock(4, makeLump(4, 1000), 1000);
+            cache.unlock(4);
+            DE_ASSERT(pinned && pinned[0] == 2);
+            const bool evicted0 = !isCached(cache, 0);
+            DE_ASSERT(evicted0);
+
+            // Removing a locked lump frees it when unlocked.
+            bool removed = false;
+            cache.remove(2, &removed);
+            DE_ASSERT(removed);
+            DE_ASSERT(pinned[999] == 2); // Still usable while locked.
+            cache.unlock(2);
+            const bool freed2 = !isCached(cache, 2);
+            DE_ASSERT(freed2);
+
+            // Inserting an already cached lump keeps the existing copy.
+            const uint8_t *first = cache.insertAndLock(5, makeLump(5, 100), 100);
+            const uint8_t *again = cache.insertAndLock(5, makeLump(5, 100), 100);
+            DE_ASSERT(again == first);
+            DE_UNUSED(evicted1, evicted0, freed2, first, again);
+            cache.unlock(5).unlock(5);
+
+            const auto stats = cache.statistics();
+            cout << stringf("%i lumps, %zu bytes (peak %zu); %llu hits, %llu misses, "
+                            "%llu evictions", stats.count, stats.bytes, stats.peakBytes,
+                            stats.hits, stats.misses, stats.evictions) << endl;
+            DE_ASSERT(stats.count == 3 && stats.bytes == 2100);
+            DE_ASSERT(stats.misses == 6);
+            DE_ASSERT(stats.evictions == 2);
+
+            cache.clear();
+            DE_ASSERT(cache.statistics().count == 0 && cache.statistics().bytes == 0);
+        }
+
+        // The shared budget evicts the least recently used lumps of all the caches.
+        {
+            const dsize oldBudget = LumpCache::sharedBudget();
+            LumpCache::setSharedBudget(3000);
+
+            LumpCache first(4), second(4);
+            first.insertAndLock(0, makeLump(0, 1000), 1000);
+            first.unlock(0);
+            second.insertAndLock(0, makeLump(0, 1000), 1000);
+            second.unlock(0);
+            first.insertAndLock(1, makeLump(1, 1000), 1000);
+            first.unlock(1);
+
+            // The first lump of the first cache is the least recently used.
+            second.insertAndLock(1, makeLump(1, 1000), 1000);
+            second.unlock(1);
+            const bool firstCached  = isCached(first, 0);
+            const bool secondCached = isCached(second, 0);
+            DE_ASSERT(!firstCached);
+            DE_ASSERT(secondCached);
+            DE_UNUSED(firstCached, secondCached);
+
+            cout << stringf("Shared budget: %llu + %llu evictions, %zu bytes in total",
+                            first.statistics().evictions, second.statistics().evictions,
+                            LumpCache::totalStatistics().bytes) << endl;
+            DE_ASSERT(first.statistics().evictions == 1);
+            DE_ASSERT(second.statistics().evictions == 0);
+            DE_ASSERT(LumpCache::totalStatistics().bytes == 3000);
+
+            LumpCache::setSharedBudget(oldBudget);
+        }
+
+        // Concurrent readers share the cached lumps.
+        {
+            const uint  lumpCount = 256;
+            const dsize lumpSize  = 4096;
+            LumpCache cache(lumpCount);
+            cache.setBudget(lumpCount * lumpSize / 4);
+
+            std::atomic<int> errors { 0 };
+            List<std::thread *> threads;
+            for (int t = 0; t < 8; ++t)
+            {
+                threads << new std::thread([&cache, &errors, t] ()
+                {
+                    duint32 seed = duint32(t + 1);
+                    for (int i = 0; i < 20000; ++i)
+                    {
+                        seed = seed * 1664525 + 1013904223;
+                        const uint idx = (seed >> 8) % lumpCount;
+                        const uint8_t *data = cache.lock(idx);
+                        if (!data)
+                        {
+                            data = cache.insertAndLock(idx, makeLump(idx, lumpSize), lumpSize);
+                        }
+                        if (data[0] != (idx & 0xff) || data[lumpSize - 1] != (idx & 0xff))
+                        {
+                            errors++;
+                        }
+                        cache.unlock(idx);
+                    }
+                });
+            }
+            for (auto *thread : threads)
+            {
+                thread->join();
+                delete thread;
+            }
+
+            const auto stats = cache.statistics();
+            cout << stringf("Concurrent: %llu hits, %llu misses, %llu evictions, %zu bytes",
+                            stats.hits, stats.misses, stats.evictions, stats.bytes) << endl;
+            DE_ASSERT(errors == 0);
+            DE_ASSERT(stats.hits + stats.misses == 8 * 20000);
+            // Lumps locked by other threads may exceed the budget momentarily.
+            DE_ASSERT(stats.bytes <= cache.budget() + 8 * lumpSize);
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file main.cpp
+ *
+ * Model kernel tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/modelkernels.h>
+#include <de/list.h>
+#include <de/math.h>
+#include <de/time.h>
+#include <iostream>
+
+using namespace de;
+using namespace de::modelkernels;
+
+static float randSigned()
+{
+    return randf() * 2 - 1;
+}
+
+static Vec3f randNormal()
+{
+    return Vec3f(randSigned(), randSigned(), randSigned()).normalize();
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    using namespace std;
+    try
+    {
+        cout << "Instruction set: " << instructionSet() << endl;
+
+        // An odd vertex count exercises the scalar tails, too.
+        const dsize count = 1023;
+        List<KeyFrameVertex> from(count), to(count);
+        for (dsize i = 0; i < count; ++i)
+        {
+            from[i] = KeyFrameVertex{Vec3f(randSigned(), randSigned(), randSigned()) * 64, randNormal()};
+            to[i]   = KeyFrameVertex{Vec3f(randSigned(), randSigned(), randSigned()) * 64, randNormal()};
+        }
+
+        List<DirectionalLight> lights;
+        for (int i = 0; i < 6; ++i)
+        {
+            lights << DirectionalLight{randNormal(), Vec3f(randf(), randf(), randf()),
+                                       randf() * .3f, 1.f, randf() * .6f, i != 3};
+        }
+        const Vec4f ambient(.2f, .15f, .1f, .75f);
+
+        List<Vec3f> pos(count), norm(count), refPos(count), refNorm(count);
+        List<Vec4ub> colors(count), refColors(count);
+
+        cout << "Correctness:" << endl;
+        for (float inter : {0.f, .25f, .5f, 1.f})
+        {
+            lerpKeyFrames        (inter, count, from.data(), to.data(), pos.data(), norm.data());
+            scalar::lerpKeyFrames(inter, count, from.data(), to.data(), refPos.data(), refNorm.data());
+
+            int mismatches = 0;
+            for (dsize i = 0; i < count; ++i)
+            {
+                if ((pos[i] - refPos[i]).length() > 1.0e-4f || (norm[i] - refNorm[i]).length() > 1.0e-6f)
+                {
+                    mismatches++;
+                }
+            }
+            cout << stringf("  lerp %.2f: %i mismatches", inter, mismatches) << endl;
+            DE_ASSERT(mismatches == 0);
+        }
+        for (dsize lightCount = 0; lightCount <= lights.size(); ++lightCount)
+        {
+            shadeVertices        (count, norm.data(), lights.data(), lightCount, ambient, colors.data());
+            scalar::shadeVertices(count, norm.data(), lights.data(), lightCount, ambient, refColors.data());
+
+            int mismatches = 0;
+            for (dsize i = 0; i < count; ++i)
+            {
+                // Rounding may differ by one step.
+                const Vec4i delta = (colors[i].toVec4i() - refColors[i].toVec4i()).abs();
+                if (delta.max() > 1) mismatches++;
+            }
+            cout << stringf("  shade with %i lights: %i mismatches", int(lightCount), mismatches) << endl;
+            DE_ASSERT(mismatches == 0);
+        }
+
+        cout << "Throughput (vertices per microsecond):" << endl;
+        const int rounds = 2000;
+        {
+            Time start;
+            for (int r = 0; r < rounds; ++r)
+            {
+                scalar::lerpKeyFrames(r / float(rounds), count, from.data(), to.data(), pos.data(), norm.data());
+            }
+            const double scalarTime = start.since();
+            start = Time();
+            for (int r = 0; r < rounds; ++r)
+            {
+                lerpKeyFrames(r / float(rounds), count, from.data(), to.data(), pos.data(), norm.data());
+            }
+            const double simdTime = start.since();
+            cout << stringf("  lerp: scalar %.1f, %s %.1f",
+                            count * rounds / scalarTime / 1.0e6, instructionSet(),
+                            count * rounds / simdTime / 1.0e6) << endl;
+        }
+        {
+            const dsize lightCount = 4;
+            Time start;
+            for (int r = 0; r < rounds; ++r)
+            {
+                scalar::shadeVertices(count, norm.data(), lights.data(), lightCount, ambient, colors.data());
+            }
+            const double scalarTime = start.since();
+            start = Time();
+            for (int r = 0; r < rounds; ++r)
+            {
+                shadeVertices(count, norm.data(), lights.data(), lightCount, ambient, colors.data());
+            }
+            const double simdTime = start.since();
+            cout << stringf("  shade (%i lights): scalar %.1f, %s %.1f", int(lightCount),
+                            count * rounds / scalarTime / 1.0e6, instructionSet(),
+                            count * rounds / simdTime / 1.0e6) << endl;
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file main.cpp
+ *
+ * Particle momentum kernel tests and timing. @ingroup tests
+ *
+ * Moves a synthetic set of particles the way Generator::moveParticles() does, and
+ * compares the result with a particle-by-particle reference. The time per tic is
+ * reported for the reference, for the kernels, and for the kernels run in worker
+ * threads over many generators' worth of particles.
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "world/particlekernels.h"
+
+#include <de/list.h>
+#include <de/taskpool.h>
+#include <de/time.h>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace de;
+using namespace std;
+
+static const float MAP_GRAVITY  = 1.f;
+static const float MIN_MOMENTUM = 1.f / 65536;
+
+/**
+ * Particles of one generator, one lane per property.
+ */
+struct Lanes
+{
+    List<float> mov[3];
+    List<float> force[3];
+    List<float> gravity;
+    List<float> resistance;
+
+    explicit Lanes(int count, std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> unit(-1, 1);
+        for (int k = 0; k < 3; ++k)
+        {
+            mov[k].resize(count);
+            force[k].resize(count);
+        }
+        gravity.resize(count);
+        resistance.resize(count);
+        for (int i = 0; i < count; ++i)
+        {
+            // Every fourth particle is unused: no forces, no resistance.
+            const bool used = (i % 4 != 3);
+            for (int k = 0; k < 3; ++k)
+            {
+                mov[k][i]   = unit(rng) * 8;
+                force[k][i] = (used? unit(rng) / 16 : 0.f);
+            }
+            gravity[i]    = (used? (unit(rng) + 1) / 2 : 0.f);
+            resistance[i] = (used? .9f + unit(rng) / 20 : 0.f);
+        }
+    }
+
+    int count() const { return gravity.sizei(); }
+
+    void move()
+    {
+        float *movPtrs[3] = { mov[0].data(), mov[1].data(), mov[2].data() };
+        const float *forcePtrs[3] = { force[0].data(), force[1].data(), force[2].data() };
+        particlekernels::applyForces(count(), movPtrs, forcePtrs, gravity.data(), MAP_GRAVITY);
+        particlekernels::applyResistance(count(), movPtrs, resistance.data(), MIN_MOMENTUM);
+    }
+};
+
+/**
+ * Particle stored as a single struct, as before the lanes.
+ */
+struct Particle
+{
+    float mov[3];
+    float force[3];
+    float gravity;
+    float resistance;
+};
+
+static List<Particle> toParticles(const Lanes &lanes)
+{
+    List<Particle> particles(lanes.count());
+    for (int i = 0; i < lanes.count(); ++i)
+    {
+        Particle &pt = particles[i];
+        for (int k = 0; k < 3; ++k)
+        {
+            pt.mov[k]   = lanes.mov[k][i];
+            pt.force[k] = lanes.force[k][i];
+        }
+        pt.gravity    = lanes.gravity[i];
+        pt.resistance = lanes.resistance[i];
+    }
+    return particles;
+}
+
+static void moveReference(List<Particle> &particles)
+{
+    for (Particle &pt : particles)
+    {
+        pt.mov[0] += pt.force[0];
+        pt.mov[1] += pt.force[1];
+        pt.mov[2] += pt.force[2] - MAP_GRAVITY * pt.gravity;
+        for (float &m : pt.mov)
+        {
+            m *= pt.resistance;
+            if (m < MIN_MOMENTUM && m > -MIN_MOMENTUM) m = 0;
+        }
+    }
+}
+
+/**
+ * Vectorized code may round differently (e.g., fused multiply-add), so the momentum
+ * is compared with a tolerance.
+ */
+static bool sameMomentum(const Lanes &lanes, const List<Particle> &particles)
+{
+    for (int i = 0; i < lanes.count(); ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            if (std::abs(lanes.mov[k][i] - particles[i].mov[k]) > 1.0e-3f) return false;
+        }
+    }
+    return true;
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    try
+    {
+        std::mt19937 rng(1234);
+
+        // Same result as moving the particles one at a time.
+        {
+            Lanes lanes(1003, rng); // Not a multiple of the vector width.
+            List<Particle> particles = toParticles(lanes);
+            for (int tic = 0; tic < 200; ++tic)
+            {
+                lanes.move();
+                moveReference(particles);
+            }
+            DE_ASSERT(sameMomentum(lanes, particles));
+
+            // Unused particles have no forces acting on them, so they have stopped.
+            int stopped = 0;
+            for (int i = 0; i < lanes.count(); ++i)
+            {
+                if (i % 4 == 3)
+                {
+                    DE_ASSERT(lanes.mov[0][i] == 0 && lanes.mov[1][i] == 0 && lanes.mov[2][i] == 0);
+                }
+                if (lanes.mov[0][i] == 0) stopped++;
+            }
+            cout << stopped << " of " << lanes.count() << " particles stopped" << endl;
+        }
+
+        // Nothing to move.
+        {
+            Lanes lanes(0, rng);
+            lanes.move();
+            DE_ASSERT(lanes.count() == 0);
+        }
+
+        // Timing with many generators.
+        {
+            const int genCount = 64;
+            const int tics     = 100;
+
+            List<Lanes *> gens;
+            List<List<Particle>> refs;
+            for (int i = 0; i < genCount; ++i)
+            {
+                gens << new Lanes(2048, rng);
+                refs << toParticles(*gens.last());
+            }
+
+            Time start;
+            for (int tic = 0; tic < tics; ++tic)
+            {
+                for (auto &particles : refs) moveReference(particles);
+            }
+            const double referenceTime = start.since();
+
+            start = Time();
+            for (int tic = 0; tic < tics; ++tic)
+            {
+                for (Lanes *lanes : gens) lanes->move();
+            }
+            const double serialTime = start.since();
+
+            for (int i = 0; i < genCount; ++i)
+            {
+                DE_ASSERT(sameMomentum(*gens[i], refs[i]));
+            }
+
+            TaskPool tasks;
+            start = Time();
+            for (int tic = 0; tic < tics; ++tic)
+            {
+                for (int first = 0; first < genCount; first += 8)
+                {
+                    tasks.start([&gens, first] ()
+                    {
+                        for (int i = first; i < first + 8; ++i) gens[i]->move();
+                    });
+                }
+                tasks.waitForDone();
+            }
+            const double concurrentTime = start.since();
+
+            cout << "Moved " << genCount << " x 2048 particles, ms per tic:" << endl
+                 << "  one at a time: " << referenceTime  * 1000 / tics << endl
+                 << "  lanes:         " << serialTime     * 1000 / tics << endl
+                 << "  concurrently:  " << concurrentTime * 1000 / tics << endl;
+
+            deleteAll(gens);
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file main.cpp
+ *
+ * ParticleSorter tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "render/particlesorter.h"
+
+#include <de/list.h>
+#include <de/math.h>
+#include <de/time.h>
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+using namespace de;
+
+static duint32 quantize(float distance)
+{
+    return duint32(de::clamp(0.0, ddouble(distance) * ParticleSorter::QUANTIZATION,
+                             ddouble(0xffffffffu)));
+}
+
+/**
+ * Reference order: farthest first, particles at the same (quantized) distance in
+ * the order they were added.
+ */
+static List<duint32> referenceOrder(const List<float> &distances)
+{
+    List<duint32> order;
+    for (dsize i = 0; i < distances.size(); ++i) order << duint32(i);
+    std::stable_sort(order.begin(), order.end(), [&distances] (duint32 a, duint32 b) {
+        return quantize(distances[a]) > quantize(distances[b]);
+    });
+    return order;
+}
+
+/**
+ * Checks that @a order is a permutation of the particles, from farthest to nearest.
+ */
+static bool isBackToFront(const List<duint32> &order, const List<float> &distances)
+{
+    if (order.size() != distances.size()) return false;
+    List<bool> seen(distances.size(), false);
+    for (dsize i = 0; i < order.size(); ++i)
+    {
+        if (order[i] >= distances.size() || seen[order[i]]) return false;
+        seen[order[i]] = true;
+        if (i > 0 && quantize(distances[order[i - 1]]) < quantize(distances[order[i]]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const List<duint32> &sortFrame(ParticleSorter &sorter, const List<duint64> &ids,
+                                      const List<float> &distances)
+{
+    sorter.clear();
+    for (dsize i = 0; i < ids.size(); ++i) sorter.add(ids[i], distances[i]);
+    return sorter.sort();
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    using namespace std;
+    try
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> distance(0, 4096);
+
+        const dsize count = 2000;
+        List<duint64> ids;
+        List<float> distances;
+        for (dsize i = 0; i < count; ++i)
+        {
+            ids << (duint64(i) << 16 | 0x55);
+            // Some particles are at exactly the same distance.
+            distances << (i % 7 == 0? 100.f : distance(rng));
+        }
+
+        ParticleSorter sorter;
+
+        // The first frame is radix sorted.
+        {
+            const auto &order = sortFrame(sorter, ids, distances);
+            DE_ASSERT(sorter.lastMethod() == ParticleSorter::RadixSort);
+            DE_ASSERT(order == referenceOrder(distances));
+            DE_UNUSED(order);
+        }
+
+        // The same particles, slightly moved: the previous order is fixed up.
+        {
+            std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+            for (dsize i = 0; i < count; ++i)
+            {
+                if (i % 7) distances[i] = de::max(0.f, distances[i] + jitter(rng));
+            }
+            const auto &order = sortFrame(sorter, ids, distances);
+            DE_ASSERT(sorter.lastMethod() == ParticleSorter::IncrementalSort);
+            DE_ASSERT(isBackToFront(order, distances));
+            DE_UNUSED(order);
+        }
+
+        // The same particles in a completely different order: too many moves, so
+        // the sorter falls back to a full sort.
+        {
+            std::shuffle(distances.begin(), distances.end(), rng);
+            const auto &order = sortFrame(sorter, ids, distances);
+            DE_ASSERT(sorter.lastMethod() == ParticleSorter::RadixSort);
+            DE_ASSERT(order == referenceOrder(distances));
+            DE_UNUSED(order);
+        }
+
+        // Different particles are always fully sorted.
+        {
+            ids.removeLast();
+            distances.removeLast();
+            ids << 0xffffffffull;
+            distances << 50000.f;
+            const auto &order = sortFrame(sorter, ids, distances);
+            DE_ASSERT(sorter.lastMethod() == ParticleSorter::RadixSort);
+            DE_ASSERT(order == referenceOrder(distances));
+            DE_UNUSED(order);
+        }
+
+        // Edge cases: nothing to sort, one particle, out-of-range distances.
+        {
+            const bool empty = sortFrame(sorter, {}, {}).isEmpty();
+            DE_ASSERT(empty);
+            const List<duint32> single = sortFrame(sorter, {1}, {10.f});
+            DE_ASSERT(single == List<duint32>({0}));
+            const List<float> extremes { -5.f, 1.0e12f, 0.f, 3.f };
+            const List<duint32> clamped = sortFrame(sorter, {1, 2, 3, 4}, extremes);
+            DE_ASSERT(clamped == referenceOrder(extremes));
+            DE_UNUSED(empty);
+        }
+
+        // Timing with a large synthetic particle set.
+        {
+            const dsize bigCount = 200000;
+            List<duint64> bigIds;
+            List<float> bigDistances;
+            for (dsize i = 0; i < bigCount; ++i)
+            {
+                bigIds << duint64(i);
+                bigDistances << distance(rng);
+            }
+
+            Time start;
+            sortFrame(sorter, bigIds, bigDistances);
+            const double radixTime = start.since();
+
+            for (auto &d : bigDistances) d += 0.01f;
+            start = Time();
+            const auto &order = sortFrame(sorter, bigIds, bigDistances);
+            const double incrementalTime = start.since();
+            DE_ASSERT(sorter.lastMethod() == ParticleSorter::IncrementalSort);
+            DE_ASSERT(isBackToFront(order, bigDistances));
+            DE_UNUSED(order);
+
+            start = Time();
+            referenceOrder(bigDistances);
+            const double referenceTime = start.since();
+
+            cout << stringf("Sorted %zu particles: radix %.2f ms, incremental %.2f ms, "
+                            "std::stable_sort %.2f ms",
+                            bigCount, radixTime * 1000, incrementalTime * 1000,
+                            referenceTime * 1000) << endl;
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
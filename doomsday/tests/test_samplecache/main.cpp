@@ -0,0 +1,188 @@
+/**
+ * @file main.cpp
+ *
+ * SampleCache tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <doomsday/audio/samplecache.h>
+#include <de/list.h>
+#include <de/math.h>
+#include <de/time.h>
+#include <iostream>
+
+using namespace de;
+using namespace audio;
+
+static SampleCache::PreparedSample makeSample(int id, int numSamples)
+{
+    List<duint8> data(dsize(numSamples), 0x80);
+    return SampleCache::prepare(id, 0, data.data(), 1, 11025, numSamples, 1);
+}
+
+/**
+ * Straightforward 16-bit upsampling, as a reference.
+ */
+static List<dint16> referenceUpsample(const List<dint16> &src, int factor)
+{
+    List<dint16> out;
+    for (dsize i = 0; i + 1 < src.size(); ++i)
+    {
+        const int a = src[i], b = src[i + 1];
+        if (factor == 2)
+        {
+            out << dint16(a) << dint16((a + b) >> 1);
+        }
+        else if (factor == 4)
+        {
+            const int mid = (a + b) >> 1;
+            out << dint16(a) << dint16((a + mid) >> 1) << dint16(mid) << dint16((mid + b) >> 1);
+        }
+        else
+        {
+            for (int k = 0; k < factor; ++k) out << dint16(a + (b - a) * k / factor);
+        }
+    }
+    for (int k = 0; k < factor; ++k) out << src.last();
+    return out;
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    using namespace std;
+    try
+    {
+        // Least recently used samples are removed first.
+        {
+            SampleCache cache(3000);
+            List<int> removed;
+            struct Observer : public SampleCache::IRemoveObserver
+            {
+                List<int> *removed;
+                void sampleCacheAboutToRemove(const sfxsample_t &sample) override
+                {
+                    *removed << sample.id;
+                }
+            } observer;
+            observer.removed = &removed;
+            cache.audienceForRemove() += observer;
+
+            cache.insert(makeSample(1, 1000));
+            cache.insert(makeSample(2, 1000));
+            cache.insert(makeSample(3, 1000));
+            cache.markUsed(1);
+            cache.insert(makeSample(4, 1000)); // 2 is the least recently used.
+
+            DE_ASSERT(!cache.has(2));
+            DE_ASSERT(cache.has(1) && cache.has(3) && cache.has(4));
+            DE_ASSERT(removed == List<int>({2}));
+
+            // Samples in use are kept.
+            cache.setInUseCheck([] (const sfxsample_t &s) { return s.id == 3; });
+            cache.insert(makeSample(5, 1000)); // 3 is in use, so 1 goes.
+            DE_ASSERT(cache.has(3));
+            DE_ASSERT(!cache.has(1));
+
+            // A sample larger than the budget is still cached.
+            cache.insert(makeSample(6, 5000));
+            DE_ASSERT(cache.find(6));
+            DE_ASSERT(!cache.find(4));
+            DE_ASSERT(cache.statistics().count == 2);
+
+            const auto stats = cache.statistics();
+            cout << stringf("Cached %i samples, %zu bytes (peak %zu); %u hits, %u misses, "
+                            "%u evictions", stats.count, stats.bytes, stats.peakBytes,
+                            stats.hits, stats.misses, stats.evictions) << endl;
+            cout << "Removed:";
+            for (int id : removed) cout << " " << id;
+            cout << endl;
+            DE_ASSERT(stats.hits == 1 && stats.misses == 1);
+            DE_ASSERT(stats.evictions == 4);
+            DE_ASSERT(stats.bytes == 6000);
+
+            cache.clear();
+            DE_ASSERT(cache.statistics().count == 0 && cache.statistics().bytes == 0);
+        }
+
+        // Conversion to the playback format.
+        {
+            List<duint8> samples8;
+            List<dint16> samples16;
+            for (int i = 0; i < 1001; ++i)
+            {
+                samples8  << duint8(128 + 127 * std::sin(i * 0.05));
+                samples16 << dint16(32767 * std::sin(i * 0.03) * ((i & 1)? -1 : 1));
+            }
+
+            // 8-bit to 16-bit.
+            {
+                const auto prep = SampleCache::prepare(1, 0, samples8.data(), 1, 11025,
+                                                       samples8.sizei(), 2);
+                const auto *out = reinterpret_cast<const dint16 *>(prep.data.data());
+                DE_ASSERT(prep.sample.bytesPer == 2);
+                DE_ASSERT(prep.data.size() == samples8.size() * 2);
+                for (dsize i = 0; i < samples8.size(); ++i)
+                {
+                    DE_ASSERT(out[i] == dint16((samples8[i] - 0x80) << 8));
+                }
+                DE_UNUSED(out);
+            }
+
+            // Upsampling.
+            for (int factor : {2, 3, 4})
+            {
+                const auto prep = SampleCache::prepare(1, 0, samples16.data(), 2, 11025,
+                                                       samples16.sizei(), 2, factor);
+                const auto ref = referenceUpsample(samples16, factor);
+                const auto *out = reinterpret_cast<const dint16 *>(prep.data.data());
+                DE_ASSERT(prep.sample.rate == 11025 * factor);
+                DE_ASSERT(prep.sample.numSamples == ref.sizei());
+
+                // Same as the reference, sample by sample.
+                int mismatches = 0;
+                for (dsize i = 0; i < ref.size(); ++i)
+                {
+                    if (out[i] != ref[i]) mismatches++;
+                }
+                cout << "Upsampled by " << factor << ": " << prep.sample.numSamples
+                     << " samples, " << mismatches << " differ from the reference" << endl;
+                DE_ASSERT(mismatches == 0);
+            }
+
+            // Throughput.
+            {
+                List<dint16> longSample(dsize(11025 * 60), 0);
+                for (dsize i = 0; i < longSample.size(); ++i) longSample[i] = dint16(i * 7);
+                Time start;
+                const auto prep = SampleCache::prepare(1, 0, longSample.data(), 2, 11025,
+                                                       longSample.sizei(), 2, 4);
+                const double elapsed = start.since();
+                cout << stringf("Upsampled 60 s of audio to %i Hz in %.2f ms",
+                                prep.sample.rate, elapsed * 1000) << endl;
+            }
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file main.cpp
+ *
+ * SectorVisibility tests. @ingroup tests
+ *
+ * @authors Copyright © 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include <doomsday/world/sectorvisibility.h>
+#include <iostream>
+
+using namespace de;
+using namespace std;
+using world::SectorVisibility;
+
+static void addLine(List<SectorVisibility::Edge> &edges, const Vec2d &from, const Vec2d &to,
+                    int front, int back = -1)
+{
+    edges << SectorVisibility::Edge{from, to, front, back};
+}
+
+/**
+ * Adds the lines of a rectangle. The front side of each line is inside.
+ */
+static void addRoom(List<SectorVisibility::Edge> &edges, const Vec2d &min, const Vec2d &max,
+                    int front, int back)
+{
+    const Vec2d corners[4] = { min, Vec2d(min.x, max.y), max, Vec2d(max.x, min.y) };
+    for (int i = 0; i < 4; ++i)
+    {
+        addLine(edges, corners[i], corners[(i + 1) % 4], front, back);
+    }
+}
+
+static void printMatrix(const SectorVisibility &pvs)
+{
+    for (int from = 0; from < pvs.sectorCount(); ++from)
+    {
+        String row;
+        for (int to = 0; to < pvs.sectorCount(); ++to)
+        {
+            row += (pvs.isVisible(from, to)? "1" : ".");
+        }
+        cout << "  " << row << "  (" << pvs.visibleCount(from) << " visible)" << endl;
+    }
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    try
+    {
+        // Sector 0 is a room with deep water (sector 1) in the middle, and a walkway
+        // (sector 2) over the water. Sectors 1 and 2 have only self-referencing lines.
+        // Sector 3 is a sealed room elsewhere. Sectors 4 and 5 are rooms joined by an
+        // opening, with a lift (sector 6) made of self-referencing lines in sector 5.
+        List<SectorVisibility::Edge> edges;
+        addRoom(edges, Vec2d(0, 0),       Vec2d(512, 512),   0, -1);
+        addRoom(edges, Vec2d(192, 192),   Vec2d(320, 320),   1,  1);
+        addRoom(edges, Vec2d(240, 100),   Vec2d(272, 400),   2,  2);
+        addRoom(edges, Vec2d(1024, 0),    Vec2d(1280, 256),  3, -1);
+        addLine(edges, Vec2d(0, 1024),    Vec2d(0, 1280),    4);
+        addLine(edges, Vec2d(0, 1280),    Vec2d(256, 1280),  4);
+        addLine(edges, Vec2d(256, 1024),  Vec2d(0, 1024),    4);
+        addLine(edges, Vec2d(256, 1280),  Vec2d(512, 1280),  5);
+        addLine(edges, Vec2d(512, 1280),  Vec2d(512, 1024),  5);
+        addLine(edges, Vec2d(512, 1024),  Vec2d(256, 1024),  5);
+        addLine(edges, Vec2d(256, 1024),  Vec2d(256, 1280),  5, 4);
+        addRoom(edges, Vec2d(400, 1100),  Vec2d(450, 1150),  6, 6);
+
+        SectorVisibility pvs;
+        pvs.build(7, edges);
+
+        cout << "Visibility matrix:" << endl;
+        printMatrix(pvs);
+
+        // Self-referencing sectors see the sector around them, and each other.
+        DE_ASSERT(pvs.isVisible(0, 1) && pvs.isVisible(1, 0));
+        DE_ASSERT(pvs.isVisible(0, 2) && pvs.isVisible(2, 0));
+        DE_ASSERT(pvs.isVisible(1, 2) && pvs.isVisible(2, 1));
+        DE_ASSERT(pvs.isVisible(6, 5) && pvs.isVisible(6, 4) && pvs.isVisible(4, 6));
+
+        // Sealed rooms are not visible.
+        DE_ASSERT(!pvs.isVisible(1, 3) && !pvs.isVisible(3, 1));
+        DE_ASSERT(!pvs.isVisible(0, 4) && !pvs.isVisible(6, 0));
+        DE_ASSERT(pvs.visibleCount(3) == 1);
+
+        // A self-referencing sector with nothing around it may see everything.
+        addRoom(edges, Vec2d(2000, 2000), Vec2d(2100, 2100), 7, 7);
+        pvs.build(8, edges);
+
+        cout << "With an isolated self-referencing sector:" << endl;
+        printMatrix(pvs);
+
+        DE_ASSERT(pvs.visibleCount(7) == 8);
+        DE_ASSERT(pvs.isVisible(3, 7));
+        DE_ASSERT(!pvs.isVisible(3, 0));
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file main.cpp
+ *
+ * UDMFParser tests. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Doomsday Engine contributors
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "udmfparser.h"
+#include <de/block.h>
+#include <de/time.h>
+#include <cstring>
+#include <iostream>
+
+using namespace de;
+
+/**
+ * Generates a TEXTMAP that resembles a large modern map.
+ */
+static Block makeTextmap(int sectorCount)
+{
+    std::string src = "// Synthetic test map.\nnamespace = \"zdoom\";\n\n";
+    for (int s = 0; s < sectorCount; ++s)
+    {
+        const int v = s * 4;
+        for (int i = 0; i < 4; ++i)
+        {
+            src += stringf("vertex // %i\n{\nx = %i.000;\ny = %i.000;\n}\n\n",
+                           v + i, (s % 64) * 128 + (i & 1) * 64, (s / 64) * 128 + (i / 2) * 64);
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            src += stringf("linedef\n{\nv1 = %i;\nv2 = %i;\nsidefront = %i;\nblocking = true;\n"
+                           "special = 80;\narg0 = 0x%x;\ncomment = \"Line \\\"%i\\\"\";\n}\n\n",
+                           v + i, v + (i + 1) % 4, v + i, s & 0xff, v + i);
+            src += stringf("sidedef\n{\nsector = %i;\ntexturemiddle = \"STARTAN2\";\n"
+                           "offsetx = %i;\nlight = 16;\n}\n\n", s, -i * 8);
+        }
+        src += stringf("sector\n{\nheightfloor = 0;\nheightceiling = 128;\n"
+                       "texturefloor = \"FLOOR4_8\";\ntextureceiling = \"CEIL3_5\";\n"
+                       "lightlevel = 192;\nid = %i;\n/* ZDoom extensions. */\n"
+                       "xpanningfloor = 0.5;\nrotationceiling = -45.0;\n}\n\n", s);
+        src += stringf("thing\n{\nx = %i.5;\ny = %i.5;\nangle = 90;\ntype = 3004;\n"
+                       "skill1 = true;\nskill2 = true;\nsingle = true;\n}\n\n",
+                       (s % 64) * 128 + 32, (s / 64) * 128 + 32);
+    }
+    Block block(src.size());
+    std::memcpy(block.data(), src.data(), src.size());
+    return block;
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    using namespace std;
+    try
+    {
+        // Values and handlers.
+        {
+            const String src = "namespace = \"Hexen\";\n"
+                               "THING { x = -32.5; Y = 0x10; type = 017; ambush = true; "
+                               "comment = \"a\\\"b\"; renderstyle = add; }";
+            UDMFParser parser;
+            double x = 0;
+            int y = 0, type = 0;
+            bool ambush = false;
+            int unknownCount = 0;
+            parser.setPropertyHandler("thing", "x", [&x] (const UDMFParser::Literal &v) { x = v.asNumber(); });
+            parser.setPropertyHandler("thing", "y", [&y] (const UDMFParser::Literal &v) { y = v.asInt(); });
+            parser.setPropertyHandler("thing", "type", [&type] (const UDMFParser::Literal &v) { type = v.asInt(); });
+            parser.setPropertyHandler("thing", "ambush", [&ambush] (const UDMFParser::Literal &v) { ambush = v.isTrue(); });
+            parser.setBlockHandler([&unknownCount] (const String &blockType, const UDMFParser::Block &block) {
+                cout << "Block " << blockType << ", comment: " << block["comment"]->asText()
+                     << ", renderstyle: " << block["renderstyle"]->asText() << endl;
+                unknownCount = block.sizei();
+            });
+            parser.parse(src.c_str(), src.c_str() + src.size());
+            cout << "Namespace: " << parser.globals()["namespace"]->asText() << endl;
+            cout << "x: " << x << " y: " << y << " type: " << type << " ambush: " << ambush
+                 << " unhandled: " << unknownCount << endl;
+
+            // Hexadecimal and octal integers; keywords are case-insensitive.
+            DE_ASSERT(fequal(x, -32.5));
+            DE_ASSERT(y == 16);
+            DE_ASSERT(type == 15);
+            DE_ASSERT(ambush);
+
+            // Properties without a handler are passed to the block handler.
+            DE_ASSERT(unknownCount == 2);
+        }
+
+        // Syntax errors.
+        for (const char *bad : {"thing { x = ; }", "thing { x = 1 }", "thing { x = 1;",
+                                "/* comment", "thing { s = \"text; }", "x = 1.2.3;"})
+        {
+            try
+            {
+                UDMFParser().parse(bad, bad + strlen(bad));
+                cout << "No error for: " << bad << endl;
+                DE_ASSERT_FAIL("Syntax error was not detected");
+            }
+            catch (const UDMFParser::SyntaxError &er)
+            {
+                cout << er.asText() << endl;
+            }
+        }
+
+        // Throughput.
+        {
+            const Block textmap = makeTextmap(20000);
+            cout << "TEXTMAP size: " << textmap.size() / 1000 << " KB" << endl;
+
+            int lines = 0;
+            int sectors = 0;
+            double sum = 0;
+            UDMFParser parser;
+            for (const char *key : {"x", "y", "angle", "type", "skill1", "skill2", "single"})
+            {
+                parser.setPropertyHandler("thing", key, [&sum] (const UDMFParser::Literal &v) { sum += v.asNumber(); });
+            }
+            for (const char *key : {"x", "y"})
+            {
+                parser.setPropertyHandler("vertex", key, [&sum] (const UDMFParser::Literal &v) { sum += v.asNumber(); });
+            }
+            for (const char *key : {"v1", "v2", "sidefront", "blocking", "special", "arg0"})
+            {
+                parser.setPropertyHandler("linedef", key, [&sum] (const UDMFParser::Literal &v) { sum += v.asInt(); });
+            }
+            for (const char *key : {"sector", "offsetx", "texturemiddle"})
+            {
+                parser.setPropertyHandler("sidedef", key, [&sum] (const UDMFParser::Literal &v) { sum += v.text.size(); });
+            }
+            for (const char *key : {"heightfloor", "heightceiling", "texturefloor", "textureceiling",
+                                    "lightlevel", "id"})
+            {
+                parser.setPropertyHandler("sector", key, [&sum] (const UDMFParser::Literal &v) { sum += v.text.size(); });
+            }
+            parser.setBlockHandler([&lines, &sectors] (const String &type, const UDMFParser::Block &) {
+                if (type == "linedef") lines++;
+                if (type == "sector")  sectors++;
+            });
+
+            Time start;
+            parser.parse(textmap);
+            const double typedTime = start.since();
+
+            // The same without property handlers: all values are boxed.
+            UDMFParser boxingParser;
+            start = Time();
+            boxingParser.parse(textmap);
+            const double boxedTime = start.since();
+
+            cout << stringf("Parsed %i lines and %i sectors (checksum %.1f)", lines, sectors, sum) << endl;
+            cout << stringf("Typed callbacks: %.1f MB/s", textmap.size() / typedTime / 1.0e6) << endl;
+            cout << stringf("Boxed values:    %.1f MB/s", textmap.size() / boxedTime / 1.0e6) << endl;
+            DE_ASSERT(lines == 80000);
+            DE_ASSERT(sectors == 20000);
+        }
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    debug("Exiting main()...");
+    return 0;
+}